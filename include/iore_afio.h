@@ -30,9 +30,15 @@ typedef struct iore_afio_vtable
   ssize_t
   (*read_dset) (iore_file_t, void *, const iore_test_t *);
   int
+  (*flush) (iore_file_t, const iore_test_t *);
+  int
   (*close) (iore_file_t *);
   int
   (*remove) (iore_file_t);
+  int
+  (*prep) (const iore_test_t *); /* optional, collective, before any file */
+  void
+  (*post) (void); /* optional, collective, after all files */
 } iore_afio_vtable_t;
 
 /*** PROTOTYPES **************************************************************/
@@ -8,14 +8,25 @@
 #define INCLUDE_IORE_AFIO_TYPES_H_
 
 #include "iore_dict.h"
+#include "iore_prng_types.h"
 
 /*** DEFINES *****************************************************************/
 
 #define AFIO_PARAM_SEEK_RW_SINGLE_OP "seek_rw_single_op"
 #define AFIO_PARAM_COLLECTIVE_IO "collective_io"
 #define AFIO_PARAM_FILE_VIEW "file_view"
+#define AFIO_PARAM_TARGET "target"
+#define AFIO_PARAM_BANDWIDTH "bandwidth"
+#define AFIO_PARAM_BURST "burst"
+#define AFIO_PARAM_SERVICE_SLOTS "service_slots"
+#define AFIO_PARAM_SHARED "shared"
+#define AFIO_PARAM_SEED "seed"
+#define AFIO_PARAM_MEMORY_FILE "memory_file"
 
-#define AFIO2STR_FORMAT "iore_afio_t (%p) { type = '%s', params = %s }"
+#define AFIO_TARGET_FILE "file"
+#define AFIO_TARGET_MEMORY "memory"
+
+#define AFIO2STR_FORMAT "iore_afio_t (%p) { type = '%s', params = %s, latency_distrib = %s }"
 
 /*** TYPES *******************************************************************/
 
@@ -23,6 +34,8 @@ enum iore_afio_type
 {
   IORE_AFIO_POSIX, /* POSIX I/O system calls */
   IORE_AFIO_CSTREAM, /* C standard stream-based I/O functions */
+  IORE_AFIO_EMULATOR, /* storage device model over local files or memory */
+  IORE_AFIO_NULL, /* no storage, for measuring the IORE overhead */
 #ifdef WITH_MPIIO_AFIO
   IORE_AFIO_MPIIO, /* MPI-IO functions */
 #endif
@@ -33,6 +46,7 @@ typedef struct iore_afio
 {
   enum iore_afio_type type;
   dict_t params;
+  iore_prng_dist_t *latency_distrib; /* request latency, in microseconds */
 } iore_afio_t;
 
 /*** PROTOTYPES **************************************************************/
@@ -7,7 +7,22 @@
 #ifndef INCLUDE_IORE_AFSB_H_
 #define INCLUDE_IORE_AFSB_H_
 
+#include <stdbool.h>
+
 #include "iore_afsb_types.h"
+#include "iore_file.h"
+
+/*** TYPES *******************************************************************/
+
+typedef struct iore_afsb_vtable
+{
+  int
+  (*valid) (const iore_afsb_t *);
+  int
+  (*prep) (iore_file_t *, const iore_afsb_t *);
+  int
+  (*post) (iore_file_t *, const iore_afsb_t *, bool);
+} iore_afsb_vtable_t;
 
 /*** PROTOTYPES **************************************************************/
 
@@ -18,4 +33,8 @@ afsb_free (iore_afsb_t *);
 int
 afsb_valid (iore_afsb_t *);
 
+/*** VARIABLES ***************************************************************/
+
+extern const iore_afsb_vtable_t *afsb_pool[];
+
 #endif /* INCLUDE_IORE_AFSB_H_ */
@@ -13,6 +13,7 @@
 
 #define AFSB_PARAM_STRIPE_SIZE "stripe_size"
 #define AFSB_PARAM_STRIPE_WIDTH "stripe_width"
+#define AFSB_PARAM_STRIPE_DIRS "stripe_dirs"
 
 #define AFSB2STR_FORMAT "iore_afsb_t (%p) { type = '%s', params = %s }"
 
@@ -21,6 +22,7 @@
 enum iore_afsb_type
 {
   IORE_AFSB_UNSET, /* no AFSB configuration on tests */
+  IORE_AFSB_STRIPED, /* striping emulated over local directories */
 #ifdef WITH_ORANGEFS_AFSB
   IORE_AFSB_ORANGEFS, /* PVFS2/OrangeFS */
 #endif
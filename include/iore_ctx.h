@@ -8,6 +8,7 @@
 #define INCLUDE_IORE_CTX_H_
 
 #include <mpi.h>
+#include <stdio.h>
 
 /*** DEFINES *****************************************************************/
 
@@ -23,7 +24,15 @@ typedef struct iore_ctx
   int task_id;
   MPI_Comm comm;
 
+  /* nodes of the tasks of 'comm', see ctx_node_map () */
+  MPI_Comm node_comm; /* tasks of 'comm' on the node of the task */
+  int *node_of; /* node of each task of 'comm' */
+  int num_nodes;
+
   int verb_lvl;
+  FILE *out; /* summaries of the master task, see run_cosched_exec () */
+
+  struct iore_lmet_slot *lmet; /* live metrics slot of the task, if enabled */
 } iore_ctx_t;
 
 /*** VARIABLES ***************************************************************/
@@ -34,5 +43,9 @@ extern iore_ctx_t ctx;
 
 void
 ctx_init ();
+void
+ctx_node_map ();
+void
+ctx_node_map_free ();
 
 #endif /* INCLUDE_IORE_CTX_H_ */
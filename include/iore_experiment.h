@@ -17,5 +17,7 @@ void
 exp_free (iore_exp_t *);
 int
 exp_exec (iore_exp_t *);
+int
+exp_plan (iore_exp_t *);
 
 #endif /* INCLUDE_IORE_EXPERIMENT_H_ */
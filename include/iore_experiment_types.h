@@ -9,11 +9,12 @@
 
 #include "iore_run_types.h"
 #include "iore_stex_types.h"
+#include "iore_lmet_types.h"
 
 /*** DEFINES *****************************************************************/
 
-#define EXP2STR_FORMAT "iore_exp_t (%p) { num_replications = %u, runs = [ %s ], _runs_len = %u, run_order = '%s', stex = %s }"
-#define EXPREPL2STR_FORMAT "iore_exp_repl_t (%p) { id = %u, runs = [ %s ], _runs_len = %u }"
+#define EXP2STR_FORMAT "iore_exp_t (%p) { num_replications = %u, runs = [ %s ], _runs_len = %u, run_order = '%s', co_schedule = '%s', stex = %s, lmet = %s, clock = %s, reqs = %s, plan = '%s', plan_stripe_size = %zu }"
+#define EXPREPL2STR_FORMAT "iore_exp_repl_t (%p) { id = %u, runs = [ %s ], _runs_len = %u, co_schedule = '%s' }"
 
 /*** TYPES *******************************************************************/
 
@@ -24,6 +25,19 @@ enum iore_exp_run_order
   IORE_RORDER_LENGTH
 };
 
+/**
+ * Co-scheduling of the runs of a replication. Co-scheduled runs take
+ * disjoint groups of tasks, in the order they are defined, and start
+ * together.
+ */
+enum iore_exp_co_schedule
+{
+  IORE_COSCHED_NONE, /* runs executed one after another */
+  IORE_COSCHED_CONCURRENT, /* runs executed at once */
+  IORE_COSCHED_INTERFERENCE, /* runs executed alone, then at once */
+  IORE_COSCHED_LENGTH
+};
+
 typedef struct iore_exp
 {
   unsigned int num_replications;
@@ -31,8 +45,15 @@ typedef struct iore_exp
   iore_run_t *runs;
   unsigned int _runs_len;
   enum iore_exp_run_order run_order;
+  enum iore_exp_co_schedule co_schedule;
 
   iore_stex_t stex;
+  iore_lmet_t lmet;
+  iore_trec_clock_t clock;
+  iore_trec_reqs_t reqs;
+
+  bool plan; /* runs planned instead of executed, see exp_plan () */
+  size_t plan_stripe_size; /* stripe size checked by the plan */
 } iore_exp_t;
 
 typedef struct iore_exp_repl
@@ -41,6 +62,7 @@ typedef struct iore_exp_repl
 
   iore_run_t **runs;
   unsigned int _runs_len;
+  enum iore_exp_co_schedule co_schedule;
 } iore_exp_repl_t;
 
 /*** PROTOTYPES **************************************************************/
@@ -53,5 +75,6 @@ exprepl2str (const iore_exp_repl_t *);
 /*** VARIABLES ***************************************************************/
 
 extern const char *exp_run_order_lbl[];
+extern const char *exp_co_schedule_lbl[];
 
 #endif /* INCLUDE_IORE_EXPERIMENT_TYPES_H_ */
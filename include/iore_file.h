@@ -7,6 +7,8 @@
 #ifndef INCLUDE_IORE_FILE_H_
 #define INCLUDE_IORE_FILE_H_
 
+#include <stddef.h>
+
 /*** DEFINES *****************************************************************/
 
 #ifndef PATH_MAX
@@ -17,6 +19,18 @@
 
 /*** TYPES *******************************************************************/
 
+/**
+ * Objects holding the stripes of a file striped by IORE itself, in
+ * round-robin order.
+ */
+typedef struct iore_file_stripes
+{
+  unsigned int count;
+  size_t size; /* stripe size, in bytes */
+  char **names;
+  int *fints;
+} iore_file_stripes_t;
+
 typedef struct iore_file
 {
   char *name;
@@ -25,6 +39,7 @@ typedef struct iore_file
     int fint;
     void *fptr;
   } hdle;
+  iore_file_stripes_t *stripes; /* NULL for non-striped files */
 } iore_file_t;
 
 /*** PROTOTYPES **************************************************************/
@@ -0,0 +1,70 @@
+/*
+ * iore_lmet.h
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#ifndef INCLUDE_IORE_LMET_H_
+#define INCLUDE_IORE_LMET_H_
+
+#include <stddef.h>
+
+#include "iore_lmet_types.h"
+#include "iore_ctx.h"
+
+/*** PROTOTYPES **************************************************************/
+
+iore_lmet_t *
+lmet_init (iore_lmet_t *);
+void
+lmet_free (iore_lmet_t *);
+bool
+lmet_enabled (const iore_lmet_t *);
+int
+lmet_start (const iore_lmet_t *);
+void
+lmet_stop ();
+
+/*** FUNCTIONS ***************************************************************/
+
+/**
+ * Updates of the slot of the task, at the I/O path. They are plain stores,
+ * as the task is the only writer of its slot, and cost a test when live
+ * metrics are disabled.
+ */
+static inline void
+lmet_xfer (size_t count)
+{
+  iore_lmet_slot_t *slot = ctx.lmet;
+  if (slot)
+    {
+      __atomic_store_n (&slot->bytes, slot->bytes + count, __ATOMIC_RELAXED);
+      __atomic_store_n (&slot->reqs, slot->reqs + 1, __ATOMIC_RELAXED);
+    }
+} /* lmet_xfer () */
+
+static inline void
+lmet_action (int test_type, int action)
+{
+  iore_lmet_slot_t *slot = ctx.lmet;
+  if (slot)
+    {
+      __atomic_store_n (&slot->test_type, test_type, __ATOMIC_RELAXED);
+      __atomic_store_n (&slot->action, action, __ATOMIC_RELAXED);
+    }
+} /* lmet_action () */
+
+static inline void
+lmet_rept (unsigned int exp_repl_id, unsigned int run_id,
+	   unsigned int run_rept_id)
+{
+  iore_lmet_slot_t *slot = ctx.lmet;
+  if (slot)
+    {
+      __atomic_store_n (&slot->exp_repl_id, exp_repl_id, __ATOMIC_RELAXED);
+      __atomic_store_n (&slot->run_id, run_id, __ATOMIC_RELAXED);
+      __atomic_store_n (&slot->run_rept_id, run_rept_id, __ATOMIC_RELAXED);
+    }
+} /* lmet_rept () */
+
+#endif /* INCLUDE_IORE_LMET_H_ */
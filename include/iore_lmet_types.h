@@ -0,0 +1,54 @@
+/*
+ * iore_lmet_types.h
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#ifndef INCLUDE_IORE_LMET_TYPES_H_
+#define INCLUDE_IORE_LMET_TYPES_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*** DEFINES *****************************************************************/
+
+#define LMET2STR_FORMAT "iore_lmet_t (%p) { interval_ms = %u, socket = '%s', prom_file = '%s' }"
+
+#define IORE_LMET_SLOT_ALIGN 64 /* a cache line, slots are not shared */
+#define IORE_LMET_IDLE -1 /* test type and action of idle tasks */
+
+/*** TYPES *******************************************************************/
+
+/**
+ * Live metrics options. Metrics are served when a socket or a file is given.
+ */
+typedef struct iore_lmet
+{
+  unsigned int interval_ms; /* period of file updates and stall checks */
+  char *socket; /* Unix domain socket path */
+  char *prom_file; /* Prometheus text file path */
+} iore_lmet_t;
+
+/**
+ * Live counters of a task, in the shared memory segment of its node. Each
+ * task is the only writer of its slot; the server thread of the node only
+ * reads it.
+ */
+typedef struct iore_lmet_slot
+{
+  int32_t task_id;
+  int32_t test_type; /* enum iore_test_type, or IORE_LMET_IDLE */
+  int32_t action; /* enum iore_trec_action, or IORE_LMET_IDLE */
+  uint32_t exp_repl_id;
+  uint32_t run_id;
+  uint32_t run_rept_id;
+  uint64_t bytes; /* bytes written/read, so far */
+  uint64_t reqs; /* requests written/read, so far */
+} __attribute__ ((aligned (IORE_LMET_SLOT_ALIGN))) iore_lmet_slot_t;
+
+/*** PROTOTYPES **************************************************************/
+
+char *
+lmet2str (const iore_lmet_t *);
+
+#endif /* INCLUDE_IORE_LMET_TYPES_H_ */
@@ -0,0 +1,17 @@
+/*
+ * iore_lmet_valid.h
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#ifndef INCLUDE_IORE_LMET_VALID_H_
+#define INCLUDE_IORE_LMET_VALID_H_
+
+#include "iore_lmet_types.h"
+
+/*** PROTOTYPES **************************************************************/
+
+int
+lmet_valid (iore_lmet_t *);
+
+#endif /* INCLUDE_IORE_LMET_VALID_H_ */
@@ -15,7 +15,7 @@ typedef struct iore_prsr_vtable
 {
   char extension[4];
   int
-  (*parse) (const char *, iore_exp_t *);
+  (*parse) (const char *, size_t, iore_exp_t *); /* parses a definition */
 } iore_prsr_vtable_t;
 
 /*** PROTOTYPES **************************************************************/
@@ -13,23 +13,63 @@
 #define JSON_ATTR_STEX_REPORT_TYPE "report_type"
 #define JSON_ATTR_STEX_DATA_FORMAT "data_format"
 #define JSON_ATTR_STEX_EXPORT_DIR "export_dir"
+#define JSON_ATTR_STEX_TASK_GATHER "task_gather"
+#define JSON_ATTR_STEX_STREAM "stream"
+#define JSON_ATTR_STEX_STREAM_SYNC_INTERVAL "stream_sync_interval"
+#define JSON_ATTR_STEX_OS_COUNTERS "os_counters"
+#define JSON_ATTR_STEX_TIMELINE "timeline"
+#define JSON_ATTR_LMET "live_metrics"
+#define JSON_ATTR_LMET_INTERVAL_MS "interval_ms"
+#define JSON_ATTR_LMET_SOCKET "socket"
+#define JSON_ATTR_LMET_PROM_FILE "prom_file"
+#define JSON_ATTR_CLOCK "clock"
+#define JSON_ATTR_CLOCK_TIMER "timer"
+#define JSON_ATTR_CLOCK_SYNC_ROUNDS "sync_rounds"
+#define JSON_ATTR_REQS "request_capture"
+#define JSON_ATTR_REQS_RING_LEN "ring_len"
+#define JSON_ATTR_REQS_DIR "dir"
 #define JSON_ATTR_NUM_REPLICATIONS "num_replications"
 #define JSON_ATTR_RUN_ORDER "run_order"
+#define JSON_ATTR_CO_SCHEDULE "co_schedule"
 #define JSON_ATTR_RUNS "runs"
 #define JSON_ATTR_RUN_NUM_REPETITIONS "num_repetitions"
+#define JSON_ATTR_RUN_MAX_REPETITIONS "max_repetitions"
+#define JSON_ATTR_RUN_CI_TARGET "ci_target"
+#define JSON_ATTR_RUN_CI_LEVEL "ci_level"
+#define JSON_ATTR_RUN_SWEEP "sweep"
+#define JSON_ATTR_SWEEP_MODE "mode"
+#define JSON_ATTR_SWEEP_PARAMS "params"
+#define JSON_ATTR_SWEEP_PARAM "param"
+#define JSON_ATTR_SWEEP_VALUES "values"
+#define JSON_ATTR_SWEEP_RANGE "range"
+#define JSON_ATTR_SWEEP_RANGE_FROM "from"
+#define JSON_ATTR_SWEEP_RANGE_TO "to"
+#define JSON_ATTR_SWEEP_RANGE_MUL "mul"
+#define JSON_ATTR_SWEEP_RANGE_ADD "add"
 #define JSON_ATTR_TEST "test"
 #define JSON_ATTR_TEST_TYPE "type"
 #define JSON_ATTR_TEST_WRITE_FLUSH "write_flush"
 #define JSON_ATTR_TEST_WRITE_FLUSH_PER_REQ "write_flush_per_req"
+#define JSON_ATTR_TEST_WRITE_FLUSH_MODE "write_flush_mode"
+#define JSON_ATTR_TEST_WRITE_FLUSH_WINDOW "write_flush_window"
+#define JSON_ATTR_TEST_READ_REORDER "read_reorder"
 #define JSON_ATTR_TEST_READ_REORDER_OFFSET "read_reorder_offset"
+#define JSON_ATTR_TEST_READ_CACHE_DEFEAT "read_cache_defeat"
+#define JSON_ATTR_TEST_READ_CACHE_DEFEAT_MEM_SIZE "read_cache_defeat_mem_size"
 #define JSON_ATTR_TEST_INTRA_TEST_BARRIER "intra_test_barrier"
 #define JSON_ATTR_TEST_INTER_TEST_DELAY_SECS "inter_test_delay_secs"
 #define JSON_ATTR_TEST_FILE_MODE "file_mode"
+#define JSON_ATTR_TEST_FILE_GROUP_SIZE "file_group_size"
+#define JSON_ATTR_TEST_FILES_PER_TASK "files_per_task"
+#define JSON_ATTR_TEST_FILE_DIR_HASH "file_dir_hash"
 #define JSON_ATTR_TEST_FILE_NAME "file_name"
 #define JSON_ATTR_TEST_FILE_NAME_APPEND_SEQ_NUM "file_name_append_sequence_num"
 #define JSON_ATTR_TEST_FILE_NAME_APPEND_TASK_ID "file_name_append_task_id"
 #define JSON_ATTR_TEST_FILE_DIR_PER_TASK "file_dir_per_task"
 #define JSON_ATTR_TEST_FILE_KEEP "file_keep"
+#define JSON_ATTR_TEST_FILE_PREALLOC "file_prealloc"
+#define JSON_ATTR_TEST_FILE_REUSE "file_reuse"
+#define JSON_ATTR_TEST_FILE_TRUNCATE "file_truncate"
 #define JSON_ATTR_WKLD "workload"
 #define JSON_ATTR_WKLD_NUM_TASKS "num_tasks"
 #define JSON_ATTR_WKLD_OSET_AC_PATTERN "access_pattern"
@@ -42,7 +82,10 @@
 #define JSON_ATTR_WKLD_DSET_CART_NUM_DIMS "num_dims"
 #define JSON_ATTR_WKLD_DSET_CART_G_DIM_SIZES "dim_sizes"
 #define JSON_ATTR_WKLD_DSET_CART_G_DIM_DIVS "dim_divs"
+#define JSON_ATTR_WKLD_TRACE_FILE "file"
+#define JSON_ATTR_WKLD_TRACE_TIMING "timing"
 #define JSON_ATTR_AFIO "afio"
+#define JSON_ATTR_AFIO_LATENCY_DISTRIB "latency_distrib"
 #define JSON_ATTR_AFSB "afsb"
 
 #endif /* INCLUDE_IORE_PARSER_FILE_JSON_ATTR_H_ */
@@ -17,5 +17,9 @@ void
 run_free (iore_run_t *);
 int
 run_exec (iore_run_t *, unsigned int);
+int
+run_cosched_exec (iore_run_t **, unsigned int, unsigned int, bool);
+int
+run_plan (iore_run_t *, size_t);
 
 #endif /* INCLUDE_IORE_RUN_H_ */
@@ -11,7 +11,7 @@
 
 /*** DEFINES *****************************************************************/
 
-#define RUN2STR_FORMAT "iore_run_t (%p) { id = %u, num_repetitions = %u, test = %s }"
+#define RUN2STR_FORMAT "iore_run_t (%p) { id = %u, num_repetitions = %u, max_repetitions = %u, ci_target = %f, ci_level = %f, test = %s }"
 
 /*** TYPES *******************************************************************/
 
@@ -19,7 +19,10 @@ typedef struct iore_run
 {
   unsigned int id;
 
-  unsigned int num_repetitions;
+  unsigned int num_repetitions; /* minimum, in the adaptive mode */
+  unsigned int max_repetitions; /* adaptive mode if greater than zero */
+  double ci_target; /* relative half-width of the bandwidth CI to reach */
+  double ci_level; /* confidence level of the bandwidth CI */
   iore_test_t test;
 } iore_run_t;
 
@@ -15,9 +15,14 @@
 typedef struct iore_stex_vtable
 {
   int
-  (*export_task) (const iore_trec_exp_t, const char *);
+  (*export_task) (const iore_trec_exp_t, const iore_stex_t *);
   int
-  (*export_test) (const iore_trec_exp_t, const char *);
+  (*export_test) (const iore_trec_exp_t, const iore_stex_t *);
+  int
+  (*export_stats) (const iore_trec_exp_t, const iore_stex_t *);
+  int
+  (*stream_rept) (const iore_stex_t *, unsigned int, unsigned int,
+		  const iore_trec_run_rept_t *); /* NULL if unsupported */
 } iore_stex_vtable_t;
 
 /*** PROTOTYPES **************************************************************/
@@ -28,5 +33,48 @@ void
 stex_free (iore_stex_t *);
 int
 stex_export (const iore_trec_exp_t, const iore_stex_t);
+void
+stex_sweep_add (iore_stex_t *, unsigned int, const char *, const char *);
+const char *
+stex_sweep_value (const iore_stex_sweep_t *, unsigned int, unsigned int);
+int
+stex_stats (const iore_trec_test_t *, iore_stex_stats_t *);
+double
+stex_ci (const double *, unsigned int, double);
+iore_stex_row_t *
+stex_rows (const iore_trec_exp_t, enum iore_stex_report_type, size_t *);
+size_t
+stex_rows_rept (unsigned int, unsigned int, const iore_trec_run_rept_t *,
+		enum iore_stex_report_type, iore_stex_row_t *);
+iore_stex_row_t *
+stex_rows_gather (iore_stex_row_t *, size_t *);
+int
+stex_dir_check (const char *);
+int
+stex_write_shared (const char *, const void *, size_t);
+int
+stex_append_shared (const char *, const void *, size_t);
+long long
+stex_file_size (const char *);
+void
+stex_stream_file_name (const iore_stex_t *, enum iore_stex_report_type,
+		       char *);
+int
+stex_stream_open (const iore_stex_t *);
+int
+stex_stream_rept (unsigned int, unsigned int, const iore_trec_run_rept_t *);
+bool
+stex_stream_done (unsigned int, unsigned int, unsigned int);
+bool
+stex_stream_active ();
+int
+stex_stream_close ();
+int
+stex_timeline_open (const iore_stex_t *);
+int
+stex_timeline_rept (unsigned int, unsigned int, const iore_trec_run_rept_t *,
+		    bool);
+void
+stex_timeline_close ();
 
 #endif /* INCLUDE_IORE_STEX_H_ */
@@ -0,0 +1,140 @@
+/*
+ * iore_stex_columnar.h
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#ifndef INCLUDE_IORE_STEX_COLUMNAR_H_
+#define INCLUDE_IORE_STEX_COLUMNAR_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*** DEFINES *****************************************************************/
+
+/**
+ * Columnar report files are laid out as a header, the columns, each one
+ * holding the values of all rows, and a footer with the column directory,
+ * the label dictionary and the index. A trailer at the end of the file
+ * locates the footer. Fields are in the byte order of the writer.
+ */
+#define IORE_STEX_COL_MAGIC "IORECOLS"
+#define IORE_STEX_COL_VERSION 1
+#define IORE_STEX_COL_BYTE_ORDER 0x01020304 /* reads 0x04030201 if swapped */
+#define IORE_STEX_COL_ALIGN 8 /* columns start at multiples of it */
+#define IORE_STEX_COL_LABEL_LEN 16
+
+/*** TYPES *******************************************************************/
+
+enum iore_stex_col
+{
+  IORE_STEX_COL_EXP_REPL_ID, /* uint32_t */
+  IORE_STEX_COL_RUN_ID, /* uint32_t */
+  IORE_STEX_COL_RUN_REPT_ID, /* uint32_t */
+  IORE_STEX_COL_TASK_ID, /* int32_t, -1 in the test report */
+  IORE_STEX_COL_LABEL, /* uint8_t, code into the label dictionary */
+  IORE_STEX_COL_START_TIME, /* double */
+  IORE_STEX_COL_STOP_TIME, /* double */
+  IORE_STEX_COL_DATA_SIZE, /* uint64_t */
+  IORE_STEX_COL_LENGTH
+};
+
+typedef struct iore_stex_col_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t report_type;
+  uint32_t num_cols;
+  uint64_t num_rows;
+} iore_stex_col_header_t;
+
+/**
+ * Footer, followed by 'num_cols' column descriptors, 'num_labels' labels
+ * and 'num_entries' index entries.
+ */
+typedef struct iore_stex_col_footer
+{
+  uint32_t num_cols;
+  uint32_t num_labels;
+  uint64_t num_entries;
+} iore_stex_col_footer_t;
+
+typedef struct iore_stex_col_desc
+{
+  uint32_t id;
+  uint32_t width;
+  uint64_t offset;
+} iore_stex_col_desc_t;
+
+/**
+ * Dictionary entry of the test/action label of rows. Test types and actions
+ * are indices of test_type_lbl and trec_action_lbl.
+ */
+typedef struct iore_stex_col_label
+{
+  uint8_t test;
+  uint8_t action;
+  char test_lbl[IORE_STEX_COL_LABEL_LEN];
+  char action_lbl[IORE_STEX_COL_LABEL_LEN];
+  uint8_t pad[6];
+} iore_stex_col_label_t;
+
+/**
+ * Index entry of the rows of a run repetition, which are contiguous.
+ */
+typedef struct iore_stex_col_entry
+{
+  uint32_t exp_repl_id;
+  uint32_t run_id;
+  uint32_t run_rept_id;
+  uint32_t pad;
+  uint64_t first_row;
+  uint64_t num_rows;
+} iore_stex_col_entry_t;
+
+typedef struct iore_stex_col_trailer
+{
+  uint64_t footer_offset;
+  char magic[8];
+} iore_stex_col_trailer_t;
+
+/**
+ * Columnar report file loaded in memory.
+ */
+typedef struct iore_stex_cols
+{
+  uint32_t report_type;
+  uint64_t num_rows;
+
+  uint32_t *exp_repl_id;
+  uint32_t *run_id;
+  uint32_t *run_rept_id;
+  int32_t *task_id;
+  uint8_t *label;
+  double *start_time;
+  double *stop_time;
+  uint64_t *data_size;
+
+  uint32_t num_labels;
+  iore_stex_col_label_t *labels;
+  uint64_t num_entries;
+  iore_stex_col_entry_t *entries;
+
+  char *_data; /* file contents */
+} iore_stex_cols_t;
+
+/*** PROTOTYPES **************************************************************/
+
+int
+stex_cols_read (const char *, iore_stex_cols_t *);
+void
+stex_cols_free (iore_stex_cols_t *);
+const iore_stex_col_entry_t *
+stex_cols_find (const iore_stex_cols_t *, unsigned int, unsigned int,
+		unsigned int);
+void
+stex_cols_to_csv (const iore_stex_cols_t *, const iore_stex_col_entry_t *,
+		  FILE *);
+
+#endif /* INCLUDE_IORE_STEX_COLUMNAR_H_ */
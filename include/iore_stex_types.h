@@ -9,15 +9,19 @@
 
 #include <stdbool.h>
 
+#include "iore_trec_types.h"
+
 /*** DEFINES *****************************************************************/
 
-#define STEX2STR_FORMAT "iore_stex_t (%p) { report_type = { task = '%s', test = '%s' }, data_format = '%s', export_dir = '%s' }"
+#define STEX2STR_FORMAT "iore_stex_t (%p) { report_type = { task = '%s', test = '%s', stats = '%s' }, data_format = '%s', export_dir = '%s', task_gather = '%s', stream = '%s', stream_sync_interval = %u, resume = '%s', timeline = '%s', os_counters = { rusage = '%s', io = '%s', perf = '%s' }, sweep_params = %u }"
 
 /*** TYPES *******************************************************************/
 
 enum iore_stex_format
 {
   IORE_STEX_FORMAT_CSV, /* comma-separated values format */
+  IORE_STEX_FORMAT_BINARY, /* fixed-size binary records */
+  IORE_STEX_FORMAT_COLUMNAR, /* binary columns, with an index */
   IORE_STEX_FORMAT_LENGTH
 };
 
@@ -25,6 +29,7 @@ enum iore_stex_report_type
 {
   IORE_STEX_REPORT_TASK, /* statistics per task */
   IORE_STEX_REPORT_TEST, /* statistics per write/read test */
+  IORE_STEX_REPORT_STATS, /* distributions across tasks per test action */
   IORE_STEX_REPORT_LENGTH
 };
 
@@ -32,15 +37,80 @@ typedef struct iore_stex_report_type_flags
 {
   bool task; /* statistics per task */
   bool test; /* statistics per write/read test */
+  bool stats; /* distributions across tasks per test action */
 } iore_stex_report_type_flags_t;
 
+/**
+ * Coordinates of the runs generated by parameter sweeps, exported as a
+ * column per swept parameter. Values are indexed by run id and parameter,
+ * i.e., values[run_id * num_params + param], and NULL where the run does
+ * not sweep the parameter.
+ */
+typedef struct iore_stex_sweep
+{
+  unsigned int num_params;
+  char **params; /* swept parameters */
+  unsigned int num_runs; /* highest run id + 1 */
+  char **values;
+} iore_stex_sweep_t;
+
 typedef struct iore_stex
 {
   iore_stex_report_type_flags_t report_type;
   enum iore_stex_format data_format;
   char *export_dir;
+  bool task_gather; /* task report gathered at the master task */
+  bool stream; /* reports appended after each run repetition */
+  unsigned int stream_sync_interval; /* run repetitions between syncs */
+  bool resume; /* streamed reports resumed from their journal */
+  bool timeline; /* timeline of each run repetition, Chrome trace format */
+  iore_trec_rsrc_flags_t os_counters; /* resource counters per action */
+  iore_stex_sweep_t sweep;
 } iore_stex_t;
 
+/**
+ * Distribution of a metric across the tasks of a test.
+ */
+typedef struct iore_stex_dist
+{
+  double min;
+  double median;
+  double mean;
+  double p95;
+  double max;
+} iore_stex_dist_t;
+
+/**
+ * Statistics of a test action across tasks.
+ */
+typedef struct iore_stex_stats
+{
+  int num_tasks; /* tasks accounted */
+  iore_stex_dist_t latency; /* duration, in seconds */
+  iore_stex_dist_t throughput; /* task bandwidth, in bytes/s (write/read) */
+  double start_skew; /* spread of start times, i.e., barrier exit skew */
+  int straggler_task; /* task with the longest duration */
+  const char *straggler_host;
+  unsigned int num_stragglers; /* tasks well above the median duration */
+} iore_stex_stats_t;
+
+/**
+ * Row of the task and test reports, i.e., an action of a test. Rows of the
+ * test report have a negative task id.
+ */
+typedef struct iore_stex_row
+{
+  unsigned int exp_repl_id;
+  unsigned int run_id;
+  unsigned int run_rept_id;
+  int task_id;
+  enum iore_test_type type;
+  enum iore_trec_action action;
+  iore_time_t time[IORE_TREC_EVENT_LENGTH];
+  size_t data_size;
+  double rsrc[IORE_TREC_RSRC_LENGTH]; /* summed across tasks at the test */
+} iore_stex_row_t;
+
 /*** PROTOTYPES **************************************************************/
 
 char *
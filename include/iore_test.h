@@ -17,5 +17,7 @@ void
 test_free (iore_test_t *);
 int
 test_exec (iore_test_t *, unsigned int, unsigned int, unsigned int);
+int
+test_plan (iore_test_t *, size_t);
 
 #endif /* INCLUDE_IORE_TEST_H_ */
@@ -8,6 +8,7 @@
 #define INCLUDE_IORE_TEST_TYPES_H_
 
 #include <stdbool.h>
+#include <mpi.h>
 
 #include "iore_afio_types.h"
 #include "iore_afsb_types.h"
@@ -15,7 +16,8 @@
 
 /*** DEFINES *****************************************************************/
 
-#define TEST2STR_FORMAT "iore_test_t (%p) { type = { write = '%s', read = '%s' }, write_flush = '%s', write_flush_per_req = '%s', read_reorder_offset = %d, intra_test_barrier = '%s', inter_test_delay_secs = %d, file_mode = '%s', file_name = '%s', file_name_append_sequence_num = '%s', file_name_append_task_id = '%s', file_dir_per_task = '%s', file_keep = '%s', wkld = %s, afio = %s, afsb = %s }"
+#define TEST_DIRECT_ALIGNMENT 4096 /* of O_DIRECT sizes, offsets and buffers */
+#define TEST2STR_FORMAT "iore_test_t (%p) { type = { write = '%s', read = '%s' }, write_flush = '%s', write_flush_per_req = '%s', write_flush_mode = '%s', write_flush_window = %u, read_reorder = '%s', read_reorder_offset = %d, read_cache_defeat = '%s', read_cache_defeat_mem_size = %zu, intra_test_barrier = '%s', inter_test_delay_secs = %d, file_mode = '%s', file_group_size = %u, files_per_task = %u, file_dir_hash = %u, file_name = '%s', file_name_append_sequence_num = '%s', file_name_append_task_id = '%s', file_dir_per_task = '%s', file_keep = '%s', file_prealloc = '%s', file_reuse = '%s', file_truncate = '%s', wkld = %s, afio = %s, afsb = %s }"
 
 /*** TYPES *******************************************************************/
 
@@ -23,9 +25,46 @@ enum iore_test_file_mode
 {
   IORE_TEST_FMODE_NX1, /* single file shared by all tasks */
   IORE_TEST_FMODE_NXN, /* one independent file for each task */
+  IORE_TEST_FMODE_NXM, /* one file shared by each group of tasks */
   IORE_TEST_FMODE_LENGTH
 };
 
+enum iore_test_flush_mode
+{
+  IORE_TEST_FLUSH_FSYNC, /* fsync(), or the AFIO native flush */
+  IORE_TEST_FLUSH_FDATASYNC, /* fdatasync() */
+  IORE_TEST_FLUSH_SYNC_FILE_RANGE, /* sync_file_range() write-behind */
+  IORE_TEST_FLUSH_O_DSYNC, /* file created with O_DSYNC */
+  IORE_TEST_FLUSH_O_SYNC, /* file created with O_SYNC */
+  IORE_TEST_FLUSH_RWF_DSYNC, /* each request written with RWF_DSYNC */
+  IORE_TEST_FLUSH_LENGTH
+};
+
+enum iore_test_read_reorder
+{
+  IORE_TEST_RREORDER_TASK, /* shifts task ids by the reorder offset */
+  IORE_TEST_RREORDER_NODE, /* shifts task ids across compute nodes */
+  IORE_TEST_RREORDER_LENGTH
+};
+
+enum iore_test_cache_defeat
+{
+  IORE_TEST_CDEFEAT_NONE, /* reads may hit the page cache */
+  IORE_TEST_CDEFEAT_FADVISE, /* posix_fadvise(DONTNEED) on the test file */
+  IORE_TEST_CDEFEAT_DIRECT, /* reopens the test file with O_DIRECT */
+  IORE_TEST_CDEFEAT_MEM_SWEEP, /* allocates and touches node memory */
+  IORE_TEST_CDEFEAT_DROP_CACHES, /* writes to /proc/sys/vm/drop_caches */
+  IORE_TEST_CDEFEAT_LENGTH
+};
+
+enum iore_test_file_prealloc
+{
+  IORE_TEST_FPREALLOC_NONE, /* blocks are allocated by the first writes */
+  IORE_TEST_FPREALLOC_FALLOCATE, /* fallocate() */
+  IORE_TEST_FPREALLOC_POSIX_FALLOCATE, /* posix_fallocate() */
+  IORE_TEST_FPREALLOC_LENGTH
+};
+
 enum iore_test_type
 {
   IORE_TEST_TYPE_WRITE, IORE_TEST_TYPE_READ, IORE_TEST_TYPE_LENGTH
@@ -42,16 +81,32 @@ typedef struct iore_test
   iore_test_type_flags_t type;
   bool write_flush;
   bool write_flush_per_req;
+  enum iore_test_flush_mode write_flush_mode;
+  unsigned int write_flush_window; /* requests in flight, sync_file_range */
+  enum iore_test_read_reorder read_reorder;
   unsigned int read_reorder_offset;
+  enum iore_test_cache_defeat read_cache_defeat;
+  size_t read_cache_defeat_mem_size; /* per node, for memory sweeps */
   bool intra_test_barrier;
   unsigned int inter_test_delay_secs;
 
   enum iore_test_file_mode file_mode;
+  unsigned int file_group_size; /* tasks per file in NxM, 0 for per node */
+  unsigned int files_per_task; /* files written by each task in NxN */
+  unsigned int file_dir_hash; /* number of directories files are hashed to */
   char *file_name;
   bool file_name_append_sequence_num;
   bool file_name_append_task_id;
   bool file_dir_per_task;
   bool file_keep;
+  enum iore_test_file_prealloc file_prealloc;
+  bool file_reuse; /* pre-creates files once and reuses them */
+  bool file_truncate; /* drops existing extents when pre-creating */
+  unsigned int _num_repetitions;
+  bool _file_remove;
+  int _file_group_id;
+  int _file_group_task_id;
+  MPI_Comm _file_comm;
 
   iore_wkld_t wkld;
   iore_afio_t afio;
@@ -67,5 +122,9 @@ test2str (const iore_test_t *);
 
 extern const char *test_type_lbl[];
 extern const char *test_file_mode_lbl[];
+extern const char *test_file_prealloc_lbl[];
+extern const char *test_flush_mode_lbl[];
+extern const char *test_read_reorder_lbl[];
+extern const char *test_cache_defeat_lbl[];
 
 #endif /* INCLUDE_IORE_TEST_TYPES_H_ */
@@ -19,6 +19,34 @@ trec_destroy ();
 iore_trec_exp_t
 get_trec_exp ();
 
+void
+trec_clock_set (const iore_trec_clock_t *);
+void
+trec_clock_sync ();
+iore_time_t
+trec_clock_error ();
+
+int
+trec_rsrc_start (iore_trec_rsrc_flags_t);
+void
+trec_rsrc_stop ();
+
+int
+trec_reqs_start (const iore_trec_reqs_t *);
+void
+trec_reqs_stop ();
+void
+trec_req_file (unsigned int);
+iore_time_t
+trec_req_start ();
+void
+trec_req_stop (off_t, size_t, iore_time_t);
+void
+trec_reqs_get (const iore_trec_req_t **, size_t *, const iore_trec_req_t **,
+	       size_t *);
+int
+trec_reqs_flush (unsigned int, unsigned int, unsigned int);
+
 void
 trec_exp_start (unsigned int);
 iore_trec_exp_t *
@@ -32,6 +60,8 @@ trec_run_start (unsigned int, unsigned int);
 iore_trec_run_t *
 trec_run_stop ();
 void
+trec_run_release (iore_trec_run_t *);
+void
 trec_run_rept_start (unsigned int);
 iore_trec_run_rept_t *
 trec_run_rept_stop ();
@@ -39,7 +69,15 @@ void
 trec_test_start (enum iore_test_type, enum iore_trec_action);
 void
 trec_test_stop (size_t);
+iore_time_t
+trec_flush_req_start ();
+void
+trec_flush_req_stop (iore_time_t);
 iore_trec_test_t *
 trec_test_commit ();
+void
+trec_test_reduce (iore_trec_test_t *);
+iore_time_t
+trec_test_cost (unsigned int);
 
 #endif /* INCLUDE_IORE_TREC_H_ */
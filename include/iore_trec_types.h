@@ -7,12 +7,18 @@
 #ifndef INCLUDE_IORE_TREC_TYPES_H_
 #define INCLUDE_IORE_TREC_TYPES_H_
 
+#include <sys/types.h>
+
 #include "iore_test_types.h"
 
 /*** DEFINES *****************************************************************/
 
-#define TRECEXP2STR_FORMAT "iore_trec_exp_t (%p) { time = [ %s ], num_exp_rpl = %u, exp_repl = [ %s ] }"
-#define TRECEXPREPL2STR_FORMAT "iore_trec_exp_repl_t (%p) { id = %u, time = [ %s ], num_run = %u, run = [ %s ] }"
+#define TRECEXP2STR_FORMAT "iore_trec_exp_t (%p) { time = [ %s ], clock_error = %.9f, num_exp_rpl = %u, exp_repl = [ %s ] }"
+#define TRECEXPREPL2STR_FORMAT "iore_trec_exp_repl_t (%p) { id = %u, time = [ %s ], clock_error = %.9f, num_run = %u, run = [ %s ] }"
+#define TRECCLOCK2STR_FORMAT "iore_trec_clock_t (%p) { timer = '%s', sync_rounds = %u }"
+#define TRECREQS2STR_FORMAT "iore_trec_reqs_t (%p) { ring_len = %zu, dir = '%s' }"
+
+#define IORE_TREC_CLOCK_SYNC_ROUNDS 16
 #define TRECRUN2STR_FORMAT "iore_trec_run_t (%p) { id = %u, time = [ %s ], num_run_rept = %u, run_rept = [ %s ] }"
 #define TRECRUNREPT2STR_FORMAT "iore_trec_run_rept_t (%p) { id = %u, time [ %s ], test = [ %s ] }"
 #define TRECTEST2STR_FORMAT "iore_trec_test_t (%p) { type = '%s', task_time = [ %s ], task_data_size = %zu, test_time = [ %s ], test_data_size = %zu, committed = '%s' }"
@@ -32,9 +38,89 @@ enum iore_trec_action
   IORE_TREC_ACTION_WRITE_READ,
   IORE_TREC_ACTION_CLOSE,
   IORE_TREC_ACTION_REMOVE,
+  IORE_TREC_ACTION_CACHE_DEFEAT,
+  IORE_TREC_ACTION_FLUSH,
+  IORE_TREC_ACTION_PREALLOC,
   IORE_TREC_ACTION_LENGTH
 };
 
+enum iore_trec_timer
+{
+  IORE_TREC_TIMER_MPI_WTIME, /* MPI_Wtime () */
+  IORE_TREC_TIMER_MONOTONIC_RAW, /* clock_gettime (CLOCK_MONOTONIC_RAW) */
+  IORE_TREC_TIMER_LENGTH
+};
+
+/**
+ * Clock of the records. Clocks of all tasks are synchronized to the clock
+ * of the master task by 'sync_rounds' ping-pong rounds per task.
+ */
+typedef struct iore_trec_clock
+{
+  enum iore_trec_timer timer;
+  unsigned int sync_rounds;
+} iore_trec_clock_t;
+
+/**
+ * OS resource counters of a task, as deltas over an action. CPU times are in
+ * seconds.
+ */
+enum iore_trec_rsrc
+{
+  IORE_TREC_RSRC_UTIME, /* getrusage () */
+  IORE_TREC_RSRC_STIME,
+  IORE_TREC_RSRC_MINFLT,
+  IORE_TREC_RSRC_MAJFLT,
+  IORE_TREC_RSRC_NVCSW,
+  IORE_TREC_RSRC_NIVCSW,
+  IORE_TREC_RSRC_RCHAR, /* /proc/self/io */
+  IORE_TREC_RSRC_WCHAR,
+  IORE_TREC_RSRC_READ_BYTES,
+  IORE_TREC_RSRC_WRITE_BYTES,
+  IORE_TREC_RSRC_TASK_CLOCK, /* perf_event_open () software counters */
+  IORE_TREC_RSRC_PAGE_FAULTS,
+  IORE_TREC_RSRC_CONTEXT_SWITCHES,
+  IORE_TREC_RSRC_CPU_MIGRATIONS,
+  IORE_TREC_RSRC_LENGTH
+};
+
+enum iore_trec_rsrc_group
+{
+  IORE_TREC_RSRC_GROUP_RUSAGE,
+  IORE_TREC_RSRC_GROUP_IO,
+  IORE_TREC_RSRC_GROUP_PERF,
+  IORE_TREC_RSRC_GROUP_LENGTH
+};
+
+typedef struct iore_trec_rsrc_flags
+{
+  bool rusage; /* getrusage () counters */
+  bool io; /* /proc/self/io counters */
+  bool perf; /* perf_event_open () software counters */
+} iore_trec_rsrc_flags_t;
+
+/**
+ * Capture of every request of the tests into a ring of 'ring_len' records
+ * per task, flushed into a trace file in 'dir' after each run repetition.
+ * Disabled if 'ring_len' is zero.
+ */
+typedef struct iore_trec_reqs
+{
+  size_t ring_len;
+  char *dir;
+} iore_trec_reqs_t;
+
+typedef struct iore_trec_record_req
+{
+  enum iore_test_type type;
+  enum iore_trec_action action;
+  unsigned int file_id; /* among the files of the task */
+  off_t offset;
+  size_t size;
+
+  iore_time_t time[IORE_TREC_EVENT_LENGTH];
+} iore_trec_req_t;
+
 typedef struct iore_trec_record_test
 {
   enum iore_test_type type;
@@ -46,6 +132,14 @@ typedef struct iore_trec_record_test
   size_t test_data_size;
 
   bool committed; /* denotes all actions and events were recorded */
+  bool remote; /* test level only, received from a run of other tasks */
+
+  double bw_ci; /* relative half-width of the run bandwidth CI, so far */
+  double bw_ci_level; /* confidence level of 'bw_ci' */
+  double interference; /* bandwidth lost to co-scheduled runs, or NAN */
+
+  double task_rsrc[IORE_TREC_ACTION_LENGTH][IORE_TREC_RSRC_LENGTH];
+  double test_rsrc[IORE_TREC_ACTION_LENGTH][IORE_TREC_RSRC_LENGTH]; /* sums */
 } iore_trec_test_t;
 
 typedef struct iore_trec_record_run_rept
@@ -72,6 +166,7 @@ typedef struct iore_trec_record_exp_repl
   unsigned int id;
 
   iore_time_t time[IORE_TREC_EVENT_LENGTH];
+  iore_time_t clock_error; /* bound of clock offsets across tasks */
 
   unsigned int num_run;
   iore_trec_run_t *run;
@@ -80,9 +175,12 @@ typedef struct iore_trec_record_exp_repl
 typedef struct iore_trec_record_exp
 {
   iore_time_t time[IORE_TREC_EVENT_LENGTH];
+  iore_time_t clock_error; /* bound of clock offsets across tasks */
 
   unsigned int num_exp_repl;
   iore_trec_exp_repl_t *exp_repl;
+
+  iore_trec_rsrc_flags_t rsrc; /* resource counters recorded */
 } iore_trec_exp_t;
 
 typedef struct iore_trec_state
@@ -92,6 +190,7 @@ typedef struct iore_trec_state
   iore_trec_run_rept_t *trec_rept;
   iore_trec_test_t *trec_test;
   enum iore_trec_action test_action;
+  iore_time_t flush_time; /* of per-request flushes of the write action */
 } iore_trec_st_t;
 
 /*** PROTOTYPES **************************************************************/
@@ -106,10 +205,19 @@ char *
 trecrunrept2str (const iore_trec_run_rept_t *);
 char *
 trectest2str (const iore_trec_test_t *);
+char *
+trecclock2str (const iore_trec_clock_t *);
+char *
+trecreqs2str (const iore_trec_reqs_t *);
+bool
+trec_rsrc_enabled (iore_trec_rsrc_flags_t, enum iore_trec_rsrc);
 
 /*** VARIABLES ***************************************************************/
 
 extern const char * const trec_event_lbl[];
 extern const char * const trec_action_lbl[];
+extern const char * const trec_timer_lbl[];
+extern const char * const trec_rsrc_lbl[];
+extern const char * const trec_rsrc_group_lbl[];
 
 #endif /* INCLUDE_IORE_TREC_TYPES_H_ */
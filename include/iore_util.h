@@ -9,6 +9,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdarg.h>
 
 /*** DEFINES *****************************************************************/
 
@@ -25,6 +26,8 @@
 
 bool
 strtob (const char *);
+size_t
+strtosz (const char *);
 char *
 itoa (int);
 char *
@@ -48,6 +51,8 @@ arrlld2str (long long int *, int);
 char *
 strfmt (const char *fmt, ...);
 char *
+vstrfmt (const char *fmt, va_list ap);
+char *
 coallesce_str (const char **a, int len, char *sep);
 char *
 coallesce_uint (const unsigned int *a, int len, char *sep);
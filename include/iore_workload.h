@@ -24,6 +24,14 @@ void
 wkld_dset_free (iore_wkld_dset_t *);
 void
 wkld_dset_cart_free (iore_wkld_dset_cart_t *);
+void
+wkld_trace_free (iore_wkld_trace_t *);
+int
+wkld_trace_map (iore_wkld_trace_t *, int, enum iore_test_type, unsigned int);
+void
+wkld_trace_unmap (iore_wkld_trace_t *);
+bool
+wkld_trace_aligned (const iore_wkld_trace_t *, enum iore_test_type, size_t);
 
 off_t *
 dset_to_off (const iore_wkld_dset_t *, enum iore_test_file_mode);
@@ -8,12 +8,14 @@
 #define INCLUDE_IORE_WORKLOAD_TYPES_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "iore_prng_types.h"
 
 /*** DEFINES *****************************************************************/
 
 #define WKLD2STR_FORMAT "workload (%p) { num_tasks = %u, type = %s }"
+#define WKLD_TRACE_MAGIC "IORETRC1"
 
 /*** TYPES *******************************************************************/
 
@@ -21,6 +23,7 @@ enum iore_wkld_type
 {
   IORE_WKLD_OFFSET, /* offset-based workload */
   IORE_WKLD_DATASET, /* dataset-based workload */
+  IORE_WKLD_TRACE, /* replay of recorded requests */
   IORE_WKLD_LENGTH
 };
 
@@ -48,6 +51,64 @@ enum iore_wkld_dset_var_type
   IORE_WKLD_DSET_DV_LENGTH
 };
 
+enum iore_wkld_trace_timing
+{
+  IORE_WKLD_TRACE_TM_NONE, /* requests issued as fast as possible */
+  IORE_WKLD_TRACE_TM_RECORDED, /* requests issued at their recorded times */
+  IORE_WKLD_TRACE_TM_LENGTH
+};
+
+/* meaning of the 'time' field of the records of a trace file */
+enum iore_wkld_trace_time_mode
+{
+  IORE_WKLD_TRACE_TIME_NONE, /* no timing recorded */
+  IORE_WKLD_TRACE_TIME_STAMP, /* ns since a base time common to the ranks */
+  IORE_WKLD_TRACE_TIME_THINK, /* ns of computation before the request */
+  IORE_WKLD_TRACE_TIME_LENGTH
+};
+
+/**
+ * Trace files are laid out, in host byte order, as a header, followed by
+ * 'num_ranks + 1' uint64_t indexes of records and by the records; rank 'r'
+ * replays records [index[r], index[r + 1]) in order.
+ */
+typedef struct iore_wkld_trace_hdr
+{
+  char magic[8]; /* WKLD_TRACE_MAGIC, not terminated */
+  uint32_t num_ranks;
+  uint32_t time_mode; /* enum iore_wkld_trace_time_mode */
+} iore_wkld_trace_hdr_t;
+
+typedef struct iore_wkld_trace_rec
+{
+  uint64_t offset;
+  uint64_t size;
+  uint64_t time; /* see enum iore_wkld_trace_time_mode */
+  uint64_t duration; /* ns, of captured requests, or 0 */
+  uint32_t file_id; /* among the files of the task */
+  uint32_t op; /* enum iore_test_type */
+} iore_wkld_trace_rec_t;
+
+typedef struct iore_wkld_trace
+{
+  char *file_name;
+  enum iore_wkld_trace_timing timing;
+
+  const iore_wkld_trace_rec_t *my_recs; /* mapped from the trace file */
+  size_t _my_recs_len;
+  enum iore_wkld_trace_time_mode _time_mode;
+
+  /* of the records of the test type being replayed */
+  size_t my_data_size;
+  size_t my_req_size; /* largest request */
+  size_t _num_reqs;
+  size_t _file_size; /* largest extent, over all files */
+  uint64_t _first_time; /* earliest time stamp, over all ranks */
+
+  void *_map;
+  size_t _map_size;
+} iore_wkld_trace_t;
+
 typedef struct iore_wkld_dset_cart
 {
   unsigned int num_dims;
@@ -96,6 +157,7 @@ typedef struct iore_wkld
   {
     iore_wkld_oset_t oset;
     iore_wkld_dset_t dset;
+    iore_wkld_trace_t trace;
   } u;
 } iore_wkld_t;
 
@@ -111,6 +173,8 @@ char *
 wklddsetvartypes2str (const enum iore_wkld_dset_var_type *, int);
 char *
 wklddsetcart2str (const iore_wkld_dset_cart_t *);
+char *
+wkldtrace2str (const iore_wkld_trace_t *);
 
 /*** VARIABLES ***************************************************************/
 
@@ -118,5 +182,7 @@ extern const char * const wkld_type_lbl[];
 extern const char * const wkld_oset_access_pattern_lbl[];
 extern const char * const wkld_dset_type_lbl[];
 extern const char * const wkld_dset_var_type_lbl[];
+extern const char * const wkld_trace_timing_lbl[];
+extern const char * const wkld_trace_time_mode_lbl[];
 
 #endif /* INCLUDE_IORE_WORKLOAD_TYPES_H_ */
@@ -5,20 +5,31 @@
  */
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "iore_afio.h"
 #include "iore_error.h"
+#include "iore_prng.h"
+#include "iore_util.h"
 #include "iore_valid.h"
 
+/*** PROTOTYPES **************************************************************/
+
+static int
+afio_emulator_valid (iore_afio_t *);
+
 /*** VARIABLES ***************************************************************/
 
 extern const iore_afio_vtable_t afio_posix;
 extern const iore_afio_vtable_t afio_cstream;
+extern const iore_afio_vtable_t afio_emulator;
+extern const iore_afio_vtable_t afio_null;
 #ifdef WITH_MPIIO_AFIO
 extern const iore_afio_vtable_t afio_mpiio;
 #endif
 const iore_afio_vtable_t *afio_pool[IORE_AFIO_LENGTH] =
-  { &afio_posix, &afio_cstream
+  { &afio_posix, &afio_cstream, &afio_emulator, &afio_null
 #ifdef WITH_MPIIO_AFIO
     , &afio_mpiio
 #endif
@@ -33,6 +44,7 @@ afio_init (iore_afio_t *this)
 
   this->type = IORE_AFIO_POSIX;
   dict_init (&this->params);
+  this->latency_distrib = NULL;
 
   return this;
 } /* afio_init () */
@@ -41,7 +53,15 @@ void
 afio_free (iore_afio_t *this)
 {
   if (this)
-    dict_free (&this->params);
+    {
+      dict_free (&this->params);
+      if (this->latency_distrib)
+	{
+	  prng_dist_free (this->latency_distrib);
+	  free (this->latency_distrib);
+	  this->latency_distrib = NULL;
+	}
+    }
 } /* afio_free () */
 
 int
@@ -56,6 +76,54 @@ afio_valid (iore_afio_t *this)
       iore_errorf(VALID_MSG_INVALID_OPTION, "AFIO implementation");
       rerr = IORE_FAILURE;
     }
+  else if (this->type == IORE_AFIO_EMULATOR)
+    rerr = afio_emulator_valid (this);
+  else if (this->latency_distrib)
+    iore_warn("Request latency distributions are only used by the "
+	      "emulator AFIO.");
 
   return rerr;
 } /* afio_valid () */
+
+static int
+afio_emulator_valid (iore_afio_t *this)
+{
+  int rerr = IORE_SUCCESS;
+
+  const char *target = dict_get (&this->params, AFIO_PARAM_TARGET);
+  if (target && strcasecmp (target, AFIO_TARGET_FILE)
+      && strcasecmp (target, AFIO_TARGET_MEMORY))
+    {
+      iore_errorf(VALID_MSG_INVALID_OPTION, AFIO_PARAM_TARGET);
+      rerr = IORE_FAILURE;
+    }
+
+  const char *bandwidth = dict_get (&this->params, AFIO_PARAM_BANDWIDTH);
+  if (bandwidth && strtosz (bandwidth) == 0)
+    {
+      iore_errorf(VALID_MSG_GREATER_ZERO, AFIO_PARAM_BANDWIDTH);
+      rerr = IORE_FAILURE;
+    }
+
+  const char *burst = dict_get (&this->params, AFIO_PARAM_BURST);
+  if (burst && !bandwidth)
+    iore_warnf("'%s' is only used along with '%s'.", AFIO_PARAM_BURST,
+	       AFIO_PARAM_BANDWIDTH);
+
+  const char *slots = dict_get (&this->params, AFIO_PARAM_SERVICE_SLOTS);
+  if (slots && atoi (slots) <= 0)
+    {
+      iore_errorf(VALID_MSG_GREATER_ZERO, AFIO_PARAM_SERVICE_SLOTS);
+      rerr = IORE_FAILURE;
+    }
+  else if (slots
+      && !strtob (dict_get (&this->params, AFIO_PARAM_SHARED)))
+    iore_warnf("'%s' only limits concurrency across the tasks of a node, "
+	       "which requires '%s'.", AFIO_PARAM_SERVICE_SLOTS,
+	       AFIO_PARAM_SHARED);
+
+  if (this->latency_distrib)
+    rerr |= prng_dist_valid (this->latency_distrib);
+
+  return rerr;
+} /* afio_emulator_valid () */
@@ -13,6 +13,8 @@
 #include "iore_afio.h"
 #include "iore_error.h"
 #include "iore_ctx.h"
+#include "iore_lmet.h"
+#include "iore_trec.h"
 #include "iore_util.h"
 #include "iore_workload.h"
 
@@ -32,6 +34,8 @@ cstream_write_dset (iore_file_t, const void *, const iore_test_t *);
 ssize_t
 cstream_read_dset (iore_file_t, void *, const iore_test_t *);
 int
+cstream_flush (iore_file_t, const iore_test_t *);
+int
 cstream_close (iore_file_t *);
 int
 cstream_remove (iore_file_t);
@@ -40,7 +44,8 @@ cstream_remove (iore_file_t);
 
 const iore_afio_vtable_t afio_cstream =
   { cstream_create, cstream_open, cstream_write_oset, cstream_read_oset,
-      cstream_write_dset, cstream_read_dset, cstream_close, cstream_remove };
+      cstream_write_dset, cstream_read_dset, cstream_flush, cstream_close,
+      cstream_remove, NULL, NULL };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -51,16 +56,26 @@ cstream_create (iore_file_t *file, const iore_test_t *test)
 
   FILE *fptr;
   char *mode;
+  /* pre-created files keep their extents */
+  char *create_mode =
+      (test->file_prealloc != IORE_TEST_FPREALLOC_NONE || test->file_reuse) ?
+	  "r+" : "w+";
 
-  if (test->file_mode == IORE_TEST_FMODE_NX1)
+  if (test->file_mode == IORE_TEST_FMODE_NX1
+      || test->file_mode == IORE_TEST_FMODE_NXM)
     {
-      if (ctx.task_id == IORE_MASTER_TASK)
+      /* the first task sharing the file creates it */
+      bool creator =
+	  (test->file_mode == IORE_TEST_FMODE_NX1) ?
+	      (ctx.task_id == IORE_MASTER_TASK) :
+	      (test->_file_group_task_id == 0);
+      if (creator)
 	{
-	  mode = "w+";
+	  mode = create_mode;
 	  fptr = fopen (file->name, mode);
 	}
       MPI_Barrier (ctx.comm);
-      if (ctx.task_id != IORE_MASTER_TASK)
+      if (!creator)
 	{
 	  mode = "r+";
 	  fptr = fopen (file->name, mode);
@@ -68,7 +83,7 @@ cstream_create (iore_file_t *file, const iore_test_t *test)
     }
   else /* IORE_FM_NxN */
     {
-      mode = "w+";
+      mode = create_mode;
       fptr = fopen (file->name, mode);
     }
 
@@ -114,9 +129,11 @@ cstream_write_oset (iore_file_t file, const void *buf, const off_t *offs,
   size_t req_size;
   size_t nmemb;
   size_t xferd;
+  iore_time_t start;
 
   while (remaining && nbytes >= 0)
     {
+      start = trec_req_start ();
       if (fseek (fp, *offs, SEEK_SET) < 0)
 	nbytes = -1;
       else
@@ -127,12 +144,14 @@ cstream_write_oset (iore_file_t file, const void *buf, const off_t *offs,
 	  if (req_size > remaining)
 	    req_size = remaining;
 	  nmemb = fwrite (buf, sizeof(char), req_size, fp);
+	  trec_req_stop (*offs, req_size, start);
 	  xferd = nmemb * sizeof(char);
 	  if (xferd < req_size)
 	    nbytes = -1;
 	  else
 	    {
 	      nbytes += xferd;
+	      lmet_xfer (xferd);
 	      if (test->write_flush_per_req)
 		fflush (fp);
 	    }
@@ -141,9 +160,6 @@ cstream_write_oset (iore_file_t file, const void *buf, const off_t *offs,
       offs++;
     }
 
-  if (nbytes > 0 && test->write_flush)
-    fflush (fp);
-
   return nbytes;
 } /* cstream_write_oset () */
 
@@ -160,9 +176,11 @@ cstream_read_oset (iore_file_t file, void *buf, const off_t *offs,
   size_t req_size;
   size_t nmemb;
   size_t xferd;
+  iore_time_t start;
 
   while (remaining && nbytes >= 0)
     {
+      start = trec_req_start ();
       if (fseek (fp, *offs, SEEK_SET) < 0)
 	nbytes = -1;
       else
@@ -173,11 +191,15 @@ cstream_read_oset (iore_file_t file, void *buf, const off_t *offs,
 	  if (req_size > remaining)
 	    req_size = remaining;
 	  nmemb = fread (buf, sizeof(char), req_size, fp);
+	  trec_req_stop (*offs, req_size, start);
 	  xferd = nmemb * sizeof(char);
 	  if (xferd < req_size)
 	    nbytes = -1;
 	  else
-	    nbytes += xferd;
+	    {
+	      nbytes += xferd;
+	      lmet_xfer (xferd);
+	    }
 	}
       remaining -= req_size;
       offs++;
@@ -199,6 +221,7 @@ cstream_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
   size_t req_size;
   size_t nmemb;
   size_t xferd;
+  iore_time_t start;
 
   if (test->wkld.u.dset.type == IORE_WKLD_DSET_CARTESIAN)
     {
@@ -220,17 +243,20 @@ cstream_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
 
   while (nbytes < (ssize_t) dset_size && nbytes >= 0)
     {
+      start = trec_req_start ();
       if (fseek (fp, *offs, SEEK_SET) < 0)
 	nbytes = -1;
       else
 	{
 	  nmemb = fwrite (buf + nbytes, sizeof(char), req_size, fp);
+	  trec_req_stop (*offs, req_size, start);
 	  xferd = nmemb * sizeof(char);
 	  if (xferd < req_size)
 	    nbytes = -1;
 	  else
 	    {
 	      nbytes += xferd;
+	      lmet_xfer (xferd);
 	      if (test->write_flush_per_req)
 		fflush (fp);
 	    }
@@ -238,9 +264,6 @@ cstream_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
       offs++;
     }
 
-  if (nbytes > 0 && test->write_flush)
-    fflush (fp);
-
   free (first_off);
 
   return nbytes;
@@ -259,6 +282,7 @@ cstream_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
   size_t req_size;
   size_t nmemb;
   size_t xferd;
+  iore_time_t start;
 
   if (test->wkld.u.dset.type == IORE_WKLD_DSET_CARTESIAN)
     {
@@ -280,16 +304,21 @@ cstream_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
 
   while (nbytes < (ssize_t) dset_size && nbytes >= 0)
     {
+      start = trec_req_start ();
       if (fseek (fp, *offs, SEEK_SET) < 0)
 	nbytes = -1;
       else
 	{
 	  nmemb = fread (buf + nbytes, sizeof(char), req_size, fp);
+	  trec_req_stop (*offs, req_size, start);
 	  xferd = nmemb * sizeof(char);
 	  if (xferd < req_size)
 	    nbytes = -1;
 	  else
-	    nbytes += xferd;
+	    {
+	      nbytes += xferd;
+	      lmet_xfer (xferd);
+	    }
 	}
       offs++;
     }
@@ -299,6 +328,13 @@ cstream_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
   return nbytes;
 } /* cstream_read_dset () */
 
+int
+cstream_flush (iore_file_t file, const iore_test_t *test)
+{
+  assert(test);
+  return fflush (file.hdle.fptr);
+} /* cstream_flush () */
+
 int
 cstream_close (iore_file_t *file)
 {
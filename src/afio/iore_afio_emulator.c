@@ -0,0 +1,556 @@
+/*
+ * iore_afio_emulator.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 600
+#endif
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* strcasecmp */
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <mpi.h>
+
+#include "iore_afio.h"
+#include "iore_error.h"
+#include "iore_util.h"
+#include "iore_workload.h"
+#include "iore_prng.h"
+#include "iore_ctx.h"
+#include "iore_lmet.h"
+#include "iore_trec.h"
+
+/*** DEFINES *****************************************************************/
+
+#define EMU_NSECS_PER_SEC 1000000000ull
+#define EMU_NSECS_PER_USEC 1000ull
+
+/*** TYPES *******************************************************************/
+
+/**
+ * Device state, shared by the tasks of a node when the device is shared.
+ */
+typedef struct emu_state
+{
+  uint64_t tat; /* theoretical arrival time of the token bucket, in ns */
+  unsigned int busy; /* requests being served */
+} emu_state_t;
+
+/**
+ * Device model. Set up before the files of a test and torn down after them
+ * (see emulator_prep ()), so that all files of a test contend for the same
+ * device.
+ */
+typedef struct emu_dev
+{
+  bool memory; /* memory target */
+  double nsecs_per_byte; /* 0 for unlimited bandwidth */
+  uint64_t burst_nsecs;
+  unsigned int slots; /* 0 for unbounded concurrency */
+  iore_prng_t *latency;
+  emu_state_t local;
+  emu_state_t *state; /* points to local or node-shared state */
+  MPI_Win win;
+  char *scratch; /* contents of memory targets */
+  size_t scratch_size;
+} emu_dev_t;
+
+/*** PROTOTYPES **************************************************************/
+
+int
+emulator_create (iore_file_t *, const iore_test_t *);
+int
+emulator_open (iore_file_t *, const iore_test_t *);
+ssize_t
+emulator_write_oset (iore_file_t, const void *, const off_t *,
+		     const iore_test_t *);
+ssize_t
+emulator_read_oset (iore_file_t, void *, const off_t *, const iore_test_t *);
+ssize_t
+emulator_write_dset (iore_file_t, const void *, const iore_test_t *);
+ssize_t
+emulator_read_dset (iore_file_t, void *, const iore_test_t *);
+int
+emulator_flush (iore_file_t, const iore_test_t *);
+int
+emulator_close (iore_file_t *);
+int
+emulator_remove (iore_file_t);
+int
+emulator_prep (const iore_test_t *);
+void
+emulator_post (void);
+
+static ssize_t
+emu_xfer (int, void *, size_t, off_t, bool);
+static void
+emu_serve (emu_dev_t *, size_t);
+static uint64_t
+emu_now (void);
+
+/*** VARIABLES ***************************************************************/
+
+const iore_afio_vtable_t afio_emulator =
+  { emulator_create, emulator_open, emulator_write_oset, emulator_read_oset,
+      emulator_write_dset, emulator_read_dset, emulator_flush, emulator_close,
+      emulator_remove, emulator_prep, emulator_post };
+
+static emu_dev_t *emu_dev = NULL;
+
+/*** FUNCTIONS ***************************************************************/
+
+int
+emulator_create (iore_file_t *file, const iore_test_t *test)
+{
+  assert(file);
+  assert(test);
+
+  assert(emu_dev);
+
+  file->hdle.fint = -1;
+  if (!emu_dev->memory)
+    {
+      mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+      file->hdle.fint = open (file->name, O_CREAT | O_WRONLY, mode);
+      if (file->hdle.fint < 0)
+	return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* emulator_create () */
+
+int
+emulator_open (iore_file_t *file, const iore_test_t *test)
+{
+  assert(file);
+  assert(test);
+
+  assert(emu_dev);
+
+  file->hdle.fint = -1;
+  if (!emu_dev->memory)
+    {
+      file->hdle.fint = open (file->name, O_RDONLY);
+      if (file->hdle.fint < 0)
+	return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* emulator_open () */
+
+ssize_t
+emulator_write_oset (iore_file_t file, const void *buf, const off_t *offs,
+		     const iore_test_t *test)
+{
+  assert(buf);
+  assert(offs);
+  assert(test);
+
+  ssize_t nbytes = 0;
+
+  size_t file_size = test->wkld.u.oset._file_size;
+  size_t remaining = test->wkld.u.oset.my_data_size;
+  size_t max_req_size = test->wkld.u.oset.my_req_size;
+  size_t req_size;
+  ssize_t xferd;
+
+  while (remaining && nbytes >= 0)
+    {
+      req_size = (file_size - *offs);
+      if (req_size > max_req_size)
+	req_size = max_req_size;
+      if (req_size > remaining)
+	req_size = remaining;
+      xferd = emu_xfer (file.hdle.fint, (void *) buf, req_size, *offs, true);
+      if (xferd < (ssize_t) req_size)
+	nbytes = -1;
+      else
+	{
+	  nbytes += xferd;
+	  lmet_xfer (xferd);
+	}
+
+      remaining -= req_size;
+      offs++;
+    }
+
+  return nbytes;
+} /* emulator_write_oset () */
+
+ssize_t
+emulator_read_oset (iore_file_t file, void *buf, const off_t *offs,
+		    const iore_test_t *test)
+{
+  assert(buf);
+  assert(offs);
+  assert(test);
+
+  ssize_t nbytes = 0;
+
+  size_t file_size = test->wkld.u.oset._file_size;
+  size_t remaining = test->wkld.u.oset.my_data_size;
+  size_t max_req_size = test->wkld.u.oset.my_req_size;
+  size_t req_size;
+  ssize_t xferd;
+
+  while (remaining && nbytes >= 0)
+    {
+      req_size = (file_size - *offs);
+      if (req_size > max_req_size)
+	req_size = max_req_size;
+      if (req_size > remaining)
+	req_size = remaining;
+      xferd = emu_xfer (file.hdle.fint, buf, req_size, *offs, false);
+      if (xferd < (ssize_t) req_size)
+	nbytes = -1;
+      else
+	{
+	  nbytes += xferd;
+	  lmet_xfer (xferd);
+	}
+
+      remaining -= req_size;
+      offs++;
+    }
+
+  return nbytes;
+} /* emulator_read_oset () */
+
+ssize_t
+emulator_write_dset (iore_file_t file, const void *buf,
+		     const iore_test_t *test)
+{
+  assert(buf);
+  assert(test);
+
+  ssize_t nbytes = 0;
+
+  size_t dset_size = test->wkld.u.dset.my_size;
+  size_t req_size;
+  ssize_t xferd;
+
+  if (test->wkld.u.dset.type == IORE_WKLD_DSET_CARTESIAN)
+    {
+      req_size =
+	  (test->wkld.u.dset._vars_size
+	      * test->wkld.u.dset.u.cart.my_dim_sizes[test->wkld.u.dset.u.cart.num_dims
+		  - 1]);
+    }
+  else /* unsupported dataset type */
+    {
+      return -1;
+    }
+
+  off_t *offs = dset_to_off (&test->wkld.u.dset, test->file_mode);
+  if (!offs)
+    return -1;
+  /* pointer kept for freeing it later */
+  off_t *first_off = offs;
+
+  while (nbytes < (ssize_t) dset_size && nbytes >= 0)
+    {
+      xferd = emu_xfer (file.hdle.fint, (void *) (buf + nbytes), req_size,
+			*offs, true);
+      if (xferd < (ssize_t) req_size)
+	nbytes = -1;
+      else
+	{
+	  nbytes += xferd;
+	  lmet_xfer (xferd);
+	}
+
+      offs++;
+    }
+
+  free (first_off);
+
+  return nbytes;
+} /* emulator_write_dset () */
+
+ssize_t
+emulator_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
+{
+  assert(buf);
+  assert(test);
+
+  ssize_t nbytes = 0;
+
+  size_t dset_size = test->wkld.u.dset.my_size;
+  size_t req_size;
+  ssize_t xferd;
+
+  if (test->wkld.u.dset.type == IORE_WKLD_DSET_CARTESIAN)
+    {
+      req_size =
+	  (test->wkld.u.dset._vars_size
+	      * test->wkld.u.dset.u.cart.my_dim_sizes[test->wkld.u.dset.u.cart.num_dims
+		  - 1]);
+    }
+  else /* unsupported dataset type */
+    {
+      return -1;
+    }
+
+  off_t *offs = dset_to_off (&test->wkld.u.dset, test->file_mode);
+  if (!offs)
+    return -1;
+  /* pointer kept for freeing it later */
+  off_t *first_off = offs;
+
+  while (nbytes < (ssize_t) dset_size && nbytes >= 0)
+    {
+      xferd = emu_xfer (file.hdle.fint, buf + nbytes, req_size, *offs,
+			false);
+      if (xferd < (ssize_t) req_size)
+	nbytes = -1;
+      else
+	{
+	  nbytes += xferd;
+	  lmet_xfer (xferd);
+	}
+
+      offs++;
+    }
+
+  free (first_off);
+
+  return nbytes;
+} /* emulator_read_dset () */
+
+int
+emulator_flush (iore_file_t file, const iore_test_t *test)
+{
+  assert(test);
+
+  if (file.hdle.fint < 0)
+    return IORE_SUCCESS;
+
+  return fdatasync (file.hdle.fint);
+} /* emulator_flush () */
+
+int
+emulator_close (iore_file_t *file)
+{
+  assert(file);
+
+  int rerr = IORE_SUCCESS;
+
+  if (file->hdle.fint >= 0)
+    rerr = close (file->hdle.fint);
+
+  return rerr;
+} /* emulator_close () */
+
+int
+emulator_remove (iore_file_t file)
+{
+  if (emu_dev && emu_dev->memory)
+    return IORE_SUCCESS;
+
+  /* files may not exist, e.g. after a failed creation */
+  if (access (file.name, F_OK) && errno == ENOENT)
+    return IORE_SUCCESS;
+
+  return unlink (file.name);
+} /* emulator_remove () */
+
+/**
+ * Sets the device of the running task up. The setup is collective over
+ * ctx.comm when the device is shared, and thus done once per test rather
+ * than by the first file created or opened.
+ */
+int
+emulator_prep (const iore_test_t *test)
+{
+  assert(test);
+  assert(!emu_dev);
+
+  const dict_t *params = &test->afio.params;
+  emu_dev_t *dev = calloc (1, sizeof(emu_dev_t));
+  assert(dev);
+
+  const char *target = dict_get (params, AFIO_PARAM_TARGET);
+  dev->memory = (target && strcasecmp (target, AFIO_TARGET_MEMORY) == 0);
+
+  size_t bandwidth = strtosz (dict_get (params, AFIO_PARAM_BANDWIDTH));
+  if (bandwidth > 0)
+    {
+      dev->nsecs_per_byte = (double) EMU_NSECS_PER_SEC / bandwidth;
+      dev->burst_nsecs = strtosz (dict_get (params, AFIO_PARAM_BURST))
+	  * dev->nsecs_per_byte;
+    }
+
+  const char *slots = dict_get (params, AFIO_PARAM_SERVICE_SLOTS);
+  dev->slots = slots ? atoi (slots) : 0;
+
+  /* fixed seeds make latencies reproducible across runs */
+  if (test->afio.latency_distrib)
+    {
+      const char *seed = dict_get (params, AFIO_PARAM_SEED);
+      dev->latency = prng_new_seed (
+	  test->afio.latency_distrib,
+	  seed ? (unsigned int) atoi (seed) + ctx.task_id : prng_gen_seed ());
+    }
+
+  dev->state = &dev->local;
+  dev->win = MPI_WIN_NULL;
+  if (strtob (dict_get (params, AFIO_PARAM_SHARED)))
+    {
+      int node_task_id;
+      ctx_node_map ();
+      MPI_Comm_rank (ctx.node_comm, &node_task_id);
+
+      /* the first task of the node holds the state */
+      emu_state_t *state;
+      MPI_Aint size = (node_task_id == 0) ? sizeof(emu_state_t) : 0;
+      MPI_Win_allocate_shared (size, 1, MPI_INFO_NULL, ctx.node_comm, &state,
+			       &dev->win);
+      int disp_unit;
+      MPI_Win_shared_query (dev->win, 0, &size, &disp_unit, &dev->state);
+      if (node_task_id == 0)
+	memset (dev->state, 0, sizeof(emu_state_t));
+      MPI_Barrier (ctx.node_comm);
+    }
+
+  emu_dev = dev;
+
+  return IORE_SUCCESS;
+} /* emulator_prep () */
+
+/**
+ * Tears the device of the running task down, collectively when shared.
+ */
+void
+emulator_post (void)
+{
+  emu_dev_t *dev = emu_dev;
+  if (!dev)
+    return;
+
+  if (dev->win != MPI_WIN_NULL)
+    MPI_Win_free (&dev->win);
+  free (dev->latency);
+  free (dev->scratch);
+  free (dev);
+  emu_dev = NULL;
+} /* emulator_post () */
+
+/**
+ * Serves a request through the device model and then transfers it from/to
+ * the local file, or from/to memory if 'fd' is negative.
+ */
+static ssize_t
+emu_xfer (int fd, void *buf, size_t count, off_t off, bool is_write)
+{
+  emu_dev_t *dev = emu_dev;
+  assert(dev);
+
+  iore_time_t start = trec_req_start ();
+  unsigned int busy;
+  if (dev->slots)
+    for (;;)
+      {
+	busy = __atomic_load_n (&dev->state->busy, __ATOMIC_ACQUIRE);
+	if (busy < dev->slots
+	    && __atomic_compare_exchange_n (&dev->state->busy, &busy,
+					    busy + 1, false, __ATOMIC_ACQ_REL,
+					    __ATOMIC_ACQUIRE))
+	  break;
+	sched_yield ();
+      }
+
+  emu_serve (dev, count);
+
+  ssize_t xferd;
+  if (fd >= 0)
+    xferd = is_write ? pwrite (fd, buf, count, off) : pread (fd, buf, count,
+							     off);
+  else
+    {
+      /* memory targets keep a single request worth of contents */
+      if (dev->scratch_size < count)
+	{
+	  dev->scratch = realloc (dev->scratch, count);
+	  assert(dev->scratch);
+	  memset (dev->scratch + dev->scratch_size, 0,
+		  count - dev->scratch_size);
+	  dev->scratch_size = count;
+	}
+      if (is_write)
+	memcpy (dev->scratch, buf, count);
+      else
+	memcpy (buf, dev->scratch, count);
+      xferd = count;
+    }
+
+  if (dev->slots)
+    __atomic_fetch_sub (&dev->state->busy, 1, __ATOMIC_RELEASE);
+  trec_req_stop (off, count, start);
+
+  return xferd;
+} /* emu_xfer () */
+
+/**
+ * Delays a request of 'count' bytes by a sampled latency and, under a
+ * bandwidth cap, until the token bucket (a GCRA, with 'burst' bytes of
+ * tolerance) admits it. Tokens are reserved atomically, so tasks sharing
+ * the device contend for its bandwidth.
+ */
+static void
+emu_serve (emu_dev_t *dev, size_t count)
+{
+  uint64_t now = emu_now ();
+  uint64_t done = now;
+
+  if (dev->latency)
+    {
+      double latency = prng_next_double (dev->latency);
+      if (latency > 0)
+	done += latency * EMU_NSECS_PER_USEC;
+    }
+
+  if (dev->nsecs_per_byte > 0)
+    {
+      uint64_t cost = count * dev->nsecs_per_byte;
+      uint64_t tat = __atomic_load_n (&dev->state->tat, __ATOMIC_ACQUIRE);
+      uint64_t new_tat;
+      do
+	new_tat = ((tat > now) ? tat : now) + cost;
+      while (!__atomic_compare_exchange_n (&dev->state->tat, &tat, new_tat,
+					   false, __ATOMIC_ACQ_REL,
+					   __ATOMIC_ACQUIRE));
+      if (new_tat > dev->burst_nsecs && new_tat - dev->burst_nsecs > done)
+	done = new_tat - dev->burst_nsecs;
+    }
+
+  if (done > now)
+    {
+      struct timespec ts =
+	{ done / EMU_NSECS_PER_SEC, done % EMU_NSECS_PER_SEC };
+      while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)
+	  == EINTR)
+	;
+    }
+} /* emu_serve () */
+
+static uint64_t
+emu_now (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec * EMU_NSECS_PER_SEC + ts.tv_nsec;
+} /* emu_now () */
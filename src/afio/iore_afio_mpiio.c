@@ -14,6 +14,8 @@
 #include "iore_util.h"
 #include "iore_workload.h"
 #include "iore_ctx.h"
+#include "iore_lmet.h"
+#include "iore_trec.h"
 
 /*** DEFINES *****************************************************************/
 
@@ -34,6 +36,8 @@ mpiio_write_dset (iore_file_t, const void *, const iore_test_t *);
 ssize_t
 mpiio_read_dset (iore_file_t, void *, const iore_test_t *);
 int
+mpiio_flush (iore_file_t, const iore_test_t *);
+int
 mpiio_close (iore_file_t *);
 int
 mpiio_remove (iore_file_t);
@@ -42,12 +46,15 @@ static int
 mpiio_set_file_view (MPI_File *, const iore_test_t *);
 static int
 mpiio_create_datatype (const iore_wkld_dset_t *, MPI_Datatype *);
+static void
+mpiio_sync_req (MPI_File *);
 
 /*** VARIABLES ***************************************************************/
 
 const iore_afio_vtable_t afio_mpiio =
   { mpiio_create, mpiio_open, mpiio_write_oset, mpiio_read_oset,
-      mpiio_write_dset, mpiio_read_dset, mpiio_close, mpiio_remove };
+      mpiio_write_dset, mpiio_read_dset, mpiio_flush, mpiio_close,
+      mpiio_remove, NULL, NULL };
 
 static const MPI_Datatype mpi_types[IORE_WKLD_DSET_DV_LENGTH] =
   { MPI_CHAR, MPI_INTEGER, MPI_LONG, MPI_LONG_LONG, MPI_FLOAT, MPI_DOUBLE };
@@ -62,8 +69,11 @@ mpiio_create (iore_file_t *file, const iore_test_t *test)
   MPI_File *fh = malloc (sizeof(MPI_File));
   assert(fh);
   int mode = MPI_MODE_CREATE | MPI_MODE_WRONLY;
-  MPI_Comm comm =
-      (test->file_mode == IORE_TEST_FMODE_NX1) ? ctx.comm : MPI_COMM_SELF;
+  MPI_Comm comm = MPI_COMM_SELF;
+  if (test->file_mode == IORE_TEST_FMODE_NX1)
+    comm = ctx.comm;
+  else if (test->file_mode == IORE_TEST_FMODE_NXM)
+    comm = test->_file_comm;
 
   rerr = MPI_File_open (comm, file->name, mode, MPI_INFO_NULL, fh);
   if (rerr == MPI_SUCCESS)
@@ -93,8 +103,11 @@ mpiio_open (iore_file_t *file, const iore_test_t *test)
   MPI_File *fh = malloc (sizeof(MPI_File));
   assert(fh);
   int mode = MPI_MODE_RDONLY;
-  MPI_Comm comm =
-      (test->file_mode == IORE_TEST_FMODE_NX1) ? ctx.comm : MPI_COMM_SELF;
+  MPI_Comm comm = MPI_COMM_SELF;
+  if (test->file_mode == IORE_TEST_FMODE_NX1)
+    comm = ctx.comm;
+  else if (test->file_mode == IORE_TEST_FMODE_NXM)
+    comm = test->_file_comm;
 
   rerr = MPI_File_open (comm, file->name, mode, MPI_INFO_NULL, fh);
   if (rerr == MPI_SUCCESS)
@@ -131,6 +144,7 @@ mpiio_write_oset (iore_file_t file, const void *buf, const off_t *offs,
   size_t remaining = test->wkld.u.oset.my_data_size;
   size_t max_req_size = test->wkld.u.oset.my_req_size;
   size_t req_size;
+  iore_time_t start;
   int rerr = MPI_SUCCESS;
 
   int
@@ -162,15 +176,18 @@ mpiio_write_oset (iore_file_t file, const void *buf, const off_t *offs,
 	    req_size = max_req_size;
 	  if (req_size > remaining)
 	    req_size = remaining;
+	  start = trec_req_start ();
 	  rerr = mpi_write_at (*fh, *offs, buf, req_size, MPI_BYTE,
 	  MPI_STATUS_IGNORE);
+	  trec_req_stop (*offs, req_size, start);
 	  if (rerr != MPI_SUCCESS)
 	    nbytes = -1;
 	  else
 	    {
 	      nbytes += req_size * sizeof(char);
+	      lmet_xfer (req_size * sizeof(char));
 	      if (test->write_flush_per_req)
-		MPI_File_sync (*fh);
+		mpiio_sync_req (fh);
 	    }
 	  remaining -= req_size;
 	  offs++;
@@ -185,6 +202,7 @@ mpiio_write_oset (iore_file_t file, const void *buf, const off_t *offs,
 	    req_size = max_req_size;
 	  if (req_size > remaining)
 	    req_size = remaining;
+	  start = trec_req_start ();
 	  rerr = MPI_File_seek (*fh, *offs, MPI_SEEK_SET);
 	  if (rerr != MPI_SUCCESS)
 	    nbytes = -1;
@@ -192,13 +210,15 @@ mpiio_write_oset (iore_file_t file, const void *buf, const off_t *offs,
 	    {
 	      rerr = mpi_write (*fh, buf, req_size, MPI_BYTE,
 	      MPI_STATUS_IGNORE);
+	      trec_req_stop (*offs, req_size, start);
 	      if (rerr != MPI_SUCCESS)
 		nbytes = -1;
 	      else
 		{
 		  nbytes += req_size * sizeof(char);
+		  lmet_xfer (req_size * sizeof(char));
 		  if (test->write_flush_per_req)
-		    MPI_File_sync (*fh);
+		    mpiio_sync_req (fh);
 		}
 	    }
 	  remaining -= req_size;
@@ -206,9 +226,6 @@ mpiio_write_oset (iore_file_t file, const void *buf, const off_t *offs,
 	}
     }
 
-  if (nbytes > 0 && test->write_flush)
-    MPI_File_sync (*fh);
-
   return nbytes;
 } /* mpiio_write_oset () */
 
@@ -223,6 +240,7 @@ mpiio_read_oset (iore_file_t file, void *buf, const off_t *offs,
   size_t remaining = test->wkld.u.oset.my_data_size;
   size_t max_req_size = test->wkld.u.oset.my_req_size;
   size_t req_size;
+  iore_time_t start;
   int rerr = MPI_SUCCESS;
 
   int
@@ -253,12 +271,17 @@ mpiio_read_oset (iore_file_t file, void *buf, const off_t *offs,
 	    req_size = max_req_size;
 	  if (req_size > remaining)
 	    req_size = remaining;
+	  start = trec_req_start ();
 	  rerr = mpi_read_at (*fh, *offs, buf, req_size, MPI_BYTE,
 	  MPI_STATUS_IGNORE);
+	  trec_req_stop (*offs, req_size, start);
 	  if (rerr != MPI_SUCCESS)
 	    nbytes = -1;
 	  else
-	    nbytes += req_size * sizeof(char);
+	    {
+	      nbytes += req_size * sizeof(char);
+	      lmet_xfer (req_size * sizeof(char));
+	    }
 
 	  remaining -= req_size;
 	  offs++;
@@ -273,6 +296,7 @@ mpiio_read_oset (iore_file_t file, void *buf, const off_t *offs,
 	    req_size = max_req_size;
 	  if (req_size > remaining)
 	    req_size = remaining;
+	  start = trec_req_start ();
 	  rerr = MPI_File_seek (*fh, *offs, MPI_SEEK_SET);
 	  if (rerr != MPI_SUCCESS)
 	    nbytes = -1;
@@ -280,10 +304,14 @@ mpiio_read_oset (iore_file_t file, void *buf, const off_t *offs,
 	    {
 	      rerr = mpi_read (*fh, buf, req_size, MPI_BYTE,
 	      MPI_STATUS_IGNORE);
+	      trec_req_stop (*offs, req_size, start);
 	      if (rerr != MPI_SUCCESS)
 		nbytes = -1;
 	      else
-		nbytes += req_size * sizeof(char);
+		{
+		  nbytes += req_size * sizeof(char);
+		  lmet_xfer (req_size * sizeof(char));
+		}
 	    }
 	  remaining -= req_size;
 	  offs++;
@@ -304,6 +332,7 @@ mpiio_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
   MPI_File *fh = (MPI_File *) file.hdle.fptr;
   size_t dset_size = test->wkld.u.dset.my_size;
   size_t req_size;
+  iore_time_t start;
   int rerr = 0;
 
   int
@@ -361,15 +390,18 @@ mpiio_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
 	{
 	  while (nbytes < (ssize_t) dset_size && nbytes >= 0)
 	    {
+	      start = trec_req_start ();
 	      rerr = mpi_write_at (*fh, *offs, buf + nbytes, req_size, MPI_BYTE,
 	      MPI_STATUS_IGNORE);
+	      trec_req_stop (*offs, req_size, start);
 	      if (rerr != MPI_SUCCESS)
 		nbytes = -1;
 	      else
 		{
 		  nbytes += req_size * sizeof(char);
+		  lmet_xfer (req_size * sizeof(char));
 		  if (test->write_flush_per_req)
-		    MPI_File_sync (*fh);
+		    mpiio_sync_req (fh);
 		}
 	      offs++;
 	    }
@@ -378,6 +410,7 @@ mpiio_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
 	{
 	  while (nbytes < (ssize_t) dset_size && nbytes >= 0)
 	    {
+	      start = trec_req_start ();
 	      rerr = MPI_File_seek (*fh, *offs, MPI_SEEK_SET);
 	      if (rerr != MPI_SUCCESS)
 		nbytes = -1;
@@ -385,13 +418,15 @@ mpiio_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
 		{
 		  rerr = mpi_write (*fh, buf, req_size, MPI_BYTE,
 		  MPI_STATUS_IGNORE);
+		  trec_req_stop (*offs, req_size, start);
 		  if (rerr != MPI_SUCCESS)
 		    nbytes = -1;
 		  else
 		    {
 		      nbytes += req_size * sizeof(char);
+		      lmet_xfer (req_size * sizeof(char));
 		      if (test->write_flush_per_req)
-			MPI_File_sync (*fh);
+			mpiio_sync_req (fh);
 		    }
 		}
 	      offs++;
@@ -401,9 +436,6 @@ mpiio_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
       free (first_off);
     }
 
-  if (nbytes > 0 && test->write_flush)
-    MPI_File_sync (*fh);
-
   return nbytes;
 } /* mpiio_write_dset () */
 
@@ -418,6 +450,7 @@ mpiio_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
   MPI_File *fh = (MPI_File *) file.hdle.fptr;
   size_t dset_size = test->wkld.u.dset.my_size;
   size_t req_size;
+  iore_time_t start;
   int rerr = 0;
 
   int
@@ -472,12 +505,17 @@ mpiio_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
 	{
 	  while (nbytes < (ssize_t) dset_size && nbytes >= 0)
 	    {
+	      start = trec_req_start ();
 	      rerr = mpi_read_at (*fh, *offs, buf + nbytes, req_size, MPI_BYTE,
 	      MPI_STATUS_IGNORE);
+	      trec_req_stop (*offs, req_size, start);
 	      if (rerr != MPI_SUCCESS)
 		nbytes = -1;
 	      else
-		nbytes += req_size * sizeof(char);
+		{
+		  nbytes += req_size * sizeof(char);
+		  lmet_xfer (req_size * sizeof(char));
+		}
 
 	      offs++;
 	    }
@@ -486,6 +524,7 @@ mpiio_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
 	{
 	  while (nbytes < (ssize_t) dset_size && nbytes >= 0)
 	    {
+	      start = trec_req_start ();
 	      rerr = MPI_File_seek (*fh, *offs, MPI_SEEK_SET);
 	      if (rerr != MPI_SUCCESS)
 		nbytes = -1;
@@ -493,10 +532,14 @@ mpiio_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
 		{
 		  rerr = mpi_read (*fh, buf, req_size, MPI_BYTE,
 		  MPI_STATUS_IGNORE);
+		  trec_req_stop (*offs, req_size, start);
 		  if (rerr != MPI_SUCCESS)
 		    nbytes = -1;
 		  else
-		    nbytes += req_size * sizeof(char);
+		    {
+		      nbytes += req_size * sizeof(char);
+		      lmet_xfer (req_size * sizeof(char));
+		    }
 		}
 	      offs++;
 	    }
@@ -508,6 +551,17 @@ mpiio_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
   return nbytes;
 } /* mpiio_read_dset () */
 
+int
+mpiio_flush (iore_file_t file, const iore_test_t *test)
+{
+  assert(test);
+
+  int rerr =
+      (MPI_File_sync (*((MPI_File *) file.hdle.fptr)) == MPI_SUCCESS) ?
+	  IORE_SUCCESS : IORE_FAILURE;
+  return rerr;
+} /* mpiio_flush () */
+
 int
 mpiio_close (iore_file_t *file)
 {
@@ -618,3 +672,15 @@ mpiio_create_datatype (const iore_wkld_dset_t *dset, MPI_Datatype *datatype)
 
   return rerr;
 } /* mpiio_create_datatype () */
+
+/**
+ * Flushes the requests written so far, timed under the flush action (see
+ * trec_flush_req_stop ()).
+ */
+static void
+mpiio_sync_req (MPI_File *fh)
+{
+  iore_time_t start = trec_flush_req_start ();
+  MPI_File_sync (*fh);
+  trec_flush_req_stop (start);
+} /* mpiio_sync_req () */
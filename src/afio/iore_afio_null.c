@@ -0,0 +1,351 @@
+/*
+ * iore_afio_null.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "iore_afio.h"
+#include "iore_error.h"
+#include "iore_util.h"
+#include "iore_workload.h"
+#include "iore_lmet.h"
+#include "iore_trec.h"
+
+/*** TYPES *******************************************************************/
+
+/**
+ * Memory-backed file. Contents survive closing the file, so that read tests
+ * get the data of write tests, and are released when the file is removed.
+ */
+typedef struct null_mfile
+{
+  char *name;
+  char *data;
+  size_t size;
+  size_t capacity;
+  struct null_mfile *next;
+} null_mfile_t;
+
+/*** PROTOTYPES **************************************************************/
+
+int
+null_create (iore_file_t *, const iore_test_t *);
+int
+null_open (iore_file_t *, const iore_test_t *);
+ssize_t
+null_write_oset (iore_file_t, const void *, const off_t *, const iore_test_t *);
+ssize_t
+null_read_oset (iore_file_t, void *, const off_t *, const iore_test_t *);
+ssize_t
+null_write_dset (iore_file_t, const void *, const iore_test_t *);
+ssize_t
+null_read_dset (iore_file_t, void *, const iore_test_t *);
+int
+null_flush (iore_file_t, const iore_test_t *);
+int
+null_close (iore_file_t *);
+int
+null_remove (iore_file_t);
+
+static null_mfile_t *
+null_mfile_get (const char *);
+static ssize_t
+null_xfer (null_mfile_t *, void *, size_t, off_t, bool);
+static size_t
+null_dset_req_size (const iore_test_t *);
+
+/*** VARIABLES ***************************************************************/
+
+const iore_afio_vtable_t afio_null =
+  { null_create, null_open, null_write_oset, null_read_oset, null_write_dset,
+      null_read_dset, null_flush, null_close, null_remove, NULL, NULL };
+
+static null_mfile_t *mfiles = NULL;
+
+/* source of reads when files are not memory-backed */
+static char *zeros = NULL;
+static size_t zeros_size = 0;
+
+/*** FUNCTIONS ***************************************************************/
+
+int
+null_create (iore_file_t *file, const iore_test_t *test)
+{
+  assert(file);
+  assert(test);
+
+  file->hdle.fptr = NULL;
+  if (strtob (dict_get (&test->afio.params, AFIO_PARAM_MEMORY_FILE)))
+    file->hdle.fptr = null_mfile_get (file->name);
+
+  return IORE_SUCCESS;
+} /* null_create () */
+
+int
+null_open (iore_file_t *file, const iore_test_t *test)
+{
+  assert(file);
+  assert(test);
+
+  file->hdle.fptr = NULL;
+  if (strtob (dict_get (&test->afio.params, AFIO_PARAM_MEMORY_FILE)))
+    file->hdle.fptr = null_mfile_get (file->name);
+
+  return IORE_SUCCESS;
+} /* null_open () */
+
+ssize_t
+null_write_oset (iore_file_t file, const void *buf, const off_t *offs,
+		 const iore_test_t *test)
+{
+  assert(buf);
+  assert(offs);
+  assert(test);
+
+  ssize_t nbytes = 0;
+
+  size_t file_size = test->wkld.u.oset._file_size;
+  size_t remaining = test->wkld.u.oset.my_data_size;
+  size_t max_req_size = test->wkld.u.oset.my_req_size;
+  size_t req_size;
+
+  while (remaining)
+    {
+      req_size = (file_size - *offs);
+      if (req_size > max_req_size)
+	req_size = max_req_size;
+      if (req_size > remaining)
+	req_size = remaining;
+      nbytes += null_xfer (file.hdle.fptr, (void *) buf, req_size, *offs,
+			   true);
+
+      remaining -= req_size;
+      offs++;
+    }
+
+  return nbytes;
+} /* null_write_oset () */
+
+ssize_t
+null_read_oset (iore_file_t file, void *buf, const off_t *offs,
+		const iore_test_t *test)
+{
+  assert(buf);
+  assert(offs);
+  assert(test);
+
+  ssize_t nbytes = 0;
+
+  size_t file_size = test->wkld.u.oset._file_size;
+  size_t remaining = test->wkld.u.oset.my_data_size;
+  size_t max_req_size = test->wkld.u.oset.my_req_size;
+  size_t req_size;
+
+  while (remaining)
+    {
+      req_size = (file_size - *offs);
+      if (req_size > max_req_size)
+	req_size = max_req_size;
+      if (req_size > remaining)
+	req_size = remaining;
+      nbytes += null_xfer (file.hdle.fptr, buf, req_size, *offs, false);
+
+      remaining -= req_size;
+      offs++;
+    }
+
+  return nbytes;
+} /* null_read_oset () */
+
+ssize_t
+null_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
+{
+  assert(buf);
+  assert(test);
+
+  ssize_t nbytes = 0;
+
+  size_t dset_size = test->wkld.u.dset.my_size;
+  size_t req_size = null_dset_req_size (test);
+  if (req_size == 0) /* unsupported dataset type */
+    return -1;
+
+  off_t *offs = dset_to_off (&test->wkld.u.dset, test->file_mode);
+  if (!offs)
+    return -1;
+
+  unsigned int i;
+  for (i = 0; nbytes < (ssize_t) dset_size; i++)
+    nbytes += null_xfer (file.hdle.fptr, (void *) (buf + nbytes), req_size,
+			 offs[i], true);
+
+  free (offs);
+
+  return nbytes;
+} /* null_write_dset () */
+
+ssize_t
+null_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
+{
+  assert(buf);
+  assert(test);
+
+  ssize_t nbytes = 0;
+
+  size_t dset_size = test->wkld.u.dset.my_size;
+  size_t req_size = null_dset_req_size (test);
+  if (req_size == 0) /* unsupported dataset type */
+    return -1;
+
+  off_t *offs = dset_to_off (&test->wkld.u.dset, test->file_mode);
+  if (!offs)
+    return -1;
+
+  unsigned int i;
+  for (i = 0; nbytes < (ssize_t) dset_size; i++)
+    nbytes += null_xfer (file.hdle.fptr, buf + nbytes, req_size, offs[i],
+			 false);
+
+  free (offs);
+
+  return nbytes;
+} /* null_read_dset () */
+
+int
+null_flush (iore_file_t file, const iore_test_t *test)
+{
+  assert(file.name);
+  assert(test);
+
+  return IORE_SUCCESS;
+} /* null_flush () */
+
+int
+null_close (iore_file_t *file)
+{
+  assert(file);
+
+  file->hdle.fptr = NULL;
+
+  return IORE_SUCCESS;
+} /* null_close () */
+
+int
+null_remove (iore_file_t file)
+{
+  null_mfile_t **prev = &mfiles;
+  while (*prev && strcmp ((*prev)->name, file.name))
+    prev = &(*prev)->next;
+
+  null_mfile_t *mfile = *prev;
+  if (mfile)
+    {
+      *prev = mfile->next;
+      free (mfile->name);
+      free (mfile->data);
+      free (mfile);
+    }
+
+  return IORE_SUCCESS;
+} /* null_remove () */
+
+/**
+ * Looks up the memory-backed file named 'name', adding an empty one if none
+ * exists.
+ */
+static null_mfile_t *
+null_mfile_get (const char *name)
+{
+  null_mfile_t *mfile = mfiles;
+  while (mfile && strcmp (mfile->name, name))
+    mfile = mfile->next;
+
+  if (!mfile)
+    {
+      mfile = calloc (1, sizeof(null_mfile_t));
+      assert(mfile);
+      mfile->name = strdup (name);
+      assert(mfile->name);
+      mfile->next = mfiles;
+      mfiles = mfile;
+    }
+
+  return mfile;
+} /* null_mfile_get () */
+
+/**
+ * Writes are discarded and reads copied from a zeroed buffer, unless the
+ * file is memory-backed. Memory-backed files grow on demand, and read as
+ * zeros past their end, like sparse files.
+ */
+static ssize_t
+null_xfer (null_mfile_t *mfile, void *buf, size_t count, off_t off,
+	   bool is_write)
+{
+  iore_time_t start = trec_req_start ();
+
+  /* requests never fail */
+  lmet_xfer (count);
+
+  if (!mfile)
+    {
+      if (!is_write)
+	{
+	  if (zeros_size < count)
+	    {
+	      free (zeros);
+	      zeros = calloc (count, 1);
+	      assert(zeros);
+	      zeros_size = count;
+	    }
+	  memcpy (buf, zeros, count);
+	}
+      trec_req_stop (off, count, start);
+      return count;
+    }
+
+  size_t end = off + count;
+  if (is_write)
+    {
+      if (mfile->capacity < end)
+	{
+	  mfile->capacity = (2 * mfile->capacity > end) ?
+	      2 * mfile->capacity : end;
+	  mfile->data = realloc (mfile->data, mfile->capacity);
+	  assert(mfile->data);
+	}
+      if (mfile->size < end)
+	{
+	  memset (mfile->data + mfile->size, 0, end - mfile->size);
+	  mfile->size = end;
+	}
+      memcpy (mfile->data + off, buf, count);
+    }
+  else
+    {
+      size_t avail = (mfile->size > (size_t) off) ? mfile->size - off : 0;
+      if (avail > count)
+	avail = count;
+      memcpy (buf, mfile->data + off, avail);
+      memset (buf + avail, 0, count - avail);
+    }
+  trec_req_stop (off, count, start);
+
+  return count;
+} /* null_xfer () */
+
+static size_t
+null_dset_req_size (const iore_test_t *test)
+{
+  const iore_wkld_dset_t *dset = &test->wkld.u.dset;
+
+  if (dset->type != IORE_WKLD_DSET_CARTESIAN)
+    return 0;
+
+  return (dset->_vars_size
+      * dset->u.cart.my_dim_sizes[dset->u.cart.num_dims - 1]);
+} /* null_dset_req_size () */
@@ -7,9 +7,13 @@
 #ifndef _XOPEN_SOURCE
 #define _XOPEN_SOURCE 500
 #endif
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* O_DIRECT */
+#endif
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/uio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <stdio.h>
@@ -19,6 +23,8 @@
 #include "iore_util.h"
 #include "iore_workload.h"
 #include "iore_ctx.h"
+#include "iore_lmet.h"
+#include "iore_trec.h"
 
 /*** PROTOTYPES **************************************************************/
 
@@ -35,15 +41,31 @@ posix_write_dset (iore_file_t, const void *, const iore_test_t *);
 ssize_t
 posix_read_dset (iore_file_t, void *, const iore_test_t *);
 int
+posix_flush (iore_file_t, const iore_test_t *);
+int
 posix_close (iore_file_t *);
 int
 posix_remove (iore_file_t);
 
+static int
+posix_open_stripes (iore_file_t *, int, mode_t);
+static ssize_t
+posix_xfer_req (const iore_file_t *, void *, size_t, off_t, bool, bool,
+		const iore_test_t *);
+static ssize_t
+posix_xfer_fd (int, void *, size_t, off_t, bool, bool, const iore_test_t *);
+static int
+posix_flush_fd (int, const iore_test_t *);
+static int
+posix_flush_req (const iore_file_t *, const off_t *, unsigned int, size_t,
+		 const iore_test_t *);
+
 /*** VARIABLES ***************************************************************/
 
 const iore_afio_vtable_t afio_posix =
   { posix_create, posix_open, posix_write_oset, posix_read_oset,
-      posix_write_dset, posix_read_dset, posix_close, posix_remove };
+      posix_write_dset, posix_read_dset, posix_flush, posix_close,
+      posix_remove, NULL, NULL };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -58,6 +80,13 @@ posix_create (iore_file_t *file, const iore_test_t *test)
   int fd;
   int oflag = O_CREAT | O_WRONLY;
   mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+  if (test->write_flush_mode == IORE_TEST_FLUSH_O_DSYNC)
+    oflag |= O_DSYNC;
+  else if (test->write_flush_mode == IORE_TEST_FLUSH_O_SYNC)
+    oflag |= O_SYNC;
+
+  if (file->stripes)
+    return posix_open_stripes (file, oflag, mode);
 
   fd = open (file->name, oflag, mode);
   if (fd >= 0)
@@ -78,6 +107,11 @@ posix_open (iore_file_t *file, const iore_test_t *test)
 
   int fd;
   int oflag = O_RDONLY;
+  if (test->read_cache_defeat == IORE_TEST_CDEFEAT_DIRECT)
+    oflag |= O_DIRECT;
+
+  if (file->stripes)
+    return posix_open_stripes (file, oflag, 0);
 
   fd = open (file->name, oflag);
   if (fd >= 0)
@@ -98,68 +132,39 @@ posix_write_oset (iore_file_t file, const void *buf, const off_t *offs,
 
   ssize_t nbytes = 0;
 
-  int fd = file.hdle.fint;
   size_t file_size = test->wkld.u.oset._file_size;
   size_t remaining = test->wkld.u.oset.my_data_size;
   size_t max_req_size = test->wkld.u.oset.my_req_size;
   size_t req_size;
   ssize_t xferd;
+  const off_t *first_off = offs;
 
   bool seek_rw_single_op = strtob (
       dict_get (&test->afio.params, AFIO_PARAM_SEEK_RW_SINGLE_OP));
-  if (seek_rw_single_op)
-    {
-      while (remaining && nbytes >= 0)
-	{
-	  req_size = (file_size - *offs);
-	  if (req_size > max_req_size)
-	    req_size = max_req_size;
-	  if (req_size > remaining)
-	    req_size = remaining;
-	  xferd = pwrite (fd, buf, req_size, *offs);
-	  if (xferd < (ssize_t) req_size)
-	    nbytes = -1;
-	  else
-	    {
-	      nbytes += xferd;
-	      if (test->write_flush_per_req)
-		fsync (fd);
-	    }
-	  remaining -= req_size;
-	  offs++;
-	}
-    }
-  else /* not seek_rw_single_op */
+  while (remaining && nbytes >= 0)
     {
-      while (remaining && nbytes >= 0)
+      req_size = (file_size - *offs);
+      if (req_size > max_req_size)
+	req_size = max_req_size;
+      if (req_size > remaining)
+	req_size = remaining;
+      xferd = posix_xfer_req (&file, (void *) buf, req_size, *offs,
+			      !seek_rw_single_op, true, test);
+      if (xferd < (ssize_t) req_size)
+	nbytes = -1;
+      else
 	{
-	  if (lseek (fd, *offs, SEEK_SET) < 0)
+	  nbytes += xferd;
+	  lmet_xfer (xferd);
+	  if (test->write_flush_per_req
+	      && posix_flush_req (&file, offs, (offs - first_off),
+				  max_req_size, test))
 	    nbytes = -1;
-	  else
-	    {
-	      req_size = (file_size - *offs);
-	      if (req_size > max_req_size)
-		req_size = max_req_size;
-	      if (req_size > remaining)
-		req_size = remaining;
-	      xferd = write (fd, buf, req_size);
-	      if (xferd < (ssize_t) req_size)
-		nbytes = -1;
-	      else
-		{
-		  nbytes += xferd;
-		  if (test->write_flush_per_req)
-		    fsync (fd);
-		}
-	    }
-	  remaining -= req_size;
-	  offs++;
 	}
+      remaining -= req_size;
+      offs++;
     }
 
-  if (nbytes > 0 && test->write_flush)
-    fsync (fd);
-
   return nbytes;
 } /* posix_write_oset () */
 
@@ -173,7 +178,6 @@ posix_read_oset (iore_file_t file, void *buf, const off_t *offs,
 
   ssize_t nbytes = 0;
 
-  int fd = file.hdle.fint;
   size_t file_size = test->wkld.u.oset._file_size;
   size_t remaining = test->wkld.u.oset.my_data_size;
   size_t max_req_size = test->wkld.u.oset.my_req_size;
@@ -182,48 +186,25 @@ posix_read_oset (iore_file_t file, void *buf, const off_t *offs,
 
   bool seek_rw_single_op = strtob (
       dict_get (&test->afio.params, AFIO_PARAM_SEEK_RW_SINGLE_OP));
-  if (seek_rw_single_op)
+  while (remaining && nbytes >= 0)
     {
-      while (remaining && nbytes >= 0)
+      req_size = (file_size - *offs);
+      if (req_size > max_req_size)
+	req_size = max_req_size;
+      if (req_size > remaining)
+	req_size = remaining;
+      xferd = posix_xfer_req (&file, buf, req_size, *offs, !seek_rw_single_op,
+			      false, test);
+      if (xferd < (ssize_t) req_size)
+	nbytes = -1;
+      else
 	{
-	  req_size = (file_size - *offs);
-	  if (req_size > max_req_size)
-	    req_size = max_req_size;
-	  if (req_size > remaining)
-	    req_size = remaining;
-	  xferd = pread (fd, buf, req_size, *offs);
-	  if (xferd < (ssize_t) req_size)
-	    nbytes = -1;
-	  else
-	    nbytes += xferd;
-
-	  remaining -= req_size;
-	  offs++;
-	}
-    }
-  else /* not seek_rw_single_op */
-    {
-      while (remaining && nbytes >= 0)
-	{
-	  if (lseek (fd, *offs, SEEK_SET) < 0)
-	    nbytes = -1;
-	  else
-	    {
-	      req_size = (file_size - *offs);
-	      if (req_size > max_req_size)
-		req_size = max_req_size;
-	      if (req_size > remaining)
-		req_size = remaining;
-	      xferd = read (fd, buf, req_size);
-	      if (xferd < (ssize_t) req_size)
-		nbytes = -1;
-	      else
-		nbytes += xferd;
-	    }
-
-	  remaining -= req_size;
-	  offs++;
+	  nbytes += xferd;
+	  lmet_xfer (xferd);
 	}
+
+      remaining -= req_size;
+      offs++;
     }
 
   return nbytes;
@@ -237,7 +218,6 @@ posix_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
 
   ssize_t nbytes = 0;
 
-  int fd = file.hdle.fint;
   size_t dset_size = test->wkld.u.dset.my_size;
   size_t req_size;
   ssize_t xferd;
@@ -262,47 +242,24 @@ posix_write_dset (iore_file_t file, const void *buf, const iore_test_t *test)
 
   bool seek_rw_single_op = strtob (
       dict_get (&test->afio.params, AFIO_PARAM_SEEK_RW_SINGLE_OP));
-  if (seek_rw_single_op)
-    {
-      while (nbytes < (ssize_t) dset_size && nbytes >= 0)
-	{
-	  xferd = pwrite (fd, buf + nbytes, req_size, *offs);
-	  if (xferd < (ssize_t) req_size)
-	    nbytes = -1;
-	  else
-	    {
-	      nbytes += xferd;
-	      if (test->write_flush_per_req)
-		fsync (fd);
-	    }
-	  offs++;
-	}
-    }
-  else /* not seek_rw_single_op */
+  while (nbytes < (ssize_t) dset_size && nbytes >= 0)
     {
-      while (nbytes < (ssize_t) dset_size && nbytes >= 0)
+      xferd = posix_xfer_req (&file, (void *) (buf + nbytes), req_size, *offs,
+			      !seek_rw_single_op, true, test);
+      if (xferd < (ssize_t) req_size)
+	nbytes = -1;
+      else
 	{
-	  if (lseek (fd, *offs, SEEK_SET) < 0)
+	  nbytes += xferd;
+	  lmet_xfer (xferd);
+	  if (test->write_flush_per_req
+	      && posix_flush_req (&file, offs, (offs - first_off), req_size,
+				  test))
 	    nbytes = -1;
-	  else
-	    {
-	      xferd = write (fd, buf + nbytes, req_size);
-	      if (xferd < (ssize_t) req_size)
-		nbytes = -1;
-	      else
-		{
-		  nbytes += xferd;
-		  if (test->write_flush_per_req)
-		    fsync (fd);
-		}
-	    }
-	  offs++;
 	}
+      offs++;
     }
 
-  if (nbytes > 0 && test->write_flush)
-    fsync (fd);
-
   free (first_off);
 
   return nbytes;
@@ -316,7 +273,6 @@ posix_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
 
   ssize_t nbytes = 0;
 
-  int fd = file.hdle.fint;
   size_t dset_size = test->wkld.u.dset.my_size;
   size_t req_size;
   ssize_t xferd;
@@ -341,35 +297,19 @@ posix_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
 
   bool seek_rw_single_op = strtob (
       dict_get (&test->afio.params, AFIO_PARAM_SEEK_RW_SINGLE_OP));
-  if (seek_rw_single_op)
-    {
-      while (nbytes < (ssize_t) dset_size && nbytes >= 0)
-	{
-	  xferd = pread (fd, buf + nbytes, req_size, *offs);
-	  if (xferd < (ssize_t) req_size)
-	    nbytes = -1;
-	  else
-	    nbytes += xferd;
-
-	  offs++;
-	}
-    }
-  else /* not seek_rw_single_op */
+  while (nbytes < (ssize_t) dset_size && nbytes >= 0)
     {
-      while (nbytes < (ssize_t) dset_size && nbytes >= 0)
+      xferd = posix_xfer_req (&file, buf + nbytes, req_size, *offs,
+			      !seek_rw_single_op, false, test);
+      if (xferd < (ssize_t) req_size)
+	nbytes = -1;
+      else
 	{
-	  if (lseek (fd, *offs, SEEK_SET) < 0)
-	    nbytes = -1;
-	  else
-	    {
-	      xferd = read (fd, buf + nbytes, req_size);
-	      if (xferd < (ssize_t) req_size)
-		nbytes = -1;
-	      else
-		nbytes += xferd;
-	    }
-	  offs++;
+	  nbytes += xferd;
+	  lmet_xfer (xferd);
 	}
+
+      offs++;
     }
 
   free (first_off);
@@ -377,16 +317,222 @@ posix_read_dset (iore_file_t file, void *buf, const iore_test_t *test)
   return nbytes;
 } /* posix_read_dset () */
 
+int
+posix_flush (iore_file_t file, const iore_test_t *test)
+{
+  assert(test);
+
+  if (file.stripes)
+    {
+      int rerr = IORE_SUCCESS;
+      unsigned int i;
+      for (i = 0; i < file.stripes->count; i++)
+	rerr |= posix_flush_fd (file.stripes->fints[i], test);
+      return rerr;
+    }
+
+  return posix_flush_fd (file.hdle.fint, test);
+} /* posix_flush () */
+
 int
 posix_close (iore_file_t *file)
 {
   assert(file);
 
+  if (file->stripes)
+    {
+      int rerr = IORE_SUCCESS;
+      unsigned int i;
+      for (i = 0; i < file->stripes->count; i++)
+	rerr |= close (file->stripes->fints[i]);
+      return rerr;
+    }
+
   return close (file->hdle.fint);
 } /* posix_close () */
 
 int
 posix_remove (iore_file_t file)
 {
+  if (file.stripes)
+    {
+      int rerr = IORE_SUCCESS;
+      unsigned int i;
+      for (i = 0; i < file.stripes->count; i++)
+	rerr |= unlink (file.stripes->names[i]);
+      return rerr;
+    }
+
   return unlink (file.name);
 } /* posix_remove () */
+
+/**
+ * Opens every stripe object of a striped file. On failure, the objects
+ * already opened are closed.
+ */
+static int
+posix_open_stripes (iore_file_t *file, int oflag, mode_t mode)
+{
+  iore_file_stripes_t *stripes = file->stripes;
+  unsigned int i;
+  for (i = 0; i < stripes->count; i++)
+    {
+      stripes->fints[i] = open (stripes->names[i], oflag, mode);
+      if (stripes->fints[i] < 0)
+	{
+	  while (i-- > 0)
+	    close (stripes->fints[i]);
+	  return IORE_FAILURE;
+	}
+    }
+  file->hdle.fint = stripes->fints[0];
+
+  return IORE_SUCCESS;
+} /* posix_open_stripes () */
+
+/**
+ * Transfers a request at offset 'off' of the file. For striped files, the
+ * request is split into stripe units, each one mapped round-robin to the
+ * stripe objects.
+ */
+static ssize_t
+posix_xfer_req (const iore_file_t *file, void *buf, size_t count, off_t off,
+		bool seek, bool is_write, const iore_test_t *test)
+{
+  iore_time_t start = trec_req_start ();
+
+  const iore_file_stripes_t *stripes = file->stripes;
+  if (!stripes)
+    {
+      ssize_t xferd = posix_xfer_fd (file->hdle.fint, buf, count, off, seek,
+				     is_write, test);
+      trec_req_stop (off, count, start);
+      return xferd;
+    }
+
+  off_t req_off = off;
+  size_t req_count = count;
+  ssize_t nbytes = 0;
+  while (count && nbytes >= 0)
+    {
+      size_t unit = off / stripes->size;
+      size_t unit_off = off % stripes->size;
+      size_t len = stripes->size - unit_off;
+      if (len > count)
+	len = count;
+
+      int fd = stripes->fints[unit % stripes->count];
+      off_t obj_off = (unit / stripes->count) * stripes->size + unit_off;
+      ssize_t xferd = posix_xfer_fd (fd, buf, len, obj_off, seek, is_write,
+				     test);
+      if (xferd < (ssize_t) len)
+	nbytes = -1;
+      else
+	{
+	  nbytes += xferd;
+	  buf = (char *) buf + len;
+	  off += len;
+	  count -= len;
+	}
+    }
+  trec_req_stop (req_off, req_count, start);
+
+  return nbytes;
+} /* posix_xfer_req () */
+
+/**
+ * Writes or reads a request at 'off', seeking to it first if 'seek' is set.
+ */
+static ssize_t
+posix_xfer_fd (int fd, void *buf, size_t count, off_t off, bool seek,
+	       bool is_write, const iore_test_t *test)
+{
+  if (seek)
+    {
+      if (lseek (fd, off, SEEK_SET) < 0)
+	return -1;
+      off = -1; /* current file offset */
+    }
+
+  if (!is_write)
+    return (off < 0) ? read (fd, buf, count) : pread (fd, buf, count, off);
+  else if (test->write_flush_mode == IORE_TEST_FLUSH_RWF_DSYNC)
+    {
+      struct iovec iov =
+	{ buf, count };
+      return pwritev2 (fd, &iov, 1, off, RWF_DSYNC);
+    }
+  else if (off < 0)
+    return write (fd, buf, count);
+  else
+    return pwrite (fd, buf, count, off);
+} /* posix_xfer_fd () */
+
+static int
+posix_flush_fd (int fd, const iore_test_t *test)
+{
+  switch (test->write_flush_mode)
+    {
+    case IORE_TEST_FLUSH_FSYNC:
+    case IORE_TEST_FLUSH_O_SYNC:
+      return fsync (fd);
+    case IORE_TEST_FLUSH_SYNC_FILE_RANGE:
+      return sync_file_range (
+	  fd, 0, 0,
+	  SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE
+	      | SYNC_FILE_RANGE_WAIT_AFTER);
+    default:
+      return fdatasync (fd);
+    }
+} /* posix_flush_fd () */
+
+/**
+ * Flushes the 'req_id'-th request, whose offset is pointed by 'off'.
+ * sync_file_range() flushes start the write-back of the request and wait
+ * for the one issued 'write_flush_window' requests before. Striped files
+ * are flushed as a whole. The flush is timed under the flush action (see
+ * trec_flush_req_stop ()).
+ */
+static int
+posix_flush_req (const iore_file_t *file, const off_t *off,
+		 unsigned int req_id, size_t len, const iore_test_t *test)
+{
+  int rerr = IORE_SUCCESS;
+
+  int fd = file->hdle.fint;
+  unsigned int window = test->write_flush_window;
+  iore_time_t start = trec_flush_req_start ();
+
+  if (file->stripes)
+    {
+      if (test->write_flush_mode == IORE_TEST_FLUSH_FSYNC
+	  || test->write_flush_mode == IORE_TEST_FLUSH_FDATASYNC
+	  || test->write_flush_mode == IORE_TEST_FLUSH_SYNC_FILE_RANGE)
+	rerr = posix_flush (*file, test);
+    }
+  else
+    switch (test->write_flush_mode)
+      {
+      case IORE_TEST_FLUSH_FSYNC:
+	rerr = fsync (fd);
+	break;
+      case IORE_TEST_FLUSH_FDATASYNC:
+	rerr = fdatasync (fd);
+	break;
+      case IORE_TEST_FLUSH_SYNC_FILE_RANGE:
+	rerr = sync_file_range (fd, *off, len, SYNC_FILE_RANGE_WRITE);
+	if (!rerr && req_id >= window)
+	  rerr = sync_file_range (
+	      fd, *(off - window), len,
+	      SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE
+		  | SYNC_FILE_RANGE_WAIT_AFTER);
+	break;
+      default:
+	/* writes are already synchronous */
+	break;
+      }
+
+  trec_flush_req_stop (start);
+
+  return rerr;
+} /* posix_flush_req () */
@@ -10,11 +10,12 @@
 
 #include "iore_afio_types.h"
 #include "iore_dict.h"
+#include "iore_prng_types.h"
 
 /*** VARIABLES ***************************************************************/
 
 const char * const afio_lbl[IORE_AFIO_LENGTH] =
-  { "posix", "cstream"
+  { "posix", "cstream", "emulator", "null"
 #ifdef WITH_MPIIO_AFIO
     , "mpiio"
 #endif
@@ -30,15 +31,18 @@ afio2str (const iore_afio_t *afio)
   if (afio)
     {
       char *params_str = dict2str (&afio->params);
+      char *latency_distrib = prngdist2str (afio->latency_distrib);
       int len = snprintf (str, 0, AFIO2STR_FORMAT, afio, afio_lbl[afio->type],
-	  params_str) + 1;
+	  params_str, latency_distrib) + 1;
       if (len > 0)
 	{
 	  str = malloc (len);
 	  assert(str);
 	  snprintf(str, len, AFIO2STR_FORMAT, afio, afio_lbl[afio->type],
-		   params_str);
+		   params_str, latency_distrib);
 	}
+      free (params_str);
+      free (latency_distrib);
     }
 
   return str;
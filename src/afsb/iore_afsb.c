@@ -6,11 +6,25 @@
 
 #include <assert.h>
 
-#include "iore_afsb_types.h"
+#include "iore_afsb.h"
 #include "iore_dict.h"
 #include "iore_error.h"
 #include "iore_valid.h"
 
+/*** VARIABLES ***************************************************************/
+
+/* storage-specific backends are not implemented yet */
+extern const iore_afsb_vtable_t afsb_striped;
+const iore_afsb_vtable_t *afsb_pool[IORE_AFSB_LENGTH] =
+  { NULL, &afsb_striped
+#ifdef WITH_ORANGEFS_AFSB
+    , NULL
+#endif
+#ifdef WITH_LUSTRE_AFSB
+    , NULL
+#endif
+};
+
 /*** FUNCTIONS ***************************************************************/
 
 iore_afsb_t *
@@ -43,6 +57,14 @@ afsb_valid (iore_afsb_t *this)
       iore_errorf(VALID_MSG_INVALID_OPTION, "AFSB implementation");
       rerr = IORE_FAILURE;
     }
+  else if (this->type != IORE_AFSB_UNSET && !afsb_pool[this->type])
+    {
+      iore_errorf("Validation: AFSB implementation '%s' is not available.",
+		  afsb_lbl[this->type]);
+      rerr = IORE_FAILURE;
+    }
+  else if (afsb_pool[this->type])
+    rerr = afsb_pool[this->type]->valid (this);
 
   return rerr;
 } /* afsb_valid () */
@@ -0,0 +1,228 @@
+/*
+ * iore_afsb_striped.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#include <libgen.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "iore_afsb.h"
+#include "iore_dict.h"
+#include "iore_error.h"
+#include "iore_util.h"
+#include "iore_valid.h"
+
+/*** DEFINES *****************************************************************/
+
+#define STRIPED_DIR_NAME "ost"
+#define STRIPED_DIRS_SEP ","
+
+/*** PROTOTYPES **************************************************************/
+
+int
+striped_valid (const iore_afsb_t *);
+int
+striped_prep (iore_file_t *, const iore_afsb_t *);
+int
+striped_post (iore_file_t *, const iore_afsb_t *, bool);
+
+static char **
+striped_dirs (const iore_afsb_t *, const char *, unsigned int,
+	      unsigned int *);
+static unsigned int
+striped_hash (const char *);
+
+/*** VARIABLES ***************************************************************/
+
+const iore_afsb_vtable_t afsb_striped =
+  { striped_valid, striped_prep, striped_post };
+
+/*** FUNCTIONS ***************************************************************/
+
+int
+striped_valid (const iore_afsb_t *afsb)
+{
+  assert(afsb);
+
+  int rerr = IORE_SUCCESS;
+
+  const char *stripe_size = dict_get (&afsb->params, AFSB_PARAM_STRIPE_SIZE);
+  const char *stripe_width = dict_get (&afsb->params, AFSB_PARAM_STRIPE_WIDTH);
+  if (!stripe_size)
+    {
+      iore_errorf(VALID_MSG_REQUIRED_PARAM, AFSB_PARAM_STRIPE_SIZE,
+		  afsb_lbl[afsb->type]);
+      rerr = IORE_FAILURE;
+    }
+  else if (strtosz (stripe_size) == 0)
+    {
+      iore_errorf(VALID_MSG_GREATER_ZERO, AFSB_PARAM_STRIPE_SIZE);
+      rerr = IORE_FAILURE;
+    }
+  if (!stripe_width)
+    {
+      iore_errorf(VALID_MSG_REQUIRED_PARAM, AFSB_PARAM_STRIPE_WIDTH,
+		  afsb_lbl[afsb->type]);
+      rerr = IORE_FAILURE;
+    }
+  else if (atoi (stripe_width) <= 0)
+    {
+      iore_errorf(VALID_MSG_GREATER_ZERO, AFSB_PARAM_STRIPE_WIDTH);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* striped_valid () */
+
+/**
+ * Stripes 'file' over 'stripe_width' objects, each one in a directory
+ * standing for an object storage target (OST). Directories are taken from
+ * 'stripe_dirs' (comma-separated) or created as 'ost.<i>' next to the file.
+ * As in Lustre, the first OST of a file is chosen by hashing its name.
+ */
+int
+striped_prep (iore_file_t *file, const iore_afsb_t *afsb)
+{
+  assert(file);
+  assert(afsb);
+
+  char *file_name = strdup (file->name);
+  assert(file_name);
+  char *base_name = strdup (basename (file_name));
+  assert(base_name);
+  strcpy (file_name, file->name);
+  char *dir_name = dirname (file_name);
+
+  unsigned int width = atoi (
+      dict_get (&afsb->params, AFSB_PARAM_STRIPE_WIDTH));
+  unsigned int num_dirs;
+  char **dirs = striped_dirs (afsb, dir_name, width, &num_dirs);
+
+  iore_file_stripes_t *stripes = malloc (sizeof(iore_file_stripes_t));
+  assert(stripes);
+  stripes->count = width;
+  stripes->size = strtosz (dict_get (&afsb->params, AFSB_PARAM_STRIPE_SIZE));
+  stripes->names = malloc (width * sizeof(char *));
+  assert(stripes->names);
+  stripes->fints = malloc (width * sizeof(int));
+  assert(stripes->fints);
+
+  int rerr = IORE_SUCCESS;
+  unsigned int first = striped_hash (base_name) % num_dirs;
+  unsigned int i;
+  for (i = 0; i < width; i++)
+    {
+      const char *dir = dirs[(first + i) % num_dirs];
+      if (mkdir (dir, S_IRWXU) && errno != EEXIST)
+	{
+	  iore_errorf_all("Failed creating directory '%s'.", dir);
+	  rerr = IORE_FAILURE;
+	}
+      stripes->names[i] = strfmt ("%s/%s.s%u", dir, base_name, i);
+      stripes->fints[i] = -1;
+    }
+  file->stripes = stripes;
+
+  for (i = 0; i < num_dirs; i++)
+    free (dirs[i]);
+  free (dirs);
+  free (base_name);
+  free (file_name);
+
+  return rerr;
+} /* striped_prep () */
+
+/**
+ * Releases the stripes of 'file'. When 'cleanup' is set, the OST
+ * directories created by striped_prep () are removed once empty.
+ */
+int
+striped_post (iore_file_t *file, const iore_afsb_t *afsb, bool cleanup)
+{
+  assert(file);
+  assert(afsb);
+
+  iore_file_stripes_t *stripes = file->stripes;
+  if (!stripes)
+    return IORE_SUCCESS;
+
+  bool own_dirs = (dict_get (&afsb->params, AFSB_PARAM_STRIPE_DIRS) == NULL);
+  unsigned int i;
+  for (i = 0; i < stripes->count; i++)
+    {
+      if (cleanup && own_dirs)
+	{
+	  /* other files may still have stripes in the directory */
+	  char *dir_name = dirname (stripes->names[i]);
+	  rmdir (dir_name);
+	}
+      free (stripes->names[i]);
+    }
+  free (stripes->names);
+  free (stripes->fints);
+  free (stripes);
+  file->stripes = NULL;
+
+  return IORE_SUCCESS;
+} /* striped_post () */
+
+static char **
+striped_dirs (const iore_afsb_t *afsb, const char *dir_name,
+	      unsigned int width, unsigned int *num_dirs)
+{
+  char **dirs;
+
+  const char *param = dict_get (&afsb->params, AFSB_PARAM_STRIPE_DIRS);
+  if (param)
+    {
+      char *list = strdup (param);
+      assert(list);
+      dirs = malloc (strlen (list) * sizeof(char *));
+      assert(dirs);
+      *num_dirs = 0;
+      char *saveptr;
+      char *dir = strtok_r (list, STRIPED_DIRS_SEP, &saveptr);
+      while (dir)
+	{
+	  dirs[(*num_dirs)++] = strdup (dir);
+	  dir = strtok_r (NULL, STRIPED_DIRS_SEP, &saveptr);
+	}
+      free (list);
+    }
+  else
+    *num_dirs = 0;
+
+  if (*num_dirs == 0)
+    {
+      if (param)
+	free (dirs);
+      dirs = malloc (width * sizeof(char *));
+      assert(dirs);
+      unsigned int i;
+      for (i = 0; i < width; i++)
+	dirs[i] = strfmt ("%s/%s.%u", dir_name, STRIPED_DIR_NAME, i);
+      *num_dirs = width;
+    }
+
+  return dirs;
+} /* striped_dirs () */
+
+/**
+ * djb2 string hash.
+ */
+static unsigned int
+striped_hash (const char *str)
+{
+  unsigned int hash = 5381;
+  while (*str)
+    hash = (hash << 5) + hash + (unsigned char) *str++;
+
+  return hash;
+} /* striped_hash () */
@@ -14,7 +14,7 @@
 /*** VARIABLES ***************************************************************/
 
 const char * const afsb_lbl[IORE_AFSB_LENGTH] =
-  { "unset"
+  { "unset", "striped"
 #ifdef WITH_ORANGEFS_AFSB
     , "orangefs"
 #endif
@@ -4,6 +4,9 @@
  * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
  */
 
+#include <stdlib.h>
+#include <assert.h>
+
 #include "iore_ctx.h"
 
 /*** VARIABLES ***************************************************************/
@@ -21,5 +24,57 @@ ctx_init ()
   MPI_Comm_size (MPI_COMM_WORLD, &ctx.num_procs);
   MPI_Comm_rank (MPI_COMM_WORLD, &ctx.task_id);
 
+  ctx.node_comm = MPI_COMM_NULL;
+  ctx.node_of = NULL;
+  ctx.num_nodes = 0;
+
   ctx.verb_lvl = VERB_LVL_NORMAL;
+  ctx.out = stdout;
+  ctx.lmet = NULL;
 } /* ctx_init () */
+
+/**
+ * Maps the tasks of ctx.comm to their nodes, numbered by their lowest
+ * task, unless already mapped. The map is kept until ctx_node_map_free (),
+ * which must be called before ctx.comm changes, so that tests of a run
+ * find it without collectives. Collective.
+ */
+void
+ctx_node_map ()
+{
+  if (ctx.node_of)
+    return;
+
+  int num_tasks;
+  MPI_Comm_size (ctx.comm, &num_tasks);
+  ctx.node_of = malloc (num_tasks * sizeof(int));
+  assert(ctx.node_of);
+
+  /* the lowest task of each shared-memory domain identifies its node */
+  int leader = ctx.task_id;
+  MPI_Comm_split_type (ctx.comm, MPI_COMM_TYPE_SHARED, ctx.task_id,
+		       MPI_INFO_NULL, &ctx.node_comm);
+  MPI_Bcast (&leader, 1, MPI_INT, 0, ctx.node_comm);
+  int *leaders = malloc (num_tasks * sizeof(int));
+  assert(leaders);
+  MPI_Allgather (&leader, 1, MPI_INT, leaders, 1, MPI_INT, ctx.comm);
+
+  int i;
+  for (i = 0, ctx.num_nodes = 0; i < num_tasks; i++)
+    if (leaders[i] == i)
+      ctx.node_of[i] = ctx.num_nodes++;
+  for (i = 0; i < num_tasks; i++)
+    ctx.node_of[i] = ctx.node_of[leaders[i]];
+
+  free (leaders);
+} /* ctx_node_map () */
+
+void
+ctx_node_map_free ()
+{
+  if (ctx.node_comm != MPI_COMM_NULL)
+    MPI_Comm_free (&ctx.node_comm);
+  free (ctx.node_of);
+  ctx.node_of = NULL;
+  ctx.num_nodes = 0;
+} /* ctx_node_map_free () */
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <time.h>
+#include <stdarg.h>
 
 #include "iore_util.h"
 #include "iore_prng.h"
@@ -27,6 +28,48 @@ strtob (const char *str)
   return b;
 } /* strtob () */
 
+/**
+ * Converts a number of bytes, optionally followed by a K, M, G or T
+ * multiplier. Returns 0 in case of failure.
+ */
+size_t
+strtosz (const char *str)
+{
+  if (!str)
+    return 0;
+
+  char *endptr;
+  unsigned long long v = strtoull (str, &endptr, 10);
+  if (endptr == str)
+    return 0;
+
+  switch (*endptr)
+    {
+    case '\0':
+      return v;
+    case 'k':
+    case 'K':
+      v *= KIBIBYTE;
+      break;
+    case 'm':
+    case 'M':
+      v *= MEBIBYTE;
+      break;
+    case 'g':
+    case 'G':
+      v *= GIBIBYTE;
+      break;
+    case 't':
+    case 'T':
+      v *= TEBIBYTE;
+      break;
+    default:
+      return 0;
+    }
+
+  return (*(endptr + 1) == '\0') ? v : 0;
+} /* strtosz () */
+
 char *
 itoa (int i)
 {
@@ -329,10 +372,30 @@ strfmt (const char *fmt, ...)
   return str;
 } /* strfmt () */
 
+char *
+vstrfmt (const char *fmt, va_list ap)
+{
+  char *str = NULL;
+  va_list ap2;
+
+  va_copy (ap2, ap);
+  int len = vsnprintf (str, 0, fmt, ap2) + 1;
+  va_end (ap2);
+  if (len > 0)
+    {
+      str = malloc (len);
+      assert(str);
+      vsnprintf (str, len, fmt, ap);
+    }
+
+  return str;
+} /* vstrfmt () */
+
 char *
 coallesce_str (const char **a, int len, char *sep)
 {
   char *str = NULL;
+  char *str_ptr;
   int ttl_len, sep_len, i;
 
   if (a && len > 0 && sep)
@@ -348,15 +411,15 @@ coallesce_str (const char **a, int len, char *sep)
       str = malloc (ttl_len);
       assert(str);
 
-      str = stpncpy(str, a[0], strlen (a[0]));
+      str_ptr = stpcpy (str, a[0]);
       for (i = 1; i < len; i++)
 	{
-	  str = stpncpy(str, sep, sep_len);
-	  str = stpncpy(str, a[0], strlen (a[0]));
+	  str_ptr = stpcpy (str_ptr, sep);
+	  str_ptr = stpcpy (str_ptr, a[i]);
 	}
     }
 
-  return &str[0];
+  return str;
 } /* coallesce_str () */
 
 char *
@@ -373,7 +436,7 @@ coallesce_uint (const unsigned int *a, int len, char *sep)
       for (i = 0; i < len; i++)
 	str_a[i] = strfmt ("%u", a[i]);
 
-      str = coallesce_str (str_a, len, sep);
+      str = coallesce_str ((const char **) str_a, len, sep);
 
       for (i = 0; i < len; i++)
 	free (str_a[i]);
@@ -381,5 +444,5 @@ coallesce_uint (const unsigned int *a, int len, char *sep)
     }
 
   return str;
-} /* coallesce_uint ()
+} /* coallesce_uint () */
 
@@ -43,6 +43,11 @@ main (int argc, char **argv)
 	rerr = EXIT_FAILURE;
       else if (exp_valid (&exp))
 	rerr = EXIT_FAILURE;
+      else if (exp.plan)
+	{
+	  if (exp_plan (&exp))
+	    rerr = EXIT_FAILURE;
+	}
       else if (exp_exec (&exp))
 	rerr = EXIT_FAILURE;
       else
@@ -69,7 +74,9 @@ main (int argc, char **argv)
 static void
 iore_init (int argc, char **argv)
 {
-  MPI_Init (&argc, &argv);
+  /* only the main thread calls MPI, see lmet_start () */
+  int provided;
+  MPI_Init_thread (&argc, &argv, MPI_THREAD_FUNNELED, &provided);
   ctx_init ();
   trec_init ();
 } /* iore_init () */
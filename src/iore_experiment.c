@@ -7,11 +7,13 @@
 #include <mpi.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 
 #include "iore_experiment.h"
 
 #include "iore_stex.h"
+#include "iore_lmet.h"
 #include "iore_trec.h"
 #include "iore_error.h"
 #include "iore_util.h"
@@ -19,6 +21,10 @@
 #include "iore_ctx.h"
 #include "iore_prng.h"
 
+/*** DEFINES *****************************************************************/
+
+#define EXP_REQS_DIR_DFLT "."
+
 /*** PROTOTYPES **************************************************************/
 
 static int
@@ -46,8 +52,17 @@ exp_init (iore_exp_t *this)
   run_init (this->runs);
   this->_runs_len = 1;
   this->run_order = IORE_RORDER_FIXED;
+  this->co_schedule = IORE_COSCHED_NONE;
 
   stex_init (&this->stex);
+  lmet_init (&this->lmet);
+  this->clock.timer = IORE_TREC_TIMER_MPI_WTIME;
+  this->clock.sync_rounds = IORE_TREC_CLOCK_SYNC_ROUNDS;
+  this->reqs.ring_len = 0;
+  this->reqs.dir = strdup (EXP_REQS_DIR_DFLT);
+  assert(this->reqs.dir);
+  this->plan = false;
+  this->plan_stripe_size = 0;
 
   return this;
 } /* exp_init () */
@@ -66,6 +81,9 @@ exp_free (iore_exp_t *this)
 	}
 
       stex_free (&this->stex);
+      lmet_free (&this->lmet);
+      free (this->reqs.dir);
+      this->reqs.dir = NULL;
     }
 } /* exp_free () */
 
@@ -76,11 +94,22 @@ exp_exec (iore_exp_t *this)
 
   int rerr = IORE_SUCCESS;
 
+  trec_clock_set (&this->clock);
   trec_exp_start (this->num_replications);
 
   if (ctx.task_id == IORE_MASTER_TASK)
     fprintf (stdout, "Starting experiment at %s.\n\n", curtimestr ());
 
+  rerr = lmet_start (&this->lmet);
+  if (!rerr)
+    rerr = trec_rsrc_start (this->stex.os_counters);
+  if (!rerr)
+    rerr = trec_reqs_start (&this->reqs);
+  if (!rerr)
+    rerr = stex_stream_open (&this->stex);
+  if (!rerr)
+    rerr = stex_timeline_open (&this->stex);
+
   unsigned int i;
   for (i = 1; i <= this->num_replications && !rerr; i++)
     {
@@ -94,17 +123,50 @@ exp_exec (iore_exp_t *this)
       MPI_Barrier (ctx.comm);
     }
 
+  rerr |= stex_stream_close ();
+  stex_timeline_close ();
+  trec_reqs_stop ();
+  trec_rsrc_stop ();
+  lmet_stop ();
+
   iore_trec_exp_t *trec_exp = trec_exp_stop ();
   exp_show_summary (trec_exp);
 
   return rerr;
 } /* exp_exec () */
 
+/**
+ * Reports the access pattern of each run without doing I/O, so that the
+ * experiment definition can be checked before being executed. Replications
+ * and repetitions repeat the same patterns, so they are not planned.
+ */
+int
+exp_plan (iore_exp_t *this)
+{
+  assert(this);
+
+  int rerr = IORE_SUCCESS;
+
+  if (ctx.task_id == IORE_MASTER_TASK)
+    fprintf (stdout, "Planning experiment, stripe size %zu bytes.\n\n",
+	     this->plan_stripe_size);
+
+  unsigned int i;
+  for (i = 0; i < this->_runs_len && !rerr; i++)
+    rerr = run_plan (&this->runs[i], this->plan_stripe_size);
+
+  if (!rerr && ctx.task_id == IORE_MASTER_TASK)
+    fputs ("Experiment planned, no I/O performed.\n", stdout);
+
+  return rerr;
+} /* exp_plan () */
+
 static int
 exp_repl_prep (iore_exp_t *exp, iore_exp_repl_t *repl)
 {
   unsigned int runs_len = exp->_runs_len;
   repl->_runs_len = runs_len;
+  repl->co_schedule = exp->co_schedule;
 
   repl->runs = malloc (runs_len * sizeof(iore_run_t *));
   assert(repl->runs);
@@ -130,14 +192,22 @@ exp_repl_exec (iore_exp_repl_t repl)
 {
   int rerr = IORE_SUCCESS;
 
+  /* clocks drift apart along the experiment */
+  trec_clock_sync ();
   trec_exp_repl_start (repl.id, repl._runs_len);
 
   if (ctx.task_id == IORE_MASTER_TASK)
     fprintf (stdout, "> Experiment replication #%d: \n", repl.id);
 
-  unsigned int i;
-  for (i = 0; i < repl._runs_len && !rerr; i++)
-    rerr = run_exec (repl.runs[i], repl.id);
+  if (repl.co_schedule != IORE_COSCHED_NONE)
+    rerr = run_cosched_exec (repl.runs, repl._runs_len, repl.id,
+			     repl.co_schedule == IORE_COSCHED_INTERFERENCE);
+  else
+    {
+      unsigned int i;
+      for (i = 0; i < repl._runs_len && !rerr; i++)
+	rerr = run_exec (repl.runs[i], repl.id);
+    }
 
   iore_trec_exp_repl_t *trec_exp_repl = trec_exp_repl_stop ();
   exp_repl_show_summary (trec_exp_repl);
@@ -178,8 +248,12 @@ exp_show_summary (iore_trec_exp_t *trec_exp)
 		  ctx.comm);
 
       if (ctx.task_id == IORE_MASTER_TASK)
-	fprintf (stdout, "Experiment executed in %.5f seconds.\n",
-		 (max_time - min_time));
+	{
+	  fprintf (stdout, "Experiment executed in %.5f seconds.\n",
+		   (max_time - min_time));
+	  fprintf (stdout, "Task clocks synchronized within %.3f us.\n",
+		   trec_exp->clock_error * 1e6);
+	}
     }
 } /* exp_show_summary () */
 
@@ -204,7 +278,8 @@ exp_repl_show_summary (iore_trec_exp_repl_t *trec_exp_repl)
 		  ctx.comm);
 
       if (ctx.task_id == IORE_MASTER_TASK)
-	fprintf (stdout, "Replication executed in %.5f seconds.\n\n",
-		 (max_time - min_time));
+	fprintf (stdout, "Replication executed in %.5f seconds, with task "
+		 "clocks synchronized within %.3f us.\n\n",
+		 (max_time - min_time), trec_exp_repl->clock_error * 1e6);
     }
 } /* exp_repl_show_summary () */
@@ -15,6 +15,8 @@
 
 const char *exp_run_order_lbl[IORE_RORDER_LENGTH] =
   { "fixed", "random" };
+const char *exp_co_schedule_lbl[IORE_COSCHED_LENGTH] =
+  { "none", "concurrent", "interference" };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -27,16 +29,24 @@ exp2str (const iore_exp_t *exp)
     {
       char *runs = runs2str (exp->runs, exp->_runs_len);
       char *stex = stex2str (&exp->stex);
+      char *lmet = lmet2str (&exp->lmet);
+      char *clock = trecclock2str (&exp->clock);
+      char *reqs = trecreqs2str (&exp->reqs);
 
       int len = snprintf(str, 0, EXP2STR_FORMAT, exp, exp->num_replications,
 	  runs, exp->_runs_len,
-	  exp_run_order_lbl[exp->run_order], stex) + 1;
+	  exp_run_order_lbl[exp->run_order],
+	  exp_co_schedule_lbl[exp->co_schedule], stex, lmet, clock, reqs,
+	  (exp->plan ? "true" : "false"), exp->plan_stripe_size) + 1;
       if (len > 0)
 	{
 	  str = malloc (len);
 	  assert(str);
 	  snprintf(str, len, EXP2STR_FORMAT, exp, exp->num_replications, runs,
-		   exp->_runs_len, exp_run_order_lbl[exp->run_order], stex);
+		   exp->_runs_len, exp_run_order_lbl[exp->run_order],
+		   exp_co_schedule_lbl[exp->co_schedule], stex, lmet, clock,
+		   reqs, (exp->plan ? "true" : "false"),
+		   exp->plan_stripe_size);
 	}
     }
 
@@ -53,13 +63,13 @@ exprepl2str (const iore_exp_repl_t *repl)
       char *runs = runs2str (*repl->runs, repl->_runs_len);
 
       int len = snprintf(str, 0, EXPREPL2STR_FORMAT, repl, repl->id, runs,
-	  repl->_runs_len) + 1;
+	  repl->_runs_len, exp_co_schedule_lbl[repl->co_schedule]) + 1;
       if (len > 0)
 	{
 	  str = malloc (len);
 	  assert(str);
 	  snprintf(str, len, EXPREPL2STR_FORMAT, repl, repl->id, runs,
-		   repl->_runs_len);
+		   repl->_runs_len, exp_co_schedule_lbl[repl->co_schedule]);
 	}
     }
 
@@ -4,13 +4,22 @@
  * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
  */
 
+#include <limits.h>
+#include <string.h>
+
 #include "iore_experiment_valid.h"
 #include "iore_run_valid.h"
 #include "iore_stex_valid.h"
+#include "iore_lmet_valid.h"
 #include "iore_valid.h"
 #include "iore_error.h"
 #include "iore_ctx.h"
 
+/*** PROTOTYPES **************************************************************/
+
+static int
+exp_valid_cosched (iore_exp_t *);
+
 /*** FUNCTIONS ***************************************************************/
 
 int
@@ -30,6 +39,12 @@ exp_valid (iore_exp_t *exp)
       rerr = IORE_FAILURE;
     }
 
+  if (exp->co_schedule >= IORE_COSCHED_LENGTH)
+    {
+      iore_errorf(VALID_MSG_INVALID_OPTION, "co-schedule");
+      rerr = IORE_FAILURE;
+    }
+
   if (exp->_runs_len == 0 || exp->runs == NULL)
     {
       iore_errorf(VALID_MSG_ONE_REQUIRED, "run definition");
@@ -40,10 +55,86 @@ exp_valid (iore_exp_t *exp)
       unsigned int i;
       for (i = 0; i < exp->_runs_len; i++)
 	rerr |= run_valid (&exp->runs[i]);
+      if (exp->co_schedule != IORE_COSCHED_NONE
+	  && exp->co_schedule < IORE_COSCHED_LENGTH)
+	rerr |= exp_valid_cosched (exp);
+    }
+
+  if (exp->clock.timer >= IORE_TREC_TIMER_LENGTH)
+    {
+      iore_errorf(VALID_MSG_INVALID_OPTION, "clock timer");
+      rerr = IORE_FAILURE;
+    }
+
+  if (exp->clock.sync_rounds == 0)
+    {
+      iore_errorf(VALID_MSG_GREATER_ZERO, "clock sync rounds");
+      rerr = IORE_FAILURE;
+    }
+
+  if (exp->reqs.ring_len > 0
+      && (exp->reqs.dir == NULL || strlen (exp->reqs.dir) == 0))
+    {
+      iore_error("Validation: Empty request capture directory.");
+      rerr = IORE_FAILURE;
+    }
+  /* rings are flushed with int counts of records */
+  if (exp->reqs.ring_len > INT_MAX)
+    {
+      iore_errorf("Validation: Request capture ring length greater than %d.",
+		  INT_MAX);
+      rerr = IORE_FAILURE;
     }
 
   rerr |= stex_valid (&exp->stex);
+  rerr |= lmet_valid (&exp->lmet);
 
   return rerr;
 } /* exp_valid () */
 
+
+/**
+ * Co-scheduled runs execute at once on disjoint groups of tasks, so their
+ * tasks must fit in the available processes, and they must not share
+ * files.
+ */
+static int
+exp_valid_cosched (iore_exp_t *exp)
+{
+  int rerr = IORE_SUCCESS;
+
+  unsigned int num_tasks = 0;
+  unsigned int i, j;
+  for (i = 0; i < exp->_runs_len; i++)
+    {
+      num_tasks += exp->runs[i].test.wkld.num_tasks;
+      for (j = 0; j < i; j++)
+	if (exp->runs[i].test.file_name && exp->runs[j].test.file_name
+	    && strcmp (exp->runs[i].test.file_name,
+		       exp->runs[j].test.file_name) == 0)
+	  {
+	    iore_errorf("Validation: Co-scheduled runs #%u and #%u share the "
+			"file name '%s'.",
+			exp->runs[j].id, exp->runs[i].id,
+			exp->runs[i].test.file_name);
+	    rerr = IORE_FAILURE;
+	  }
+    }
+
+  if (num_tasks > (unsigned int) ctx.num_procs)
+    {
+      iore_errorf("Validation: Co-scheduled runs take '%u' tasks, more than "
+		  "the available number of processes '%d'.",
+		  num_tasks, ctx.num_procs);
+      rerr = IORE_FAILURE;
+    }
+
+  if (exp->stex.stream)
+    {
+      iore_error("Validation: Co-scheduled runs do not support streamed "
+		 "export.");
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* exp_valid_cosched () */
@@ -6,27 +6,77 @@
 
 #include <mpi.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
 #include <assert.h>
 
 #include "iore_run.h"
 #include "iore_test.h"
 #include "iore_error.h"
 #include "iore_trec.h"
+#include "iore_stex.h"
 #include "iore_ctx.h"
 
+/*** DEFINES *****************************************************************/
+
+#define RUN_COSCHED_TAG 1
+#define RUN_COSCHED_OUT_TAG 2
+
+/*** TYPES *******************************************************************/
+
+/**
+ * Bandwidth of each test over the repetitions of a run, from which its
+ * confidence interval is taken.
+ */
+typedef struct run_bw
+{
+  double *bw[IORE_TEST_TYPE_LENGTH];
+  unsigned int len[IORE_TEST_TYPE_LENGTH];
+  double ci[IORE_TEST_TYPE_LENGTH]; /* relative half-width, NAN if unknown */
+  double solo[IORE_TEST_TYPE_LENGTH]; /* mean alone, NAN if unknown */
+} run_bw_t;
+
 /*** PROTOTYPES **************************************************************/
 
+static unsigned int
+run_max_repts (iore_run_t *);
+static void
+run_bw_init (run_bw_t *, unsigned int);
+static void
+run_bw_reset (run_bw_t *);
+static void
+run_bw_free (run_bw_t *);
 static int
 run_prep (iore_run_t *);
 static int
 run_post ();
 static int
-run_rept_exec (iore_run_t *, unsigned int, unsigned int);
+run_repts_exec (iore_run_t *, unsigned int, run_bw_t *);
+static int
+run_cosched_comm (iore_run_t **, unsigned int, MPI_Comm *, int *);
+static int
+run_cosched_group_exec (iore_run_t *, unsigned int, MPI_Comm, run_bw_t *,
+			iore_trec_run_t **, char **, size_t *);
+static void
+run_cosched_share (iore_trec_run_t *, int);
+static void
+run_cosched_show (const char *, size_t, int);
+static int
+run_rept_exec (iore_run_t *, unsigned int, unsigned int, run_bw_t *);
+static void
+run_rept_ci (iore_run_t *, iore_trec_run_rept_t *, run_bw_t *);
+static bool
+run_ci_reached (iore_run_t *, const run_bw_t *);
 
 static void
 run_show_summary (iore_trec_run_t *);
 static void
+run_show_ci (iore_run_t *, const run_bw_t *);
+static void
 run_rept_show_summary (iore_trec_run_rept_t *);
+static void
+run_cosched_show_summary (iore_run_t **, iore_trec_run_t **, unsigned int);
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -37,6 +87,9 @@ run_init (iore_run_t *this)
 
   this->id = 1;
   this->num_repetitions = 1;
+  this->max_repetitions = 0;
+  this->ci_target = 0;
+  this->ci_level = 0.95;
 
   test_init (&this->test);
 
@@ -57,25 +110,223 @@ run_exec (iore_run_t *this, unsigned int rpl_id)
 
   int rerr = IORE_SUCCESS;
 
-  trec_run_start (this->id, this->num_repetitions);
+  unsigned int max_repts = run_max_repts (this);
+  trec_run_start (this->id, max_repts);
+
+  run_bw_t bw;
+  run_bw_init (&bw, max_repts);
 
   rerr = run_prep (this);
   if (!rerr && ctx.comm != MPI_COMM_NULL)
-    {
-      unsigned int i;
-      for (i = 1; i <= this->num_repetitions && !rerr; i++)
-	rerr = run_rept_exec (this, rpl_id, i);
-    }
+    rerr = run_repts_exec (this, rpl_id, &bw);
   rerr = run_post ();
 
+  run_bw_free (&bw);
+
   iore_trec_run_t *trec_run = trec_run_stop ();
   run_show_summary (trec_run);
 
+  /* streamed records are no longer needed */
+  if (stex_stream_active ())
+    trec_run_release (trec_run);
+
   MPI_Barrier (ctx.comm);
 
   return rerr;
 } /* run_exec () */
 
+/**
+ * Executes 'runs' at once, each on its own group of tasks, see
+ * run_cosched_comm (). Groups start together, after a barrier of all
+ * tasks, and do no collective out of the group until all of them are
+ * done. If 'solo' is set, each run is first executed alone on its group,
+ * and every test repetition of the runs executed at once records the
+ * fraction of the mean bandwidth of the test alone that was lost, as
+ * interference. Runs are recorded apart, as if executed one after
+ * another; test records of the runs out of the master task are sent to
+ * it, for the reports. The summaries of each group are buffered at its
+ * first task and shown by the master task in run order, so that groups do
+ * not interleave them. Collective.
+ */
+int
+run_cosched_exec (iore_run_t **runs, unsigned int runs_len,
+		  unsigned int rpl_id, bool solo)
+{
+  assert(runs);
+
+  int rerr = IORE_SUCCESS;
+
+  MPI_Comm comm;
+  int *first_task = malloc (runs_len * sizeof(int));
+  assert(first_task);
+  int i_mine = run_cosched_comm (runs, runs_len, &comm, first_task);
+
+  run_bw_t *bw = malloc (runs_len * sizeof(run_bw_t));
+  assert(bw);
+  iore_trec_run_t **trec_runs = malloc (runs_len * sizeof(iore_trec_run_t *));
+  assert(trec_runs);
+  char **outs = calloc (runs_len, sizeof(char *));
+  assert(outs);
+  size_t *out_lens = calloc (runs_len, sizeof(size_t));
+  assert(out_lens);
+  unsigned int i;
+  for (i = 0; i < runs_len; i++)
+    run_bw_init (&bw[i], run_max_repts (runs[i]));
+
+  /* solo runs, one group at a time, released once their bandwidth is kept */
+  for (i = 0; i < runs_len && solo && !rerr; i++)
+    {
+      if (ctx.task_id == IORE_MASTER_TASK)
+	fprintf (stdout, ">> Run #%d alone, on tasks %d to %d:\n\n",
+		 runs[i]->id, first_task[i],
+		 first_task[i] + runs[i]->test.wkld.num_tasks - 1);
+      MPI_Barrier (MPI_COMM_WORLD);
+
+      rerr = run_cosched_group_exec (
+	  runs[i], rpl_id, ((int) i == i_mine ? comm : MPI_COMM_NULL), &bw[i],
+	  &trec_runs[i], &outs[i], &out_lens[i]);
+      trec_run_release (trec_runs[i]);
+      run_bw_reset (&bw[i]);
+      MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN,
+		     MPI_COMM_WORLD);
+
+      run_cosched_show (outs[i], out_lens[i], first_task[i]);
+      free (outs[i]);
+      outs[i] = NULL;
+      out_lens[i] = 0;
+    }
+
+  if (!rerr && ctx.task_id == IORE_MASTER_TASK)
+    fprintf (stdout, ">> Runs at once, from a shared start:\n\n");
+
+  /* tasks out of a run keep empty records of the same shape */
+  for (i = 0; i < runs_len && !rerr; i++)
+    if ((int) i != i_mine)
+      rerr = run_cosched_group_exec (runs[i], rpl_id, MPI_COMM_NULL, &bw[i],
+				     &trec_runs[i], &outs[i], &out_lens[i]);
+  if (!rerr)
+    {
+      MPI_Barrier (MPI_COMM_WORLD);
+      if (i_mine >= 0)
+	rerr = run_cosched_group_exec (runs[i_mine], rpl_id, comm,
+				       &bw[i_mine], &trec_runs[i_mine],
+				       &outs[i_mine], &out_lens[i_mine]);
+      MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN,
+		     MPI_COMM_WORLD);
+
+      for (i = 0; i < runs_len; i++)
+	{
+	  run_cosched_show (outs[i], out_lens[i], first_task[i]);
+	  run_cosched_share (trec_runs[i], first_task[i]);
+	}
+      if (solo)
+	run_cosched_show_summary (runs, trec_runs, runs_len);
+    }
+
+  for (i = 0; i < runs_len; i++)
+    {
+      run_bw_free (&bw[i]);
+      free (outs[i]);
+    }
+  free (out_lens);
+  free (outs);
+  free (trec_runs);
+  free (bw);
+  free (first_task);
+  if (comm != MPI_COMM_NULL)
+    MPI_Comm_free (&comm);
+
+  MPI_Barrier (MPI_COMM_WORLD);
+
+  return rerr;
+} /* run_cosched_exec () */
+
+/**
+ * Reports the access pattern of the run, see test_plan ().
+ */
+int
+run_plan (iore_run_t *this, size_t stripe_size)
+{
+  assert(this);
+
+  int rerr = run_prep (this);
+  if (!rerr && ctx.comm != MPI_COMM_NULL)
+    {
+      if (ctx.task_id == IORE_MASTER_TASK)
+	fprintf (stdout, ">> Run #%d plan: %u tasks, %s file mode, %s "
+		 "workload\n",
+		 this->id, this->test.wkld.num_tasks,
+		 test_file_mode_lbl[this->test.file_mode],
+		 wkld_type_lbl[this->test.wkld.type]);
+      rerr = test_plan (&this->test, stripe_size);
+      if (ctx.task_id == IORE_MASTER_TASK)
+	fputc ('\n', stdout);
+    }
+  rerr |= run_post ();
+
+  MPI_Barrier (ctx.comm);
+
+  return rerr;
+} /* run_plan () */
+
+/**
+ * Returns the number of repetitions a run may take; adaptive runs stop
+ * between the minimum and maximum repetitions.
+ */
+static unsigned int
+run_max_repts (iore_run_t *run)
+{
+  if (run->max_repetitions > run->num_repetitions)
+    return run->max_repetitions;
+
+  return run->num_repetitions;
+} /* run_max_repts () */
+
+static void
+run_bw_init (run_bw_t *bw, unsigned int max_repts)
+{
+  int i_test;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    {
+      bw->bw[i_test] = malloc (max_repts * sizeof(double));
+      assert(bw->bw[i_test]);
+      bw->len[i_test] = 0;
+      bw->ci[i_test] = NAN;
+      bw->solo[i_test] = NAN;
+    }
+} /* run_bw_init () */
+
+/**
+ * Keeps the mean bandwidth of each test so far as its bandwidth alone,
+ * and discards the bandwidth of the repetitions.
+ */
+static void
+run_bw_reset (run_bw_t *bw)
+{
+  int i_test;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    {
+      if (bw->len[i_test] > 0)
+	{
+	  double sum = 0;
+	  unsigned int i;
+	  for (i = 0; i < bw->len[i_test]; i++)
+	    sum += bw->bw[i_test][i];
+	  bw->solo[i_test] = sum / bw->len[i_test];
+	}
+      bw->len[i_test] = 0;
+      bw->ci[i_test] = NAN;
+    }
+} /* run_bw_reset () */
+
+static void
+run_bw_free (run_bw_t *bw)
+{
+  int i_test;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    free (bw->bw[i_test]);
+} /* run_bw_free () */
+
 static int
 run_prep (iore_run_t *run)
 {
@@ -106,6 +357,7 @@ run_prep (iore_run_t *run)
 static int
 run_post ()
 {
+  ctx_node_map_free ();
   if (ctx.comm != MPI_COMM_NULL)
     MPI_Comm_free (&ctx.comm);
   ctx.comm = MPI_COMM_WORLD;
@@ -113,8 +365,183 @@ run_post ()
   return IORE_SUCCESS;
 } /* run_post () */
 
+/**
+ * Executes the repetitions of 'run' on the tasks of ctx.comm, adding the
+ * bandwidth of its tests to 'bw'.
+ */
 static int
-run_rept_exec (iore_run_t *run, unsigned int rpl_id, unsigned int rpt_id)
+run_repts_exec (iore_run_t *run, unsigned int rpl_id, run_bw_t *bw)
+{
+  int rerr = IORE_SUCCESS;
+
+  unsigned int max_repts = run_max_repts (run);
+  run->test._num_repetitions = max_repts;
+
+  unsigned int i;
+  for (i = 1; i <= max_repts && !rerr; i++)
+    {
+      if (stex_stream_done (rpl_id, run->id, i))
+	{
+	  if (ctx.task_id == IORE_MASTER_TASK)
+	    fprintf (ctx.out, ">> Run #%d, repetition #%d: already "
+		     "exported, skipped.\n\n",
+		     run->id, i);
+	  continue;
+	}
+      rerr = run_rept_exec (run, rpl_id, i, bw);
+      if (i >= run->num_repetitions && run_ci_reached (run, bw))
+	break;
+    }
+
+  if (run->max_repetitions > 0)
+    run_show_ci (run, bw);
+
+  return rerr;
+} /* run_repts_exec () */
+
+/**
+ * Places co-scheduled runs on consecutive groups of tasks, in the order
+ * they are defined, into 'first_task', and splits the tasks into a
+ * communicator per group into 'comm', MPI_COMM_NULL for tasks out of all
+ * groups. Returns the index in 'runs' of the run of the task, or -1.
+ * Collective.
+ */
+static int
+run_cosched_comm (iore_run_t **runs, unsigned int runs_len, MPI_Comm *comm,
+		  int *first_task)
+{
+  int i_mine = -1;
+  unsigned int i, j;
+  for (i = 0; i < runs_len; i++)
+    {
+      first_task[i] = 0;
+      for (j = 0; j < runs_len; j++)
+	if (runs[j]->id < runs[i]->id)
+	  first_task[i] += runs[j]->test.wkld.num_tasks;
+      if (ctx.task_id >= first_task[i]
+	  && ctx.task_id
+	      < first_task[i] + (int) runs[i]->test.wkld.num_tasks)
+	i_mine = i;
+    }
+
+  MPI_Comm_split (MPI_COMM_WORLD, (i_mine >= 0 ? i_mine : MPI_UNDEFINED),
+		  ctx.task_id, comm);
+
+  return i_mine;
+} /* run_cosched_comm () */
+
+/**
+ * Executes 'run' on the tasks of 'comm', which take its place as ctx.comm,
+ * into a new run record, set into 'trec_run'. The summaries of the run
+ * are buffered into '*out', of '*out_len' bytes, at the first task of
+ * 'comm', and left NULL at other tasks. Tasks out of the run, with
+ * MPI_COMM_NULL, only get an empty record of the same shape.
+ */
+static int
+run_cosched_group_exec (iore_run_t *run, unsigned int rpl_id, MPI_Comm comm,
+			run_bw_t *bw, iore_trec_run_t **trec_run, char **out,
+			size_t *out_len)
+{
+  int rerr = IORE_SUCCESS;
+
+  *out = NULL;
+  *out_len = 0;
+  trec_run_start (run->id, run_max_repts (run));
+  if (comm == MPI_COMM_NULL)
+    {
+      *trec_run = trec_run_stop ();
+      return IORE_SUCCESS;
+    }
+
+  int task_id = ctx.task_id;
+  ctx.comm = comm;
+  MPI_Comm_rank (comm, &ctx.task_id);
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      ctx.out = open_memstream (out, out_len);
+      assert(ctx.out);
+    }
+
+  rerr = run_repts_exec (run, rpl_id, bw);
+  *trec_run = trec_run_stop ();
+  run_show_summary (*trec_run);
+
+  if (ctx.out != stdout)
+    {
+      fclose (ctx.out);
+      ctx.out = stdout;
+    }
+  ctx_node_map_free ();
+  ctx.comm = MPI_COMM_WORLD;
+  ctx.task_id = task_id;
+
+  return rerr;
+} /* run_cosched_group_exec () */
+
+/**
+ * Sends the test records of a run out of the master task, reduced at the
+ * first task of its group, to the master task, which keeps them as remote
+ * records, for the test and statistics reports. Collective.
+ */
+static void
+run_cosched_share (iore_trec_run_t *trec_run, int first_task)
+{
+  if (first_task == IORE_MASTER_TASK)
+    return;
+
+  int len = trec_run->num_run_rept * sizeof(iore_trec_run_rept_t);
+  if (ctx.task_id == first_task)
+    MPI_Send (trec_run->run_rept, len, MPI_BYTE, IORE_MASTER_TASK,
+	      RUN_COSCHED_TAG, MPI_COMM_WORLD);
+  else if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      MPI_Recv (trec_run->run_rept, len, MPI_BYTE, first_task,
+		RUN_COSCHED_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+      unsigned int i_rept, i_test;
+      for (i_rept = 0; i_rept < trec_run->num_run_rept; i_rept++)
+	{
+	  iore_trec_test_t *test = trec_run->run_rept[i_rept].test;
+	  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+	    test[i_test].remote = test[i_test].committed;
+	}
+    }
+} /* run_cosched_share () */
+
+/**
+ * Shows the summaries of a run, buffered into 'out', of 'out_len' bytes, at
+ * the first task of its group, at the master task. Collective.
+ */
+static void
+run_cosched_show (const char *out, size_t out_len, int first_task)
+{
+  if (ctx.task_id == first_task && first_task != IORE_MASTER_TASK)
+    {
+      assert(out_len <= INT_MAX);
+      MPI_Send ((void *) out, out_len, MPI_CHAR, IORE_MASTER_TASK,
+		RUN_COSCHED_OUT_TAG, MPI_COMM_WORLD);
+    }
+  else if (ctx.task_id == IORE_MASTER_TASK && first_task != IORE_MASTER_TASK)
+    {
+      MPI_Status status;
+      int len;
+      MPI_Probe (first_task, RUN_COSCHED_OUT_TAG, MPI_COMM_WORLD, &status);
+      MPI_Get_count (&status, MPI_CHAR, &len);
+      char *buf = malloc (len + 1);
+      assert(buf);
+      MPI_Recv (buf, len, MPI_CHAR, first_task, RUN_COSCHED_OUT_TAG,
+		MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      fwrite (buf, 1, len, stdout);
+      free (buf);
+    }
+  else if (ctx.task_id == IORE_MASTER_TASK)
+    fwrite (out, 1, out_len, stdout);
+  fflush (stdout);
+} /* run_cosched_show () */
+
+static int
+run_rept_exec (iore_run_t *run, unsigned int rpl_id, unsigned int rpt_id,
+	       run_bw_t *bw)
 {
   int rerr = IORE_SUCCESS;
 
@@ -122,21 +549,118 @@ run_rept_exec (iore_run_t *run, unsigned int rpl_id, unsigned int rpt_id)
 
   if (ctx.task_id == IORE_MASTER_TASK)
     {
-      fprintf (stdout, ">> Run #%d, repetition #%d:\n", run->id, rpt_id);
-      fprintf (stdout, "%-5s %10s %10s %10s %10s %10s %15s\n", "test",
-	       "cr/op (s)", "wr/rd (s)", "close (s)", "rm (s)", "total (s)",
-	       "tput");
+      fprintf (ctx.out, ">> Run #%d, repetition #%d:\n", run->id, rpt_id);
+      fprintf (ctx.out, "%-5s %10s %10s %10s %10s %10s %10s %15s\n", "test",
+	       "cr/op (s)", "wr/rd (s)", "flush (s)", "close (s)", "rm (s)",
+	       "total (s)", "tput");
     }
   rerr = test_exec (&run->test, rpl_id, run->id, rpt_id);
 
   iore_trec_run_rept_t *trec_run_rept = trec_run_rept_stop ();
+  run_rept_ci (run, trec_run_rept, bw);
   run_rept_show_summary (trec_run_rept);
 
+  if (!rerr)
+    rerr = stex_stream_rept (rpl_id, run->id, trec_run_rept);
+  if (!rerr)
+    rerr = stex_timeline_rept (rpl_id, run->id, trec_run_rept,
+			       run->test.intra_test_barrier);
+  if (!rerr)
+    rerr = trec_reqs_flush (rpl_id, run->id, rpt_id);
+
   MPI_Barrier (ctx.comm);
 
   return rerr;
 } /* run_rept_exec () */
 
+/**
+ * Adds the bandwidth of the committed tests of a run repetition to 'bw'
+ * and records the confidence interval of the run bandwidth so far, and
+ * the interference, if the bandwidth of the run alone is known. Test
+ * records were reduced, so tasks agree on them.
+ */
+static void
+run_rept_ci (iore_run_t *run, iore_trec_run_rept_t *trec_run_rept,
+	     run_bw_t *bw)
+{
+  assert(trec_run_rept);
+
+  int i_test;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    {
+      iore_trec_test_t *trec_test = &trec_run_rept->test[i_test];
+      if (!trec_test->committed)
+	continue;
+
+      /* same bandwidth as in the test summary */
+      iore_time_t (*time)[IORE_TREC_EVENT_LENGTH] = trec_test->test_time;
+      iore_time_t remove = (time[IORE_TREC_ACTION_REMOVE][IORE_TREC_EVENT_STOP]
+	  - time[IORE_TREC_ACTION_REMOVE][IORE_TREC_EVENT_START]);
+      iore_time_t total = ((
+	  remove > 0 ?
+	      time[IORE_TREC_ACTION_REMOVE][IORE_TREC_EVENT_STOP] :
+	      time[IORE_TREC_ACTION_CLOSE][IORE_TREC_EVENT_STOP])
+	  - time[IORE_TREC_ACTION_CREATE_OPEN][IORE_TREC_EVENT_START]);
+
+      double test_bw = (total > 0 ? trec_test->test_data_size / total : 0);
+      bw->bw[i_test][bw->len[i_test]++] = test_bw;
+      bw->ci[i_test] = stex_ci (bw->bw[i_test], bw->len[i_test],
+				run->ci_level);
+
+      trec_test->bw_ci = bw->ci[i_test];
+      trec_test->bw_ci_level = run->ci_level;
+      trec_test->interference = (
+	  bw->solo[i_test] > 0 ? 1 - test_bw / bw->solo[i_test] : NAN);
+    }
+} /* run_rept_ci () */
+
+/**
+ * Tells whether the confidence interval of every test of an adaptive run
+ * is within the target.
+ */
+static bool
+run_ci_reached (iore_run_t *run, const run_bw_t *bw)
+{
+  if (run->max_repetitions == 0)
+    return false;
+
+  bool reached = false;
+  int i_test;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    {
+      if (bw->len[i_test] == 0)
+	continue;
+      if (!(bw->ci[i_test] <= run->ci_target)) /* NAN if unknown */
+	return false;
+      reached = true;
+    }
+
+  return reached;
+} /* run_ci_reached () */
+
+static void
+run_show_ci (iore_run_t *run, const run_bw_t *bw)
+{
+  if (ctx.task_id != IORE_MASTER_TASK)
+    return;
+
+  unsigned int num_repts = 0;
+  fprintf (ctx.out, "Run #%d bandwidth CI (%.0f%%):", run->id,
+	   run->ci_level * 100);
+  int i_test;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    {
+      if (bw->len[i_test] == 0)
+	continue;
+      fprintf (ctx.out, "%s %s +/-%.2f%%", (num_repts ? "," : ""),
+	       test_type_lbl[i_test], bw->ci[i_test] * 100);
+      if (bw->len[i_test] > num_repts)
+	num_repts = bw->len[i_test];
+    }
+  fprintf (ctx.out, ", after %u repetitions (target +/-%.2f%%).\n\n",
+	   num_repts, run->ci_target * 100);
+} /* run_show_ci () */
+
 static void
 run_show_summary (iore_trec_run_t *trec_run)
 {
@@ -158,7 +682,7 @@ run_show_summary (iore_trec_run_t *trec_run)
 		  ctx.comm);
 
       if (ctx.task_id == IORE_MASTER_TASK)
-	fprintf (stdout, "Run repetitions executed in %.5f seconds.\n\n",
+	fprintf (ctx.out, "Run repetitions executed in %.5f seconds.\n\n",
 		 (max_time - min_time));
     }
 } /* run_show_summary () */
@@ -184,7 +708,49 @@ run_rept_show_summary (iore_trec_run_rept_t *trec_run_rept)
 		  ctx.comm);
 
       if (ctx.task_id == IORE_MASTER_TASK)
-	fprintf (stdout, "\nRepetition executed in %.5f seconds.\n\n",
+	fprintf (ctx.out, "\nRepetition executed in %.5f seconds.\n\n",
 		 (max_time - min_time));
     }
 } /* run_rept_show_summary () */
+
+/**
+ * Shows the mean interference of each test of co-scheduled runs, from the
+ * test records at the master task.
+ */
+static void
+run_cosched_show_summary (iore_run_t **runs, iore_trec_run_t **trec_runs,
+			  unsigned int runs_len)
+{
+  if (ctx.task_id != IORE_MASTER_TASK)
+    return;
+
+  unsigned int i;
+  for (i = 0; i < runs_len; i++)
+    {
+      fprintf (stdout, "Run #%d interference:", runs[i]->id);
+
+      unsigned int num_tests = 0;
+      int i_test;
+      for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+	{
+	  double sum = 0;
+	  unsigned int len = 0, i_rept;
+	  for (i_rept = 0; i_rept < trec_runs[i]->num_run_rept; i_rept++)
+	    {
+	      const iore_trec_test_t *trec_test =
+		  &trec_runs[i]->run_rept[i_rept].test[i_test];
+	      if (trec_test->committed && !isnan (trec_test->interference))
+		{
+		  sum += trec_test->interference;
+		  len++;
+		}
+	    }
+	  if (len == 0)
+	    continue;
+	  fprintf (stdout, "%s %s %.2f%%", (num_tests++ ? "," : ""),
+		   test_type_lbl[i_test], sum / len * 100);
+	}
+      fprintf (stdout, "%s\n", (num_tests ? "." : " unknown."));
+    }
+  fputc ('\n', stdout);
+} /* run_cosched_show_summary () */
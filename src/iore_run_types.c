@@ -24,13 +24,14 @@ run2str (const iore_run_t *run)
       char *test = test2str (&run->test);
 
       int len = snprintf(str, 0, RUN2STR_FORMAT, run, run->id,
-	  run->num_repetitions, test) + 1;
+	  run->num_repetitions, run->max_repetitions, run->ci_target,
+	  run->ci_level, test) + 1;
       if (len > 0)
 	{
 	  str = malloc (len);
 	  assert(str);
 	  snprintf(str, len, RUN2STR_FORMAT, run, run->id, run->num_repetitions,
-		   test);
+		   run->max_repetitions, run->ci_target, run->ci_level, test);
 	}
     }
 
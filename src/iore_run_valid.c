@@ -25,6 +25,37 @@ run_valid (iore_run_t *run)
       rerr = IORE_FAILURE;
     }
 
+  if (run->max_repetitions > 0)
+    {
+      if (run->max_repetitions < run->num_repetitions)
+	{
+	  iore_errorf("Validation: Maximum number of repetitions lower than "
+		      "the minimum '%u'.",
+		      run->num_repetitions);
+	  rerr = IORE_FAILURE;
+	}
+
+      if (run->ci_target <= 0)
+	{
+	  iore_errorf(VALID_MSG_GREATER_ZERO, "confidence interval target");
+	  rerr = IORE_FAILURE;
+	}
+
+      /* files are removed at the last repetition, unknown beforehand */
+      if (run->test.file_reuse)
+	{
+	  iore_error("Validation: Adaptive repetitions do not support file "
+		     "reuse.");
+	  rerr = IORE_FAILURE;
+	}
+    }
+
+  if (run->ci_level <= 0 || run->ci_level >= 1)
+    {
+      iore_errorf(VALID_MSG_INVALID_VALUE, "confidence level");
+      rerr = IORE_FAILURE;
+    }
+
   if (run->id == 0)
     run->id = 1;
 
@@ -0,0 +1,168 @@
+/*
+ * iore_stex_conv.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <unistd.h>
+
+#include "iore_stex_columnar.h"
+#include "iore_stex_types.h"
+#include "iore_error.h"
+
+/*** DEFINES *****************************************************************/
+
+#define CONV_OPTS "his:o:"
+
+/*** PROTOTYPES **************************************************************/
+
+static void
+conv_show_info (const iore_stex_cols_t *);
+static void
+usage (char **);
+
+/*** MAIN ********************************************************************/
+
+/**
+ * Reads columnar report files written by the stats exporter, showing their
+ * index or converting them to CSV.
+ */
+int
+main (int argc, char **argv)
+{
+  bool info = false;
+  bool select = false;
+  unsigned int exp_repl_id = 0, run_id = 0, run_rept_id = 0;
+  const char *out_name = NULL;
+
+  opterr = 0;
+  int c;
+  while ((c = getopt (argc, argv, CONV_OPTS)) != -1)
+    {
+      switch (c)
+	{
+	case 'i':
+	  info = true;
+	  break;
+	case 's':
+	  if (sscanf (optarg, "%u.%u.%u", &exp_repl_id, &run_id, &run_rept_id)
+	      != 3)
+	    {
+	      fprintf (stderr, "Invalid repetition '%s'.\n", optarg);
+	      return EXIT_FAILURE;
+	    }
+	  select = true;
+	  break;
+	case 'o':
+	  out_name = optarg;
+	  break;
+	case 'h':
+	  usage (argv);
+	  break;
+	case '?':
+	default:
+	  if (isprint(optopt))
+	    fprintf (stderr, "Unknown option -%c.\n", optopt);
+	  usage (argv);
+	  break;
+	}
+    } /* end of option loop */
+
+  if (optind != argc - 1)
+    usage (argv);
+
+  iore_stex_cols_t cols;
+  if (stex_cols_read (argv[optind], &cols))
+    {
+      fprintf (stderr, "Unable to read columnar report file '%s'.\n",
+	       argv[optind]);
+      return EXIT_FAILURE;
+    }
+
+  int rerr = EXIT_SUCCESS;
+  if (info)
+    conv_show_info (&cols);
+  else
+    {
+      const iore_stex_col_entry_t *entry = NULL;
+      if (select)
+	{
+	  entry = stex_cols_find (&cols, exp_repl_id, run_id, run_rept_id);
+	  if (!entry)
+	    {
+	      fprintf (stderr, "No rows of repetition %u.%u.%u.\n",
+		       exp_repl_id, run_id, run_rept_id);
+	      rerr = EXIT_FAILURE;
+	    }
+	}
+
+      FILE *out = stdout;
+      if (!rerr && out_name)
+	{
+	  out = fopen (out_name, "w");
+	  if (!out)
+	    {
+	      fprintf (stderr, "Unable to open file '%s'.\n", out_name);
+	      rerr = EXIT_FAILURE;
+	    }
+	}
+
+      if (!rerr)
+	{
+	  stex_cols_to_csv (&cols, entry, out);
+	  if (out != stdout)
+	    fclose (out);
+	}
+    }
+
+  stex_cols_free (&cols);
+
+  return rerr;
+} /* main () */
+
+/*** FUNCTIONS ***************************************************************/
+
+static void
+conv_show_info (const iore_stex_cols_t *cols)
+{
+  fprintf (stdout, "report_type: %s\n",
+	   (cols->report_type < IORE_STEX_REPORT_LENGTH) ?
+	       stex_report_lbl[cols->report_type] : "unknown");
+  fprintf (stdout, "num_rows: %llu\n", (unsigned long long) cols->num_rows);
+
+  fprintf (stdout, "labels:\n");
+  uint32_t i;
+  for (i = 0; i < cols->num_labels; i++)
+    fprintf (stdout, "  %u: %s %s\n", i, cols->labels[i].test_lbl,
+	     cols->labels[i].action_lbl);
+
+  fprintf (stdout, "index (exp_repl_id.run_id.run_rept_id: rows):\n");
+  uint64_t j;
+  for (j = 0; j < cols->num_entries; j++)
+    {
+      const iore_stex_col_entry_t *entry = &cols->entries[j];
+      fprintf (stdout, "  %u.%u.%u: %llu-%llu\n", entry->exp_repl_id,
+	       entry->run_id, entry->run_rept_id,
+	       (unsigned long long) entry->first_row,
+	       (unsigned long long) (entry->first_row + entry->num_rows - 1));
+    }
+} /* conv_show_info () */
+
+static void
+usage (char **argv)
+{
+  fprintf (stderr, "usage: %s [OPTIONS] FILE\n\n", *argv);
+  fputs ("OPTIONS:\n", stderr);
+  fputs ("  -i         : shows the labels and index of FILE\n", stderr);
+  fputs ("  -s R.U.P   : converts only the rows of replication R, run U "
+	 "and repetition P\n", stderr);
+  fputs ("  -o OUTFILE : CSV output file, instead of the standard output\n",
+	 stderr);
+  fputs ("  -h         : displays this help message\n", stderr);
+  fflush (stderr);
+
+  exit (EXIT_FAILURE);
+} /* usage () */
@@ -4,6 +4,10 @@
  * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* fallocate */
+#endif
+
 #include <mpi.h>
 #include <string.h>
 #include <stdlib.h>
@@ -14,6 +18,9 @@
 #include <libgen.h>
 #include <sys/stat.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <time.h>
 
 #include "iore_test_types.h"
 #include "iore_workload.h"
@@ -28,6 +35,38 @@
 /*** DEFINES *****************************************************************/
 
 #define TEST_FILE_NAME_DFLT "./testfile.iore"
+#define TEST_BUF_ALIGNMENT TEST_DIRECT_ALIGNMENT
+#define TEST_DROP_CACHES_FILE "/proc/sys/vm/drop_caches"
+#define TEST_OVERHEAD_ITERS 100 /* samples of each overhead measurement */
+#define TEST_PLAN_HIST_BINS 64 /* request sizes binned by powers of two */
+
+/*** TYPES *******************************************************************/
+
+/**
+ * Byte range [start, end) of a file accessed by a test, where 'file'
+ * numbers the files across the tasks of the test.
+ */
+typedef struct test_plan_ext
+{
+  unsigned long long file;
+  unsigned long long start;
+  unsigned long long end;
+} test_plan_ext_t;
+
+/**
+ * Per-task counts of a test plan, see test_plan_type ().
+ */
+enum test_plan_count
+{
+  TEST_PLAN_REQS,
+  TEST_PLAN_BYTES,
+  TEST_PLAN_UNALIGNED, /* requests not starting at a stripe boundary */
+  TEST_PLAN_CROSSING, /* requests spanning more than one stripe */
+  TEST_PLAN_OVERLAPS,
+  TEST_PLAN_OVERLAP_BYTES,
+  TEST_PLAN_MEM, /* bytes allocated for the requests */
+  TEST_PLAN_LENGTH
+};
 
 /*** PROTOTYPES **************************************************************/
 
@@ -35,22 +74,37 @@ static int
 test_oset_exec (iore_test_t *, unsigned int, unsigned int, unsigned int);
 static int
 test_oset_type_prep (iore_test_t *, enum iore_test_type, unsigned int,
-		     unsigned int, unsigned int, iore_file_t *, char **,
+		     unsigned int, unsigned int, iore_file_t **, char **,
 		     off_t **);
 static int
-test_oset_type_post (iore_test_t *, iore_file_t *, char *, off_t *);
+test_oset_sizes_prep (iore_test_t *, int, const int *, unsigned int);
 static int
-test_oset_write_exec (iore_test_t *, iore_file_t, const char *, const off_t *);
+test_oset_type_post (iore_test_t *, enum iore_test_type, iore_file_t *, char *,
+		     off_t *);
+static size_t
+test_oset_file_share (const iore_test_t *, unsigned int, iore_test_t *);
 static int
-test_oset_read_exec (iore_test_t *, iore_file_t, char *, const off_t *);
+test_oset_write_exec (iore_test_t *, iore_file_t *, const char *,
+		      const off_t *);
+static int
+test_oset_read_exec (iore_test_t *, iore_file_t *, char *, const off_t *);
 
+static ssize_t
+test_trace_xfer (iore_test_t *, enum iore_test_type, iore_file_t *, char *,
+		 unsigned int *);
+static void
+test_trace_wait (const iore_wkld_trace_t *, const iore_wkld_trace_rec_t *,
+		 const struct timespec *);
+static size_t
+test_my_data_size (iore_test_t *);
 static int
 test_dset_exec (iore_test_t *, unsigned int, unsigned int, unsigned int);
 static int
 test_dset_type_prep (iore_test_t *, enum iore_test_type, unsigned int,
 		     unsigned int, unsigned int, iore_file_t *, char **);
 static int
-test_dset_type_post (iore_test_t *, iore_file_t *, char *);
+test_dset_type_post (iore_test_t *, enum iore_test_type, iore_file_t *,
+		     char *);
 static int
 test_dset_cart_type_prep (iore_wkld_dset_t *, int);
 static int
@@ -60,26 +114,80 @@ test_dset_write_exec (iore_test_t *, iore_file_t, const char *);
 static int
 test_dset_read_exec (iore_test_t *, iore_file_t, char *);
 
+static int
+test_read_task_id (iore_test_t *);
+
+static int
+test_cache_defeat (iore_test_t *, iore_file_t *, unsigned int);
+static int
+test_fadvise_dontneed (const iore_file_t *);
+static int
+test_mem_sweep (size_t, int);
+
+static int
+test_file_group_prep (iore_test_t *, int, int **, unsigned int *);
+static void
+test_file_group_post (iore_test_t *);
+static bool
+test_file_owner (iore_test_t *);
 static int
 test_file_prep (iore_test_t *, unsigned int, unsigned int, unsigned int, int,
-		iore_file_t *);
+		unsigned int, iore_file_t *);
 static int
-test_file_post (iore_test_t *, iore_file_t *);
+test_file_post (iore_test_t *, enum iore_test_type, iore_file_t *);
+static int
+test_afsb_prep (iore_test_t *, iore_file_t *);
+static int
+test_file_precreate (iore_test_t *, iore_file_t *, unsigned int, unsigned int);
+static int
+test_file_alloc (iore_test_t *, const char *, size_t);
+static size_t
+test_stripe_obj_size (const iore_file_stripes_t *, size_t, unsigned int);
+static size_t
+test_file_size (iore_test_t *);
 static int
 test_buf_prep (size_t, enum iore_test_type, char **);
 static int
-test_offs_prep (iore_test_t *, int, off_t **);
+test_offs_prep (iore_test_t *, int, const int *, unsigned int, off_t **);
 static int
-test_offs_nxn_prep (iore_wkld_t *, int, off_t *);
+test_offs_nxn_prep (iore_test_t *, int, off_t *);
 static int
-test_offs_nx1_seq_prep (iore_wkld_t *, int, int, off_t *);
+test_offs_nx1_seq_prep (iore_wkld_t *, int, int, const int *, unsigned int,
+			off_t *);
 static int
-test_offs_nx1_rnd_prep (iore_wkld_t *, int, int, off_t *);
+test_offs_nx1_rnd_prep (iore_wkld_t *, int, int, const int *, unsigned int,
+			off_t *);
 static int
 test_sizes_prep (iore_prng_dist_t *, unsigned int, size_t **);
 
 static void
-test_show_summary (iore_trec_test_t *);
+test_show_summary (iore_test_t *, iore_trec_test_t *);
+static void
+test_summary_reduce (iore_trec_test_t *, iore_time_t *, iore_time_t *,
+		     size_t *);
+static void
+test_show_overhead (iore_test_t *, iore_trec_test_t *);
+static size_t
+test_num_reqs (iore_test_t *);
+
+static int
+test_plan_type (iore_test_t *, enum iore_test_type, size_t);
+static int
+test_plan_oset_exts (iore_test_t *, int, test_plan_ext_t **, size_t *,
+		     size_t *);
+static int
+test_plan_trace_exts (iore_test_t *, enum iore_test_type, int,
+		      test_plan_ext_t **, size_t *, size_t *);
+static int
+test_plan_dset_exts (iore_test_t *, int, test_plan_ext_t **, size_t *,
+		     size_t *);
+static int
+test_plan_ext_cmp (const void *, const void *);
+static size_t
+test_plan_merge (test_plan_ext_t *, size_t, unsigned long long *);
+static void
+test_plan_show (enum iore_test_type, size_t, unsigned long long *,
+		const unsigned long long *, const test_plan_ext_t *, size_t);
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -92,7 +200,12 @@ test_init (iore_test_t *this)
   this->type.read = true;
   this->write_flush = false;
   this->write_flush_per_req = false;
+  this->write_flush_mode = IORE_TEST_FLUSH_FSYNC;
+  this->write_flush_window = 0;
+  this->read_reorder = IORE_TEST_RREORDER_TASK;
   this->read_reorder_offset = 0;
+  this->read_cache_defeat = IORE_TEST_CDEFEAT_NONE;
+  this->read_cache_defeat_mem_size = 0;
   this->intra_test_barrier = false;
   this->inter_test_delay_secs = 0;
   this->file_mode = IORE_TEST_FMODE_NX1;
@@ -101,7 +214,18 @@ test_init (iore_test_t *this)
   this->file_name_append_sequence_num = false;
   this->file_name_append_task_id = false;
   this->file_dir_per_task = false;
+  this->file_dir_hash = 0;
+  this->file_group_size = 0;
+  this->files_per_task = 1;
   this->file_keep = false;
+  this->file_prealloc = IORE_TEST_FPREALLOC_NONE;
+  this->file_reuse = false;
+  this->file_truncate = false;
+  this->_num_repetitions = 0;
+  this->_file_remove = true;
+  this->_file_group_id = 0;
+  this->_file_group_task_id = 0;
+  this->_file_comm = MPI_COMM_NULL;
 
   wkld_init (&this->wkld);
   afio_init (&this->afio);
@@ -135,7 +259,19 @@ test_exec (iore_test_t *this, unsigned int rpl_id, unsigned int run_id,
 
   int rerr = IORE_SUCCESS;
 
-  if (this->wkld.type == IORE_WKLD_OFFSET)
+  /* reused files are removed by the last repetition only */
+  this->_file_remove = !this->file_keep
+      && (!this->file_reuse || rpt_id >= this->_num_repetitions);
+
+  const iore_afio_vtable_t *afio = afio_pool[this->afio.type];
+  if (afio->prep && afio->prep (this))
+    {
+      iore_error("Failed preparing the AFIO.");
+      return IORE_FAILURE;
+    }
+
+  if (this->wkld.type == IORE_WKLD_OFFSET
+      || this->wkld.type == IORE_WKLD_TRACE)
     rerr = test_oset_exec (this, rpl_id, run_id, rpt_id);
   else if (this->wkld.type == IORE_WKLD_DATASET)
     rerr = test_dset_exec (this, rpl_id, run_id, rpt_id);
@@ -145,14 +281,43 @@ test_exec (iore_test_t *this, unsigned int rpl_id, unsigned int run_id,
       rerr = IORE_FAILURE;
     }
 
+  if (afio->post)
+    afio->post ();
+
   return rerr;
 } /* test_exec () */
 
+/**
+ * Reports the access pattern of the test without doing I/O, see
+ * test_plan_type (). The stripe size of the AFSB of the test, if set, takes
+ * precedence over 'stripe_size'.
+ */
+int
+test_plan (iore_test_t *this, size_t stripe_size)
+{
+  assert(this);
+
+  int rerr = IORE_SUCCESS;
+
+  const char *afsb_stripe_size = (
+      this->afsb ?
+	  dict_get (&this->afsb->params, AFSB_PARAM_STRIPE_SIZE) : NULL);
+  if (afsb_stripe_size)
+    stripe_size = strtosz (afsb_stripe_size);
+
+  if (this->type.write)
+    rerr = test_plan_type (this, IORE_TEST_TYPE_WRITE, stripe_size);
+  if (!rerr && this->type.read)
+    rerr = test_plan_type (this, IORE_TEST_TYPE_READ, stripe_size);
+
+  return rerr;
+} /* test_plan () */
+
 static int
 test_oset_exec (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
 		unsigned int rpt_id)
 {
-  iore_file_t file;
+  iore_file_t *files;
   char *buf;
   off_t *offs;
   iore_trec_test_t *trec_test;
@@ -160,16 +325,18 @@ test_oset_exec (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
   if (test->type.write)
     {
       if (test_oset_type_prep (test, IORE_TEST_TYPE_WRITE, rpl_id, run_id,
-			       rpt_id, &file, &buf, &offs))
+			       rpt_id, &files, &buf, &offs))
+	return IORE_FAILURE;
+      if (test_file_precreate (test, files, test->files_per_task, rpt_id))
 	return IORE_FAILURE;
-      if (test_oset_write_exec (test, file, buf, offs))
+      if (test_oset_write_exec (test, files, buf, offs))
 	return IORE_FAILURE;
       else
 	{
 	  trec_test = trec_test_commit ();
-	  test_show_summary (trec_test);
+	  test_show_summary (test, trec_test);
 	}
-      if (test_oset_type_post (test, &file, buf, offs))
+      if (test_oset_type_post (test, IORE_TEST_TYPE_WRITE, files, buf, offs))
 	return IORE_FAILURE;
 
       if (test->type.read)
@@ -179,16 +346,18 @@ test_oset_exec (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
   if (test->type.read)
     {
       if (test_oset_type_prep (test, IORE_TEST_TYPE_READ, rpl_id, run_id,
-			       rpt_id, &file, &buf, &offs))
+			       rpt_id, &files, &buf, &offs))
 	return IORE_FAILURE;
-      if (test_oset_read_exec (test, file, buf, offs))
+      if (test_cache_defeat (test, files, test->files_per_task))
+	return IORE_FAILURE;
+      if (test_oset_read_exec (test, files, buf, offs))
 	return IORE_FAILURE;
       else
 	{
 	  trec_test = trec_test_commit ();
-	  test_show_summary (trec_test);
+	  test_show_summary (test, trec_test);
 	}
-      if (test_oset_type_post (test, &file, buf, offs))
+      if (test_oset_type_post (test, IORE_TEST_TYPE_READ, files, buf, offs))
 	return IORE_FAILURE;
     }
 
@@ -198,20 +367,83 @@ test_oset_exec (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
 static int
 test_oset_type_prep (iore_test_t *test, enum iore_test_type type,
 		     unsigned int rpl_id, unsigned int run_id,
-		     unsigned int rpt_id, iore_file_t *file, char **buf,
+		     unsigned int rpt_id, iore_file_t **files, char **buf,
 		     off_t **offs)
 {
   /* in read tests, tasks can perform as a different 'id' */
   int task_id =
       (type == IORE_TEST_TYPE_WRITE) ?
-	  (unsigned int) ctx.task_id :
-	  (ctx.task_id + test->read_reorder_offset) % test->wkld.num_tasks;
+	  ctx.task_id : test_read_task_id (test);
 
-  /* prepares the file */
-  if (test_file_prep (test, rpl_id, run_id, rpt_id, task_id, file))
-    return IORE_FAILURE;
+  /* identifies the tasks sharing the file */
+  int *members;
+  unsigned int num_members;
+  test_file_group_prep (test, task_id, &members, &num_members);
+
+  /* prepares the files */
+  *files = malloc (test->files_per_task * sizeof(iore_file_t));
+  assert(*files);
+  int rerr = IORE_SUCCESS;
+  unsigned int i;
+  for (i = 0; i < test->files_per_task && !rerr; i++)
+    rerr = test_file_prep (test, rpl_id, run_id, rpt_id, task_id, i,
+			   &(*files)[i]);
+
+  /* lays the files out on the storage backend */
+  for (i = 0; i < test->files_per_task && !rerr; i++)
+    rerr = test_afsb_prep (test, &(*files)[i]);
+
+  /* traces carry the sizes and offsets of their requests */
+  if (test->wkld.type == IORE_WKLD_TRACE)
+    {
+      *offs = NULL;
+      if (!rerr)
+	rerr = wkld_trace_map (&test->wkld.u.trace, task_id, type,
+			       test->files_per_task);
+
+      /* each task checks its own records, but all stop on invalid ones */
+      MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN, ctx.comm);
 
-  // TODO: invoke AFSB
+      if (!rerr)
+	{
+	  /* time stamps are replayed relative to the earliest of all ranks */
+	  MPI_Allreduce (MPI_IN_PLACE, &test->wkld.u.trace._first_time, 1,
+			 MPI_UINT64_T, MPI_MIN, ctx.comm);
+	  rerr = test_buf_prep (test->wkld.u.trace.my_req_size, type, buf);
+	}
+      if (rerr)
+	wkld_trace_unmap (&test->wkld.u.trace);
+    }
+  else if (!rerr)
+    {
+      /* sets the sizes of requests and data */
+      rerr = test_oset_sizes_prep (test, task_id, members, num_members);
+
+      /* prepares the buffer */
+      if (!rerr)
+	rerr = test_buf_prep (test->wkld.u.oset.my_req_size, type, buf);
+
+      /* prepares the list of offsets */
+      if (!rerr)
+	rerr = test_offs_prep (test, task_id, members, num_members, offs);
+    }
+
+  free (members);
+  if (rerr)
+    test_file_group_post (test);
+
+  return rerr;
+} /* test_oset_type_prep () */
+
+/**
+ * Generates the data and request sizes of the tasks, if drawn from
+ * distributions, and sets those of 'task_id' and the size of its file.
+ */
+static int
+test_oset_sizes_prep (iore_test_t *test, int task_id, const int *members,
+		      unsigned int num_members)
+{
+  unsigned int i;
 
   /* checks/generates data sizes */
   if (test->wkld.u.oset._data_sizes_len == 0)
@@ -252,61 +484,95 @@ test_oset_type_prep (iore_test_t *test, enum iore_test_type type,
       % test->wkld.u.oset._req_sizes_len];
   if (test->file_mode == IORE_TEST_FMODE_NXN)
     test->wkld.u.oset._file_size = test->wkld.u.oset.my_data_size;
-  else if (test->file_mode == IORE_TEST_FMODE_NX1)
+  else if (test->file_mode == IORE_TEST_FMODE_NX1
+      || test->file_mode == IORE_TEST_FMODE_NXM)
     {
       size_t file_size = 0;
       size_t *data_sizes = test->wkld.u.oset.data_sizes;
-      unsigned int num_tasks = test->wkld.num_tasks;
-      unsigned int i;
-      for (i = 0; i < num_tasks; i++)
-	file_size += data_sizes[i % test->wkld.u.oset._data_sizes_len];
+      for (i = 0; i < num_members; i++)
+	file_size += data_sizes[members[i] % test->wkld.u.oset._data_sizes_len];
       test->wkld.u.oset._file_size = file_size;
     }
   else
     test->wkld.u.oset._file_size = 0;
 
-  /* prepares the buffer */
-  if (test_buf_prep (test->wkld.u.oset.my_req_size, type, buf))
-    return IORE_FAILURE;
-
-  /* prepares the list of offsets */
-  if (test_offs_prep (test, task_id, offs))
-    return IORE_FAILURE;
-
   return IORE_SUCCESS;
-} /* test_oset_type_prep () */
+} /* test_oset_sizes_prep () */
 
 static int
-test_oset_type_post (iore_test_t *test, iore_file_t *file, char *buf,
-		     off_t *offs)
+test_oset_type_post (iore_test_t *test, enum iore_test_type type,
+		     iore_file_t *files, char *buf, off_t *offs)
 {
   int rerr = IORE_SUCCESS;
 
-  rerr = test_file_post (test, file);
+  unsigned int i;
+  for (i = 0; i < test->files_per_task; i++)
+    rerr |= test_file_post (test, type, &files[i]);
+  test_file_group_post (test);
+  if (test->wkld.type == IORE_WKLD_TRACE)
+    wkld_trace_unmap (&test->wkld.u.trace);
+  free (files);
   free (buf);
   free (offs);
 
   return rerr;
 } /* test_oset_type_post () */
 
+/**
+ * Narrows the test to the 'file_id'-th file of the running task, returning
+ * the index of its first request. Requests are split in contiguous blocks
+ * among the files of the task.
+ */
+static size_t
+test_oset_file_share (const iore_test_t *test, unsigned int file_id,
+		      iore_test_t *share)
+{
+  *share = *test;
+  if (test->files_per_task <= 1)
+    return 0;
+
+  iore_wkld_oset_t *oset = &share->wkld.u.oset;
+  size_t num_reqs = (oset->my_data_size + oset->my_req_size - 1)
+      / oset->my_req_size;
+  size_t file_reqs = (num_reqs + test->files_per_task - 1)
+      / test->files_per_task;
+  size_t first_req = file_id * file_reqs;
+  size_t first_byte = first_req * oset->my_req_size;
+  size_t size = 0;
+  if (first_byte < oset->my_data_size)
+    {
+      size = oset->my_data_size - first_byte;
+      if (size > file_reqs * oset->my_req_size)
+	size = file_reqs * oset->my_req_size;
+    }
+  oset->my_data_size = size;
+  oset->_file_size = size;
+
+  return first_req;
+} /* test_oset_file_share () */
+
 static int
-test_oset_write_exec (iore_test_t *test, iore_file_t file, const char *buf,
+test_oset_write_exec (iore_test_t *test, iore_file_t *files, const char *buf,
 		      const off_t *offs)
 {
   int rerr = IORE_SUCCESS;
 
   const iore_afio_vtable_t *afio = afio_pool[test->afio.type];
   bool intra_test_barrier = test->intra_test_barrier;
+  unsigned int num_files = test->files_per_task;
   ssize_t nbytes = 0;
+  iore_test_t share;
+  unsigned int i;
 
   MPI_Barrier (ctx.comm);
 
   /* creates */
   trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_CREATE_OPEN);
-  rerr = afio->create (&file, test);
+  for (i = 0; i < num_files && !rerr; i++)
+    rerr = afio->create (&files[i], test);
   trec_test_stop (0);
   if (rerr)
-    iore_fatalf("Failed creating file '%s'", file.name);
+    iore_fatalf("Failed creating file '%s'", files[i - 1].name);
   else
     {
       if (intra_test_barrier)
@@ -314,39 +580,61 @@ test_oset_write_exec (iore_test_t *test, iore_file_t file, const char *buf,
 
       /* writes */
       trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_WRITE_READ);
-      nbytes = afio->write_oset (file, buf, offs, test);
+      if (test->wkld.type == IORE_WKLD_TRACE)
+	nbytes = test_trace_xfer (test, IORE_TEST_TYPE_WRITE, files,
+				  (char *) buf, &i);
+      else
+	for (i = 0; i < num_files && nbytes >= 0; i++)
+	  {
+	    size_t first_req = test_oset_file_share (test, i, &share);
+	    trec_req_file (i);
+	    ssize_t xferd = afio->write_oset (files[i], buf, offs + first_req,
+					      &share);
+	    nbytes = (xferd < 0) ? -1 : (nbytes + xferd);
+	  }
       trec_test_stop (nbytes);
       rerr = (nbytes < 0)
-	  || (((unsigned int) nbytes) != test->wkld.u.oset.my_data_size);
+	  || (((unsigned int) nbytes) != test_my_data_size (test));
       if (rerr)
-	iore_fatalf("Failed writing to file '%s'", file.name);
+	iore_fatalf("Failed writing to file '%s'", files[i - 1].name);
       else
 	{
 	  if (intra_test_barrier)
 	    MPI_Barrier (ctx.comm);
 
+	  /* flushes */
+	  if (test->write_flush)
+	    {
+	      trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_FLUSH);
+	      for (i = 0; i < num_files && !rerr; i++)
+		rerr = afio->flush (files[i], test);
+	      trec_test_stop (0);
+	      if (rerr)
+		iore_fatalf("Failed flushing file '%s'", files[i - 1].name);
+
+	      if (intra_test_barrier)
+		MPI_Barrier (ctx.comm);
+	    }
+
 	  /* closes */
 	  trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_CLOSE);
-	  rerr = afio->close (&file);
+	  for (i = 0; i < num_files && !rerr; i++)
+	    rerr = afio->close (&files[i]);
 	  trec_test_stop (0);
 	  if (rerr)
-	    iore_fatalf("Failed closing file '%s'", file.name);
+	    iore_fatalf("Failed closing file '%s'", files[i - 1].name);
 	  else
 	    {
-	      if (!test->type.read && !test->file_keep)
+	      if (!test->type.read && test->_file_remove)
 		{
 		  MPI_Barrier (ctx.comm);
 
 		  trec_test_start (IORE_TEST_TYPE_WRITE,
 				   IORE_TREC_ACTION_REMOVE);
 		  /* removes */
-		  if ((test->file_mode == IORE_TEST_FMODE_NXN)
-		      || ((test->file_mode == IORE_TEST_FMODE_NX1)
-			  && (ctx.task_id == IORE_MASTER_TASK)))
-		    {
-
-		      rerr = afio->remove (file);
-		    }
+		  if (test_file_owner (test))
+		    for (i = 0; i < num_files; i++)
+		      rerr |= afio->remove (files[i]);
 		  trec_test_stop (0);
 		}
 	    } /* end of remove block */
@@ -359,23 +647,27 @@ test_oset_write_exec (iore_test_t *test, iore_file_t file, const char *buf,
 } /* test_oset_write_exec () */
 
 static int
-test_oset_read_exec (iore_test_t *test, iore_file_t file, char *buf,
+test_oset_read_exec (iore_test_t *test, iore_file_t *files, char *buf,
 		     const off_t *offs)
 {
   int rerr = IORE_SUCCESS;
 
   const iore_afio_vtable_t *afio = afio_pool[test->afio.type];
   bool intra_test_barrier = test->intra_test_barrier;
+  unsigned int num_files = test->files_per_task;
   ssize_t nbytes = 0;
+  iore_test_t share;
+  unsigned int i;
 
   MPI_Barrier (ctx.comm);
 
   /* opens */
   trec_test_start (IORE_TEST_TYPE_READ, IORE_TREC_ACTION_CREATE_OPEN);
-  rerr = afio->open (&file, test);
+  for (i = 0; i < num_files && !rerr; i++)
+    rerr = afio->open (&files[i], test);
   trec_test_stop (0);
   if (rerr)
-    iore_fatalf("Failed opening file '%s'", file.name);
+    iore_fatalf("Failed opening file '%s'", files[i - 1].name);
   else
     {
       if (intra_test_barrier)
@@ -383,12 +675,23 @@ test_oset_read_exec (iore_test_t *test, iore_file_t file, char *buf,
 
       /* reads */
       trec_test_start (IORE_TEST_TYPE_READ, IORE_TREC_ACTION_WRITE_READ);
-      nbytes = afio->read_oset (file, buf, offs, test);
+      if (test->wkld.type == IORE_WKLD_TRACE)
+	nbytes = test_trace_xfer (test, IORE_TEST_TYPE_READ, files,
+				  (char *) buf, &i);
+      else
+	for (i = 0; i < num_files && nbytes >= 0; i++)
+	  {
+	    size_t first_req = test_oset_file_share (test, i, &share);
+	    trec_req_file (i);
+	    ssize_t xferd = afio->read_oset (files[i], buf, offs + first_req,
+					     &share);
+	    nbytes = (xferd < 0) ? -1 : (nbytes + xferd);
+	  }
       trec_test_stop (nbytes);
       rerr = (nbytes < 0)
-	  || (((unsigned int) nbytes) != test->wkld.u.oset.my_data_size);
+	  || (((unsigned int) nbytes) != test_my_data_size (test));
       if (rerr)
-	iore_fatalf("Failed reading from file '%s'", file.name);
+	iore_fatalf("Failed reading from file '%s'", files[i - 1].name);
       else
 	{
 	  if (intra_test_barrier)
@@ -396,26 +699,23 @@ test_oset_read_exec (iore_test_t *test, iore_file_t file, char *buf,
 
 	  /* closes */
 	  trec_test_start (IORE_TEST_TYPE_READ, IORE_TREC_ACTION_CLOSE);
-	  rerr = afio->close (&file);
+	  for (i = 0; i < num_files && !rerr; i++)
+	    rerr = afio->close (&files[i]);
 	  trec_test_stop (0);
 	  if (rerr)
-	    iore_fatalf("Failed closing file '%s'", file.name);
+	    iore_fatalf("Failed closing file '%s'", files[i - 1].name);
 	  else
 	    {
-	      if (!test->file_keep)
+	      if (test->_file_remove)
 		{
 		  MPI_Barrier (ctx.comm);
 
 		  trec_test_start (IORE_TEST_TYPE_READ,
 				   IORE_TREC_ACTION_REMOVE);
 		  /* removes */
-		  if ((test->file_mode == IORE_TEST_FMODE_NXN)
-		      || ((test->file_mode == IORE_TEST_FMODE_NX1)
-			  && (ctx.task_id == IORE_MASTER_TASK)))
-		    {
-
-		      rerr = afio->remove (file);
-		    }
+		  if (test_file_owner (test))
+		    for (i = 0; i < num_files; i++)
+		      rerr |= afio->remove (files[i]);
 		  trec_test_stop (0);
 		}
 	    } /* end of remove block */
@@ -427,6 +727,104 @@ test_oset_read_exec (iore_test_t *test, iore_file_t file, char *buf,
   return rerr;
 } /* test_oset_read_exec () */
 
+/**
+ * Replays the records of test type 'type' of the trace of the running task,
+ * in order, each as a single request through the AFIO. With recorded timing,
+ * requests wait for their time stamps, relative to the earliest replayed
+ * record of all ranks, or sleep for their think times. Sets '*file_end'
+ * past the file of the last request. Returns the number of bytes
+ * transferred, or -1 in case of failure.
+ */
+static ssize_t
+test_trace_xfer (iore_test_t *test, enum iore_test_type type,
+		 iore_file_t *files, char *buf, unsigned int *file_end)
+{
+  const iore_afio_vtable_t *afio = afio_pool[test->afio.type];
+  const iore_wkld_trace_t *trace = &test->wkld.u.trace;
+  bool timed = (trace->timing == IORE_WKLD_TRACE_TM_RECORDED
+      && trace->_time_mode != IORE_WKLD_TRACE_TIME_NONE);
+  struct timespec start;
+  ssize_t nbytes = 0;
+
+  /* each record is issued as an offset workload of a single request */
+  iore_test_t share = *test;
+  share.wkld.type = IORE_WKLD_OFFSET;
+  iore_wkld_oset_t *oset = &share.wkld.u.oset;
+  memset (oset, 0, sizeof(iore_wkld_oset_t));
+
+  *file_end = 1;
+  clock_gettime (CLOCK_MONOTONIC, &start);
+  size_t i;
+  for (i = 0; i < trace->_my_recs_len && nbytes >= 0; i++)
+    {
+      const iore_wkld_trace_rec_t *rec = &trace->my_recs[i];
+      if (rec->op != type)
+	continue;
+
+      if (timed)
+	test_trace_wait (trace, rec, &start);
+
+      off_t off = rec->offset;
+      oset->my_data_size = rec->size;
+      oset->my_req_size = rec->size;
+      oset->_file_size = rec->offset + rec->size;
+      ssize_t xferd;
+      trec_req_file (rec->file_id);
+      if (type == IORE_TEST_TYPE_WRITE)
+	xferd = afio->write_oset (files[rec->file_id], buf, &off, &share);
+      else
+	xferd = afio->read_oset (files[rec->file_id], buf, &off, &share);
+      nbytes = (xferd < 0) ? -1 : (nbytes + xferd);
+      *file_end = rec->file_id + 1;
+    }
+
+  return nbytes;
+} /* test_trace_xfer () */
+
+/**
+ * Delays the replay of 'rec' by its recorded timing: until its time stamp,
+ * taken relative to the earliest stamp of the trace and to the 'start' of
+ * the replay, or by its think time.
+ */
+static void
+test_trace_wait (const iore_wkld_trace_t *trace,
+		 const iore_wkld_trace_rec_t *rec, const struct timespec *start)
+{
+  struct timespec ts;
+
+  if (trace->_time_mode == IORE_WKLD_TRACE_TIME_STAMP)
+    {
+      uint64_t first_time = trace->_first_time;
+      uint64_t delay = (rec->time > first_time) ? rec->time - first_time : 0;
+      uint64_t nsec = start->tv_nsec + delay % 1000000000;
+      ts.tv_sec = start->tv_sec + delay / 1000000000 + nsec / 1000000000;
+      ts.tv_nsec = nsec % 1000000000;
+      while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)
+	  == EINTR)
+	;
+    }
+  else if (trace->_time_mode == IORE_WKLD_TRACE_TIME_THINK && rec->time > 0)
+    {
+      ts.tv_sec = rec->time / 1000000000;
+      ts.tv_nsec = rec->time % 1000000000;
+      while (nanosleep (&ts, &ts) && errno == EINTR)
+	;
+    }
+} /* test_trace_wait () */
+
+/**
+ * Returns the number of bytes a task transfers per test of an offset or
+ * trace workload.
+ */
+static size_t
+test_my_data_size (iore_test_t *test)
+{
+  if (test->wkld.type == IORE_WKLD_TRACE)
+    return test->wkld.u.trace.my_data_size;
+
+  return test->wkld.u.oset.my_data_size;
+} /* test_my_data_size () */
+
 static int
 test_dset_exec (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
 		unsigned int rpt_id)
@@ -440,14 +838,16 @@ test_dset_exec (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
       if (test_dset_type_prep (test, IORE_TEST_TYPE_WRITE, rpl_id, run_id,
 			       rpt_id, &file, &buf))
 	return IORE_FAILURE;
+      if (test_file_precreate (test, &file, 1, rpt_id))
+	return IORE_FAILURE;
       if (test_dset_write_exec (test, file, buf))
 	return IORE_FAILURE;
       else
 	{
 	  trec_test = trec_test_commit ();
-	  test_show_summary (trec_test);
+	  test_show_summary (test, trec_test);
 	}
-      if (test_dset_type_post (test, &file, buf))
+      if (test_dset_type_post (test, IORE_TEST_TYPE_WRITE, &file, buf))
 	return IORE_FAILURE;
     }
 
@@ -456,14 +856,16 @@ test_dset_exec (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
       if (test_dset_type_prep (test, IORE_TEST_TYPE_READ, rpl_id, run_id,
 			       rpt_id, &file, &buf))
 	return IORE_FAILURE;
+      if (test_cache_defeat (test, &file, 1))
+	return IORE_FAILURE;
       if (test_dset_read_exec (test, file, buf))
 	return IORE_FAILURE;
       else
 	{
 	  trec_test = trec_test_commit ();
-	  test_show_summary (trec_test);
+	  test_show_summary (test, trec_test);
 	}
-      if (test_dset_type_post (test, &file, buf))
+      if (test_dset_type_post (test, IORE_TEST_TYPE_READ, &file, buf))
 	return IORE_FAILURE;
     }
 
@@ -478,14 +880,15 @@ test_dset_type_prep (iore_test_t *test, enum iore_test_type type,
   /* in read tests, tasks can perform as a different 'id' */
   int task_id =
       (type == IORE_TEST_TYPE_WRITE) ?
-	  (unsigned int) ctx.task_id :
-	  (ctx.task_id + test->read_reorder_offset) % test->wkld.num_tasks;
+	  ctx.task_id : test_read_task_id (test);
 
   /* prepares the file */
-  if (test_file_prep (test, rpl_id, run_id, rpt_id, task_id, file))
+  if (test_file_prep (test, rpl_id, run_id, rpt_id, task_id, 0, file))
     return IORE_FAILURE;
 
-  // TODO: invoke AFSB
+  /* lays the file out on the storage backend */
+  if (test_afsb_prep (test, file))
+    return IORE_FAILURE;
 
   /* sets task-specific parameters */
   if (test->wkld.u.dset.type == IORE_WKLD_DSET_CARTESIAN)
@@ -500,13 +903,14 @@ test_dset_type_prep (iore_test_t *test, enum iore_test_type type,
 } /* test_dset_type_prep () */
 
 static int
-test_dset_type_post (iore_test_t *test, iore_file_t *file, char *buf)
+test_dset_type_post (iore_test_t *test, enum iore_test_type type,
+		     iore_file_t *file, char *buf)
 {
   int rerr = IORE_SUCCESS;
 
   if (test->wkld.u.dset.type == IORE_WKLD_DSET_CARTESIAN)
     rerr = test_dset_cart_type_post (&test->wkld.u.dset.u.cart);
-  rerr |= test_file_post (test, file);
+  rerr |= test_file_post (test, type, file);
   free (buf);
 
   return rerr;
@@ -604,6 +1008,19 @@ test_dset_write_exec (iore_test_t *test, iore_file_t file, const char *buf)
 	  if (intra_test_barrier)
 	    MPI_Barrier (ctx.comm);
 
+	  /* flushes */
+	  if (test->write_flush)
+	    {
+	      trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_FLUSH);
+	      rerr = afio->flush (file, test);
+	      trec_test_stop (0);
+	      if (rerr)
+		iore_fatalf("Failed flushing file '%s'", file.name);
+
+	      if (intra_test_barrier)
+		MPI_Barrier (ctx.comm);
+	    }
+
 	  /* closes */
 	  trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_CLOSE);
 	  rerr = afio->close (&file);
@@ -612,20 +1029,15 @@ test_dset_write_exec (iore_test_t *test, iore_file_t file, const char *buf)
 	    iore_fatalf("Failed closing file '%s'", file.name);
 	  else
 	    {
-	      if (!test->type.read && !test->file_keep)
+	      if (!test->type.read && test->_file_remove)
 		{
 		  MPI_Barrier (ctx.comm);
 
 		  trec_test_start (IORE_TEST_TYPE_WRITE,
 				   IORE_TREC_ACTION_REMOVE);
 		  /* removes */
-		  if ((test->file_mode == IORE_TEST_FMODE_NXN)
-		      || ((test->file_mode == IORE_TEST_FMODE_NX1)
-			  && (ctx.task_id == IORE_MASTER_TASK)))
-		    {
-
-		      rerr = afio->remove (file);
-		    }
+		  if (test_file_owner (test))
+		    rerr = afio->remove (file);
 		  trec_test_stop (0);
 		}
 	    } /* end of remove block */
@@ -680,20 +1092,15 @@ test_dset_read_exec (iore_test_t *test, iore_file_t file, char *buf)
 	    iore_fatalf("Failed closing file '%s'", file.name);
 	  else
 	    {
-	      if (!test->file_keep)
+	      if (test->_file_remove)
 		{
 		  MPI_Barrier (ctx.comm);
 
 		  trec_test_start (IORE_TEST_TYPE_READ,
 				   IORE_TREC_ACTION_REMOVE);
 		  /* removes */
-		  if ((test->file_mode == IORE_TEST_FMODE_NXN)
-		      || ((test->file_mode == IORE_TEST_FMODE_NX1)
-			  && (ctx.task_id == IORE_MASTER_TASK)))
-		    {
-
-		      rerr = afio->remove (file);
-		    }
+		  if (test_file_owner (test))
+		    rerr = afio->remove (file);
 		  trec_test_stop (0);
 		}
 	    } /* end of remove block */
@@ -705,9 +1112,279 @@ test_dset_read_exec (iore_test_t *test, iore_file_t file, char *buf)
   return rerr;
 } /* test_dset_read_exec () */
 
+static int
+test_read_task_id (iore_test_t *test)
+{
+  int num_tasks = test->wkld.num_tasks;
+  int *order = malloc (num_tasks * sizeof(int));
+  assert(order);
+
+  ctx_node_map ();
+  const int *node_of = ctx.node_of;
+  int num_nodes = ctx.num_nodes, node_size;
+
+  /* tasks sorted by node, and the size of the largest node */
+  int i, j, k = 0;
+  for (i = 0, node_size = 0; i < num_nodes; i++)
+    {
+      int size = 0;
+      for (j = 0; j < num_tasks; j++)
+	if (node_of[j] == i)
+	  {
+	    order[k++] = j;
+	    size++;
+	  }
+      if (size > node_size)
+	node_size = size;
+    }
+
+  int task_id;
+  if (test->read_reorder == IORE_TEST_RREORDER_NODE)
+    {
+      /*
+       * nodes occupy contiguous positions in the sorted list, so shifting
+       * it by the size of the largest node moves every task off its own
+       * node whenever no node holds more than half of the tasks
+       */
+      unsigned int hops =
+	  (test->read_reorder_offset > 0 ? test->read_reorder_offset : 1);
+      int pos;
+      for (pos = 0; order[pos] != ctx.task_id; pos++)
+	;
+      task_id = order[(pos + hops * node_size) % num_tasks];
+    }
+  else
+    task_id = (ctx.task_id + test->read_reorder_offset) % num_tasks;
+
+  /* reports the locality of the read assignments */
+  int local = (node_of[task_id] == node_of[ctx.task_id]);
+  int num_local = 0;
+  MPI_Reduce (&local, &num_local, 1, MPI_INT, MPI_SUM, IORE_MASTER_TASK,
+	      ctx.comm);
+  if (test->read_reorder == IORE_TEST_RREORDER_NODE && num_local > 0)
+    iore_warnf("%d of %d tasks read data written on their own node "
+	       "(%d nodes, up to %d tasks per node).",
+	       num_local, num_tasks, num_nodes, node_size);
+
+  if (ctx.verb_lvl > VERB_LVL_NORMAL)
+    {
+      MPI_Gather (&task_id, 1, MPI_INT, order, 1, MPI_INT, IORE_MASTER_TASK,
+		  ctx.comm);
+      if (ctx.task_id == IORE_MASTER_TASK)
+	for (i = 0; i < num_tasks; i++)
+	  fprintf (stdout, "Task %d (node %d) reads data of task %d (node %d)"
+		   "%s\n", i, node_of[i], order[i], node_of[order[i]],
+		   (node_of[i] == node_of[order[i]] ? ", node-local" : ""));
+    }
+
+  free (order);
+
+  return task_id;
+} /* test_read_task_id () */
+
+static int
+test_cache_defeat (iore_test_t *test, iore_file_t *files,
+		   unsigned int num_files)
+{
+  int rerr = IORE_SUCCESS;
+  unsigned int i;
+
+  if (test->read_cache_defeat == IORE_TEST_CDEFEAT_NONE
+      || test->read_cache_defeat == IORE_TEST_CDEFEAT_DIRECT)
+    return IORE_SUCCESS;
+
+  ctx_node_map ();
+  int node_task_id, node_num_tasks;
+  MPI_Comm_rank (ctx.node_comm, &node_task_id);
+  MPI_Comm_size (ctx.node_comm, &node_num_tasks);
+
+  MPI_Barrier (ctx.comm);
+
+  trec_test_start (IORE_TEST_TYPE_READ, IORE_TREC_ACTION_CACHE_DEFEAT);
+  switch (test->read_cache_defeat)
+    {
+    case IORE_TEST_CDEFEAT_FADVISE:
+      for (i = 0; i < num_files; i++)
+	rerr |= test_fadvise_dontneed (&files[i]);
+      break;
+    case IORE_TEST_CDEFEAT_MEM_SWEEP:
+      rerr = test_mem_sweep (test->read_cache_defeat_mem_size,
+			     node_num_tasks);
+      break;
+    case IORE_TEST_CDEFEAT_DROP_CACHES:
+      {
+	/* one task per node drops the caches, others fall back on failure */
+	int dropped = 0;
+	if (node_task_id == 0)
+	  {
+	    sync ();
+	    int err = 0;
+	    FILE *drop = fopen (TEST_DROP_CACHES_FILE, "w");
+	    if (drop == NULL)
+	      err = errno;
+	    else
+	      {
+		if (fputs ("1\n", drop) < 0)
+		  err = errno;
+		if (fclose (drop) && err == 0)
+		  err = errno;
+		dropped = (err == 0);
+	      }
+	    if (!dropped)
+	      iore_warnf_all("Unable to write to '%s' (%s). Advising the "
+			     "kernel to drop the test file pages instead.",
+			     TEST_DROP_CACHES_FILE, strerror (err));
+	  }
+	MPI_Bcast (&dropped, 1, MPI_INT, 0, ctx.node_comm);
+	if (!dropped)
+	  for (i = 0; i < num_files; i++)
+	    rerr |= test_fadvise_dontneed (&files[i]);
+      }
+      break;
+    default:
+      break;
+    }
+
+  if (rerr)
+    iore_errorf_all("Failed defeating the page cache for file '%s'.",
+		    files[0].name);
+
+  /* reads start only after every node has defeated its cache, and no task
+   * reads if any failed */
+  MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN, ctx.comm);
+  trec_test_stop (0);
+
+  return rerr;
+} /* test_cache_defeat () */
+
+static int
+test_fadvise_dontneed (const iore_file_t *file)
+{
+  int rerr = IORE_SUCCESS;
+
+  /* striped files are advised object by object */
+  char * const *names = file->stripes ? file->stripes->names : &file->name;
+  unsigned int num_names = file->stripes ? file->stripes->count : 1;
+
+  unsigned int i;
+  for (i = 0; i < num_names && !rerr; i++)
+    {
+      int fd = open (names[i], O_RDONLY);
+      if (fd < 0)
+	return IORE_FAILURE;
+
+      /* dirty pages are not dropped, so they are written back first */
+      if (fdatasync (fd) || posix_fadvise (fd, 0, 0, POSIX_FADV_DONTNEED))
+	rerr = IORE_FAILURE;
+      close (fd);
+    }
+
+  return rerr;
+} /* test_fadvise_dontneed () */
+
+static int
+test_mem_sweep (size_t node_mem_size, int node_num_tasks)
+{
+  size_t size = node_mem_size / node_num_tasks;
+  long page_size = sysconf (_SC_PAGESIZE);
+
+  char *mem = malloc (size);
+  if (!mem)
+    return IORE_FAILURE;
+
+  /* touches every page so the kernel must reclaim page cache to back it */
+  volatile char *page = mem;
+  size_t i;
+  for (i = 0; i < size; i += page_size)
+    page[i] = (char) i;
+  free (mem);
+
+  return IORE_SUCCESS;
+} /* test_mem_sweep () */
+
+/**
+ * Identifies the group of tasks sharing a file with 'task_id', returning its
+ * members in increasing id order. In NxM mode, the tasks of a group share a
+ * communicator, which is released by test_file_group_post ().
+ */
+static int
+test_file_group_prep (iore_test_t *test, int task_id, int **members,
+		      unsigned int *num_members)
+{
+  int num_tasks = test->wkld.num_tasks;
+  int *group_of = malloc (num_tasks * sizeof(int));
+  assert(group_of);
+
+  int i;
+  if (test->file_mode == IORE_TEST_FMODE_NXM)
+    {
+      if (test->file_group_size > 0)
+	for (i = 0; i < num_tasks; i++)
+	  group_of[i] = i / test->file_group_size;
+      else
+	{
+	  /* a file per node */
+	  ctx_node_map ();
+	  for (i = 0; i < num_tasks; i++)
+	    group_of[i] = ctx.node_of[i];
+	}
+    }
+  else
+    for (i = 0; i < num_tasks; i++)
+      group_of[i] = (test->file_mode == IORE_TEST_FMODE_NXN) ? i : 0;
+
+  test->_file_group_id = group_of[task_id];
+  *members = malloc (num_tasks * sizeof(int));
+  assert(*members);
+  *num_members = 0;
+  for (i = 0; i < num_tasks; i++)
+    if (group_of[i] == test->_file_group_id)
+      {
+	if (i == task_id)
+	  test->_file_group_task_id = *num_members;
+	(*members)[(*num_members)++] = i;
+      }
+  free (group_of);
+
+  if (test->file_mode == IORE_TEST_FMODE_NXM)
+    MPI_Comm_split (ctx.comm, test->_file_group_id, task_id,
+		    &test->_file_comm);
+  else if (test->file_mode == IORE_TEST_FMODE_NX1)
+    test->_file_comm = ctx.comm;
+  else
+    test->_file_comm = MPI_COMM_SELF;
+
+  return IORE_SUCCESS;
+} /* test_file_group_prep () */
+
+static void
+test_file_group_post (iore_test_t *test)
+{
+  if (test->file_mode == IORE_TEST_FMODE_NXM
+      && test->_file_comm != MPI_COMM_NULL)
+    MPI_Comm_free (&test->_file_comm);
+  test->_file_comm = MPI_COMM_NULL;
+} /* test_file_group_post () */
+
+/**
+ * Tells whether the running task is responsible for whole-file operations
+ * (e.g., pre-creation, removal) on its files.
+ */
+static bool
+test_file_owner (iore_test_t *test)
+{
+  if (test->file_mode == IORE_TEST_FMODE_NXN)
+    return true;
+  else if (test->file_mode == IORE_TEST_FMODE_NXM)
+    return test->_file_group_task_id == 0;
+  else
+    return ctx.task_id == IORE_MASTER_TASK;
+} /* test_file_owner () */
+
 static int
 test_file_prep (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
-		unsigned int rpt_id, int task_id, iore_file_t *file)
+		unsigned int rpt_id, int task_id, unsigned int file_id,
+		iore_file_t *file)
 {
   char *file_name = malloc (strlen (test->file_name) + 1);
   assert(file_name);
@@ -748,6 +1425,56 @@ test_file_prep (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
       base_name = swp;
     }
 
+  /* appends file id (multiple files per task) or group id (NxM) */
+  if ((test->file_mode == IORE_TEST_FMODE_NXN && test->files_per_task > 1)
+      || test->file_mode == IORE_TEST_FMODE_NXM)
+    {
+      swp = malloc (PATH_MAX);
+      assert(swp);
+      if (test->file_mode == IORE_TEST_FMODE_NXN)
+	nbytes = snprintf(swp, PATH_MAX, "%s.%u", base_name, file_id);
+      else
+	nbytes = snprintf(swp, PATH_MAX, "%s.g%d", base_name,
+			  test->_file_group_id);
+      if (nbytes == -1 || nbytes > PATH_MAX)
+	{
+	  iore_error_all("Failed appending the file id to file name.");
+	  free (swp);
+	  return IORE_FAILURE;
+	}
+      base_name = swp;
+    }
+
+  /* spreads files over hashed directories */
+  if (test->file_dir_hash > 0)
+    {
+      unsigned int bucket = 0;
+      if (test->file_mode == IORE_TEST_FMODE_NXN)
+	bucket = task_id * test->files_per_task + file_id;
+      else if (test->file_mode == IORE_TEST_FMODE_NXM)
+	bucket = test->_file_group_id;
+      bucket %= test->file_dir_hash;
+
+      swp = malloc (PATH_MAX);
+      assert(swp);
+      nbytes = snprintf(swp, PATH_MAX, "%s/h%u", dir_name, bucket);
+      if (nbytes == -1 || nbytes > PATH_MAX)
+	{
+	  iore_errorf_all("Failed appeding 'h%u' to file parent dir.", bucket);
+	  free (swp);
+	  return IORE_FAILURE;
+	}
+      dir_name = swp;
+
+      /* checks if the directory exists */
+      if (mkdir (dir_name, S_IRWXU) && errno != EEXIST)
+	{
+	  iore_errorf_all("Failed creating directory '%s'.", dir_name);
+	  free (swp);
+	  return IORE_FAILURE;
+	}
+    }
+
   /* creates a directory per task */
   if (test->file_dir_per_task && test->file_mode == IORE_TEST_FMODE_NXN)
     {
@@ -783,26 +1510,53 @@ test_file_prep (iore_test_t *test, unsigned int rpl_id, unsigned int run_id,
       return IORE_FAILURE;
     }
   file->name = swp;
+  file->stripes = NULL;
 
   return IORE_SUCCESS;
 } /* test_file_prep () */
 
 static int
-test_file_post (iore_test_t *test, iore_file_t *file)
+test_file_post (iore_test_t *test, enum iore_test_type type,
+		iore_file_t *file)
 {
   int rerr = IORE_SUCCESS;
 
-  if (!test->file_keep && test->file_dir_per_task
-      && test->file_mode == IORE_TEST_FMODE_NXN)
+  /* directories are kept while a read test still needs the file */
+  bool last_type = (type == IORE_TEST_TYPE_READ || !test->type.read);
+
+  /* emulated OST directories are removed before their parent directory */
+  if (test->afsb && afsb_pool[test->afsb->type])
+    rerr |= afsb_pool[test->afsb->type]->post (
+	file, test->afsb, last_type && test->_file_remove);
+
+  /* directories are removed from the innermost, 'h<N>/task.<id>/file' */
+  if (last_type && test->_file_remove
+      && ((test->file_dir_per_task && test->file_mode == IORE_TEST_FMODE_NXN)
+	  || test->file_dir_hash > 0))
     {
       char *file_name = strdup (file->name);
       char *dir_name = dirname (file_name);
-      if (rmdir (dir_name))
+      if (test->file_dir_per_task && test->file_mode == IORE_TEST_FMODE_NXN)
+	{
+	  /* task directories are shared by the files of the task */
+	  if (rmdir (dir_name)
+	      && (test->files_per_task == 1 || (errno != ENOENT
+		  && errno != ENOTEMPTY && errno != EEXIST)))
+	    {
+	      iore_errorf_all("Failed removing directory '%s'.", dir_name);
+	      rerr = IORE_FAILURE;
+	    }
+	  dir_name = dirname (dir_name);
+	}
+
+      /* hashed directories may still hold files of other tasks */
+      if (test->file_dir_hash > 0 && rmdir (dir_name) && errno != ENOENT
+	  && errno != ENOTEMPTY && errno != EEXIST)
 	{
 	  iore_errorf_all("Failed removing directory '%s'.", dir_name);
-	  free (file_name);
 	  rerr = IORE_FAILURE;
 	}
+      free (file_name);
     }
 
   free (file->name);
@@ -811,12 +1565,143 @@ test_file_post (iore_test_t *test, iore_file_t *file)
   return rerr;
 } /* test_file_post () */
 
+static int
+test_afsb_prep (iore_test_t *test, iore_file_t *file)
+{
+  if (!test->afsb || !afsb_pool[test->afsb->type])
+    return IORE_SUCCESS;
+
+  if (afsb_pool[test->afsb->type]->prep (file, test->afsb))
+    {
+      iore_errorf_all("Failed laying file '%s' out on the '%s' AFSB.",
+		      file->name, afsb_lbl[test->afsb->type]);
+      return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* test_afsb_prep () */
+
+static int
+test_file_precreate (iore_test_t *test, iore_file_t *files,
+		     unsigned int num_files, unsigned int rpt_id)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (test->file_prealloc == IORE_TEST_FPREALLOC_NONE && !test->file_reuse
+      && !test->file_truncate)
+    return IORE_SUCCESS;
+  if (test->file_reuse && rpt_id > 1)
+    return IORE_SUCCESS;
+
+  MPI_Barrier (ctx.comm);
+
+  trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_PREALLOC);
+  if (test_file_owner (test))
+    {
+      iore_test_t share;
+      unsigned int i, j;
+
+      for (i = 0; i < num_files && !rerr; i++)
+	{
+	  if (test->wkld.type == IORE_WKLD_OFFSET)
+	    test_oset_file_share (test, i, &share);
+	  else
+	    share = *test;
+	  size_t size = test_file_size (&share);
+
+	  /* striped files are pre-created object by object */
+	  iore_file_stripes_t *stripes = files[i].stripes;
+	  if (stripes)
+	    for (j = 0; j < stripes->count && !rerr; j++)
+	      rerr = test_file_alloc (
+		  test, stripes->names[j],
+		  test_stripe_obj_size (stripes, size, j));
+	  else
+	    rerr = test_file_alloc (test, files[i].name, size);
+	}
+      if (rerr)
+	iore_errorf_all("Failed pre-creating file '%s'.", files[i - 1].name);
+    }
+  /* only owners pre-create, so all tasks learn whether any of them failed */
+  MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN, ctx.comm);
+  trec_test_stop (0);
+
+  return rerr;
+} /* test_file_precreate () */
+
+static int
+test_file_alloc (iore_test_t *test, const char *name, size_t size)
+{
+  int rerr = IORE_SUCCESS;
+
+  int oflag = O_CREAT | O_WRONLY | (test->file_truncate ? O_TRUNC : 0);
+  mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+
+  int fd = open (name, oflag, mode);
+  if (fd < 0)
+    return IORE_FAILURE;
+
+  if (size > 0 && test->file_prealloc == IORE_TEST_FPREALLOC_FALLOCATE)
+    rerr = fallocate (fd, 0, 0, size);
+  else if (size > 0
+      && test->file_prealloc == IORE_TEST_FPREALLOC_POSIX_FALLOCATE)
+    rerr = (posix_fallocate (fd, 0, size) ? IORE_FAILURE : IORE_SUCCESS);
+  rerr |= close (fd);
+
+  return rerr;
+} /* test_file_alloc () */
+
+/**
+ * Size of the 'obj'-th stripe object of a striped file of 'size' bytes.
+ */
+static size_t
+test_stripe_obj_size (const iore_file_stripes_t *stripes, size_t size,
+		      unsigned int obj)
+{
+  size_t row_size = stripes->size * stripes->count;
+  size_t obj_size = (size / row_size) * stripes->size;
+  size_t rest = size % row_size;
+  size_t obj_start = obj * stripes->size;
+
+  if (rest > obj_start)
+    obj_size += (rest - obj_start < stripes->size) ?
+	(rest - obj_start) : stripes->size;
+
+  return obj_size;
+} /* test_stripe_obj_size () */
+
+static size_t
+test_file_size (iore_test_t *test)
+{
+  size_t size = 0;
+
+  if (test->wkld.type == IORE_WKLD_OFFSET)
+    size = test->wkld.u.oset._file_size;
+  else if (test->wkld.type == IORE_WKLD_TRACE)
+    size = test->wkld.u.trace._file_size;
+  else if (test->wkld.type == IORE_WKLD_DATASET)
+    {
+      iore_wkld_dset_t *dset = &test->wkld.u.dset;
+      if (test->file_mode == IORE_TEST_FMODE_NXN)
+	size = dset->my_size;
+      else if (dset->type == IORE_WKLD_DSET_CARTESIAN)
+	{
+	  unsigned int i;
+	  size = dset->_vars_size;
+	  for (i = 0; i < dset->u.cart.num_dims; i++)
+	    size *= dset->u.cart.g_dim_sizes[i];
+	}
+    }
+
+  return size;
+} /* test_file_size () */
+
 // TODO: fill with random data
 static int
 test_buf_prep (size_t size, enum iore_test_type type, char **buf)
 {
-  *buf = malloc (size);
-  assert(*buf);
+  int rerr = posix_memalign ((void **) buf, TEST_BUF_ALIGNMENT, size);
+  assert(!rerr);
 
   if (type == IORE_TEST_TYPE_WRITE)
     {
@@ -829,7 +1714,8 @@ test_buf_prep (size_t size, enum iore_test_type type, char **buf)
 } /* test_buf_prep () */
 
 static int
-test_offs_prep (iore_test_t *test, int task_id, off_t **offs)
+test_offs_prep (iore_test_t *test, int task_id, const int *members,
+		unsigned int num_members, off_t **offs)
 {
   int rerr = IORE_SUCCESS;
 
@@ -840,14 +1726,15 @@ test_offs_prep (iore_test_t *test, int task_id, off_t **offs)
   *offs = malloc (num_reqs * sizeof(off_t));
   assert(*offs);
 
+  /* in NxM mode, each group lays out its file as in Nx1 mode */
   if (test->file_mode == IORE_TEST_FMODE_NXN)
-    rerr = test_offs_nxn_prep (&test->wkld, num_reqs, *offs);
-  else if ((test->file_mode == IORE_TEST_FMODE_NX1)
-      && (oset->ac_pattern == IORE_WKLD_OSET_AP_SEQUENTIAL))
-    rerr = test_offs_nx1_seq_prep (&test->wkld, num_reqs, task_id, *offs);
-  else if ((test->file_mode == IORE_TEST_FMODE_NX1)
-      && (oset->ac_pattern == IORE_WKLD_OSET_AP_RANDOM))
-    rerr = test_offs_nx1_rnd_prep (&test->wkld, num_reqs, task_id, *offs);
+    rerr = test_offs_nxn_prep (test, num_reqs, *offs);
+  else if (oset->ac_pattern == IORE_WKLD_OSET_AP_SEQUENTIAL)
+    rerr = test_offs_nx1_seq_prep (&test->wkld, num_reqs, task_id, members,
+				   num_members, *offs);
+  else if (oset->ac_pattern == IORE_WKLD_OSET_AP_RANDOM)
+    rerr = test_offs_nx1_rnd_prep (&test->wkld, num_reqs, task_id, members,
+				   num_members, *offs);
 
   if (rerr)
     {
@@ -858,22 +1745,33 @@ test_offs_prep (iore_test_t *test, int task_id, off_t **offs)
   return rerr;
 } /* test_offs_prep () */
 
+/**
+ * With multiple files per task, requests are split in contiguous blocks (see
+ * test_oset_file_share ()), each one addressing its own file from offset 0.
+ */
 static int
-test_offs_nxn_prep (iore_wkld_t *wkld, int num_reqs, off_t *offs)
+test_offs_nxn_prep (iore_test_t *test, int num_reqs, off_t *offs)
 {
   int rerr = IORE_SUCCESS;
 
+  size_t req_size = test->wkld.u.oset.my_req_size;
+  int file_reqs = (num_reqs + test->files_per_task - 1) / test->files_per_task;
+
   int i;
   for (i = 0; i < num_reqs; i++)
-    offs[i] = i * wkld->u.oset.my_req_size;
+    offs[i] = (i % file_reqs) * req_size;
 
-  if (wkld->u.oset.ac_pattern == IORE_WKLD_OSET_AP_RANDOM)
+  if (test->wkld.u.oset.ac_pattern == IORE_WKLD_OSET_AP_RANDOM)
     {
       unsigned int seed;
       if (ctx.task_id == IORE_MASTER_TASK)
 	seed = prng_gen_seed ();
       MPI_Bcast (&seed, 1, MPI_UNSIGNED, IORE_MASTER_TASK, ctx.comm);
-      rerr = shuffle (offs, num_reqs, sizeof(off_t), seed);
+      for (i = 0; i < num_reqs && !rerr; i += file_reqs)
+	{
+	  int len = (num_reqs - i < file_reqs) ? (num_reqs - i) : file_reqs;
+	  rerr = shuffle (offs + i, len, sizeof(off_t), seed + i);
+	}
     }
 
   return rerr;
@@ -881,13 +1779,16 @@ test_offs_nxn_prep (iore_wkld_t *wkld, int num_reqs, off_t *offs)
 
 static int
 test_offs_nx1_seq_prep (iore_wkld_t *wkld, int num_reqs, int task_id,
+			const int *members, unsigned int num_members,
 			off_t *offs)
 {
   offs[0] = 0;
-  int i;
-  for (i = 0; i < task_id; i++)
-    offs[0] += wkld->u.oset.data_sizes[i % wkld->u.oset._data_sizes_len];
+  unsigned int j;
+  for (j = 0; j < num_members && members[j] < task_id; j++)
+    offs[0] += wkld->u.oset.data_sizes[members[j]
+	% wkld->u.oset._data_sizes_len];
 
+  int i;
   for (i = 1; i < num_reqs; i++)
     offs[i] = i * wkld->u.oset.my_req_size + offs[0];
 
@@ -905,13 +1806,14 @@ test_offs_nx1_seq_prep (iore_wkld_t *wkld, int num_reqs, int task_id,
  */
 static int
 test_offs_nx1_rnd_prep (iore_wkld_t *wkld, int num_reqs, int task_id,
+			const int *members, unsigned int num_members,
 			off_t *offs)
 {
   int rerr = IORE_SUCCESS;
 
   iore_wkld_oset_t *oset = &wkld->u.oset;
 
-  unsigned int l_tid_len = wkld->num_tasks;
+  unsigned int l_tid_len = num_members;
   int *l_tid = malloc (l_tid_len * sizeof(int));
   assert(l_tid);
   size_t *l_remain = malloc (l_tid_len * sizeof(size_t));
@@ -923,8 +1825,8 @@ test_offs_nx1_rnd_prep (iore_wkld_t *wkld, int num_reqs, int task_id,
   for (i = 0; i < l_tid_len; i++)
     {
       l_tid[i] = i;
-      l_remain[i] = oset->data_sizes[i % oset->_data_sizes_len];
-      l_req_sz[i] = oset->req_sizes[i % oset->_req_sizes_len];
+      l_remain[i] = oset->data_sizes[members[i] % oset->_data_sizes_len];
+      l_req_sz[i] = oset->req_sizes[members[i] % oset->_req_sizes_len];
     }
 
   iore_prng_dist_t dist;
@@ -947,7 +1849,7 @@ test_offs_nx1_rnd_prep (iore_wkld_t *wkld, int num_reqs, int task_id,
 	  i *= l_tid_len;
 
 	  tid = l_tid[i];
-	  if (tid == task_id)
+	  if (members[tid] == task_id)
 	    offs[c++] = off;
 
 	  req_sz =
@@ -1006,34 +1908,22 @@ test_sizes_prep (iore_prng_dist_t *dist, unsigned int len, size_t **l_sizes)
 } /* test_sizes_prep () */
 
 static void
-test_show_summary (iore_trec_test_t *trec_test)
+test_show_summary (iore_test_t *test, iore_trec_test_t *trec_test)
 {
+  assert(test);
   assert(trec_test);
 
   iore_time_t min_time[IORE_TREC_ACTION_LENGTH];
   iore_time_t max_time[IORE_TREC_ACTION_LENGTH];
   size_t agg_data_size = 0;
-  int i_action;
-  for (i_action = 0; i_action < IORE_TREC_ACTION_LENGTH; i_action++)
-    {
-      MPI_Reduce (&trec_test->task_time[i_action][IORE_TREC_EVENT_START],
-		  &min_time[i_action], 1, MPI_DOUBLE, MPI_MIN, IORE_MASTER_TASK,
-		  ctx.comm);
-      MPI_Reduce (&trec_test->task_time[i_action][IORE_TREC_EVENT_STOP],
-		  &max_time[i_action], 1, MPI_DOUBLE, MPI_MAX, IORE_MASTER_TASK,
-		  ctx.comm);
-      if (i_action == IORE_TREC_ACTION_WRITE_READ)
-	{
-	  MPI_Reduce (&trec_test->task_data_size, &agg_data_size, 1, MPI_AINT,
-	  MPI_SUM,
-		      IORE_MASTER_TASK, ctx.comm);
-	}
-    }
+  test_summary_reduce (trec_test, min_time, max_time, &agg_data_size);
 
   iore_time_t create_open = (max_time[IORE_TREC_ACTION_CREATE_OPEN]
       - min_time[IORE_TREC_ACTION_CREATE_OPEN]);
   iore_time_t write_read = (max_time[IORE_TREC_ACTION_WRITE_READ]
       - min_time[IORE_TREC_ACTION_WRITE_READ]);
+  iore_time_t flush = (max_time[IORE_TREC_ACTION_FLUSH]
+      - min_time[IORE_TREC_ACTION_FLUSH]);
   iore_time_t close = (max_time[IORE_TREC_ACTION_CLOSE]
       - min_time[IORE_TREC_ACTION_CLOSE]);
   iore_time_t remove = (max_time[IORE_TREC_ACTION_REMOVE]
@@ -1048,8 +1938,530 @@ test_show_summary (iore_trec_test_t *trec_test)
 
   if (ctx.task_id == IORE_MASTER_TASK)
     {
-      fprintf (stdout, "%-5s %10.4f %10.4f %10.4f %10.4f %10.4f %15s\n",
-	       test_type_lbl[trec_test->type], create_open, write_read, close,
-	       remove, total, tput);
+      fprintf (ctx.out, "%-5s %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f %15s\n",
+	       test_type_lbl[trec_test->type], create_open, write_read, flush,
+	       close, remove, total, tput);
     }
+
+  if (test->afio.type == IORE_AFIO_NULL)
+    test_show_overhead (test, trec_test);
 } /* test_show_summary () */
+
+static void
+test_summary_reduce (iore_trec_test_t *trec_test, iore_time_t *min_time,
+		     iore_time_t *max_time, size_t *agg_data_size)
+{
+  trec_test_reduce (trec_test);
+
+  int i_action;
+  for (i_action = 0; i_action < IORE_TREC_ACTION_LENGTH; i_action++)
+    {
+      min_time[i_action] = trec_test->test_time[i_action][IORE_TREC_EVENT_START];
+      max_time[i_action] = trec_test->test_time[i_action][IORE_TREC_EVENT_STOP];
+    }
+  *agg_data_size = trec_test->test_data_size;
+} /* test_summary_reduce () */
+
+/**
+ * Shows the overhead of IORE itself, measured on tests of the null AFIO:
+ * the time per request spent iterating over offsets and dispatching to the
+ * AFIO, and the times of recording an action, of a barrier and of the
+ * reductions behind a summary line. Each is the maximum over all tasks of
+ * their mean times, in microseconds.
+ */
+static void
+test_show_overhead (iore_test_t *test, iore_trec_test_t *trec_test)
+{
+  iore_time_t task_ovhd[4], ovhd[4];
+  iore_time_t start;
+  unsigned int i;
+
+  iore_time_t *xfer_time = trec_test->task_time[IORE_TREC_ACTION_WRITE_READ];
+  size_t num_reqs = test_num_reqs (test);
+  task_ovhd[0] = 0;
+  if (num_reqs > 0)
+    task_ovhd[0] = ((xfer_time[IORE_TREC_EVENT_STOP]
+	- xfer_time[IORE_TREC_EVENT_START]) / num_reqs);
+
+  task_ovhd[1] = trec_test_cost (TEST_OVERHEAD_ITERS);
+
+  MPI_Barrier (ctx.comm);
+  start = MPI_Wtime ();
+  for (i = 0; i < TEST_OVERHEAD_ITERS; i++)
+    MPI_Barrier (ctx.comm);
+  task_ovhd[2] = (MPI_Wtime () - start) / TEST_OVERHEAD_ITERS;
+
+  iore_time_t min_time[IORE_TREC_ACTION_LENGTH];
+  iore_time_t max_time[IORE_TREC_ACTION_LENGTH];
+  size_t agg_data_size;
+  MPI_Barrier (ctx.comm);
+  start = MPI_Wtime ();
+  for (i = 0; i < TEST_OVERHEAD_ITERS; i++)
+    test_summary_reduce (trec_test, min_time, max_time, &agg_data_size);
+  task_ovhd[3] = (MPI_Wtime () - start) / TEST_OVERHEAD_ITERS;
+
+  MPI_Reduce (task_ovhd, ovhd, 4, MPI_DOUBLE, MPI_MAX, IORE_MASTER_TASK,
+	      ctx.comm);
+
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      fprintf (ctx.out, "%-5s overhead (us): request %.3f, trec %.3f, "
+	       "barrier %.3f, reduce %.3f\n",
+	       test_type_lbl[trec_test->type], ovhd[0] * 1e6, ovhd[1] * 1e6,
+	       ovhd[2] * 1e6, ovhd[3] * 1e6);
+    }
+} /* test_show_overhead () */
+
+/**
+ * Returns the number of requests a task issues per test. Partial requests
+ * at the end of NxM file shares are not accounted for.
+ */
+static size_t
+test_num_reqs (iore_test_t *test)
+{
+  size_t num_reqs = 0;
+
+  if (test->wkld.type == IORE_WKLD_OFFSET)
+    {
+      iore_wkld_oset_t *oset = &test->wkld.u.oset;
+      if (oset->my_req_size > 0)
+	num_reqs = (oset->my_data_size + oset->my_req_size - 1)
+	    / oset->my_req_size;
+    }
+  else if (test->wkld.type == IORE_WKLD_TRACE)
+    num_reqs = test->wkld.u.trace._num_reqs;
+  else if (test->wkld.type == IORE_WKLD_DATASET
+      && test->wkld.u.dset.type == IORE_WKLD_DSET_CARTESIAN)
+    {
+      iore_wkld_dset_t *dset = &test->wkld.u.dset;
+      size_t req_size = (dset->_vars_size
+	  * dset->u.cart.my_dim_sizes[dset->u.cart.num_dims - 1]);
+      if (req_size > 0)
+	num_reqs = dset->my_size / req_size;
+    }
+
+  return num_reqs;
+} /* test_num_reqs () */
+
+/**
+ * Reports the access pattern of a test type without doing I/O: the sizes
+ * and offsets of the requests are prepared as for its execution, and their
+ * counts, extents, gaps, overlaps, alignment to 'stripe_size' and the
+ * memory they need are reduced at the master task. A zero 'stripe_size'
+ * skips the alignment check.
+ */
+static int
+test_plan_type (iore_test_t *test, enum iore_test_type type,
+		size_t stripe_size)
+{
+  int rerr = IORE_SUCCESS;
+
+  /* in read tests, tasks can perform as a different 'id' */
+  int task_id =
+      (type == IORE_TEST_TYPE_WRITE) ?
+	  ctx.task_id : test_read_task_id (test);
+
+  test_plan_ext_t *exts = NULL;
+  size_t num_exts = 0;
+  size_t buf_size = 0;
+  if (test->wkld.type == IORE_WKLD_OFFSET)
+    rerr = test_plan_oset_exts (test, task_id, &exts, &num_exts, &buf_size);
+  else if (test->wkld.type == IORE_WKLD_TRACE)
+    rerr = test_plan_trace_exts (test, type, task_id, &exts, &num_exts,
+				 &buf_size);
+  else if (test->wkld.type == IORE_WKLD_DATASET)
+    rerr = test_plan_dset_exts (test, task_id, &exts, &num_exts, &buf_size);
+  else
+    {
+      iore_error("Unsupported workload type");
+      rerr = IORE_FAILURE;
+    }
+  if (rerr)
+    return rerr;
+
+  unsigned long long counts[TEST_PLAN_LENGTH] =
+    { 0 };
+  unsigned long long hist[TEST_PLAN_HIST_BINS] =
+    { 0 };
+  size_t i;
+  for (i = 0; i < num_exts; i++)
+    {
+      unsigned long long len = exts[i].end - exts[i].start;
+      counts[TEST_PLAN_BYTES] += len;
+
+      int bin = 0;
+      while (len >>= 1)
+	bin++;
+      hist[bin]++;
+
+      if (stripe_size > 0)
+	{
+	  if (exts[i].start % stripe_size)
+	    counts[TEST_PLAN_UNALIGNED]++;
+	  if (exts[i].start / stripe_size != (exts[i].end - 1) / stripe_size)
+	    counts[TEST_PLAN_CROSSING]++;
+	}
+    }
+  counts[TEST_PLAN_REQS] = num_exts;
+
+  /* the buffer and offsets, and the memory swept to defeat the cache */
+  counts[TEST_PLAN_MEM] = buf_size + num_exts * sizeof(off_t);
+  if (type == IORE_TEST_TYPE_READ
+      && test->read_cache_defeat == IORE_TEST_CDEFEAT_MEM_SWEEP)
+    {
+      int node_num_tasks;
+      ctx_node_map ();
+      MPI_Comm_size (ctx.node_comm, &node_num_tasks);
+      counts[TEST_PLAN_MEM] += test->read_cache_defeat_mem_size
+	  / node_num_tasks;
+    }
+
+  num_exts = test_plan_merge (exts, num_exts, counts);
+  test_plan_show (type, stripe_size, counts, hist, exts, num_exts);
+  free (exts);
+
+  return rerr;
+} /* test_plan_type () */
+
+/**
+ * Lists the byte ranges of the requests of 'task_id' on an offset
+ * workload, in request order.
+ */
+static int
+test_plan_oset_exts (iore_test_t *test, int task_id, test_plan_ext_t **exts,
+		     size_t *num_exts, size_t *buf_size)
+{
+  int *members;
+  unsigned int num_members;
+  test_file_group_prep (test, task_id, &members, &num_members);
+
+  off_t *offs = NULL;
+  int rerr = test_oset_sizes_prep (test, task_id, members, num_members);
+  if (!rerr)
+    rerr = test_offs_prep (test, task_id, members, num_members, &offs);
+  free (members);
+  test_file_group_post (test);
+  if (rerr)
+    return rerr;
+
+  iore_wkld_oset_t *oset = &test->wkld.u.oset;
+  size_t num_reqs = test_num_reqs (test);
+  size_t file_reqs = (num_reqs + test->files_per_task - 1)
+      / test->files_per_task;
+  *exts = malloc ((num_reqs + 1) * sizeof(test_plan_ext_t));
+  assert(*exts);
+
+  /* requests are split in contiguous blocks among the files of the task */
+  size_t i;
+  for (i = 0; i < num_reqs; i++)
+    {
+      size_t len = oset->my_data_size - i * oset->my_req_size;
+      if (len > oset->my_req_size)
+	len = oset->my_req_size;
+      (*exts)[i].file = ((unsigned long long) test->_file_group_id
+	  * test->files_per_task + i / file_reqs);
+      (*exts)[i].start = offs[i];
+      (*exts)[i].end = offs[i] + len;
+    }
+  *num_exts = num_reqs;
+  *buf_size = oset->my_req_size;
+  free (offs);
+
+  return IORE_SUCCESS;
+} /* test_plan_oset_exts () */
+
+/**
+ * Lists the byte ranges of the requests of test type 'type' of 'task_id' on
+ * a trace workload, in replay order.
+ */
+static int
+test_plan_trace_exts (iore_test_t *test, enum iore_test_type type,
+		      int task_id, test_plan_ext_t **exts, size_t *num_exts,
+		      size_t *buf_size)
+{
+  int *members;
+  unsigned int num_members;
+  test_file_group_prep (test, task_id, &members, &num_members);
+  free (members);
+  test_file_group_post (test);
+
+  iore_wkld_trace_t *trace = &test->wkld.u.trace;
+  if (wkld_trace_map (trace, task_id, type, test->files_per_task))
+    return IORE_FAILURE;
+
+  *exts = malloc ((trace->_num_reqs + 1) * sizeof(test_plan_ext_t));
+  assert(*exts);
+
+  size_t n = 0;
+  size_t i;
+  for (i = 0; i < trace->_my_recs_len; i++)
+    {
+      const iore_wkld_trace_rec_t *rec = &trace->my_recs[i];
+      if (rec->op != type || rec->size == 0)
+	continue;
+
+      (*exts)[n].file = ((unsigned long long) test->_file_group_id
+	  * test->files_per_task + rec->file_id);
+      (*exts)[n].start = rec->offset;
+      (*exts)[n].end = rec->offset + rec->size;
+      n++;
+    }
+  *num_exts = n;
+  *buf_size = trace->my_req_size;
+  wkld_trace_unmap (trace);
+
+  return IORE_SUCCESS;
+} /* test_plan_trace_exts () */
+
+/**
+ * Lists the byte ranges of the requests of 'task_id' on a dataset
+ * workload, one per row of its block of the dataset.
+ */
+static int
+test_plan_dset_exts (iore_test_t *test, int task_id, test_plan_ext_t **exts,
+		     size_t *num_exts, size_t *buf_size)
+{
+  iore_wkld_dset_t *dset = &test->wkld.u.dset;
+
+  *exts = NULL;
+  *num_exts = 0;
+  *buf_size = 0;
+  if (dset->type != IORE_WKLD_DSET_CARTESIAN)
+    return IORE_SUCCESS;
+
+  if (test_dset_cart_type_prep (dset, task_id))
+    return IORE_FAILURE;
+
+  off_t *offs = dset_to_off (dset, test->file_mode);
+  size_t num_reqs = test_num_reqs (test);
+  size_t row_size = (dset->_vars_size
+      * dset->u.cart.my_dim_sizes[dset->u.cart.num_dims - 1]);
+  *exts = malloc ((num_reqs + 1) * sizeof(test_plan_ext_t));
+  assert(*exts);
+
+  size_t i;
+  for (i = 0; i < num_reqs; i++)
+    {
+      (*exts)[i].file = (test->file_mode == IORE_TEST_FMODE_NXN ? task_id : 0);
+      (*exts)[i].start = offs[i];
+      (*exts)[i].end = offs[i] + row_size;
+    }
+  *num_exts = num_reqs;
+  *buf_size = dset->my_size;
+  free (offs);
+
+  return test_dset_cart_type_post (&dset->u.cart);
+} /* test_plan_dset_exts () */
+
+static int
+test_plan_ext_cmp (const void *a, const void *b)
+{
+  const test_plan_ext_t *ext_a = a;
+  const test_plan_ext_t *ext_b = b;
+
+  if (ext_a->file != ext_b->file)
+    return (ext_a->file < ext_b->file) ? -1 : 1;
+  if (ext_a->start != ext_b->start)
+    return (ext_a->start < ext_b->start) ? -1 : 1;
+
+  return 0;
+} /* test_plan_ext_cmp () */
+
+/**
+ * Sorts the byte ranges and merges those that touch or overlap, adding the
+ * overlaps to 'counts'. Returns the number of merged ranges.
+ */
+static size_t
+test_plan_merge (test_plan_ext_t *exts, size_t num_exts,
+		 unsigned long long *counts)
+{
+  if (num_exts == 0)
+    return 0;
+
+  qsort (exts, num_exts, sizeof(test_plan_ext_t), test_plan_ext_cmp);
+
+  size_t len = 1;
+  size_t i;
+  for (i = 1; i < num_exts; i++)
+    {
+      test_plan_ext_t *last = &exts[len - 1];
+      if (exts[i].file == last->file && exts[i].start <= last->end)
+	{
+	  if (exts[i].start < last->end)
+	    {
+	      counts[TEST_PLAN_OVERLAPS]++;
+	      counts[TEST_PLAN_OVERLAP_BYTES] += ((
+		  exts[i].end < last->end ? exts[i].end : last->end)
+		  - exts[i].start);
+	    }
+	  if (exts[i].end > last->end)
+	    last->end = exts[i].end;
+	}
+      else
+	exts[len++] = exts[i];
+    }
+
+  return len;
+} /* test_plan_merge () */
+
+/**
+ * Reduces the plan of the tasks and shows it. The merged byte ranges of
+ * all tasks are gathered at the master task, which finds the gaps and
+ * overlaps among tasks. With verbose output, the plan of each task is
+ * shown too.
+ */
+static void
+test_plan_show (enum iore_test_type type, size_t stripe_size,
+		unsigned long long *counts, const unsigned long long *hist,
+		const test_plan_ext_t *exts, size_t num_exts)
+{
+  int num_tasks;
+  MPI_Comm_size (ctx.comm, &num_tasks);
+  bool master = (ctx.task_id == IORE_MASTER_TASK);
+
+  unsigned long long min[TEST_PLAN_LENGTH], max[TEST_PLAN_LENGTH];
+  unsigned long long sum[TEST_PLAN_LENGTH], g_hist[TEST_PLAN_HIST_BINS];
+  MPI_Reduce (counts, min, TEST_PLAN_LENGTH, MPI_UNSIGNED_LONG_LONG, MPI_MIN,
+	      IORE_MASTER_TASK, ctx.comm);
+  MPI_Reduce (counts, max, TEST_PLAN_LENGTH, MPI_UNSIGNED_LONG_LONG, MPI_MAX,
+	      IORE_MASTER_TASK, ctx.comm);
+  MPI_Reduce (counts, sum, TEST_PLAN_LENGTH, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+	      IORE_MASTER_TASK, ctx.comm);
+  MPI_Reduce (hist, g_hist, TEST_PLAN_HIST_BINS, MPI_UNSIGNED_LONG_LONG,
+	      MPI_SUM, IORE_MASTER_TASK, ctx.comm);
+
+  /* extents are gathered as a datatype of their own, whose counts and
+   * displacements MPI takes as int; past that, gaps are not looked for */
+  unsigned long long my_num_exts = num_exts, total_exts;
+  MPI_Allreduce (&my_num_exts, &total_exts, 1, MPI_UNSIGNED_LONG_LONG,
+		 MPI_SUM, ctx.comm);
+  bool gather = (total_exts <= INT_MAX);
+
+  unsigned long long *task_exts = NULL, *task_counts = NULL;
+  int *lens = NULL, *displs = NULL;
+  test_plan_ext_t *g_exts = NULL;
+  if (master)
+    {
+      task_exts = malloc (num_tasks * sizeof(unsigned long long));
+      lens = malloc (num_tasks * sizeof(int));
+      displs = malloc (num_tasks * sizeof(int));
+      task_counts = malloc (num_tasks * TEST_PLAN_LENGTH
+	  * sizeof(unsigned long long));
+      assert(task_exts && lens && displs && task_counts);
+    }
+  MPI_Gather (&my_num_exts, 1, MPI_UNSIGNED_LONG_LONG, task_exts, 1,
+	      MPI_UNSIGNED_LONG_LONG, IORE_MASTER_TASK, ctx.comm);
+  MPI_Gather (counts, TEST_PLAN_LENGTH, MPI_UNSIGNED_LONG_LONG, task_counts,
+	      TEST_PLAN_LENGTH, MPI_UNSIGNED_LONG_LONG, IORE_MASTER_TASK,
+	      ctx.comm);
+
+  size_t g_num_exts = 0;
+  if (gather)
+    {
+      MPI_Datatype ext_type;
+      MPI_Type_contiguous (3, MPI_UNSIGNED_LONG_LONG, &ext_type);
+      MPI_Type_commit (&ext_type);
+
+      if (master)
+	{
+	  int i;
+	  for (i = 0; i < num_tasks; i++)
+	    {
+	      lens[i] = task_exts[i];
+	      displs[i] = g_num_exts;
+	      g_num_exts += task_exts[i];
+	    }
+	  g_exts = malloc ((g_num_exts + 1) * sizeof(test_plan_ext_t));
+	  assert(g_exts);
+	}
+      MPI_Gatherv (exts, num_exts, ext_type, g_exts, lens, displs, ext_type,
+		   IORE_MASTER_TASK, ctx.comm);
+      MPI_Type_free (&ext_type);
+    }
+
+  if (master)
+    {
+      /* files start at offset 0, so leading holes are gaps too; bytes in
+       * extents count the bytes accessed once, without gaps or overlaps */
+      unsigned long long num_files = 0, ext_bytes = 0;
+      unsigned long long gaps = 0, gap_bytes = 0;
+      unsigned long long overlaps = sum[TEST_PLAN_OVERLAPS];
+      unsigned long long overlap_bytes = sum[TEST_PLAN_OVERLAP_BYTES];
+      unsigned long long end = 0;
+      qsort (g_exts, g_num_exts, sizeof(test_plan_ext_t), test_plan_ext_cmp);
+      size_t i;
+      for (i = 0; i < g_num_exts; i++)
+	{
+	  if (i == 0 || g_exts[i].file != g_exts[i - 1].file)
+	    {
+	      num_files++;
+	      end = 0;
+	    }
+	  if (g_exts[i].start > end)
+	    {
+	      gaps++;
+	      gap_bytes += g_exts[i].start - end;
+	    }
+	  else if (g_exts[i].start < end)
+	    {
+	      overlaps++;
+	      overlap_bytes += ((g_exts[i].end < end ? g_exts[i].end : end)
+		  - g_exts[i].start);
+	    }
+	  if (g_exts[i].end > end)
+	    {
+	      ext_bytes += g_exts[i].end
+		  - (g_exts[i].start > end ? g_exts[i].start : end);
+	      end = g_exts[i].end;
+	    }
+	}
+
+      const char *lbl = test_type_lbl[type];
+      fprintf (stdout, "%-5s requests/task: min %llu, max %llu, total %llu\n",
+	       lbl, min[TEST_PLAN_REQS], max[TEST_PLAN_REQS],
+	       sum[TEST_PLAN_REQS]);
+      fprintf (stdout, "%-5s bytes/task: min %llu, max %llu, total %llu\n",
+	       lbl, min[TEST_PLAN_BYTES], max[TEST_PLAN_BYTES],
+	       sum[TEST_PLAN_BYTES]);
+      int bin;
+      for (bin = 0; bin < TEST_PLAN_HIST_BINS; bin++)
+	if (g_hist[bin] > 0)
+	  fprintf (stdout, "%-5s request sizes [%llu, %llu): %llu\n", lbl,
+		   1ull << bin, (bin < 63 ? 1ull << (bin + 1) : ULLONG_MAX),
+		   g_hist[bin]);
+      if (gather)
+	fprintf (stdout, "%-5s files: %llu, %llu bytes in extents, %llu gaps "
+		 "(%llu bytes), %llu overlaps (%llu bytes)\n",
+		 lbl, num_files, ext_bytes, gaps, gap_bytes, overlaps,
+		 overlap_bytes);
+      else
+	iore_warnf("%s plan: %llu extents, too many to find gaps and overlaps "
+		   "among tasks.", lbl, total_exts);
+      if (stripe_size > 0)
+	fprintf (stdout, "%-5s stripe size %zu: %llu requests unaligned, "
+		 "%llu crossing stripes\n",
+		 lbl, stripe_size, sum[TEST_PLAN_UNALIGNED],
+		 sum[TEST_PLAN_CROSSING]);
+      fprintf (stdout, "%-5s memory/task: min %llu, max %llu bytes\n", lbl,
+	       min[TEST_PLAN_MEM], max[TEST_PLAN_MEM]);
+
+      if (ctx.verb_lvl > VERB_LVL_NORMAL)
+	{
+	  int t;
+	  for (t = 0; t < num_tasks; t++)
+	    {
+	      unsigned long long *c = &task_counts[t * TEST_PLAN_LENGTH];
+	      fprintf (stdout, "%-5s task %d: %llu requests, %llu bytes, "
+		       "%llu extents, %llu bytes of memory\n",
+		       lbl, t, c[TEST_PLAN_REQS], c[TEST_PLAN_BYTES],
+		       task_exts[t], c[TEST_PLAN_MEM]);
+	    }
+	}
+
+      free (task_exts);
+      free (lens);
+      free (displs);
+      free (task_counts);
+      free (g_exts);
+    }
+} /* test_plan_show () */
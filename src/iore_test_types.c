@@ -16,7 +16,15 @@
 const char *test_type_lbl[IORE_TEST_TYPE_LENGTH] =
   { "write", "read" };
 const char *test_file_mode_lbl[IORE_TEST_FMODE_LENGTH] =
-  { "Nx1", "NxN" };
+  { "Nx1", "NxN", "NxM" };
+const char *test_file_prealloc_lbl[IORE_TEST_FPREALLOC_LENGTH] =
+  { "none", "fallocate", "posix_fallocate" };
+const char *test_flush_mode_lbl[IORE_TEST_FLUSH_LENGTH] =
+  { "fsync", "fdatasync", "sync_file_range", "o_dsync", "o_sync", "rwf_dsync" };
+const char *test_read_reorder_lbl[IORE_TEST_RREORDER_LENGTH] =
+  { "task", "node" };
+const char *test_cache_defeat_lbl[IORE_TEST_CDEFEAT_LENGTH] =
+  { "none", "fadvise", "direct", "mem_sweep", "drop_caches" };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -36,14 +44,21 @@ test2str (const iore_test_t *test)
 	  (test->type.read ? "true" : "false"),
 	  (test->write_flush ? "true" : "false"),
 	  (test->write_flush_per_req ? "true" : "false"),
-	  test->read_reorder_offset,
+	  test_flush_mode_lbl[test->write_flush_mode], test->write_flush_window,
+	  test_read_reorder_lbl[test->read_reorder], test->read_reorder_offset,
+	  test_cache_defeat_lbl[test->read_cache_defeat],
+	  test->read_cache_defeat_mem_size,
 	  (test->intra_test_barrier ? "true": "false"),
 	  test->inter_test_delay_secs,
-	  test_file_mode_lbl[test->file_mode], test->file_name,
+	  test_file_mode_lbl[test->file_mode], test->file_group_size,
+	  test->files_per_task, test->file_dir_hash, test->file_name,
 	  (test->file_name_append_sequence_num ? "true" : "false"),
 	  (test->file_name_append_task_id ? "true" : "false"),
 	  (test->file_dir_per_task ? "true" : "false"),
-	  (test->file_keep ? "true" : "false"), wkld, afio, afsb) + 1;
+	  (test->file_keep ? "true" : "false"),
+	  test_file_prealloc_lbl[test->file_prealloc],
+	  (test->file_reuse ? "true" : "false"),
+	  (test->file_truncate ? "true" : "false"), wkld, afio, afsb) + 1;
       if (len > 0)
 	{
 	  str = malloc (len);
@@ -53,14 +68,23 @@ test2str (const iore_test_t *test)
 		   (test->type.read ? "true" : "false"),
 		   (test->write_flush ? "true" : "false"),
 		   (test->write_flush_per_req ? "true" : "false"),
+		   test_flush_mode_lbl[test->write_flush_mode],
+		   test->write_flush_window,
+		   test_read_reorder_lbl[test->read_reorder],
 		   test->read_reorder_offset,
+		   test_cache_defeat_lbl[test->read_cache_defeat],
+		   test->read_cache_defeat_mem_size,
 		   (test->intra_test_barrier ? "true" : "false"),
 		   test->inter_test_delay_secs,
-		   test_file_mode_lbl[test->file_mode], test->file_name,
+		   test_file_mode_lbl[test->file_mode], test->file_group_size,
+		   test->files_per_task, test->file_dir_hash, test->file_name,
 		   (test->file_name_append_sequence_num ? "true" : "false"),
 		   (test->file_name_append_task_id ? "true" : "false"),
 		   (test->file_dir_per_task ? "true" : "false"),
-		   (test->file_keep ? "true" : "false"), wkld, afio, afsb);
+		   (test->file_keep ? "true" : "false"),
+		   test_file_prealloc_lbl[test->file_prealloc],
+		   (test->file_reuse ? "true" : "false"),
+		   (test->file_truncate ? "true" : "false"), wkld, afio, afsb);
 	}
     }
 
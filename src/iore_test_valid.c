@@ -8,10 +8,18 @@
 
 #include "iore_test_valid.h"
 #include "iore_workload_valid.h"
+#include "iore_workload.h"
 #include "iore_valid.h"
 #include "iore_error.h"
 #include "iore_afio.h"
 #include "iore_afsb.h"
+#include "iore_dict.h"
+#include "iore_util.h"
+
+/*** PROTOTYPES **************************************************************/
+
+static int
+test_valid_direct (iore_test_t *);
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -32,17 +40,121 @@ test_valid (iore_test_t *test)
       test->type.write = true;
     }
 
+  if (test->write_flush_mode == IORE_TEST_FLUSH_LENGTH)
+    {
+      iore_errorf(VALID_MSG_INVALID_OPTION, "write flush mode");
+      rerr = IORE_FAILURE;
+    }
+  else if (test->write_flush_mode != IORE_TEST_FLUSH_FSYNC
+      && test->afio.type != IORE_AFIO_POSIX)
+    {
+      iore_error("Validation: Write flush modes other than 'fsync' require "
+		 "the POSIX AFIO.");
+      rerr = IORE_FAILURE;
+    }
+  if (test->write_flush_per_req
+      && (test->afio.type == IORE_AFIO_CSTREAM
+	  || test->afio.type == IORE_AFIO_EMULATOR
+	  || test->afio.type == IORE_AFIO_NULL))
+    {
+      iore_error("Validation: Per-request write flushes require the POSIX "
+		 "or MPI-IO AFIO.");
+      rerr = IORE_FAILURE;
+    }
+  if (test->write_flush_window > 0
+      && test->write_flush_mode != IORE_TEST_FLUSH_SYNC_FILE_RANGE)
+    iore_warn("Write flush window is only used by 'sync_file_range' flushes.");
+  if (test->read_reorder == IORE_TEST_RREORDER_LENGTH)
+    {
+      iore_errorf(VALID_MSG_INVALID_OPTION, "read reorder");
+      rerr = IORE_FAILURE;
+    }
+  if (test->read_cache_defeat == IORE_TEST_CDEFEAT_LENGTH)
+    {
+      iore_errorf(VALID_MSG_INVALID_OPTION, "read cache defeat");
+      rerr = IORE_FAILURE;
+    }
+  else if (test->read_cache_defeat == IORE_TEST_CDEFEAT_DIRECT
+      && test->afio.type != IORE_AFIO_POSIX)
+    {
+      iore_error("Validation: Direct I/O reads require the POSIX AFIO.");
+      rerr = IORE_FAILURE;
+    }
+  else if (test->read_cache_defeat == IORE_TEST_CDEFEAT_DIRECT)
+    rerr |= test_valid_direct (test);
+  else if (test->read_cache_defeat == IORE_TEST_CDEFEAT_MEM_SWEEP
+      && test->read_cache_defeat_mem_size == 0)
+    {
+      iore_error("Validation: Memory sweeps require a non-zero memory size.");
+      rerr = IORE_FAILURE;
+    }
   if (test->file_mode == IORE_TEST_FMODE_LENGTH)
     {
       iore_errorf(VALID_MSG_INVALID_OPTION, "file mode");
       rerr = IORE_FAILURE;
     }
+  if (test->file_mode == IORE_TEST_FMODE_NXM
+      && test->wkld.type != IORE_WKLD_OFFSET)
+    {
+      iore_error("Validation: NxM file mode requires an offset workload.");
+      rerr = IORE_FAILURE;
+    }
+  if (test->files_per_task == 0)
+    {
+      iore_error("Validation: Each task must write at least one file.");
+      rerr = IORE_FAILURE;
+    }
+  else if (test->files_per_task > 1
+      && (test->file_mode != IORE_TEST_FMODE_NXN
+	  || test->wkld.type == IORE_WKLD_DATASET))
+    {
+      iore_error("Validation: Multiple files per task require NxN file mode "
+		 "and an offset or trace workload.");
+      rerr = IORE_FAILURE;
+    }
+  if (test->file_prealloc == IORE_TEST_FPREALLOC_LENGTH)
+    {
+      iore_errorf(VALID_MSG_INVALID_OPTION, "file preallocation");
+      rerr = IORE_FAILURE;
+    }
+  if (test->file_reuse && test->file_name_append_sequence_num)
+    {
+      iore_error("Validation: Reused files cannot have sequence numbers "
+		 "appended to their names.");
+      rerr = IORE_FAILURE;
+    }
   if (test->file_name == NULL || strlen (test->file_name) == 0)
     {
       iore_error("Validation: Empty file name.");
       rerr = IORE_FAILURE;
     }
 
+  if (test->afio.type == IORE_AFIO_NULL
+      && (test->file_prealloc != IORE_TEST_FPREALLOC_NONE
+	  || test->read_cache_defeat == IORE_TEST_CDEFEAT_FADVISE
+	  || test->read_cache_defeat == IORE_TEST_CDEFEAT_DROP_CACHES))
+    {
+      iore_error("Validation: File preallocation and page cache defeat "
+		 "require files, which the null AFIO does not create.");
+      rerr = IORE_FAILURE;
+    }
+
+  if (test->afsb && test->afsb->type == IORE_AFSB_STRIPED
+      && test->afio.type != IORE_AFIO_POSIX)
+    {
+      iore_error("Validation: The striped AFSB requires the POSIX AFIO.");
+      rerr = IORE_FAILURE;
+    }
+
+  /* traces issue different numbers of requests per task */
+  if (test->wkld.type == IORE_WKLD_TRACE && test->afio.type == IORE_AFIO_MPIIO
+      && strtob (dict_get (&test->afio.params, AFIO_PARAM_COLLECTIVE_IO)))
+    {
+      iore_error("Validation: Trace workloads do not support collective "
+		 "I/O.");
+      rerr = IORE_FAILURE;
+    }
+
   rerr |= wkld_valid (&test->wkld);
   rerr |= afio_valid (&test->afio);
   if (test->afsb)
@@ -50,3 +162,64 @@ test_valid (iore_test_t *test)
 
   return rerr;
 } /* test_valid () */
+
+/**
+ * O_DIRECT reads require sizes, offsets and buffers aligned to the logical
+ * block size of the file system, assumed not larger than
+ * TEST_DIRECT_ALIGNMENT. Buffers are allocated aligned, and offsets of
+ * offset workloads are sums of request sizes, so checking sizes suffices.
+ */
+static int
+test_valid_direct (iore_test_t *test)
+{
+  int rerr = IORE_SUCCESS;
+
+  unsigned int i;
+  if (test->wkld.type == IORE_WKLD_OFFSET)
+    {
+      iore_wkld_oset_t *oset = &test->wkld.u.oset;
+      if (oset->data_size_distrib || oset->req_size_distrib)
+	{
+	  iore_error("Validation: Direct I/O reads do not support data or "
+		     "request sizes drawn from distributions.");
+	  rerr = IORE_FAILURE;
+	}
+      for (i = 0; i < oset->_data_sizes_len; i++)
+	if (oset->data_sizes[i] % TEST_DIRECT_ALIGNMENT)
+	  break;
+      if (i < oset->_data_sizes_len)
+	{
+	  iore_errorf("Validation: Direct I/O reads require data sizes "
+		      "multiple of %d bytes.", TEST_DIRECT_ALIGNMENT);
+	  rerr = IORE_FAILURE;
+	}
+      for (i = 0; i < oset->_req_sizes_len; i++)
+	if (oset->req_sizes[i] % TEST_DIRECT_ALIGNMENT)
+	  break;
+      if (i < oset->_req_sizes_len)
+	{
+	  iore_errorf("Validation: Direct I/O reads require request sizes "
+		      "multiple of %d bytes.", TEST_DIRECT_ALIGNMENT);
+	  rerr = IORE_FAILURE;
+	}
+    }
+  else if (test->wkld.type == IORE_WKLD_DATASET)
+    {
+      iore_error("Validation: Direct I/O reads do not support dataset "
+		 "workloads, whose requests are not block aligned.");
+      rerr = IORE_FAILURE;
+    }
+  else if (test->wkld.type == IORE_WKLD_TRACE
+      && test->wkld.u.trace.file_name
+      && !wkld_trace_aligned (&test->wkld.u.trace, IORE_TEST_TYPE_READ,
+			      TEST_DIRECT_ALIGNMENT))
+    {
+      iore_errorf("Validation: Direct I/O reads require the read records of "
+		  "trace file '%s' to have offsets and sizes multiple of %d "
+		  "bytes.", test->wkld.u.trace.file_name,
+		  TEST_DIRECT_ALIGNMENT);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* test_valid_direct () */
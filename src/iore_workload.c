@@ -6,7 +6,13 @@
 
 #include <assert.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
 
 #include "iore_workload.h"
 #include "iore_test_types.h"
@@ -53,6 +59,8 @@ wkld_free (iore_wkld_t *this)
 	wkld_oset_free (&this->u.oset);
       else if (this->type == IORE_WKLD_DATASET)
 	wkld_dset_free (&this->u.dset);
+      else if (this->type == IORE_WKLD_TRACE)
+	wkld_trace_free (&this->u.trace);
     }
 } /* wkld_free () */
 
@@ -123,6 +131,179 @@ wkld_dset_cart_free (iore_wkld_dset_cart_t *this)
     }
 } /* wkld_dset_cart_free () */
 
+void
+wkld_trace_free (iore_wkld_trace_t *this)
+{
+  if (this)
+    {
+      wkld_trace_unmap (this);
+      if (this->file_name)
+	{
+	  free (this->file_name);
+	  this->file_name = NULL;
+	}
+    }
+} /* wkld_trace_free () */
+
+/**
+ * Maps the records of rank 'task_id' from the trace file and sums up those
+ * of test type 'type'. Only the records of the rank are mapped, and pages
+ * are read in on demand, so that traces need not fit in memory. Ranks not
+ * in the trace replay no records. The file ids of the records must be lower
+ * than 'num_files'.
+ */
+int
+wkld_trace_map (iore_wkld_trace_t *trace, int task_id,
+		enum iore_test_type type, unsigned int num_files)
+{
+  assert(trace);
+
+  trace->my_recs = NULL;
+  trace->_my_recs_len = 0;
+  trace->my_data_size = 0;
+  trace->my_req_size = 0;
+  trace->_num_reqs = 0;
+  trace->_file_size = 0;
+  trace->_first_time = UINT64_MAX;
+  trace->_map = NULL;
+  trace->_map_size = 0;
+
+  int fd = open (trace->file_name, O_RDONLY);
+  if (fd < 0)
+    {
+      iore_errorf_all("Failed opening trace file '%s'.", trace->file_name);
+      return IORE_FAILURE;
+    }
+
+  struct stat st;
+  iore_wkld_trace_hdr_t hdr;
+  if (fstat (fd, &st)
+      || pread (fd, &hdr, sizeof(hdr), 0) != (ssize_t) sizeof(hdr)
+      || memcmp (hdr.magic, WKLD_TRACE_MAGIC, sizeof(hdr.magic))
+      || hdr.time_mode >= IORE_WKLD_TRACE_TIME_LENGTH)
+    {
+      close (fd);
+      iore_errorf_all("Invalid trace file '%s'.", trace->file_name);
+      return IORE_FAILURE;
+    }
+  trace->_time_mode = hdr.time_mode;
+
+  if ((unsigned int) task_id >= hdr.num_ranks)
+    {
+      close (fd);
+      return IORE_SUCCESS;
+    }
+
+  /* the records of the rank, bounded by the file */
+  uint64_t idx[2];
+  off_t recs_off = sizeof(hdr) + (hdr.num_ranks + 1) * sizeof(uint64_t);
+  if (pread (fd, idx, sizeof(idx), sizeof(hdr) + task_id * sizeof(uint64_t))
+      != (ssize_t) sizeof(idx) || idx[0] > idx[1]
+      || recs_off + idx[1] * sizeof(iore_wkld_trace_rec_t)
+	  > (uint64_t) st.st_size)
+    {
+      close (fd);
+      iore_errorf_all("Invalid trace file '%s'.", trace->file_name);
+      return IORE_FAILURE;
+    }
+  if (idx[0] == idx[1])
+    {
+      close (fd);
+      return IORE_SUCCESS;
+    }
+
+  /* maps from the page holding the first record */
+  off_t first = recs_off + idx[0] * sizeof(iore_wkld_trace_rec_t);
+  off_t map_off = first - first % sysconf (_SC_PAGESIZE);
+  size_t len = idx[1] - idx[0];
+  trace->_map_size = first - map_off + len * sizeof(iore_wkld_trace_rec_t);
+  trace->_map = mmap (NULL, trace->_map_size, PROT_READ, MAP_SHARED, fd,
+		      map_off);
+  close (fd);
+  if (trace->_map == MAP_FAILED)
+    {
+      trace->_map = NULL;
+      trace->_map_size = 0;
+      iore_errorf_all("Failed mapping trace file '%s'.", trace->file_name);
+      return IORE_FAILURE;
+    }
+  madvise (trace->_map, trace->_map_size, MADV_SEQUENTIAL);
+  trace->my_recs = (const iore_wkld_trace_rec_t *) ((char *) trace->_map
+      + (first - map_off));
+  trace->_my_recs_len = len;
+
+  size_t i;
+  for (i = 0; i < len; i++)
+    {
+      const iore_wkld_trace_rec_t *rec = &trace->my_recs[i];
+      if (rec->file_id >= num_files || rec->op >= IORE_TEST_TYPE_LENGTH)
+	{
+	  iore_errorf_all("Invalid record %zu of rank %d in trace file '%s'.",
+			  i, task_id, trace->file_name);
+	  wkld_trace_unmap (trace);
+	  return IORE_FAILURE;
+	}
+      if (rec->offset + rec->size > trace->_file_size)
+	trace->_file_size = rec->offset + rec->size;
+      if (rec->op != type)
+	continue;
+
+      trace->my_data_size += rec->size;
+      if (rec->size > trace->my_req_size)
+	trace->my_req_size = rec->size;
+      if (rec->time < trace->_first_time)
+	trace->_first_time = rec->time;
+      trace->_num_reqs++;
+    }
+
+  return IORE_SUCCESS;
+} /* wkld_trace_map () */
+
+void
+wkld_trace_unmap (iore_wkld_trace_t *trace)
+{
+  if (trace && trace->_map)
+    {
+      munmap (trace->_map, trace->_map_size);
+      trace->_map = NULL;
+      trace->_map_size = 0;
+      trace->my_recs = NULL;
+      trace->_my_recs_len = 0;
+    }
+} /* wkld_trace_unmap () */
+
+/**
+ * Checks that the records of test type 'type' in the trace file, of all
+ * ranks, have offsets and sizes multiple of 'align'. Records are streamed,
+ * so that traces need not fit in memory. Unreadable trace files are left
+ * for wkld_trace_map () to report.
+ */
+bool
+wkld_trace_aligned (const iore_wkld_trace_t *trace, enum iore_test_type type,
+		    size_t align)
+{
+  assert(trace);
+  assert(align > 0);
+
+  FILE *fp = fopen (trace->file_name, "r");
+  if (fp == NULL)
+    return true;
+
+  bool aligned = true;
+  iore_wkld_trace_hdr_t hdr;
+  if (fread (&hdr, sizeof(hdr), 1, fp) == 1
+      && fseeko (fp, (hdr.num_ranks + 1) * sizeof(uint64_t), SEEK_CUR) == 0)
+    {
+      iore_wkld_trace_rec_t rec;
+      while (aligned && fread (&rec, sizeof(rec), 1, fp) == 1)
+	if (rec.op == type && (rec.offset % align || rec.size % align))
+	  aligned = false;
+    }
+  fclose (fp);
+
+  return aligned;
+} /* wkld_trace_aligned () */
+
 off_t *
 dset_to_off (const iore_wkld_dset_t *dset, enum iore_test_file_mode file_mode)
 {
@@ -16,18 +16,23 @@
 
 #define WKLDOSET2STR_FORMAT "offset (%p) { ac_pattern = '%s', data_sizes (%p) = [ %s ], _data_sizes_len = %u, req_sizes (%p) = [ %s ], _req_sizes_len = %u, data_size_distrib = %s, req_size_distrib = %s, my_data_size = %zu, my_req_size = %zu, _file_size = %zu }"
 #define WKLDDSET2STR_FORMAT "dataset (%p) { num_vars = %u, var_types (%p) = [ %s ], type = %s, my_size = %zu, _vars_size = %zu }"
+#define WKLDTRACE2STR_FORMAT "trace (%p) { file_name = '%s', timing = '%s', my_recs = %p, _my_recs_len = %zu, _time_mode = '%s', my_data_size = %zu, my_req_size = %zu, _num_reqs = %zu, _file_size = %zu, _first_time = %llu }"
 #define WKLDDSETCART2STR_FORMAT "cartesian (%p) { num_dims = %u, g_dim_sizes (%p) = [ %s ], g_dim_divs (%p) = [ %s ], my_dim_sizes (%p) = [ %s ], my_start_coord  (%p) = [ %s ] }"
 
 /*** VARIABLES ***************************************************************/
 
 const char * const wkld_type_lbl[IORE_WKLD_LENGTH] =
-  { "offset", "dataset" };
+  { "offset", "dataset", "trace" };
 const char * const wkld_oset_access_pattern_lbl[IORE_WKLD_OSET_AP_LENGTH] =
   { "sequential", "random" };
 const char * const wkld_dset_type_lbl[IORE_WKLD_DSET_LENGTH] =
   { "cartesian" };
 const char * const wkld_dset_var_type_lbl[IORE_WKLD_DSET_DV_LENGTH] =
   { "char", "integer", "long", "long long", "float", "double" };
+const char * const wkld_trace_timing_lbl[IORE_WKLD_TRACE_TM_LENGTH] =
+  { "none", "recorded" };
+const char * const wkld_trace_time_mode_lbl[IORE_WKLD_TRACE_TIME_LENGTH] =
+  { "none", "stamp", "think" };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -43,6 +48,8 @@ wkld2str (const iore_wkld_t *wkld)
 	type = wkldoset2str (&wkld->u.oset);
       else if (wkld->type == IORE_WKLD_DATASET)
 	type = wklddset2str (&wkld->u.dset);
+      else if (wkld->type == IORE_WKLD_TRACE)
+	type = wkldtrace2str (&wkld->u.trace);
 
       int len = snprintf (str, 0, WKLD2STR_FORMAT, wkld, wkld->num_tasks, type)
 	  + 1;
@@ -184,3 +191,36 @@ wklddsetcart2str (const iore_wkld_dset_cart_t *cart)
 
   return str;
 } /* wklddsetcart2str () */
+
+char *
+wkldtrace2str (const iore_wkld_trace_t *trace)
+{
+  char *str = NULL;
+
+  if (trace)
+    {
+      const char *time_mode = (
+	  trace->_time_mode < IORE_WKLD_TRACE_TIME_LENGTH ?
+	      wkld_trace_time_mode_lbl[trace->_time_mode] : NULL);
+
+      int len = snprintf (str, 0, WKLDTRACE2STR_FORMAT, trace,
+			  trace->file_name,
+			  wkld_trace_timing_lbl[trace->timing], trace->my_recs,
+			  trace->_my_recs_len, time_mode, trace->my_data_size,
+			  trace->my_req_size, trace->_num_reqs,
+			  trace->_file_size,
+			  (unsigned long long) trace->_first_time) + 1;
+      if (len > 0)
+	{
+	  str = malloc (len);
+	  assert(str);
+	  snprintf (str, len, WKLDTRACE2STR_FORMAT, trace, trace->file_name,
+		    wkld_trace_timing_lbl[trace->timing], trace->my_recs,
+		    trace->_my_recs_len, time_mode, trace->my_data_size,
+		    trace->my_req_size, trace->_num_reqs, trace->_file_size,
+		    (unsigned long long) trace->_first_time);
+	}
+    }
+
+  return str;
+} /* wkldtrace2str () */
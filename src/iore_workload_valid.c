@@ -4,11 +4,14 @@
  * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
  */
 
+#include <string.h>
+
 #include "iore_workload_valid.h"
 #include "iore_valid.h"
 #include "iore_error.h"
 #include "iore_ctx.h"
 #include "iore_prng.h"
+#include "iore_file.h"
 
 /*** PROTOTYPES **************************************************************/
 
@@ -18,6 +21,8 @@ static int
 wkld_dset_valid (iore_wkld_dset_t *, unsigned int);
 static int
 wkld_dset_cart_valid (iore_wkld_dset_cart_t *, unsigned int);
+static int
+wkld_trace_valid (iore_wkld_trace_t *);
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -43,6 +48,8 @@ wkld_valid (iore_wkld_t *wkld)
     rerr |= wkld_oset_valid (&wkld->u.oset);
   else if (wkld->type == IORE_WKLD_DATASET)
     rerr |= wkld_dset_valid (&wkld->u.dset, wkld->num_tasks);
+  else if (wkld->type == IORE_WKLD_TRACE)
+    rerr |= wkld_trace_valid (&wkld->u.trace);
 
   return rerr;
 } /* wkld_valid () */
@@ -169,3 +176,31 @@ wkld_dset_cart_valid (iore_wkld_dset_cart_t *cart, unsigned int num_tasks)
 
   return rerr;
 } /* wkld_dset_cart_valid () */
+
+static int
+wkld_trace_valid (iore_wkld_trace_t *trace)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (trace->file_name == NULL || strlen (trace->file_name) == 0)
+    {
+      iore_error("Validation: Empty trace file name.");
+      rerr = IORE_FAILURE;
+    }
+  else if (!file_exists (trace->file_name)
+      || !file_is_regular (trace->file_name)
+      || !file_is_readable (trace->file_name))
+    {
+      iore_errorf("Validation: Unreadable trace file '%s'.",
+		  trace->file_name);
+      rerr = IORE_FAILURE;
+    }
+
+  if (trace->timing >= IORE_WKLD_TRACE_TM_LENGTH)
+    {
+      iore_errorf(VALID_MSG_INVALID_OPTION, "trace timing");
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* wkld_trace_valid () */
@@ -0,0 +1,610 @@
+/*
+ * iore_lmet.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <mpi.h>
+
+#include "iore_lmet.h"
+#include "iore_test_types.h"
+#include "iore_trec_types.h"
+#include "iore_error.h"
+
+/*** DEFINES *****************************************************************/
+
+#define LMET_DEFAULT_INTERVAL_MS 1000
+#define LMET_NODE_PATH_FORMAT "%s.%d" /* paths of nodes other than the first */
+#define LMET_TMP_FILE_FORMAT "%s.tmp"
+#define LMET_SEND_TIMEOUT_SECS 1
+#define LMET_LISTEN_BACKLOG 8
+
+/*** TYPES *******************************************************************/
+
+/**
+ * Server of the live metrics of a node, run by a thread of the first task of
+ * the node. It never calls MPI, it only reads the slots of the node tasks.
+ */
+typedef struct lmet_server
+{
+  int node;
+  char host[MPI_MAX_PROCESSOR_NAME];
+  unsigned int interval_ms;
+  char socket[FILENAME_MAX]; /* empty if not served on a socket */
+  char prom_file[FILENAME_MAX]; /* empty if not written to a file */
+
+  const iore_lmet_slot_t *slots;
+  int num_slots;
+  uint64_t *last_reqs; /* request counts seen at the last check */
+  double *last_progress; /* time the request counts last changed */
+
+  int listen_fd;
+  int stop_fd[2]; /* pipe waking the server up for stopping */
+  pthread_t thread;
+} lmet_server_t;
+
+typedef struct lmet_st
+{
+  bool started;
+  bool serving;
+  MPI_Comm node_comm;
+  MPI_Win win;
+  lmet_server_t server;
+} lmet_st_t;
+
+/*** PROTOTYPES **************************************************************/
+
+static int
+lmet_server_start (const iore_lmet_t *, int, iore_lmet_slot_t *, int);
+static void
+lmet_server_stop ();
+static int
+lmet_listen (const char *);
+static void *
+lmet_serve (void *);
+static void
+lmet_serve_client (lmet_server_t *);
+static void
+lmet_track (lmet_server_t *);
+static char *
+lmet_snapshot (lmet_server_t *, size_t *);
+static void
+lmet_family (FILE *, const char *, const char *, const char *);
+static int
+lmet_write_file (lmet_server_t *);
+static void
+lmet_node_path (const char *, int, char *);
+static double
+lmet_curtime ();
+
+/*** VARIABLES ***************************************************************/
+
+static lmet_st_t state =
+  { .started = false, .serving = false, .node_comm = MPI_COMM_NULL, .win =
+  MPI_WIN_NULL };
+
+/*** FUNCTIONS ***************************************************************/
+
+iore_lmet_t *
+lmet_init (iore_lmet_t *this)
+{
+  assert(this);
+
+  this->interval_ms = LMET_DEFAULT_INTERVAL_MS;
+  this->socket = NULL;
+  this->prom_file = NULL;
+
+  return this;
+} /* lmet_init () */
+
+void
+lmet_free (iore_lmet_t *this)
+{
+  if (this)
+    {
+      if (this->socket)
+	{
+	  free (this->socket);
+	  this->socket = NULL;
+	}
+      if (this->prom_file)
+	{
+	  free (this->prom_file);
+	  this->prom_file = NULL;
+	}
+    }
+} /* lmet_free () */
+
+bool
+lmet_enabled (const iore_lmet_t *this)
+{
+  return (this && (this->socket || this->prom_file));
+} /* lmet_enabled () */
+
+/**
+ * Sets up the live metrics, collectively over all tasks. The slots of the
+ * tasks of a node lie in a shared memory segment, read by a server thread of
+ * the first task of the node. Metrics are thus served per node; the paths of
+ * the socket and file of nodes other than the first are suffixed with the
+ * node number.
+ */
+int
+lmet_start (const iore_lmet_t *lmet)
+{
+  if (!lmet_enabled (lmet))
+    return IORE_SUCCESS;
+
+  /* the server thread does not call MPI, the main thread does */
+  int provided;
+  MPI_Query_thread (&provided);
+  if (provided < MPI_THREAD_FUNNELED)
+    {
+      iore_error("Live metrics require MPI thread support.");
+      return IORE_FAILURE;
+    }
+
+  MPI_Comm_split_type (MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, ctx.task_id,
+		       MPI_INFO_NULL, &state.node_comm);
+  int local_id, local_size;
+  MPI_Comm_rank (state.node_comm, &local_id);
+  MPI_Comm_size (state.node_comm, &local_size);
+
+  iore_lmet_slot_t *slots;
+  MPI_Aint size = (local_id == 0 ? local_size * sizeof(iore_lmet_slot_t) : 0);
+  MPI_Win_allocate_shared (size, sizeof(iore_lmet_slot_t), MPI_INFO_NULL,
+			   state.node_comm, &slots, &state.win);
+  int disp_unit;
+  MPI_Win_shared_query (state.win, 0, &size, &disp_unit, &slots);
+  state.started = true;
+
+  iore_lmet_slot_t *slot = &slots[local_id];
+  memset (slot, 0, sizeof(iore_lmet_slot_t));
+  slot->task_id = ctx.task_id;
+  slot->test_type = IORE_LMET_IDLE;
+  slot->action = IORE_LMET_IDLE;
+
+  /* nodes are numbered after the order of their first tasks */
+  MPI_Comm leader_comm;
+  MPI_Comm_split (MPI_COMM_WORLD, (local_id == 0 ? 0 : MPI_UNDEFINED),
+		  ctx.task_id, &leader_comm);
+  int node = 0;
+  if (leader_comm != MPI_COMM_NULL)
+    {
+      MPI_Comm_rank (leader_comm, &node);
+      MPI_Comm_free (&leader_comm);
+    }
+  MPI_Bcast (&node, 1, MPI_INT, 0, state.node_comm);
+
+  /* slots are set before the server reads them */
+  MPI_Win_sync (state.win);
+  MPI_Barrier (state.node_comm);
+
+  int rerr = IORE_SUCCESS;
+  if (local_id == 0)
+    rerr = lmet_server_start (lmet, node, slots, local_size);
+  MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (rerr)
+    {
+      lmet_stop ();
+      return IORE_FAILURE;
+    }
+
+  ctx.lmet = slot;
+
+  return IORE_SUCCESS;
+} /* lmet_start () */
+
+/**
+ * Stops the live metrics, collectively over all tasks. The server writes
+ * the file a last time, with the final counters.
+ */
+void
+lmet_stop ()
+{
+  if (!state.started)
+    return;
+
+  ctx.lmet = NULL;
+  MPI_Barrier (state.node_comm);
+
+  if (state.serving)
+    lmet_server_stop ();
+
+  MPI_Win_free (&state.win);
+  MPI_Comm_free (&state.node_comm);
+  state.started = false;
+} /* lmet_stop () */
+
+static int
+lmet_server_start (const iore_lmet_t *lmet, int node, iore_lmet_slot_t *slots,
+		   int num_slots)
+{
+  lmet_server_t *srv = &state.server;
+  memset (srv, 0, sizeof(lmet_server_t));
+
+  srv->node = node;
+  int len;
+  MPI_Get_processor_name (srv->host, &len);
+  srv->interval_ms = lmet->interval_ms;
+  if (lmet->socket)
+    lmet_node_path (lmet->socket, node, srv->socket);
+  if (lmet->prom_file)
+    lmet_node_path (lmet->prom_file, node, srv->prom_file);
+
+  srv->slots = slots;
+  srv->num_slots = num_slots;
+  srv->last_reqs = calloc (num_slots, sizeof(uint64_t));
+  assert(srv->last_reqs);
+  srv->last_progress = malloc (num_slots * sizeof(double));
+  assert(srv->last_progress);
+  double now = lmet_curtime ();
+  int i;
+  for (i = 0; i < num_slots; i++)
+    srv->last_progress[i] = now;
+
+  srv->listen_fd = -1;
+  srv->stop_fd[0] = srv->stop_fd[1] = -1;
+  int rerr = IORE_SUCCESS;
+  if (pipe (srv->stop_fd))
+    {
+      iore_error_all("Failed creating the live metrics stop pipe.");
+      rerr = IORE_FAILURE;
+    }
+  if (!rerr && srv->socket[0])
+    {
+      srv->listen_fd = lmet_listen (srv->socket);
+      if (srv->listen_fd < 0)
+	rerr = IORE_FAILURE;
+    }
+  if (!rerr && pthread_create (&srv->thread, NULL, lmet_serve, srv))
+    {
+      iore_error_all("Failed creating the live metrics server thread.");
+      rerr = IORE_FAILURE;
+    }
+
+  if (rerr)
+    lmet_server_stop ();
+  else
+    state.serving = true;
+
+  return rerr;
+} /* lmet_server_start () */
+
+static void
+lmet_server_stop ()
+{
+  lmet_server_t *srv = &state.server;
+
+  if (state.serving)
+    {
+      char c = 0;
+      if (write (srv->stop_fd[1], &c, 1) != 1)
+	iore_warn_all("Failed stopping the live metrics server.");
+      pthread_join (srv->thread, NULL);
+      state.serving = false;
+    }
+
+  if (srv->listen_fd >= 0)
+    {
+      close (srv->listen_fd);
+      unlink (srv->socket);
+      srv->listen_fd = -1;
+    }
+  if (srv->stop_fd[0] >= 0)
+    close (srv->stop_fd[0]);
+  if (srv->stop_fd[1] >= 0)
+    close (srv->stop_fd[1]);
+  srv->stop_fd[0] = srv->stop_fd[1] = -1;
+
+  free (srv->last_reqs);
+  free (srv->last_progress);
+  srv->last_reqs = NULL;
+  srv->last_progress = NULL;
+} /* lmet_server_stop () */
+
+/**
+ * Binds a listening socket to 'path'. A stale socket left at 'path' is
+ * replaced; any other file is left untouched.
+ */
+static int
+lmet_listen (const char *path)
+{
+  struct stat st;
+  if (stat (path, &st) == 0)
+    {
+      if (!S_ISSOCK(st.st_mode))
+	{
+	  iore_errorf_all("File '%s' exists and is not a socket.", path);
+	  return -1;
+	}
+      unlink (path);
+    }
+
+  int fd = socket (AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    {
+      iore_error_all("Failed creating the live metrics socket.");
+      return -1;
+    }
+
+  struct sockaddr_un addr;
+  memset (&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy (addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  if (bind (fd, (struct sockaddr *) &addr, sizeof(addr))
+      || listen (fd, LMET_LISTEN_BACKLOG))
+    {
+      iore_errorf_all("Failed binding socket '%s'.", path);
+      close (fd);
+      return -1;
+    }
+
+  return fd;
+} /* lmet_listen () */
+
+/**
+ * Server loop. Each client connecting to the socket gets a snapshot and is
+ * disconnected; the file is rewritten at every interval.
+ */
+static void *
+lmet_serve (void *arg)
+{
+  lmet_server_t *srv = arg;
+
+  struct pollfd fds[2];
+  fds[0].fd = srv->stop_fd[0];
+  fds[0].events = POLLIN;
+  fds[1].fd = srv->listen_fd;
+  fds[1].events = POLLIN;
+  nfds_t nfds = (srv->listen_fd >= 0 ? 2 : 1);
+
+  double interval = srv->interval_ms / 1e3;
+  double next = lmet_curtime () + interval;
+  bool stop = false;
+  while (!stop)
+    {
+      double now = lmet_curtime ();
+      int timeout = (now < next ? (int) ((next - now) * 1e3) + 1 : 0);
+      fds[0].revents = fds[1].revents = 0;
+      if (poll (fds, nfds, timeout) < 0 && errno != EINTR)
+	break;
+
+      if (fds[0].revents)
+	stop = true;
+      if (nfds > 1 && (fds[1].revents & POLLIN))
+	lmet_serve_client (srv);
+
+      now = lmet_curtime ();
+      if (now >= next || stop)
+	{
+	  lmet_track (srv);
+	  if (srv->prom_file[0])
+	    lmet_write_file (srv);
+	  next = (next + interval > now ? next + interval : now + interval);
+	}
+    }
+
+  return NULL;
+} /* lmet_serve () */
+
+static void
+lmet_serve_client (lmet_server_t *srv)
+{
+  int fd = accept (srv->listen_fd, NULL, NULL);
+  if (fd < 0)
+    return;
+
+  /* a stuck client does not hold the server */
+  struct timeval tv =
+    { .tv_sec = LMET_SEND_TIMEOUT_SECS, .tv_usec = 0 };
+  setsockopt (fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+  lmet_track (srv);
+  size_t len;
+  char *buf = lmet_snapshot (srv, &len);
+  size_t sent = 0;
+  while (buf && sent < len)
+    {
+      ssize_t n = send (fd, buf + sent, len - sent, MSG_NOSIGNAL);
+      if (n <= 0)
+	break;
+      sent += n;
+    }
+  free (buf);
+  close (fd);
+} /* lmet_serve_client () */
+
+/**
+ * Tracks the progress of the tasks. A task in a write/read action whose
+ * request count did not change is stalled since it last changed.
+ */
+static void
+lmet_track (lmet_server_t *srv)
+{
+  double now = lmet_curtime ();
+  int i;
+  for (i = 0; i < srv->num_slots; i++)
+    {
+      const iore_lmet_slot_t *slot = &srv->slots[i];
+      uint64_t reqs = __atomic_load_n (&slot->reqs, __ATOMIC_RELAXED);
+      int action = __atomic_load_n (&slot->action, __ATOMIC_RELAXED);
+      if (reqs != srv->last_reqs[i] || action != IORE_TREC_ACTION_WRITE_READ)
+	{
+	  srv->last_reqs[i] = reqs;
+	  srv->last_progress[i] = now;
+	}
+    }
+} /* lmet_track () */
+
+/**
+ * Returns the metrics of the node in Prometheus text exposition format.
+ */
+static char *
+lmet_snapshot (lmet_server_t *srv, size_t *len)
+{
+  char *buf = NULL;
+  FILE *out = open_memstream (&buf, len);
+  if (!out)
+    return NULL;
+
+  int n = srv->num_slots;
+  iore_lmet_slot_t *slots = malloc (n * sizeof(iore_lmet_slot_t));
+  assert(slots);
+  double now = lmet_curtime ();
+  uint64_t node_bytes = 0, node_reqs = 0;
+  int busy = 0, stalled = 0;
+  int i;
+  for (i = 0; i < n; i++)
+    {
+      const iore_lmet_slot_t *slot = &srv->slots[i];
+      slots[i].task_id = __atomic_load_n (&slot->task_id, __ATOMIC_RELAXED);
+      slots[i].test_type = __atomic_load_n (&slot->test_type,
+      __ATOMIC_RELAXED);
+      slots[i].action = __atomic_load_n (&slot->action, __ATOMIC_RELAXED);
+      slots[i].exp_repl_id = __atomic_load_n (&slot->exp_repl_id,
+      __ATOMIC_RELAXED);
+      slots[i].run_id = __atomic_load_n (&slot->run_id, __ATOMIC_RELAXED);
+      slots[i].run_rept_id = __atomic_load_n (&slot->run_rept_id,
+      __ATOMIC_RELAXED);
+      slots[i].bytes = __atomic_load_n (&slot->bytes, __ATOMIC_RELAXED);
+      slots[i].reqs = __atomic_load_n (&slot->reqs, __ATOMIC_RELAXED);
+
+      node_bytes += slots[i].bytes;
+      node_reqs += slots[i].reqs;
+      if (slots[i].action != IORE_LMET_IDLE)
+	busy++;
+      if (now - srv->last_progress[i] >= srv->interval_ms / 1e3)
+	stalled++;
+    }
+
+  lmet_family (out, "iore_live_bytes_total",
+	       "Bytes written/read by the task.", "counter");
+  for (i = 0; i < n; i++)
+    fprintf (out, "iore_live_bytes_total{node=\"%d\",host=\"%s\",task=\"%d\"} "
+	     "%llu\n",
+	     srv->node, srv->host, slots[i].task_id,
+	     (unsigned long long) slots[i].bytes);
+
+  lmet_family (out, "iore_live_requests_total",
+	       "Requests written/read by the task.", "counter");
+  for (i = 0; i < n; i++)
+    fprintf (out, "iore_live_requests_total{node=\"%d\",host=\"%s\","
+	     "task=\"%d\"} %llu\n",
+	     srv->node, srv->host, slots[i].task_id,
+	     (unsigned long long) slots[i].reqs);
+
+  lmet_family (out, "iore_live_stall_seconds",
+	       "Seconds without a completed request in a write/read action.",
+	       "gauge");
+  for (i = 0; i < n; i++)
+    fprintf (out, "iore_live_stall_seconds{node=\"%d\",host=\"%s\","
+	     "task=\"%d\"} %.3f\n",
+	     srv->node, srv->host, slots[i].task_id,
+	     now - srv->last_progress[i]);
+
+  lmet_family (out, "iore_live_action", "Current test action of the task.",
+	       "gauge");
+  for (i = 0; i < n; i++)
+    {
+      int type = slots[i].test_type, action = slots[i].action;
+      fprintf (out, "iore_live_action{node=\"%d\",host=\"%s\",task=\"%d\","
+	       "test=\"%s\",action=\"%s\",exp_repl_id=\"%u\",run_id=\"%u\","
+	       "run_rept_id=\"%u\"} 1\n",
+	       srv->node, srv->host, slots[i].task_id,
+	       (type >= 0 && type < IORE_TEST_TYPE_LENGTH) ?
+		   test_type_lbl[type] : "none",
+	       (action >= 0 && action < IORE_TREC_ACTION_LENGTH) ?
+		   trec_action_lbl[action] : "idle",
+	       slots[i].exp_repl_id, slots[i].run_id, slots[i].run_rept_id);
+    }
+
+  lmet_family (out, "iore_live_node_bytes_total",
+	       "Bytes written/read by the tasks of the node.", "counter");
+  fprintf (out, "iore_live_node_bytes_total{node=\"%d\",host=\"%s\"} %llu\n",
+	   srv->node, srv->host, (unsigned long long) node_bytes);
+  lmet_family (out, "iore_live_node_requests_total",
+	       "Requests written/read by the tasks of the node.", "counter");
+  fprintf (out, "iore_live_node_requests_total{node=\"%d\",host=\"%s\"} "
+	   "%llu\n",
+	   srv->node, srv->host, (unsigned long long) node_reqs);
+  lmet_family (out, "iore_live_node_busy_tasks",
+	       "Tasks of the node in a test action.", "gauge");
+  fprintf (out, "iore_live_node_busy_tasks{node=\"%d\",host=\"%s\"} %d\n",
+	   srv->node, srv->host, busy);
+  lmet_family (out, "iore_live_node_stalled_tasks",
+	       "Tasks of the node stalled for an interval or longer.", "gauge");
+  fprintf (out, "iore_live_node_stalled_tasks{node=\"%d\",host=\"%s\"} %d\n",
+	   srv->node, srv->host, stalled);
+
+  free (slots);
+  fclose (out);
+
+  return buf;
+} /* lmet_snapshot () */
+
+static void
+lmet_family (FILE *out, const char *name, const char *help, const char *type)
+{
+  fprintf (out, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+} /* lmet_family () */
+
+/**
+ * Rewrites the file with a snapshot, through a temporary file renamed over
+ * it, so readers never see a partial snapshot.
+ */
+static int
+lmet_write_file (lmet_server_t *srv)
+{
+  size_t len;
+  char *buf = lmet_snapshot (srv, &len);
+  if (!buf)
+    return IORE_FAILURE;
+
+  char tmp[FILENAME_MAX + 4];
+  snprintf (tmp, sizeof(tmp), LMET_TMP_FILE_FORMAT, srv->prom_file);
+  int rerr = IORE_FAILURE;
+  FILE *file = fopen (tmp, "w");
+  if (file)
+    {
+      if (fwrite (buf, 1, len, file) == len)
+	rerr = IORE_SUCCESS;
+      if (fclose (file))
+	rerr = IORE_FAILURE;
+      if (!rerr && rename (tmp, srv->prom_file))
+	rerr = IORE_FAILURE;
+      if (rerr)
+	unlink (tmp);
+    }
+  free (buf);
+
+  return rerr;
+} /* lmet_write_file () */
+
+static void
+lmet_node_path (const char *path, int node, char *node_path)
+{
+  if (node == 0)
+    snprintf (node_path, FILENAME_MAX, "%s", path);
+  else
+    snprintf (node_path, FILENAME_MAX, LMET_NODE_PATH_FORMAT, path, node);
+} /* lmet_node_path () */
+
+static double
+lmet_curtime ()
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+} /* lmet_curtime () */
@@ -0,0 +1,34 @@
+/*
+ * iore_lmet_types.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "iore_lmet_types.h"
+
+/*** FUNCTIONS ***************************************************************/
+
+char *
+lmet2str (const iore_lmet_t *lmet)
+{
+  char *str = NULL;
+
+  if (lmet)
+    {
+      int len = snprintf(str, 0, LMET2STR_FORMAT, lmet, lmet->interval_ms,
+	  lmet->socket, lmet->prom_file) + 1;
+      if (len > 0)
+	{
+	  str = malloc (len);
+	  assert(str);
+	  snprintf(str, len, LMET2STR_FORMAT, lmet, lmet->interval_ms,
+		   lmet->socket, lmet->prom_file);
+	}
+    }
+
+  return str;
+} /* lmet2str () */
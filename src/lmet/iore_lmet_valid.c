@@ -0,0 +1,51 @@
+/*
+ * iore_lmet_valid.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <string.h>
+#include <sys/un.h>
+
+#include "iore_lmet_valid.h"
+#include "iore_valid.h"
+#include "iore_error.h"
+
+/*** DEFINES *****************************************************************/
+
+/* room for the node suffix of socket paths, see lmet_start () */
+#define LMET_NODE_SUFFIX_LEN 12
+
+/*** FUNCTIONS ***************************************************************/
+
+int
+lmet_valid (iore_lmet_t *lmet)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (lmet->socket || lmet->prom_file)
+    {
+      if (lmet->interval_ms == 0)
+	{
+	  iore_errorf(VALID_MSG_GREATER_ZERO, "live metrics interval");
+	  rerr = IORE_FAILURE;
+	}
+
+      if (lmet->socket
+	  && (strlen (lmet->socket) == 0
+	      || strlen (lmet->socket) + LMET_NODE_SUFFIX_LEN
+		  >= sizeof(((struct sockaddr_un *) 0)->sun_path)))
+	{
+	  iore_errorf(VALID_MSG_INVALID_VALUE, "live metrics socket path");
+	  rerr = IORE_FAILURE;
+	}
+
+      if (lmet->prom_file && strlen (lmet->prom_file) == 0)
+	{
+	  iore_error("Validation: Empty live metrics file path.");
+	  rerr = IORE_FAILURE;
+	}
+    }
+
+  return rerr;
+} /* lmet_valid () */
@@ -16,10 +16,11 @@
 #include "iore_ctx.h"
 #include "iore_file.h"
 #include "iore_parser_file.h"
+#include "iore_util.h"
 
 /*** DEFINES *****************************************************************/
 
-#define PARSER_OPTS "hvf:"
+#define PARSER_OPTS "hvrf:p:"
 #define PARSER_OPT_HELP "-h"
 
 /*** PROTOTYPES **************************************************************/
@@ -54,10 +55,23 @@ parse_cmdline_opts (int argc, char **argv, iore_exp_t *exp)
 	case 'v':
 	  ctx.verb_lvl++;
 	  break;
+	case 'r':
+	  exp->stex.resume = true;
+	  break;
+	case 'p':
+	  exp->plan = true;
+	  exp->plan_stripe_size = strtosz (optarg);
+	  if (exp->plan_stripe_size == 0)
+	    {
+	      iore_errorf("Invalid stripe size '%s'.", optarg);
+	      rerr = IORE_FAILURE;
+	    }
+	  break;
 	case 'f':
+	  /* errors are agreed by all tasks, and reported once */
 	  if (!parse (optarg, exp))
 	    {
-	      iore_fatalf("Unable to parse file '%s'.", optarg);
+	      iore_errorf("Unable to parse file '%s'.", optarg);
 	      rerr = IORE_FAILURE;
 	    }
 	  break;
@@ -69,6 +83,10 @@ parse_cmdline_opts (int argc, char **argv, iore_exp_t *exp)
 		iore_errorf("Option -%c requires the experiment definition "
 			    "file as argument.",
 			    optopt);
+	      else if (optopt == 'p')
+		iore_errorf("Option -%c requires the stripe size as "
+			    "argument.",
+			    optopt);
 	      else if (isprint(optopt))
 		iore_errorf("Unknown option -%c.", optopt);
 	      else
@@ -106,6 +124,12 @@ usage (char **argv)
       fputs ("OPTIONS:\n", stderr);
       fputs ("  -f FILE : experiment description file\n", stderr);
       fputs ("  -h      : displays this help message\n", stderr);
+      fputs ("  -p SIZE : plans the experiment without doing I/O, checking "
+	     "the alignment\n            of requests to stripes of SIZE "
+	     "bytes\n",
+	     stderr);
+      fputs ("  -r      : resumes a streamed experiment from its journal\n",
+	     stderr);
       fputs ("  -v      : verbose output\n", stderr);
       fflush (stderr);
     }
@@ -4,13 +4,24 @@
  * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
  */
 
+#include <mpi.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <assert.h>
 
 #include "iore_parser_file.h"
 #include "iore_error.h"
 #include "iore_file.h"
+#include "iore_ctx.h"
+
+/*** PROTOTYPES **************************************************************/
+
+static int
+prsr_backend (char *);
+static long long
+prsr_read_file (const char *, char **);
 
 /*** VARIABLES ***************************************************************/
 
@@ -20,40 +31,116 @@ static const iore_prsr_vtable_t *prsr_pool[] =
 
 /*** FUNCTIONS ***************************************************************/
 
+/**
+ * Parses the experiment definition file at 'path'. The file is read by the
+ * master task only and broadcast, so that other tasks do no file system
+ * I/O; all tasks then parse the same definition. Collective.
+ */
 iore_exp_t *
 parse (char *path, iore_exp_t *exp)
 {
   assert(exp);
 
+  char *buf = NULL;
+  long long len = -1;
+  int i_backend = -1;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      i_backend = prsr_backend (path);
+      if (i_backend >= 0)
+	len = prsr_read_file (path, &buf);
+    }
+
+  long long hdr[2] =
+    { i_backend, len };
+  MPI_Bcast (hdr, 2, MPI_LONG_LONG, IORE_MASTER_TASK, ctx.comm);
+  i_backend = hdr[0];
+  len = hdr[1];
+  if (i_backend < 0 || len <= 0)
+    return NULL;
+
+  if (ctx.task_id != IORE_MASTER_TASK)
+    {
+      buf = malloc (len);
+      assert(buf);
+    }
+  MPI_Bcast (buf, len, MPI_CHAR, IORE_MASTER_TASK, ctx.comm);
+
+  int rerr = prsr_pool[i_backend]->parse (buf, len, exp);
+  free (buf);
+
+  if (rerr)
+    return NULL;
+
+  return exp;
+} /* parse () */
+
+/**
+ * Returns the index of the parser of the file at 'path', by its extension,
+ * or -1 if the file cannot be parsed.
+ */
+static int
+prsr_backend (char *path)
+{
   if (!path || !file_exists (path) || !file_is_regular (path)
       || !file_is_readable (path))
-    return NULL;
+    return -1;
 
   char *ext = file_get_extension (path);
   if (!ext)
     {
       iore_errorf("File without extension '%s'.", path);
-      return NULL;
+      return -1;
     }
 
-  const iore_prsr_vtable_t *backend = NULL;
-  const iore_prsr_vtable_t *iter = prsr_pool[0];
-  while (iter && !backend)
+  int i;
+  for (i = 0; prsr_pool[i]; i++)
+    if (strcmp (ext, prsr_pool[i]->extension) == 0)
+      return i;
+
+  iore_errorf("Unsupported file type '%s'.", ext);
+  return -1;
+} /* prsr_backend () */
+
+/**
+ * Reads the file at 'path' into '*buf'. Returns its size, or -1 in case of
+ * failure.
+ */
+static long long
+prsr_read_file (const char *path, char **buf)
+{
+  FILE *fp = fopen (path, "r");
+  if (!fp)
     {
-      if (strcmp (ext, iter->extension) == 0)
-	backend = iter;
+      iore_errorf("Failed opening file '%s'.", path);
+      return -1;
+    }
 
-      iter++;
+  fseek (fp, 0, SEEK_END);
+  long int fsize = ftell (fp);
+  if (fsize <= 0 || fsize > INT_MAX)
+    {
+      fclose (fp);
+      if (fsize == 0)
+	iore_errorf("Empty file '%s'.", path);
+      else
+	iore_errorf("Failed getting file '%s' size.", path);
+      return -1;
     }
+  rewind (fp);
 
-  if (!backend)
+  *buf = malloc (fsize);
+  assert(*buf);
+  if (fread (*buf, fsize, 1, fp) != 1)
     {
-      iore_errorf("Unsupported file type '%s'.", ext);
-      return NULL;
+      fclose (fp);
+      free (*buf);
+      *buf = NULL;
+      iore_errorf("Failed reading file '%s'.", path);
+      return -1;
     }
 
-  if (backend->parse (path, exp))
-    return NULL;
+  fclose (fp);
 
-  return exp;
-} /* parse () */
+  return fsize;
+} /* prsr_read_file () */
@@ -20,6 +20,9 @@
 #include "iore_workload.h"
 #include "iore_util.h"
 #include "iore_prng.h"
+#include "iore_afsb.h"
+#include "iore_lmet.h"
+#include "iore_stex.h"
 
 /*** DEFINES *****************************************************************/
 
@@ -38,13 +41,59 @@
 #define JSON_MSG_INT_OPTION "JSON Parser: '%s': Must be an integer."
 #define JSON_MSG_INT_OUT_OF_RANGE "JSON Parser: '%s': Integer out of range."
 #define JSON_MSG_INT_POSITIVE "JSON Parser: '%s': Must be a positive integer."
+#define JSON_MSG_NUMBER_OPTION "JSON Parser: '%s': Must be a number."
 #define JSON_MSG_ARRAY_OPTION "JSON Parser: '%s': Must be an array."
 #define JSON_MSG_ARRAY_SIZE "JSON Parser: '%s': Must match the size of '%s'."
 
+/* upper bound of the runs generated by the sweep of a single run */
+#define JSON_SWEEP_MAX_RUNS 65536
+#define JSON_SWEEP_VALUE_LEN 32
+
+/*** TYPES *******************************************************************/
+
+enum json_sweep_mode
+{
+  JSON_SWEEP_PRODUCT, JSON_SWEEP_ZIP, JSON_SWEEP_MODE_LENGTH
+};
+
+/**
+ * Swept parameter: the path of a run attribute, with '.' between nesting
+ * levels, and the values it takes. Values generated from a range are
+ * owned by 'gen'.
+ */
+typedef struct json_sweep_param
+{
+  const char *path;
+  unsigned int num_vals;
+  json_value **vals;
+  json_value *gen;
+} json_sweep_param_t;
+
+/**
+ * Sweep of a run definition. Runs without a sweep have a single point.
+ */
+typedef struct json_sweep
+{
+  enum json_sweep_mode mode;
+  unsigned int num_params;
+  json_sweep_param_t *params;
+  unsigned int num_points;
+} json_sweep_t;
+
+/**
+ * Memory allocated while overriding the attributes of a run definition,
+ * released once the run is parsed.
+ */
+typedef struct json_scratch
+{
+  unsigned int len;
+  void **ptrs;
+} json_scratch_t;
+
 /*** PROTOTYPES **************************************************************/
 
 int
-jsonp_parse_file (const char *, iore_exp_t *);
+jsonp_parse (const char *, size_t, iore_exp_t *);
 
 static int
 json_check_uint (json_value *, const char *, unsigned int *);
@@ -56,9 +105,9 @@ static int
 json_check_bool (json_value *, const char *, bool *);
 static int
 json_check_size (json_value *, const char *, size_t *);
+static int
+json_check_double (json_value *, const char *, double *);
 
-static size_t
-json_read_file (const char *, json_char **);
 static int
 json_exp (json_value *, iore_exp_t *);
 static int
@@ -66,8 +115,34 @@ json_exp_num_repls (json_value *, iore_exp_t *);
 static int
 json_exp_run_order (json_value *, iore_exp_t *);
 static int
+json_exp_co_schedule (json_value *, iore_exp_t *);
+static int
 json_exp_runs (json_value *, iore_exp_t *);
 static int
+json_sweep_init (json_value *, json_sweep_t *);
+static int
+json_sweep_params (json_value *, json_sweep_t *);
+static int
+json_sweep_param (json_value *, json_sweep_param_t *);
+static int
+json_sweep_values (json_value *, json_sweep_param_t *);
+static int
+json_sweep_range (json_value *, json_sweep_param_t *);
+static int
+json_sweep_run (json_value *, const json_sweep_t *, unsigned int,
+		iore_run_t *, iore_stex_t *);
+static json_value *
+json_sweep_override (json_value *, const char *, json_value *,
+		     json_scratch_t *);
+static const char *
+json_sweep_value2str (const json_value *, char *, size_t);
+static void
+json_sweep_free (json_sweep_t *);
+static void *
+json_scratch_push (json_scratch_t *, void *);
+static void
+json_scratch_free (json_scratch_t *);
+static int
 json_stex (json_value *, iore_stex_t *);
 static int
 json_stex_report_type (json_value *, iore_stex_t *);
@@ -76,10 +151,42 @@ json_stex_data_format (json_value *, iore_stex_t *);
 static int
 json_stex_export_dir (json_value *, iore_stex_t *);
 static int
+json_stex_task_gather (json_value *, iore_stex_t *);
+static int
+json_stex_stream (json_value *, iore_stex_t *);
+static int
+json_stex_stream_sync_interval (json_value *, iore_stex_t *);
+static int
+json_stex_os_counters (json_value *, iore_stex_t *);
+static int
+json_stex_timeline (json_value *, iore_stex_t *);
+static int
+json_lmet (json_value *, iore_lmet_t *);
+static int
+json_lmet_interval_ms (json_value *, iore_lmet_t *);
+static int
+json_lmet_socket (json_value *, iore_lmet_t *);
+static int
+json_lmet_prom_file (json_value *, iore_lmet_t *);
+static int
+json_clock (json_value *, iore_trec_clock_t *);
+static int
+json_clock_timer (json_value *, iore_trec_clock_t *);
+static int
+json_clock_sync_rounds (json_value *, iore_trec_clock_t *);
+static int
+json_reqs (json_value *, iore_trec_reqs_t *);
+static int
 json_run (json_value *, iore_run_t *);
 static int
 json_run_num_repts (json_value *, iore_run_t *);
 static int
+json_run_max_repts (json_value *, iore_run_t *);
+static int
+json_run_ci_target (json_value *, iore_run_t *);
+static int
+json_run_ci_level (json_value *, iore_run_t *);
+static int
 json_test (json_value *, iore_test_t *);
 static int
 json_test_type (json_value *, iore_test_t *);
@@ -88,14 +195,30 @@ json_test_write_flush (json_value *, iore_test_t *);
 static int
 json_test_write_flush_per_req (json_value *, iore_test_t *);
 static int
+json_test_write_flush_mode (json_value *, iore_test_t *);
+static int
+json_test_write_flush_window (json_value *, iore_test_t *);
+static int
+json_test_read_reorder (json_value *, iore_test_t *);
+static int
 json_test_read_reorder_offset (json_value *, iore_test_t *);
 static int
+json_test_read_cache_defeat (json_value *, iore_test_t *);
+static int
+json_test_read_cache_defeat_mem_size (json_value *, iore_test_t *);
+static int
 json_test_intra_test_barrier (json_value *, iore_test_t *);
 static int
 json_test_inter_test_delay_secs (json_value *, iore_test_t *);
 static int
 json_test_file_mode (json_value *, iore_test_t *);
 static int
+json_test_file_group_size (json_value *, iore_test_t *);
+static int
+json_test_files_per_task (json_value *, iore_test_t *);
+static int
+json_test_file_dir_hash (json_value *, iore_test_t *);
+static int
 json_test_file_name (json_value *, iore_test_t *);
 static int
 json_test_file_name_append_seq_num (json_value *, iore_test_t *);
@@ -106,6 +229,12 @@ json_test_file_dir_per_task (json_value *, iore_test_t *);
 static int
 json_test_file_keep (json_value *, iore_test_t *);
 static int
+json_test_file_prealloc (json_value *, iore_test_t *);
+static int
+json_test_file_reuse (json_value *, iore_test_t *);
+static int
+json_test_file_truncate (json_value *, iore_test_t *);
+static int
 json_wkld (json_value *, iore_wkld_t *);
 static int
 json_wkld_num_tasks (json_value *, iore_wkld_t *);
@@ -138,56 +267,53 @@ json_wkld_dset_cart_dim_sizes (json_value *, iore_wkld_dset_cart_t *);
 static int
 json_wkld_dset_cart_dim_divs (json_value *, iore_wkld_dset_cart_t *);
 static int
+json_wkld_trace (json_value *, iore_wkld_trace_t *);
+static int
 json_afio (json_value *, iore_afio_t *);
 static int
 json_afio_params (json_value *, iore_afio_t *);
 static int
+json_afio_latency_distrib (json_value *, iore_afio_t *);
+static int
 json_afsb (json_value *, iore_afsb_t **);
 static int
 json_afsb_params (json_value *, iore_afsb_t *);
 
 /*** VARIABLES ***************************************************************/
 
+static const char * const json_sweep_mode_lbl[JSON_SWEEP_MODE_LENGTH] =
+  { "product", "zip" };
+
 const iore_prsr_vtable_t prsr_json =
-  { "json", jsonp_parse_file };
+  { "json", jsonp_parse };
 
 /*** FUNCTIONS ***************************************************************/
 
 /**
- * Assumes @path refers to a readable regular file.
+ * Parses the experiment definition in 'json', of 'len' bytes.
  */
 int
-jsonp_parse_file (const char *path, iore_exp_t *exp)
+jsonp_parse (const char *json, size_t len, iore_exp_t *exp)
 {
-  assert(path);
+  assert(json);
   assert(exp);
 
   int rerr = IORE_SUCCESS;
 
-  json_char *json = NULL;
-  size_t fsize = json_read_file (path, &json);
-  if (fsize > 0)
+  json_value *root = json_parse (json, len);
+  if (root)
     {
-      json_value *root = json_parse (json, fsize);
-      if (root)
-	{
-	  rerr = json_exp (root, exp);
-	  json_value_free (root);
-	}
-      else
-	{
-	  iore_error("JSON Parser: Invalid experiment definition.");
-	  rerr = IORE_FAILURE;
-	}
-
-      free (json);
+      rerr = json_exp (root, exp);
+      json_value_free (root);
     }
   else
-    /* fsize == 0 */
-    rerr = IORE_FAILURE;
+    {
+      iore_error("JSON Parser: Invalid experiment definition.");
+      rerr = IORE_FAILURE;
+    }
 
   return rerr;
-} /* jsonp_parse_file () */
+} /* jsonp_parse () */
 
 static int
 json_check_uint (json_value *jval, const char *jname, unsigned int *val)
@@ -340,42 +466,23 @@ json_check_size (json_value *jval, const char *jname, size_t *val)
   return rerr;
 } /* json_check_size () */
 
-static size_t
-json_read_file (const char *path, json_char **json)
+static int
+json_check_double (json_value *jval, const char *jname, double *val)
 {
-  FILE *fp = fopen (path, "r");
-  if (!fp)
-    iore_fatalf("JSON Parser: Failed opening file '%s'.", path);
+  int rerr = IORE_SUCCESS;
 
-  fseek (fp, 0, SEEK_END);
-  long int fsize = ftell (fp);
-  if (fsize == -1)
-    {
-      fclose (fp);
-      iore_fatalf("JSON Parser: Failed get file '%s' size.", path);
-    }
-  else if (fsize == 0)
-    {
-      fclose (fp);
-      iore_errorf("JSON Parser: Empty file '%s'.", path);
-      return 0;
-    }
+  if (jval->type == json_double)
+    *val = jval->u.dbl;
+  else if (jval->type == json_integer)
+    *val = jval->u.integer;
   else
-    rewind (fp);
-
-  *json = malloc (fsize);
-  assert(*json);
-  if (fread (*json, fsize, 1, fp) != 1)
     {
-      fclose (fp);
-      free (*json);
-      iore_fatalf("JSON Parser: Failed reading file '%s'.", path);
+      iore_errorf(JSON_MSG_NUMBER_OPTION, jname);
+      rerr = IORE_FAILURE;
     }
 
-  fclose (fp);
-
-  return fsize;
-} /* json_read_file () */
+  return rerr;
+} /* json_check_double () */
 
 static int
 json_exp (json_value *jexp, iore_exp_t *exp)
@@ -395,10 +502,18 @@ json_exp (json_value *jexp, iore_exp_t *exp)
 	    rerr |= json_exp_num_repls (jval, exp);
 	  else if (strcasecmp (jname, JSON_ATTR_RUN_ORDER) == 0)
 	    rerr |= json_exp_run_order (jval, exp);
+	  else if (strcasecmp (jname, JSON_ATTR_CO_SCHEDULE) == 0)
+	    rerr |= json_exp_co_schedule (jval, exp);
 	  else if (strcasecmp (jname, JSON_ATTR_RUNS) == 0)
 	    rerr |= json_exp_runs (jval, exp);
 	  else if (strcasecmp (jname, JSON_ATTR_STEX) == 0)
 	    rerr |= json_stex (jval, &exp->stex);
+	  else if (strcasecmp (jname, JSON_ATTR_LMET) == 0)
+	    rerr |= json_lmet (jval, &exp->lmet);
+	  else if (strcasecmp (jname, JSON_ATTR_CLOCK) == 0)
+	    rerr |= json_clock (jval, &exp->clock);
+	  else if (strcasecmp (jname, JSON_ATTR_REQS) == 0)
+	    rerr |= json_reqs (jval, &exp->reqs);
 	  else
 	    {
 	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
@@ -431,6 +546,18 @@ json_exp_run_order (json_value *jval, iore_exp_t *exp)
   return rerr;
 } /* json_exp_run_order () */
 
+static int
+json_exp_co_schedule (json_value *jval, iore_exp_t *exp)
+{
+  int rerr = json_check_enum (jval, JSON_ATTR_CO_SCHEDULE, exp_co_schedule_lbl,
+			      IORE_COSCHED_LENGTH, (int *) &exp->co_schedule);
+  return rerr;
+} /* json_exp_co_schedule () */
+
+/**
+ * Parses the run definitions, expanding the sweep of each run into one run
+ * per point of the sweep.
+ */
 static int
 json_exp_runs (json_value *jval, iore_exp_t *exp)
 {
@@ -446,18 +573,45 @@ json_exp_runs (json_value *jval, iore_exp_t *exp)
 	      unsigned int i;
 	      for (i = 0; i < exp->_runs_len; i++)
 		run_free (&exp->runs[i]);
+	      free (exp->runs);
+	      exp->runs = NULL;
+	      exp->_runs_len = 0;
 	    }
-	  exp->runs = calloc (len, sizeof(iore_run_t));
-	  assert(exp->runs);
-	  exp->_runs_len = len;
 
+	  json_sweep_t *sweeps = calloc (len, sizeof(json_sweep_t));
+	  assert(sweeps);
+
+	  unsigned int num_runs = 0;
 	  unsigned int i;
 	  for (i = 0; i < len; i++)
 	    {
-	      run_init (&exp->runs[i]);
-	      exp->runs[i].id = i + 1;
-	      rerr |= json_run (jval->u.array.values[i], &exp->runs[i]);
+	      rerr |= json_sweep_init (jval->u.array.values[i], &sweeps[i]);
+	      num_runs += sweeps[i].num_points;
 	    }
+
+	  if (!rerr)
+	    {
+	      exp->runs = calloc (num_runs, sizeof(iore_run_t));
+	      assert(exp->runs);
+	      exp->_runs_len = num_runs;
+
+	      iore_run_t *run = exp->runs;
+	      for (i = 0; i < len; i++)
+		{
+		  unsigned int j;
+		  for (j = 0; j < sweeps[i].num_points; j++, run++)
+		    {
+		      run_init (run);
+		      run->id = run - exp->runs + 1;
+		      rerr |= json_sweep_run (jval->u.array.values[i],
+					      &sweeps[i], j, run, &exp->stex);
+		    }
+		}
+	    }
+
+	  for (i = 0; i < len; i++)
+	    json_sweep_free (&sweeps[i]);
+	  free (sweeps);
 	}
     }
   else
@@ -466,8 +620,550 @@ json_exp_runs (json_value *jval, iore_exp_t *exp)
       rerr = IORE_FAILURE;
     }
 
-  return rerr;
-} /* json_exp_runs () */
+  return rerr;
+} /* json_exp_runs () */
+
+/**
+ * Parses the sweep of run definition 'jrun', if any.
+ */
+static int
+json_sweep_init (json_value *jrun, json_sweep_t *sweep)
+{
+  int rerr = IORE_SUCCESS;
+
+  memset (sweep, 0, sizeof(json_sweep_t));
+  sweep->mode = JSON_SWEEP_PRODUCT;
+  sweep->num_points = 1;
+
+  /* other errors are reported by json_run () */
+  if (jrun->type != json_object)
+    return rerr;
+
+  json_value *jsweep = NULL;
+  unsigned int i;
+  for (i = 0; i < jrun->u.object.length; i++)
+    if (strcasecmp (jrun->u.object.values[i].name, JSON_ATTR_RUN_SWEEP) == 0)
+      jsweep = jrun->u.object.values[i].value;
+  if (!jsweep)
+    return rerr;
+
+  if (jsweep->type == json_object)
+    {
+      bool has_params = false;
+      for (i = 0; i < jsweep->u.object.length; i++)
+	{
+	  char *jname = jsweep->u.object.values[i].name;
+	  json_value *jval = jsweep->u.object.values[i].value;
+
+	  if (strcasecmp (jname, JSON_ATTR_SWEEP_MODE) == 0)
+	    {
+	      int mode;
+	      if (json_check_enum (jval, jname, json_sweep_mode_lbl,
+				   JSON_SWEEP_MODE_LENGTH, &mode))
+		rerr = IORE_FAILURE;
+	      else
+		sweep->mode = mode;
+	    }
+	  else if (strcasecmp (jname, JSON_ATTR_SWEEP_PARAMS) == 0)
+	    {
+	      rerr |= json_sweep_params (jval, sweep);
+	      has_params = true;
+	    }
+	  else
+	    {
+	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
+	      rerr = IORE_FAILURE;
+	    }
+	}
+
+      if (!has_params)
+	{
+	  iore_errorf("JSON Parser: '%s': Missing '%s'.", JSON_ATTR_RUN_SWEEP,
+		      JSON_ATTR_SWEEP_PARAMS);
+	  rerr = IORE_FAILURE;
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_OBJECT_OPTION, JSON_ATTR_RUN_SWEEP);
+      rerr = IORE_FAILURE;
+    }
+
+  if (!rerr && sweep->num_params > 0)
+    {
+      if (sweep->mode == JSON_SWEEP_ZIP)
+	{
+	  sweep->num_points = sweep->params[0].num_vals;
+	  for (i = 1; i < sweep->num_params; i++)
+	    if (sweep->params[i].num_vals != sweep->num_points)
+	      {
+		iore_errorf(JSON_MSG_ARRAY_SIZE, sweep->params[i].path,
+			    sweep->params[0].path);
+		rerr = IORE_FAILURE;
+	      }
+	}
+      else
+	for (i = 0; i < sweep->num_params && !rerr; i++)
+	  {
+	    if (sweep->num_points
+		> JSON_SWEEP_MAX_RUNS / sweep->params[i].num_vals)
+	      {
+		iore_errorf("JSON Parser: '%s': More than %d runs.",
+			    JSON_ATTR_RUN_SWEEP, JSON_SWEEP_MAX_RUNS);
+		rerr = IORE_FAILURE;
+	      }
+	    sweep->num_points *= sweep->params[i].num_vals;
+	  }
+    }
+
+  if (rerr)
+    sweep->num_points = 0;
+
+  return rerr;
+} /* json_sweep_init () */
+
+static int
+json_sweep_params (json_value *jval, json_sweep_t *sweep)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jval->type == json_array && jval->u.array.length > 0
+      && sweep->num_params == 0)
+    {
+      unsigned int len = jval->u.array.length;
+      sweep->params = calloc (len, sizeof(json_sweep_param_t));
+      assert(sweep->params);
+      sweep->num_params = len;
+
+      unsigned int i;
+      for (i = 0; i < len; i++)
+	rerr |= json_sweep_param (jval->u.array.values[i], &sweep->params[i]);
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_ARRAY_OPTION, JSON_ATTR_SWEEP_PARAMS);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_sweep_params () */
+
+/**
+ * Parses a swept parameter, given either by a list of values or by a range.
+ */
+static int
+json_sweep_param (json_value *jparam, json_sweep_param_t *param)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jparam->type == json_object)
+    {
+      unsigned int i;
+      for (i = 0; i < jparam->u.object.length; i++)
+	{
+	  char *jname = jparam->u.object.values[i].name;
+	  json_value *jval = jparam->u.object.values[i].value;
+
+	  if (strcasecmp (jname, JSON_ATTR_SWEEP_PARAM) == 0)
+	    {
+	      char *path;
+	      if (json_check_str (jval, jname, &path))
+		rerr = IORE_FAILURE;
+	      else
+		param->path = path;
+	    }
+	  else if (strcasecmp (jname, JSON_ATTR_SWEEP_VALUES) == 0
+	      && !param->vals)
+	    rerr |= json_sweep_values (jval, param);
+	  else if (strcasecmp (jname, JSON_ATTR_SWEEP_RANGE) == 0
+	      && !param->vals)
+	    rerr |= json_sweep_range (jval, param);
+	  else
+	    {
+	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
+	      rerr = IORE_FAILURE;
+	    }
+	}
+
+      if (!rerr
+	  && (!param->path || strlen (param->path) == 0 || !param->vals))
+	{
+	  iore_errorf("JSON Parser: '%s': Requires '%s' and either '%s' or "
+		      "'%s'.", JSON_ATTR_SWEEP_PARAMS, JSON_ATTR_SWEEP_PARAM,
+		      JSON_ATTR_SWEEP_VALUES, JSON_ATTR_SWEEP_RANGE);
+	  rerr = IORE_FAILURE;
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_OBJECT_OPTION, JSON_ATTR_SWEEP_PARAMS);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_sweep_param () */
+
+static int
+json_sweep_values (json_value *jval, json_sweep_param_t *param)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jval->type == json_array && jval->u.array.length > 0)
+    {
+      unsigned int i;
+      for (i = 0; i < jval->u.array.length; i++)
+	{
+	  json_type type = jval->u.array.values[i]->type;
+	  if (type != json_integer && type != json_double
+	      && type != json_string && type != json_boolean)
+	    {
+	      iore_errorf("JSON Parser: '%s': Must be an array of numbers, "
+			  "strings or booleans.", JSON_ATTR_SWEEP_VALUES);
+	      rerr = IORE_FAILURE;
+	      break;
+	    }
+	}
+
+      if (!rerr)
+	{
+	  param->num_vals = jval->u.array.length;
+	  param->vals = malloc (param->num_vals * sizeof(json_value *));
+	  assert(param->vals);
+	  memcpy (param->vals, jval->u.array.values,
+		  param->num_vals * sizeof(json_value *));
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_ARRAY_OPTION, JSON_ATTR_SWEEP_VALUES);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_sweep_values () */
+
+/**
+ * Generates the values of a range, from 'from' up to 'to' inclusive, by
+ * either multiplying by 'mul' or adding 'add'. Ranges of sizes, given as
+ * strings, generate strings with the number of bytes; other ranges generate
+ * integers.
+ */
+static int
+json_sweep_range (json_value *jrange, json_sweep_param_t *param)
+{
+  if (jrange->type != json_object)
+    {
+      iore_errorf(JSON_MSG_OBJECT_OPTION, JSON_ATTR_SWEEP_RANGE);
+      return IORE_FAILURE;
+    }
+
+  json_value *jfrom = NULL, *jto = NULL, *jmul = NULL, *jadd = NULL;
+  unsigned int i;
+  for (i = 0; i < jrange->u.object.length; i++)
+    {
+      char *jname = jrange->u.object.values[i].name;
+      json_value *jval = jrange->u.object.values[i].value;
+
+      if (strcasecmp (jname, JSON_ATTR_SWEEP_RANGE_FROM) == 0)
+	jfrom = jval;
+      else if (strcasecmp (jname, JSON_ATTR_SWEEP_RANGE_TO) == 0)
+	jto = jval;
+      else if (strcasecmp (jname, JSON_ATTR_SWEEP_RANGE_MUL) == 0)
+	jmul = jval;
+      else if (strcasecmp (jname, JSON_ATTR_SWEEP_RANGE_ADD) == 0)
+	jadd = jval;
+      else
+	{
+	  iore_errorf(JSON_MSG_INVALID_OPTION, jname);
+	  return IORE_FAILURE;
+	}
+    }
+
+  if (!jfrom || !jto || !jmul == !jadd)
+    {
+      iore_errorf("JSON Parser: '%s': Requires '%s', '%s' and either '%s' "
+		  "or '%s'.", JSON_ATTR_SWEEP_RANGE, JSON_ATTR_SWEEP_RANGE_FROM,
+		  JSON_ATTR_SWEEP_RANGE_TO, JSON_ATTR_SWEEP_RANGE_MUL,
+		  JSON_ATTR_SWEEP_RANGE_ADD);
+      return IORE_FAILURE;
+    }
+
+  int rerr = IORE_SUCCESS;
+  bool sizes = (jfrom->type == json_string);
+  size_t from = 0, to = 0, step = 0;
+  if (sizes)
+    {
+      rerr |= json_check_size (jfrom, JSON_ATTR_SWEEP_RANGE_FROM, &from);
+      rerr |= json_check_size (jto, JSON_ATTR_SWEEP_RANGE_TO, &to);
+    }
+  else
+    {
+      unsigned int v = 0;
+      rerr |= json_check_uint (jfrom, JSON_ATTR_SWEEP_RANGE_FROM, &v);
+      from = v;
+      rerr |= json_check_uint (jto, JSON_ATTR_SWEEP_RANGE_TO, &v);
+      to = v;
+    }
+  if (jmul)
+    {
+      unsigned int v = 0;
+      rerr |= json_check_uint (jmul, JSON_ATTR_SWEEP_RANGE_MUL, &v);
+      step = v;
+    }
+  else if (sizes && jadd->type == json_string)
+    rerr |= json_check_size (jadd, JSON_ATTR_SWEEP_RANGE_ADD, &step);
+  else
+    {
+      unsigned int v = 0;
+      rerr |= json_check_uint (jadd, JSON_ATTR_SWEEP_RANGE_ADD, &v);
+      step = v;
+    }
+  if (rerr)
+    return rerr;
+
+  if (from > to || (jmul && (from == 0 || step < 2)) || (jadd && step == 0))
+    {
+      iore_errorf("JSON Parser: '%s': Empty or endless range.",
+		  JSON_ATTR_SWEEP_RANGE);
+      return IORE_FAILURE;
+    }
+
+  unsigned int len = 0;
+  size_t v = from;
+  while (len <= JSON_SWEEP_MAX_RUNS)
+    {
+      len++;
+      if ((jmul && v > to / step) || (jadd && v > to - step))
+	break;
+      v = (jmul ? v * step : v + step);
+    }
+  if (len > JSON_SWEEP_MAX_RUNS)
+    {
+      iore_errorf("JSON Parser: '%s': More than %d values.",
+		  JSON_ATTR_SWEEP_RANGE, JSON_SWEEP_MAX_RUNS);
+      return IORE_FAILURE;
+    }
+
+  param->num_vals = len;
+  param->gen = calloc (len, sizeof(json_value));
+  assert(param->gen);
+  param->vals = malloc (len * sizeof(json_value *));
+  assert(param->vals);
+
+  for (i = 0, v = from; i < len; i++)
+    {
+      json_value *gen = &param->gen[i];
+      if (sizes)
+	{
+	  char str[JSON_SWEEP_VALUE_LEN];
+	  gen->type = json_string;
+	  gen->u.string.length = snprintf (str, sizeof(str), "%zu", v);
+	  gen->u.string.ptr = strdup (str);
+	  assert(gen->u.string.ptr);
+	}
+      else
+	{
+	  gen->type = json_integer;
+	  gen->u.integer = v;
+	}
+      param->vals[i] = gen;
+      v = (jmul ? v * step : v + step);
+    }
+
+  return rerr;
+} /* json_sweep_range () */
+
+/**
+ * Parses run 'run' from run definition 'jrun', with the swept parameters
+ * set to their values at point 'point' of 'sweep', and records them as the
+ * sweep coordinates of the run. In product sweeps the last parameter
+ * varies fastest.
+ */
+static int
+json_sweep_run (json_value *jrun, const json_sweep_t *sweep,
+		unsigned int point, iore_run_t *run, iore_stex_t *stex)
+{
+  json_scratch_t scratch =
+    { 0, NULL };
+  json_value *jpoint = jrun;
+
+  unsigned int i;
+  for (i = 0; i < sweep->num_params && jpoint; i++)
+    {
+      const json_sweep_param_t *param = &sweep->params[i];
+
+      unsigned int i_val = point;
+      if (sweep->mode == JSON_SWEEP_PRODUCT)
+	{
+	  unsigned int stride = 1;
+	  unsigned int j;
+	  for (j = i + 1; j < sweep->num_params; j++)
+	    stride *= sweep->params[j].num_vals;
+	  i_val = (point / stride) % param->num_vals;
+	}
+      json_value *val = param->vals[i_val];
+
+      jpoint = json_sweep_override (jpoint, param->path, val, &scratch);
+      if (!jpoint)
+	iore_errorf("JSON Parser: '%s': '%s' is not an attribute of the run.",
+		    JSON_ATTR_RUN_SWEEP, param->path);
+      else
+	{
+	  char str[JSON_SWEEP_VALUE_LEN];
+	  stex_sweep_add (stex, run->id, param->path,
+			  json_sweep_value2str (val, str, sizeof(str)));
+	}
+    }
+
+  int rerr = (jpoint ? json_run (jpoint, run) : IORE_FAILURE);
+  json_scratch_free (&scratch);
+
+  return rerr;
+} /* json_sweep_run () */
+
+/**
+ * Returns a copy of object 'obj' where the attribute at 'path' is set to
+ * 'val', or NULL if an attribute on the path is not an object. Only the
+ * objects along the path are copied; missing attributes are added, and
+ * list attributes are set to a list with 'val' alone.
+ */
+static json_value *
+json_sweep_override (json_value *obj, const char *path, json_value *val,
+		     json_scratch_t *scratch)
+{
+  if (obj->type != json_object)
+    return NULL;
+
+  const char *dot = strchr (path, '.');
+  size_t name_len = (dot ? (size_t) (dot - path) : strlen (path));
+  unsigned int len = obj->u.object.length;
+
+  json_value *copy = json_scratch_push (scratch,
+					calloc (1, sizeof(json_value)));
+  copy->type = json_object;
+  copy->parent = obj->parent;
+  copy->u.object.length = len;
+  copy->u.object.values = json_scratch_push (
+      scratch, malloc ((len + 1) * sizeof(json_object_entry)));
+  if (len > 0)
+    memcpy (copy->u.object.values, obj->u.object.values,
+	    len * sizeof(json_object_entry));
+
+  unsigned int i;
+  for (i = 0; i < len; i++)
+    if (copy->u.object.values[i].name_length == name_len
+	&& strncasecmp (copy->u.object.values[i].name, path, name_len) == 0)
+      break;
+
+  json_object_entry *entry = &copy->u.object.values[i];
+  if (i == len)
+    {
+      entry->name = json_scratch_push (scratch, strndup (path, name_len));
+      entry->name_length = name_len;
+      entry->value = NULL;
+      copy->u.object.length++;
+    }
+
+  if (dot)
+    {
+      json_value *child = entry->value;
+      if (!child)
+	{
+	  child = json_scratch_push (scratch, calloc (1, sizeof(json_value)));
+	  child->type = json_object;
+	}
+      entry->value = json_sweep_override (child, dot + 1, val, scratch);
+      if (!entry->value)
+	return NULL;
+    }
+  else if (entry->value && entry->value->type == json_array)
+    {
+      json_value *list = json_scratch_push (scratch,
+					    calloc (1, sizeof(json_value)));
+      list->type = json_array;
+      list->u.array.length = 1;
+      list->u.array.values = json_scratch_push (scratch,
+						malloc (sizeof(json_value *)));
+      list->u.array.values[0] = val;
+      entry->value = list;
+    }
+  else
+    entry->value = val;
+
+  return copy;
+} /* json_sweep_override () */
+
+/**
+ * Returns the text of scalar value 'val', formatted into 'buf' if needed.
+ */
+static const char *
+json_sweep_value2str (const json_value *val, char *buf, size_t len)
+{
+  switch (val->type)
+    {
+    case json_string:
+      return val->u.string.ptr;
+    case json_integer:
+      snprintf (buf, len, "%lld", (long long) val->u.integer);
+      break;
+    case json_double:
+      snprintf (buf, len, "%g", val->u.dbl);
+      break;
+    case json_boolean:
+      snprintf (buf, len, "%s", (val->u.boolean ? "true" : "false"));
+      break;
+    default:
+      snprintf (buf, len, "%s", "");
+      break;
+    }
+
+  return buf;
+} /* json_sweep_value2str () */
+
+static void
+json_sweep_free (json_sweep_t *sweep)
+{
+  unsigned int i;
+  for (i = 0; i < sweep->num_params; i++)
+    {
+      json_sweep_param_t *param = &sweep->params[i];
+      if (param->gen)
+	{
+	  unsigned int j;
+	  for (j = 0; j < param->num_vals; j++)
+	    if (param->gen[j].type == json_string)
+	      free (param->gen[j].u.string.ptr);
+	  free (param->gen);
+	}
+      free (param->vals);
+    }
+  free (sweep->params);
+  memset (sweep, 0, sizeof(json_sweep_t));
+} /* json_sweep_free () */
+
+static void *
+json_scratch_push (json_scratch_t *scratch, void *ptr)
+{
+  assert(ptr);
+
+  scratch->ptrs = realloc (scratch->ptrs,
+			   (scratch->len + 1) * sizeof(void *));
+  assert(scratch->ptrs);
+  scratch->ptrs[scratch->len++] = ptr;
+
+  return ptr;
+} /* json_scratch_push () */
+
+static void
+json_scratch_free (json_scratch_t *scratch)
+{
+  unsigned int i;
+  for (i = 0; i < scratch->len; i++)
+    free (scratch->ptrs[i]);
+  free (scratch->ptrs);
+  scratch->ptrs = NULL;
+  scratch->len = 0;
+} /* json_scratch_free () */
 
 static int
 json_stex (json_value *jstex, iore_stex_t *stex)
@@ -489,6 +1185,16 @@ json_stex (json_value *jstex, iore_stex_t *stex)
 	    rerr |= json_stex_data_format (jval, stex);
 	  else if (strcasecmp (jname, JSON_ATTR_STEX_EXPORT_DIR) == 0)
 	    rerr |= json_stex_export_dir (jval, stex);
+	  else if (strcasecmp (jname, JSON_ATTR_STEX_TASK_GATHER) == 0)
+	    rerr |= json_stex_task_gather (jval, stex);
+	  else if (strcasecmp (jname, JSON_ATTR_STEX_STREAM) == 0)
+	    rerr |= json_stex_stream (jval, stex);
+	  else if (strcasecmp (jname, JSON_ATTR_STEX_STREAM_SYNC_INTERVAL) == 0)
+	    rerr |= json_stex_stream_sync_interval (jval, stex);
+	  else if (strcasecmp (jname, JSON_ATTR_STEX_OS_COUNTERS) == 0)
+	    rerr |= json_stex_os_counters (jval, stex);
+	  else if (strcasecmp (jname, JSON_ATTR_STEX_TIMELINE) == 0)
+	    rerr |= json_stex_timeline (jval, stex);
 	  else
 	    {
 	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
@@ -527,6 +1233,8 @@ json_stex_report_type (json_value *jval, iore_stex_t *stex)
 		stex->report_type.task = true;
 	      else if (val == IORE_STEX_REPORT_TEST)
 		stex->report_type.test = true;
+	      else if (val == IORE_STEX_REPORT_STATS)
+		stex->report_type.stats = true;
 	    }
 	  rerr |= rerr2;
 	}
@@ -557,6 +1265,226 @@ json_stex_export_dir (json_value *jval, iore_stex_t *stex)
   return rerr;
 } /* json_stex_export_dir () */
 
+static int
+json_stex_task_gather (json_value *jval, iore_stex_t *stex)
+{
+  int rerr = json_check_bool (jval, JSON_ATTR_STEX_TASK_GATHER,
+			      &stex->task_gather);
+  return rerr;
+} /* json_stex_task_gather () */
+
+static int
+json_stex_stream (json_value *jval, iore_stex_t *stex)
+{
+  int rerr = json_check_bool (jval, JSON_ATTR_STEX_STREAM, &stex->stream);
+  return rerr;
+} /* json_stex_stream () */
+
+static int
+json_stex_stream_sync_interval (json_value *jval, iore_stex_t *stex)
+{
+  int rerr = json_check_uint (jval, JSON_ATTR_STEX_STREAM_SYNC_INTERVAL,
+			      &stex->stream_sync_interval);
+  return rerr;
+} /* json_stex_stream_sync_interval () */
+
+static int
+json_stex_os_counters (json_value *jval, iore_stex_t *stex)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jval->type == json_array)
+    {
+      unsigned int len = jval->u.array.length;
+      unsigned int i;
+      for (i = 0; i < len; i++)
+	{
+	  int val;
+	  json_value *jval2 = jval->u.array.values[i];
+	  int rerr2 = json_check_enum (jval2, JSON_ATTR_STEX_OS_COUNTERS,
+				       trec_rsrc_group_lbl,
+				       IORE_TREC_RSRC_GROUP_LENGTH, &val);
+	  if (!rerr2)
+	    {
+	      if (val == IORE_TREC_RSRC_GROUP_RUSAGE)
+		stex->os_counters.rusage = true;
+	      else if (val == IORE_TREC_RSRC_GROUP_IO)
+		stex->os_counters.io = true;
+	      else if (val == IORE_TREC_RSRC_GROUP_PERF)
+		stex->os_counters.perf = true;
+	    }
+	  rerr |= rerr2;
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_ARRAY_OPTION, JSON_ATTR_STEX_OS_COUNTERS);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_stex_os_counters () */
+
+static int
+json_stex_timeline (json_value *jval, iore_stex_t *stex)
+{
+  int rerr = json_check_bool (jval, JSON_ATTR_STEX_TIMELINE, &stex->timeline);
+  return rerr;
+} /* json_stex_timeline () */
+
+static int
+json_lmet (json_value *jlmet, iore_lmet_t *lmet)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jlmet->type == json_object)
+    {
+      unsigned int len = jlmet->u.object.length;
+      unsigned int i;
+      for (i = 0; i < len; i++)
+	{
+	  char *jname = jlmet->u.object.values[i].name;
+	  json_value *jval = jlmet->u.object.values[i].value;
+
+	  if (strcasecmp (jname, JSON_ATTR_LMET_INTERVAL_MS) == 0)
+	    rerr |= json_lmet_interval_ms (jval, lmet);
+	  else if (strcasecmp (jname, JSON_ATTR_LMET_SOCKET) == 0)
+	    rerr |= json_lmet_socket (jval, lmet);
+	  else if (strcasecmp (jname, JSON_ATTR_LMET_PROM_FILE) == 0)
+	    rerr |= json_lmet_prom_file (jval, lmet);
+	  else
+	    {
+	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
+	      rerr = IORE_FAILURE;
+	    }
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_OBJECT_OPTION, JSON_ATTR_LMET);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_lmet () */
+
+static int
+json_lmet_interval_ms (json_value *jval, iore_lmet_t *lmet)
+{
+  int rerr = json_check_uint (jval, JSON_ATTR_LMET_INTERVAL_MS,
+			      &lmet->interval_ms);
+  return rerr;
+} /* json_lmet_interval_ms () */
+
+static int
+json_lmet_socket (json_value *jval, iore_lmet_t *lmet)
+{
+  int rerr = json_check_str (jval, JSON_ATTR_LMET_SOCKET, &lmet->socket);
+  return rerr;
+} /* json_lmet_socket () */
+
+static int
+json_lmet_prom_file (json_value *jval, iore_lmet_t *lmet)
+{
+  int rerr = json_check_str (jval, JSON_ATTR_LMET_PROM_FILE,
+			     &lmet->prom_file);
+  return rerr;
+} /* json_lmet_prom_file () */
+
+static int
+json_clock (json_value *jclock, iore_trec_clock_t *clock)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jclock->type == json_object)
+    {
+      unsigned int len = jclock->u.object.length;
+      unsigned int i;
+      for (i = 0; i < len; i++)
+	{
+	  char *jname = jclock->u.object.values[i].name;
+	  json_value *jval = jclock->u.object.values[i].value;
+
+	  if (strcasecmp (jname, JSON_ATTR_CLOCK_TIMER) == 0)
+	    rerr |= json_clock_timer (jval, clock);
+	  else if (strcasecmp (jname, JSON_ATTR_CLOCK_SYNC_ROUNDS) == 0)
+	    rerr |= json_clock_sync_rounds (jval, clock);
+	  else
+	    {
+	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
+	      rerr = IORE_FAILURE;
+	    }
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_OBJECT_OPTION, JSON_ATTR_CLOCK);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_clock () */
+
+static int
+json_clock_timer (json_value *jval, iore_trec_clock_t *clock)
+{
+  int rerr = json_check_enum (jval, JSON_ATTR_CLOCK_TIMER, trec_timer_lbl,
+			      IORE_TREC_TIMER_LENGTH, (int *) &clock->timer);
+  return rerr;
+} /* json_clock_timer () */
+
+static int
+json_clock_sync_rounds (json_value *jval, iore_trec_clock_t *clock)
+{
+  int rerr = json_check_uint (jval, JSON_ATTR_CLOCK_SYNC_ROUNDS,
+			      &clock->sync_rounds);
+  return rerr;
+} /* json_clock_sync_rounds () */
+
+static int
+json_reqs (json_value *jreqs, iore_trec_reqs_t *reqs)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jreqs->type == json_object)
+    {
+      unsigned int len = jreqs->u.object.length;
+      unsigned int i;
+      for (i = 0; i < len; i++)
+	{
+	  char *jname = jreqs->u.object.values[i].name;
+	  json_value *jval = jreqs->u.object.values[i].value;
+
+	  if (strcasecmp (jname, JSON_ATTR_REQS_RING_LEN) == 0)
+	    {
+	      unsigned int ring_len;
+	      if (!json_check_uint (jval, JSON_ATTR_REQS_RING_LEN, &ring_len))
+		reqs->ring_len = ring_len;
+	      else
+		rerr = IORE_FAILURE;
+	    }
+	  else if (strcasecmp (jname, JSON_ATTR_REQS_DIR) == 0)
+	    {
+	      free (reqs->dir);
+	      reqs->dir = NULL;
+	      rerr |= json_check_str (jval, JSON_ATTR_REQS_DIR, &reqs->dir);
+	    }
+	  else
+	    {
+	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
+	      rerr = IORE_FAILURE;
+	    }
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_OBJECT_OPTION, JSON_ATTR_REQS);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_reqs () */
+
 static int
 json_run (json_value *jrun, iore_run_t *run)
 {
@@ -573,8 +1501,16 @@ json_run (json_value *jrun, iore_run_t *run)
 
 	  if (strcasecmp (jname, JSON_ATTR_RUN_NUM_REPETITIONS) == 0)
 	    rerr |= json_run_num_repts (jval, run);
+	  else if (strcasecmp (jname, JSON_ATTR_RUN_MAX_REPETITIONS) == 0)
+	    rerr |= json_run_max_repts (jval, run);
+	  else if (strcasecmp (jname, JSON_ATTR_RUN_CI_TARGET) == 0)
+	    rerr |= json_run_ci_target (jval, run);
+	  else if (strcasecmp (jname, JSON_ATTR_RUN_CI_LEVEL) == 0)
+	    rerr |= json_run_ci_level (jval, run);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST) == 0)
 	    rerr |= json_test (jval, &run->test);
+	  else if (strcasecmp (jname, JSON_ATTR_RUN_SWEEP) == 0)
+	    continue; /* expanded by json_exp_runs () */
 	  else
 	    {
 	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
@@ -599,6 +1535,29 @@ json_run_num_repts (json_value *jval, iore_run_t *run)
   return rerr;
 } /* json_run_num_repts () */
 
+static int
+json_run_max_repts (json_value *jval, iore_run_t *run)
+{
+  int rerr = json_check_uint (jval, JSON_ATTR_RUN_MAX_REPETITIONS,
+			      &run->max_repetitions);
+  return rerr;
+} /* json_run_max_repts () */
+
+static int
+json_run_ci_target (json_value *jval, iore_run_t *run)
+{
+  int rerr = json_check_double (jval, JSON_ATTR_RUN_CI_TARGET,
+				&run->ci_target);
+  return rerr;
+} /* json_run_ci_target () */
+
+static int
+json_run_ci_level (json_value *jval, iore_run_t *run)
+{
+  int rerr = json_check_double (jval, JSON_ATTR_RUN_CI_LEVEL, &run->ci_level);
+  return rerr;
+} /* json_run_ci_level () */
+
 static int
 json_test (json_value *jtest, iore_test_t *test)
 {
@@ -619,8 +1578,19 @@ json_test (json_value *jtest, iore_test_t *test)
 	    rerr |= json_test_write_flush (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST_WRITE_FLUSH_PER_REQ) == 0)
 	    rerr |= json_test_write_flush_per_req (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_WRITE_FLUSH_MODE) == 0)
+	    rerr |= json_test_write_flush_mode (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_WRITE_FLUSH_WINDOW) == 0)
+	    rerr |= json_test_write_flush_window (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_READ_REORDER) == 0)
+	    rerr |= json_test_read_reorder (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST_READ_REORDER_OFFSET) == 0)
 	    rerr |= json_test_read_reorder_offset (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_READ_CACHE_DEFEAT) == 0)
+	    rerr |= json_test_read_cache_defeat (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_READ_CACHE_DEFEAT_MEM_SIZE)
+	      == 0)
+	    rerr |= json_test_read_cache_defeat_mem_size (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST_INTRA_TEST_BARRIER) == 0)
 	    rerr |= json_test_intra_test_barrier (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST_INTER_TEST_DELAY_SECS)
@@ -628,6 +1598,12 @@ json_test (json_value *jtest, iore_test_t *test)
 	    rerr |= json_test_inter_test_delay_secs (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_MODE) == 0)
 	    rerr |= json_test_file_mode (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_GROUP_SIZE) == 0)
+	    rerr |= json_test_file_group_size (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILES_PER_TASK) == 0)
+	    rerr |= json_test_files_per_task (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_DIR_HASH) == 0)
+	    rerr |= json_test_file_dir_hash (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_NAME) == 0)
 	    rerr |= json_test_file_name (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_NAME_APPEND_SEQ_NUM)
@@ -640,6 +1616,12 @@ json_test (json_value *jtest, iore_test_t *test)
 	    rerr |= json_test_file_dir_per_task (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_KEEP) == 0)
 	    rerr |= json_test_file_keep (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_PREALLOC) == 0)
+	    rerr |= json_test_file_prealloc (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_REUSE) == 0)
+	    rerr |= json_test_file_reuse (jval, test);
+	  else if (strcasecmp (jname, JSON_ATTR_TEST_FILE_TRUNCATE) == 0)
+	    rerr |= json_test_file_truncate (jval, test);
 	  else if (strcasecmp (jname, JSON_ATTR_WKLD) == 0)
 	    rerr |= json_wkld (jval, &test->wkld);
 	  else if (strcasecmp (jname, JSON_ATTR_AFIO) == 0)
@@ -716,6 +1698,32 @@ json_test_write_flush_per_req (json_value *jval, iore_test_t *test)
   return rerr;
 } /* json_test_write_flush_pre_req () */
 
+static int
+json_test_write_flush_mode (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_enum (jval, JSON_ATTR_TEST_WRITE_FLUSH_MODE,
+			      test_flush_mode_lbl, IORE_TEST_FLUSH_LENGTH,
+			      (int *) &test->write_flush_mode);
+  return rerr;
+} /* json_test_write_flush_mode () */
+
+static int
+json_test_write_flush_window (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_uint (jval, JSON_ATTR_TEST_WRITE_FLUSH_WINDOW,
+			      &test->write_flush_window);
+  return rerr;
+} /* json_test_write_flush_window () */
+
+static int
+json_test_read_reorder (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_enum (jval, JSON_ATTR_TEST_READ_REORDER,
+			      test_read_reorder_lbl, IORE_TEST_RREORDER_LENGTH,
+			      (int *) &test->read_reorder);
+  return rerr;
+} /* json_test_read_reorder () */
+
 static int
 json_test_read_reorder_offset (json_value *jval, iore_test_t *test)
 {
@@ -724,6 +1732,23 @@ json_test_read_reorder_offset (json_value *jval, iore_test_t *test)
   return rerr;
 } /* json_test_read_reorder_offset () */
 
+static int
+json_test_read_cache_defeat (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_enum (jval, JSON_ATTR_TEST_READ_CACHE_DEFEAT,
+			      test_cache_defeat_lbl, IORE_TEST_CDEFEAT_LENGTH,
+			      (int *) &test->read_cache_defeat);
+  return rerr;
+} /* json_test_read_cache_defeat () */
+
+static int
+json_test_read_cache_defeat_mem_size (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_size (jval, JSON_ATTR_TEST_READ_CACHE_DEFEAT_MEM_SIZE,
+			      &test->read_cache_defeat_mem_size);
+  return rerr;
+} /* json_test_read_cache_defeat_mem_size () */
+
 static int
 json_test_intra_test_barrier (json_value *jval, iore_test_t *test)
 {
@@ -749,6 +1774,30 @@ json_test_file_mode (json_value *jval, iore_test_t *test)
   return rerr;
 } /* json_test_file_mode () */
 
+static int
+json_test_file_group_size (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_uint (jval, JSON_ATTR_TEST_FILE_GROUP_SIZE,
+			      &test->file_group_size);
+  return rerr;
+} /* json_test_file_group_size () */
+
+static int
+json_test_files_per_task (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_uint (jval, JSON_ATTR_TEST_FILES_PER_TASK,
+			      &test->files_per_task);
+  return rerr;
+} /* json_test_files_per_task () */
+
+static int
+json_test_file_dir_hash (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_uint (jval, JSON_ATTR_TEST_FILE_DIR_HASH,
+			      &test->file_dir_hash);
+  return rerr;
+} /* json_test_file_dir_hash () */
+
 static int
 json_test_file_name (json_value *jval, iore_test_t *test)
 {
@@ -792,6 +1841,32 @@ json_test_file_keep (json_value *jval, iore_test_t *test)
   return rerr;
 } /* json_test_file_keep () */
 
+static int
+json_test_file_prealloc (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_enum (jval, JSON_ATTR_TEST_FILE_PREALLOC,
+			      test_file_prealloc_lbl,
+			      IORE_TEST_FPREALLOC_LENGTH,
+			      (int *) &test->file_prealloc);
+  return rerr;
+} /* json_test_file_prealloc () */
+
+static int
+json_test_file_reuse (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_bool (jval, JSON_ATTR_TEST_FILE_REUSE,
+			      &test->file_reuse);
+  return rerr;
+} /* json_test_file_reuse () */
+
+static int
+json_test_file_truncate (json_value *jval, iore_test_t *test)
+{
+  int rerr = json_check_bool (jval, JSON_ATTR_TEST_FILE_TRUNCATE,
+			      &test->file_truncate);
+  return rerr;
+} /* json_test_file_truncate () */
+
 static int
 json_wkld (json_value *jwkld, iore_wkld_t *wkld)
 {
@@ -818,6 +1893,15 @@ json_wkld (json_value *jwkld, iore_wkld_t *wkld)
 	      wkld->type = IORE_WKLD_DATASET;
 	      rerr |= json_wkld_dset (jval, &wkld->u.dset);
 	    }
+	  else if (strcasecmp (jname, wkld_type_lbl[IORE_WKLD_TRACE]) == 0)
+	    {
+	      if (wkld->type == IORE_WKLD_OFFSET)
+		wkld_oset_free (&wkld->u.oset);
+	      if (wkld->type != IORE_WKLD_TRACE)
+		memset (&wkld->u.trace, 0, sizeof(iore_wkld_trace_t));
+	      wkld->type = IORE_WKLD_TRACE;
+	      rerr |= json_wkld_trace (jval, &wkld->u.trace);
+	    }
 	  else
 	    {
 	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
@@ -1413,6 +2497,48 @@ json_wkld_dset_cart_dim_divs (json_value *jval, iore_wkld_dset_cart_t *cart)
   return rerr;
 } /* json_wkld_dset_cart_dim_divs () */
 
+static int
+json_wkld_trace (json_value *jtrace, iore_wkld_trace_t *trace)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jtrace->type == json_object)
+    {
+      unsigned int len = jtrace->u.object.length;
+      unsigned int i;
+      for (i = 0; i < len; i++)
+	{
+	  char *jname = jtrace->u.object.values[i].name;
+	  json_value *jval = jtrace->u.object.values[i].value;
+
+	  if (strcasecmp (jname, JSON_ATTR_WKLD_TRACE_FILE) == 0)
+	    {
+	      free (trace->file_name);
+	      trace->file_name = NULL;
+	      rerr |= json_check_str (jval, JSON_ATTR_WKLD_TRACE_FILE,
+				      &trace->file_name);
+	    }
+	  else if (strcasecmp (jname, JSON_ATTR_WKLD_TRACE_TIMING) == 0)
+	    rerr |= json_check_enum (jval, JSON_ATTR_WKLD_TRACE_TIMING,
+				     wkld_trace_timing_lbl,
+				     IORE_WKLD_TRACE_TM_LENGTH,
+				     (int *) &trace->timing);
+	  else
+	    {
+	      iore_errorf(JSON_MSG_INVALID_OPTION, jname);
+	      rerr = IORE_FAILURE;
+	    }
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_OBJECT_OPTION, wkld_type_lbl[IORE_WKLD_TRACE]);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_wkld_trace () */
+
 static int
 json_afio (json_value *jafio, iore_afio_t *afio)
 {
@@ -1471,6 +2597,11 @@ json_afio_params (json_value *jval, iore_afio_t *afio)
 	    {
 	      char *jname = jval->u.object.values[i].name;
 	      json_value *jval2 = jval->u.object.values[i].value;
+	      if (strcasecmp (jname, JSON_ATTR_AFIO_LATENCY_DISTRIB) == 0)
+		{
+		  rerr |= json_afio_latency_distrib (jval2, afio);
+		  continue;
+		}
 	      char *val;
 	      rerr |= json_check_str (jval2, jname, &val);
 	      if (!rerr)
@@ -1487,6 +2618,55 @@ json_afio_params (json_value *jval, iore_afio_t *afio)
   return rerr;
 } /* json_afio_params () */
 
+static int
+json_afio_latency_distrib (json_value *jval, iore_afio_t *afio)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (jval->type == json_object)
+    {
+      unsigned int len = jval->u.object.length;
+      if (len == 1)
+	{
+	  if (afio->latency_distrib)
+	    {
+	      prng_dist_free (afio->latency_distrib);
+	      free (afio->latency_distrib);
+	    }
+	  afio->latency_distrib = malloc (sizeof(iore_prng_dist_t));
+	  assert(afio->latency_distrib);
+
+	  char *jname = jval->u.object.values[0].name;
+	  int i, type = IORE_PRNG_LENGTH;
+	  for (i = 0; i < IORE_PRNG_LENGTH; i++)
+	    {
+	      if (strcasecmp (jname, prng_type_lbl[i]) == 0)
+		{
+		  type = i;
+		  i = IORE_PRNG_LENGTH;
+		}
+	    }
+	  afio->latency_distrib->type = type;
+
+	  json_value *jval2 = jval->u.object.values[0].value;
+	  rerr |= json_wkld_oset_distrib_params (jval2, afio->latency_distrib);
+	}
+      else
+	{
+	  iore_errorf("JSON Parser: '%s': Must have one distribution.",
+		      JSON_ATTR_AFIO_LATENCY_DISTRIB);
+	  rerr = IORE_FAILURE;
+	}
+    }
+  else
+    {
+      iore_errorf(JSON_MSG_OBJECT_OPTION, JSON_ATTR_AFIO_LATENCY_DISTRIB);
+      rerr = IORE_FAILURE;
+    }
+
+  return rerr;
+} /* json_afio_latency_distrib () */
+
 static int
 json_afsb (json_value *jafsb, iore_afsb_t **afsb)
 {
@@ -1500,9 +2680,10 @@ json_afsb (json_value *jafsb, iore_afsb_t **afsb)
 	{
 	  *afsb = malloc (sizeof(iore_afsb_t));
 	  assert(*afsb);
+	  afsb_init (*afsb);
 
 	  char *jname = jafsb->u.object.values[0].name;
-	  int i, afsb_type;
+	  int i, afsb_type = IORE_AFSB_LENGTH;
 	  for (i = 0; i < IORE_AFSB_LENGTH; i++)
 	    {
 	      if (strcasecmp (jname, afsb_lbl[i]) == 0)
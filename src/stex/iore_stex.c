@@ -4,17 +4,91 @@
  * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
  */
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <assert.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <mpi.h>
 
 #include "iore_stex.h"
+#include "iore_ctx.h"
 #include "iore_error.h"
+#include "iore_file.h"
+
+/*** DEFINES *****************************************************************/
+
+/**
+ * Streamed reports have fixed file names, so that a resumed experiment
+ * appends to the reports of the interrupted one.
+ */
+#define STEX_STREAM_FILE_NAME_FORMAT "%s/iore_%s_stream.%s"
+#define STEX_JOURNAL_FILE_NAME_FORMAT "%s/iore_journal.csv"
+#define STEX_JOURNAL_HEADER "exp_repl_id,run_id,run_rept_id,task_size,test_size,stats_size\n"
+#define STEX_JOURNAL_ROW_FORMAT "%u,%u,%u,%lld,%lld,%lld\n"
+#define STEX_JOURNAL_LINE_MAX 256
+#define STEX_WRITE_CHUNK_SIZE 1048576 /* int counts of shared writes */
+
+/*** TYPES *******************************************************************/
+
+/**
+ * Journal entry of a streamed run repetition: its ids and the sizes of the
+ * report files right after its rows were appended.
+ */
+typedef struct stex_journal_entry
+{
+  unsigned int id[3]; /* exp_repl_id, run_id, run_rept_id */
+  long long size[IORE_STEX_REPORT_LENGTH];
+} stex_journal_entry_t;
+
+/**
+ * Stream state. Journal entries are kept pending at the master task until
+ * the report files are synced, so the journal only tells of rows which
+ * reached storage.
+ */
+typedef struct stex_stream
+{
+  const iore_stex_t *stex; /* NULL if not streaming */
+  unsigned int num_unsynced; /* run repetitions since the last sync */
+  stex_journal_entry_t *pending;
+  size_t num_pending;
+  unsigned int *done; /* ids of the run repetitions in the journal */
+  size_t num_done;
+} stex_stream_t;
+
+/*** PROTOTYPES **************************************************************/
+
+static int
+stex_write_at_shared (const char *, const void *, size_t, bool);
+static int
+stex_stream_sync ();
+static int
+stex_journal_load (const iore_stex_t *);
+static bool
+stex_journal_parse (const char *, stex_journal_entry_t *);
+static int
+stex_journal_append (const iore_stex_t *);
+static int
+stex_file_sync (const char *);
+static void
+stex_journal_file_name (const iore_stex_t *, char *);
+static bool
+stex_report_enabled (const iore_stex_t *, enum iore_stex_report_type);
 
 /*** VARIABLES ***************************************************************/
 
 extern const iore_stex_vtable_t stex_csv;
+extern const iore_stex_vtable_t stex_binary;
+extern const iore_stex_vtable_t stex_columnar;
 static const iore_stex_vtable_t *stex_pool[IORE_STEX_FORMAT_LENGTH] =
-  { &stex_csv };
+  { &stex_csv, &stex_binary, &stex_columnar };
+
+static stex_stream_t stream =
+  { };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -25,8 +99,18 @@ stex_init (iore_stex_t *this)
 
   this->report_type.task = false;
   this->report_type.test = false;
+  this->report_type.stats = false;
   this->data_format = IORE_STEX_FORMAT_LENGTH;
   this->export_dir = NULL;
+  this->task_gather = false;
+  this->stream = false;
+  this->stream_sync_interval = 1;
+  this->resume = false;
+  this->timeline = false;
+  this->os_counters.rusage = false;
+  this->os_counters.io = false;
+  this->os_counters.perf = false;
+  memset (&this->sweep, 0, sizeof(iore_stex_sweep_t));
 
   return this;
 } /* stex_init () */
@@ -41,24 +125,105 @@ stex_free (iore_stex_t *this)
 	  free (this->export_dir);
 	  this->export_dir = NULL;
 	}
+
+      unsigned int i;
+      for (i = 0; i < this->sweep.num_params; i++)
+	free (this->sweep.params[i]);
+      for (i = 0; i < this->sweep.num_runs * this->sweep.num_params; i++)
+	free (this->sweep.values[i]);
+      free (this->sweep.params);
+      free (this->sweep.values);
+      memset (&this->sweep, 0, sizeof(iore_stex_sweep_t));
     }
 } /* stex_free () */
 
+/**
+ * Records that run 'run_id' takes 'value' for the swept parameter 'param'.
+ */
+void
+stex_sweep_add (iore_stex_t *this, unsigned int run_id, const char *param,
+		const char *value)
+{
+  assert(this);
+  assert(param);
+  assert(value);
+
+  iore_stex_sweep_t *sweep = &this->sweep;
+  unsigned int i_param;
+  for (i_param = 0; i_param < sweep->num_params; i_param++)
+    if (strcmp (sweep->params[i_param], param) == 0)
+      break;
+  unsigned int num_params = sweep->num_params;
+  unsigned int num_runs = sweep->num_runs;
+  if (i_param == num_params)
+    {
+      sweep->params = realloc (sweep->params,
+			       (num_params + 1) * sizeof(char *));
+      assert(sweep->params);
+      sweep->params[num_params++] = strdup (param);
+    }
+  if (run_id >= num_runs)
+    num_runs = run_id + 1;
+
+  /* a new parameter or run widens the table, moving the values over */
+  if (num_params != sweep->num_params || num_runs != sweep->num_runs)
+    {
+      char **values = calloc (num_runs * num_params, sizeof(char *));
+      assert(values);
+      unsigned int i_run, i;
+      for (i_run = 0; i_run < sweep->num_runs; i_run++)
+	for (i = 0; i < sweep->num_params; i++)
+	  values[i_run * num_params + i] = sweep->values[i_run
+	      * sweep->num_params + i];
+      free (sweep->values);
+      sweep->values = values;
+      sweep->num_params = num_params;
+      sweep->num_runs = num_runs;
+    }
+
+  char **coord = &sweep->values[run_id * num_params + i_param];
+  free (*coord);
+  *coord = strdup (value);
+} /* stex_sweep_add () */
+
+/**
+ * Returns the value of swept parameter 'param' at run 'run_id', or NULL if
+ * the run does not sweep it.
+ */
+const char *
+stex_sweep_value (const iore_stex_sweep_t *sweep, unsigned int run_id,
+		  unsigned int param)
+{
+  assert(sweep);
+  assert(param < sweep->num_params);
+
+  if (run_id >= sweep->num_runs)
+    return NULL;
+
+  return sweep->values[run_id * sweep->num_params + param];
+} /* stex_sweep_value () */
+
 int
 stex_export (const iore_trec_exp_t trec_exp, const iore_stex_t stex)
 {
   int rerr = IORE_SUCCESS;
 
+  /* streamed reports were written along the experiment */
+  if (stex.stream)
+    return IORE_SUCCESS;
+
   const enum iore_stex_format data_format = stex.data_format;
   const iore_stex_vtable_t *stex_backend;
   if (data_format < IORE_STEX_FORMAT_LENGTH)
     {
       stex_backend = stex_pool[data_format];
       if (stex.report_type.task)
-	rerr |= stex_backend->export_task (trec_exp, stex.export_dir);
+	rerr |= stex_backend->export_task (trec_exp, &stex);
 
       if (stex.report_type.test)
-	rerr |= stex_backend->export_test (trec_exp, stex.export_dir);
+	rerr |= stex_backend->export_test (trec_exp, &stex);
+      if (stex.report_type.stats)
+	rerr |= stex_backend->export_stats (trec_exp, &stex);
     }
   else if (data_format > IORE_STEX_FORMAT_LENGTH)
     {
@@ -68,3 +233,659 @@ stex_export (const iore_trec_exp_t trec_exp, const iore_stex_t stex)
 
   return rerr;
 } /* stex_export () */
+
+/**
+ * Returns the rows of the committed tests of 'trec_exp' for the report of
+ * 'type', task or test, and sets their number into 'num_rows'.
+ */
+iore_stex_row_t *
+stex_rows (const iore_trec_exp_t trec_exp, enum iore_stex_report_type type,
+	   size_t *num_rows)
+{
+  assert(num_rows);
+  assert(type == IORE_STEX_REPORT_TASK || type == IORE_STEX_REPORT_TEST);
+
+  size_t len = 0;
+  unsigned int i_repl, i_run, i_rept;
+  for (i_repl = 0; i_repl < trec_exp.num_exp_repl; i_repl++)
+    for (i_run = 0; i_run < trec_exp.exp_repl[i_repl].num_run; i_run++)
+      len += (trec_exp.exp_repl[i_repl].run[i_run].num_run_rept
+	  * IORE_TEST_TYPE_LENGTH * IORE_TREC_ACTION_LENGTH);
+
+  iore_stex_row_t *rows = malloc ((len ? len : 1) * sizeof(iore_stex_row_t));
+  assert(rows);
+  *num_rows = 0;
+  for (i_repl = 0; i_repl < trec_exp.num_exp_repl; i_repl++)
+    {
+      const iore_trec_exp_repl_t trec_repl = trec_exp.exp_repl[i_repl];
+      for (i_run = 0; i_run < trec_repl.num_run; i_run++)
+	{
+	  const iore_trec_run_t trec_run = trec_repl.run[i_run];
+	  for (i_rept = 0; i_rept < trec_run.num_run_rept; i_rept++)
+	    *num_rows += stex_rows_rept (trec_repl.id, trec_run.id,
+					 &trec_run.run_rept[i_rept], type,
+					 rows + *num_rows);
+	} /* end of run loop */
+    } /* end of exp_repl loop */
+
+  return rows;
+} /* stex_rows () */
+
+/**
+ * Fills 'rows' with the rows of the committed tests of a run repetition
+ * for the report of 'type', task or test. Remote test records, of runs
+ * the task was not in, have test rows only. 'rows' must have room for
+ * IORE_TEST_TYPE_LENGTH * IORE_TREC_ACTION_LENGTH rows. Returns the number
+ * of rows filled.
+ */
+size_t
+stex_rows_rept (unsigned int exp_repl_id, unsigned int run_id,
+		const iore_trec_run_rept_t *trec_rept,
+		enum iore_stex_report_type type, iore_stex_row_t *rows)
+{
+  assert(trec_rept);
+  assert(rows);
+  assert(type == IORE_STEX_REPORT_TASK || type == IORE_STEX_REPORT_TEST);
+
+  size_t num_rows = 0;
+  unsigned int i_test, i_act;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    {
+      const iore_trec_test_t *trec_test = &trec_rept->test[i_test];
+      if (!trec_test->committed
+	  || (trec_test->remote && type == IORE_STEX_REPORT_TASK))
+	continue;
+      for (i_act = 0; i_act < IORE_TREC_ACTION_LENGTH; i_act++)
+	{
+	  iore_stex_row_t *row = &rows[num_rows++];
+	  row->exp_repl_id = exp_repl_id;
+	  row->run_id = run_id;
+	  row->run_rept_id = trec_rept->id;
+	  row->type = trec_test->type;
+	  row->action = i_act;
+	  if (type == IORE_STEX_REPORT_TASK)
+	    {
+	      row->task_id = ctx.task_id;
+	      memcpy (row->time, trec_test->task_time[i_act], sizeof(row->time));
+	      row->data_size = trec_test->task_data_size;
+	      memcpy (row->rsrc, trec_test->task_rsrc[i_act], sizeof(row->rsrc));
+	    }
+	  else
+	    {
+	      row->task_id = -1;
+	      memcpy (row->time, trec_test->test_time[i_act], sizeof(row->time));
+	      row->data_size = trec_test->test_data_size;
+	      memcpy (row->rsrc, trec_test->test_rsrc[i_act], sizeof(row->rsrc));
+	    }
+	} /* end of action loop */
+    } /* end of test loop */
+
+  return num_rows;
+} /* stex_rows_rept () */
+
+/**
+ * Gathers the 'rows' of all tasks at the master task with a single
+ * MPI_Gatherv, in task order. Counts are in rows, of a contiguous datatype,
+ * so that large reports do not overflow int byte counts. 'rows' is
+ * released; the master gets all rows and their number into 'num_rows',
+ * while other tasks get none. Collective.
+ */
+iore_stex_row_t *
+stex_rows_gather (iore_stex_row_t *rows, size_t *num_rows)
+{
+  assert(rows);
+  assert(num_rows);
+  assert(*num_rows <= INT_MAX);
+
+  int num_procs;
+  MPI_Comm_size (ctx.comm, &num_procs);
+
+  MPI_Datatype row_type;
+  MPI_Type_contiguous (sizeof(iore_stex_row_t), MPI_BYTE, &row_type);
+  MPI_Type_commit (&row_type);
+
+  int count = *num_rows;
+  int *counts = NULL, *displs = NULL;
+  iore_stex_row_t *all_rows = NULL;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      counts = malloc (num_procs * sizeof(int));
+      assert(counts);
+      displs = malloc (num_procs * sizeof(int));
+      assert(displs);
+    }
+  MPI_Gather (&count, 1, MPI_INT, counts, 1, MPI_INT, IORE_MASTER_TASK,
+	      ctx.comm);
+
+  *num_rows = 0;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      int i;
+      size_t disp = 0;
+      for (i = 0; i < num_procs; i++)
+	{
+	  assert(disp <= INT_MAX);
+	  displs[i] = disp;
+	  disp += counts[i];
+	}
+      *num_rows = disp;
+      all_rows = malloc ((disp ? disp : 1) * sizeof(iore_stex_row_t));
+      assert(all_rows);
+    }
+  MPI_Gatherv (rows, count, row_type, all_rows, counts, displs, row_type,
+	       IORE_MASTER_TASK, ctx.comm);
+  MPI_Type_free (&row_type);
+
+  free (rows);
+  free (displs);
+  free (counts);
+
+  return all_rows;
+} /* stex_rows_gather () */
+
+int
+stex_dir_check (const char *dir)
+{
+  if (!file_is_dir (dir))
+    {
+      iore_errorf_all("'%s' is not a directory.", dir);
+      return IORE_FAILURE;
+    }
+
+  int amode = F_OK | W_OK;
+  if (access (dir, amode))
+    {
+      iore_errorf_all("Insufficient permissions on directory '%s'.", dir);
+      return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* stex_dir_check () */
+
+/**
+ * Writes the 'len' bytes of 'buf' of every task into the shared file
+ * 'fname', one after the other in task order, with a single collective
+ * MPI-IO write at offsets taken by a prefix sum. Collective.
+ */
+int
+stex_write_shared (const char *fname, const void *buf, size_t len)
+{
+  return stex_write_at_shared (fname, buf, len, false);
+} /* stex_write_shared () */
+
+/**
+ * Same as stex_write_shared, but bytes are appended to the end of the file.
+ * Collective.
+ */
+int
+stex_append_shared (const char *fname, const void *buf, size_t len)
+{
+  return stex_write_at_shared (fname, buf, len, true);
+} /* stex_append_shared () */
+
+/**
+ * Returns the size of file 'fname', or zero if it does not exist.
+ */
+long long
+stex_file_size (const char *fname)
+{
+  struct stat st;
+  if (stat (fname, &st))
+    return 0;
+
+  return st.st_size;
+} /* stex_file_size () */
+
+/**
+ * Sets the file name of the streamed report of 'type' into 'fname'.
+ */
+void
+stex_stream_file_name (const iore_stex_t *stex,
+		       enum iore_stex_report_type type, char *fname)
+{
+  snprintf (fname, FILENAME_MAX, STEX_STREAM_FILE_NAME_FORMAT,
+	    stex->export_dir, stex_report_lbl[type],
+	    stex_format_lbl[stex->data_format]);
+} /* stex_stream_file_name () */
+
+/**
+ * Starts streaming the reports of 'stex', if enabled. Report files are
+ * reset or, when resuming, cut back to the sizes of the last journal entry,
+ * and the run repetitions in the journal are taken as done. Collective.
+ */
+int
+stex_stream_open (const iore_stex_t *stex)
+{
+  assert(stex);
+
+  if (!stex->stream)
+    return IORE_SUCCESS;
+
+  memset (&stream, 0, sizeof(stex_stream_t));
+
+  int rerr = IORE_SUCCESS;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      rerr = stex_dir_check (stex->export_dir);
+      if (!rerr)
+	rerr = stex_journal_load (stex);
+    }
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  if (rerr)
+    {
+      free (stream.done);
+      memset (&stream, 0, sizeof(stex_stream_t));
+      return IORE_FAILURE;
+    }
+
+  unsigned long long num_done = stream.num_done;
+  MPI_Bcast (&num_done, 1, MPI_UNSIGNED_LONG_LONG, IORE_MASTER_TASK,
+	     ctx.comm);
+  if (num_done > 0)
+    {
+      if (ctx.task_id != IORE_MASTER_TASK)
+	{
+	  stream.num_done = num_done;
+	  stream.done = malloc (3 * num_done * sizeof(unsigned int));
+	  assert(stream.done);
+	}
+      MPI_Bcast (stream.done, 3 * num_done, MPI_UNSIGNED, IORE_MASTER_TASK,
+		 ctx.comm);
+
+      if (ctx.task_id == IORE_MASTER_TASK)
+	fprintf (stdout, "Resuming experiment, %llu run repetitions already "
+		 "exported.\n\n",
+		 num_done);
+    }
+
+  stream.stex = stex;
+
+  return IORE_SUCCESS;
+} /* stex_stream_open () */
+
+/**
+ * Appends the rows of a run repetition to the streamed reports, syncing
+ * them to storage every 'stream_sync_interval' run repetitions. Collective
+ * over the tasks of the run.
+ */
+int
+stex_stream_rept (unsigned int exp_repl_id, unsigned int run_id,
+		  const iore_trec_run_rept_t *trec_rept)
+{
+  assert(trec_rept);
+
+  if (!stream.stex)
+    return IORE_SUCCESS;
+
+  const iore_stex_t *stex = stream.stex;
+  if (stex_pool[stex->data_format]->stream_rept (stex, exp_repl_id, run_id,
+						  trec_rept))
+    return IORE_FAILURE;
+
+  /* runs may have fewer tasks, so the master task decides when to sync */
+  int sync = 0;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      stream.pending = realloc (stream.pending, (stream.num_pending + 1)
+				* sizeof(stex_journal_entry_t));
+      assert(stream.pending);
+      stex_journal_entry_t *entry = &stream.pending[stream.num_pending++];
+      entry->id[0] = exp_repl_id;
+      entry->id[1] = run_id;
+      entry->id[2] = trec_rept->id;
+
+      char fname[FILENAME_MAX];
+      int i;
+      for (i = 0; i < IORE_STEX_REPORT_LENGTH; i++)
+	{
+	  entry->size[i] = 0;
+	  if (stex_report_enabled (stex, i))
+	    {
+	      stex_stream_file_name (stex, i, fname);
+	      entry->size[i] = stex_file_size (fname);
+	    }
+	}
+
+      sync = (++stream.num_unsynced >= stex->stream_sync_interval);
+    }
+  MPI_Bcast (&sync, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+
+  if (sync)
+    return stex_stream_sync ();
+
+  return IORE_SUCCESS;
+} /* stex_stream_rept () */
+
+/**
+ * Tells whether a run repetition was already exported by the experiment
+ * being resumed.
+ */
+bool
+stex_stream_done (unsigned int exp_repl_id, unsigned int run_id,
+		  unsigned int run_rept_id)
+{
+  size_t i;
+  for (i = 0; i < stream.num_done; i++)
+    {
+      const unsigned int *id = &stream.done[3 * i];
+      if (id[0] == exp_repl_id && id[1] == run_id && id[2] == run_rept_id)
+	return true;
+    }
+
+  return false;
+} /* stex_stream_done () */
+
+bool
+stex_stream_active ()
+{
+  return (stream.stex != NULL);
+} /* stex_stream_active () */
+
+/**
+ * Syncs the streamed reports and stops streaming. Collective.
+ */
+int
+stex_stream_close ()
+{
+  if (!stream.stex)
+    return IORE_SUCCESS;
+
+  int rerr = stex_stream_sync ();
+
+  free (stream.pending);
+  free (stream.done);
+  memset (&stream, 0, sizeof(stex_stream_t));
+
+  return rerr;
+} /* stex_stream_close () */
+
+/**
+ * Writes 'len' bytes at 'offset' of the shared file, or of its end if
+ * 'append', in task order. Bytes are written in chunks of
+ * STEX_WRITE_CHUNK_SIZE, then the remainder, so that int counts hold
+ * lengths past 2 GiB. Tasks agree on the open, so that all of them reach
+ * the same collectives. Collective.
+ */
+static int
+stex_write_at_shared (const char *fname, const void *buf, size_t len,
+		      bool append)
+{
+  assert(fname);
+  assert(len / STEX_WRITE_CHUNK_SIZE <= INT_MAX);
+
+  MPI_Offset my_len = len, offset = 0;
+  MPI_Exscan (&my_len, &offset, 1, MPI_OFFSET, MPI_SUM, ctx.comm);
+  if (ctx.task_id == IORE_MASTER_TASK)
+    offset = 0; /* undefined by MPI_Exscan */
+
+  MPI_File fh;
+  int rerr = MPI_File_open (ctx.comm, (char *) fname,
+			    MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+			    &fh);
+  int open_rerr = rerr;
+  MPI_Allreduce (MPI_IN_PLACE, &open_rerr, 1, MPI_INT, MPI_MAX, ctx.comm);
+  if (open_rerr != MPI_SUCCESS)
+    {
+      if (rerr == MPI_SUCCESS)
+	MPI_File_close (&fh);
+      iore_errorf("Failed opening file '%s'.", fname);
+      return IORE_FAILURE;
+    }
+
+  MPI_Status status;
+  if (append)
+    {
+      /* taken once, as other tasks may already be writing past it */
+      MPI_Offset size = 0;
+      if (ctx.task_id == IORE_MASTER_TASK)
+	rerr = MPI_File_get_size (fh, &size);
+      MPI_Bcast (&size, 1, MPI_OFFSET, IORE_MASTER_TASK, ctx.comm);
+      offset += size;
+    }
+  else
+    rerr = MPI_File_set_size (fh, 0);
+
+  MPI_Datatype chunk_type;
+  MPI_Type_contiguous (STEX_WRITE_CHUNK_SIZE, MPI_BYTE, &chunk_type);
+  MPI_Type_commit (&chunk_type);
+  size_t num_chunks = len / STEX_WRITE_CHUNK_SIZE;
+  size_t chunks_len = num_chunks * STEX_WRITE_CHUNK_SIZE;
+  int chunk_rerr = MPI_File_write_at_all (fh, offset, (void *) buf,
+					  num_chunks, chunk_type, &status);
+  int tail_rerr = MPI_File_write_at_all (fh, offset + chunks_len,
+					 (char *) buf + chunks_len,
+					 len - chunks_len, MPI_BYTE, &status);
+  MPI_Type_free (&chunk_type);
+  MPI_File_close (&fh);
+  if (rerr == MPI_SUCCESS)
+    rerr = (chunk_rerr != MPI_SUCCESS) ? chunk_rerr : tail_rerr;
+
+  MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MAX, ctx.comm);
+  if (rerr != MPI_SUCCESS)
+    {
+      iore_errorf("Failed writing file '%s'.", fname);
+      return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* stex_write_at_shared () */
+
+/**
+ * Syncs the streamed reports and then appends the pending entries to the
+ * journal. The task report is synced by all tasks, as they write it
+ * through MPI-IO. Collective.
+ */
+static int
+stex_stream_sync ()
+{
+  const iore_stex_t *stex = stream.stex;
+
+  int rerr = IORE_SUCCESS;
+  char fname[FILENAME_MAX];
+  if (stex->report_type.task)
+    {
+      stex_stream_file_name (stex, IORE_STEX_REPORT_TASK, fname);
+      MPI_File fh;
+      int mpi_rerr = MPI_File_open (ctx.comm, fname,
+				    MPI_MODE_CREATE | MPI_MODE_WRONLY,
+				    MPI_INFO_NULL, &fh);
+      if (mpi_rerr == MPI_SUCCESS)
+	{
+	  mpi_rerr = MPI_File_sync (fh);
+	  MPI_File_close (&fh);
+	}
+      if (mpi_rerr != MPI_SUCCESS)
+	{
+	  iore_errorf("Failed syncing file '%s'.", fname);
+	  rerr = IORE_FAILURE;
+	}
+    }
+
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      if (!rerr && stex->report_type.test)
+	{
+	  stex_stream_file_name (stex, IORE_STEX_REPORT_TEST, fname);
+	  rerr = stex_file_sync (fname);
+	}
+      if (!rerr && stex->report_type.stats)
+	{
+	  stex_stream_file_name (stex, IORE_STEX_REPORT_STATS, fname);
+	  rerr = stex_file_sync (fname);
+	}
+      if (!rerr)
+	rerr = stex_journal_append (stex);
+      stream.num_unsynced = 0;
+    }
+
+  /* IORE_FAILURE is negative */
+  MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN, ctx.comm);
+  return rerr;
+} /* stex_stream_sync () */
+
+/**
+ * Reads the journal and cuts the report files back to the sizes of its
+ * last entry, dropping rows which were not synced; without resuming, the
+ * journal and reports start empty. Master task only.
+ */
+static int
+stex_journal_load (const iore_stex_t *stex)
+{
+  long long size[IORE_STEX_REPORT_LENGTH] =
+    { 0 };
+  char fname[FILENAME_MAX];
+  stex_journal_file_name (stex, fname);
+
+  long valid_len = 0;
+  FILE *file = (stex->resume ? fopen (fname, "r") : NULL);
+  if (file)
+    {
+      char line[STEX_JOURNAL_LINE_MAX];
+      if (fgets (line, sizeof(line), file)
+	  && strcmp (line, STEX_JOURNAL_HEADER) == 0)
+	{
+	  valid_len = ftell (file);
+
+	  stex_journal_entry_t entry;
+	  while (fgets (line, sizeof(line), file)
+	      && stex_journal_parse (line, &entry))
+	    {
+	      stream.done = realloc (stream.done, 3 * (stream.num_done + 1)
+				     * sizeof(unsigned int));
+	      assert(stream.done);
+	      memcpy (&stream.done[3 * stream.num_done++], entry.id,
+		      sizeof(entry.id));
+	      memcpy (size, entry.size, sizeof(size));
+	      valid_len = ftell (file);
+	    }
+	}
+      fclose (file);
+    }
+
+  /* a torn last entry is dropped, as its rows may not be on storage */
+  if (truncate (fname, valid_len) && errno != ENOENT)
+    {
+      iore_errorf("Failed truncating file '%s'.", fname);
+      return IORE_FAILURE;
+    }
+
+  int i;
+  for (i = 0; i < IORE_STEX_REPORT_LENGTH; i++)
+    {
+      if (!stex_report_enabled (stex, i))
+	continue;
+
+      stex_stream_file_name (stex, i, fname);
+      if (stex_file_size (fname) < size[i])
+	{
+	  iore_errorf("File '%s' is shorter than told by the journal.", fname);
+	  return IORE_FAILURE;
+	}
+      if (truncate (fname, size[i]) && errno != ENOENT)
+	{
+	  iore_errorf("Failed truncating file '%s'.", fname);
+	  return IORE_FAILURE;
+	}
+    }
+
+  return IORE_SUCCESS;
+} /* stex_journal_load () */
+
+static bool
+stex_journal_parse (const char *line, stex_journal_entry_t *entry)
+{
+  size_t len = strlen (line);
+  if (len == 0 || line[len - 1] != '\n')
+    return false;
+
+  return (sscanf (line, STEX_JOURNAL_ROW_FORMAT, &entry->id[0], &entry->id[1],
+		  &entry->id[2], &entry->size[IORE_STEX_REPORT_TASK],
+		  &entry->size[IORE_STEX_REPORT_TEST],
+		  &entry->size[IORE_STEX_REPORT_STATS]) == 6);
+} /* stex_journal_parse () */
+
+/**
+ * Appends the pending entries to the journal and syncs it. Master task
+ * only.
+ */
+static int
+stex_journal_append (const iore_stex_t *stex)
+{
+  char fname[FILENAME_MAX];
+  stex_journal_file_name (stex, fname);
+
+  FILE *file = fopen (fname, "a");
+  if (!file)
+    {
+      iore_errorf("Failed opening file '%s'.", fname);
+      return IORE_FAILURE;
+    }
+
+  fseek (file, 0, SEEK_END);
+  if (ftell (file) == 0)
+    fputs (STEX_JOURNAL_HEADER, file);
+
+  size_t i;
+  for (i = 0; i < stream.num_pending; i++)
+    {
+      const stex_journal_entry_t *entry = &stream.pending[i];
+      fprintf (file, STEX_JOURNAL_ROW_FORMAT, entry->id[0], entry->id[1],
+	       entry->id[2], entry->size[IORE_STEX_REPORT_TASK],
+	       entry->size[IORE_STEX_REPORT_TEST],
+	       entry->size[IORE_STEX_REPORT_STATS]);
+    }
+  stream.num_pending = 0;
+
+  int rerr = IORE_SUCCESS;
+  if (fflush (file) || fsync (fileno (file)))
+    {
+      iore_errorf("Failed syncing file '%s'.", fname);
+      rerr = IORE_FAILURE;
+    }
+  fclose (file);
+
+  return rerr;
+} /* stex_journal_append () */
+
+static int
+stex_file_sync (const char *fname)
+{
+  int fd = open (fname, O_WRONLY);
+  if (fd < 0)
+    {
+      if (errno == ENOENT)
+	return IORE_SUCCESS;
+      iore_errorf("Failed opening file '%s'.", fname);
+      return IORE_FAILURE;
+    }
+
+  int rerr = IORE_SUCCESS;
+  if (fsync (fd))
+    {
+      iore_errorf("Failed syncing file '%s'.", fname);
+      rerr = IORE_FAILURE;
+    }
+  close (fd);
+
+  return rerr;
+} /* stex_file_sync () */
+
+static void
+stex_journal_file_name (const iore_stex_t *stex, char *fname)
+{
+  snprintf (fname, FILENAME_MAX, STEX_JOURNAL_FILE_NAME_FORMAT,
+	    stex->export_dir);
+} /* stex_journal_file_name () */
+
+static bool
+stex_report_enabled (const iore_stex_t *stex, enum iore_stex_report_type type)
+{
+  if (type == IORE_STEX_REPORT_TASK)
+    return stex->report_type.task;
+  else if (type == IORE_STEX_REPORT_TEST)
+    return stex->report_type.test;
+  else if (type == IORE_STEX_REPORT_STATS)
+    return stex->report_type.stats;
+
+  return false;
+} /* stex_report_enabled () */
@@ -0,0 +1,287 @@
+/*
+ * iore_stex_binary.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "iore_stex.h"
+#include "iore_ctx.h"
+#include "iore_error.h"
+
+/*** DEFINES *****************************************************************/
+
+#define BIN_STEX_TASK_FILE_NAME_FORMAT "%s/iore_task_%04d%02d%02d%02d%02d%02d.bin"
+#define BIN_STEX_TEST_FILE_NAME_FORMAT "%s/iore_test_%04d%02d%02d%02d%02d%02d.bin"
+
+#define BIN_STEX_MAGIC "IORESTEX"
+#define BIN_STEX_VERSION 1
+#define BIN_STEX_BYTE_ORDER 0x01020304 /* reads 0x04030201 if swapped */
+
+/*** TYPES *******************************************************************/
+
+/**
+ * File header, followed by 'num_rows' rows of 'row_size' bytes. Fields are
+ * in the byte order of the writer, told by 'byte_order'.
+ */
+typedef struct bin_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t report_type;
+  uint32_t row_size;
+  uint64_t num_rows;
+} bin_header_t;
+
+/**
+ * Row of the task and test reports. The task id is -1 in the test report;
+ * test types and actions are indices of test_type_lbl and trec_action_lbl.
+ */
+typedef struct bin_row
+{
+  uint32_t exp_repl_id;
+  uint32_t run_id;
+  uint32_t run_rept_id;
+  int32_t task_id;
+  uint8_t test;
+  uint8_t action;
+  uint8_t pad[6];
+  double start_time;
+  double stop_time;
+  uint64_t data_size;
+} bin_row_t;
+
+/*** PROTOTYPES **************************************************************/
+
+int
+bin_export_task (const iore_trec_exp_t, const iore_stex_t *);
+int
+bin_export_test (const iore_trec_exp_t, const iore_stex_t *);
+int
+bin_export_stats (const iore_trec_exp_t, const iore_stex_t *);
+
+static bin_row_t *
+bin_rows (const iore_stex_row_t *, size_t, bool);
+static void
+bin_header (bin_header_t *, enum iore_stex_report_type, size_t);
+static int
+bin_write (const char *, enum iore_stex_report_type, const bin_row_t *,
+	   size_t);
+static int
+bin_get_file_name (enum iore_stex_report_type, const char *, char *);
+
+/*** VARIABLES ***************************************************************/
+
+const iore_stex_vtable_t stex_binary =
+  { bin_export_task, bin_export_test, bin_export_stats, NULL };
+
+/*** FUNCTIONS ***************************************************************/
+
+/**
+ * Exports the task report of all tasks into a single file. Rows have a
+ * fixed size, so each task writes its own rows collectively through MPI-IO
+ * right after the rows of the preceding tasks or, if the task report is
+ * gathered, rows are gathered and written by the master task.
+ */
+int
+bin_export_task (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
+{
+  assert(stex);
+  assert(stex->export_dir);
+
+  const char *dir = stex->export_dir;
+
+  /* the file name is taken at the master, clocks may tick in between */
+  char fname[FILENAME_MAX];
+  int rerr = IORE_SUCCESS;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      rerr = stex_dir_check (dir);
+      if (!rerr)
+	rerr = bin_get_file_name (IORE_STEX_REPORT_TASK, dir, fname);
+    }
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  if (rerr)
+    return IORE_FAILURE;
+  MPI_Bcast (fname, FILENAME_MAX, MPI_CHAR, IORE_MASTER_TASK, ctx.comm);
+
+  size_t num_rows;
+  iore_stex_row_t *rows = stex_rows (trec_exp, IORE_STEX_REPORT_TASK,
+				     &num_rows);
+  if (stex->task_gather)
+    {
+      rows = stex_rows_gather (rows, &num_rows);
+      if (ctx.task_id == IORE_MASTER_TASK)
+	{
+	  bin_row_t *brows = bin_rows (rows, num_rows, false);
+	  rerr = bin_write (fname, IORE_STEX_REPORT_TASK, brows, num_rows);
+	  free (brows);
+	}
+      MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+    }
+  else
+    {
+      unsigned long long total_rows = 0, my_rows = num_rows;
+      MPI_Reduce (&my_rows, &total_rows, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+		  IORE_MASTER_TASK, ctx.comm);
+
+      /* the master task writes the header ahead of its rows */
+      bool has_header = (ctx.task_id == IORE_MASTER_TASK);
+      bin_row_t *brows = bin_rows (rows, num_rows, has_header);
+      size_t len = num_rows * sizeof(bin_row_t);
+      char *buf = (char *) brows;
+      if (has_header)
+	{
+	  buf -= sizeof(bin_header_t);
+	  bin_header ((bin_header_t *) buf, IORE_STEX_REPORT_TASK, total_rows);
+	  len += sizeof(bin_header_t);
+	}
+
+      rerr = stex_write_shared (fname, buf, len);
+      free (has_header ? buf : (char *) brows);
+    }
+  free (rows);
+
+  return rerr;
+} /* bin_export_task () */
+
+int
+bin_export_test (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
+{
+  assert(stex);
+  assert(stex->export_dir);
+
+  const char *dir = stex->export_dir;
+
+  int rerr = IORE_SUCCESS;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      char fname[FILENAME_MAX];
+      rerr = stex_dir_check (dir);
+      if (!rerr)
+	rerr = bin_get_file_name (IORE_STEX_REPORT_TEST, dir, fname);
+      if (!rerr)
+	{
+	  size_t num_rows;
+	  iore_stex_row_t *rows = stex_rows (trec_exp, IORE_STEX_REPORT_TEST,
+					     &num_rows);
+	  bin_row_t *brows = bin_rows (rows, num_rows, false);
+	  rerr = bin_write (fname, IORE_STEX_REPORT_TEST, brows, num_rows);
+	  free (brows);
+	  free (rows);
+	}
+    }
+
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  return rerr;
+} /* bin_export_test () */
+
+int
+bin_export_stats (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
+{
+  assert(trec_exp.num_exp_repl == 0 || trec_exp.exp_repl);
+  assert(stex);
+
+  iore_error("Unsupported report type.");
+  return IORE_FAILURE;
+} /* bin_export_stats () */
+
+/**
+ * Converts 'rows' into binary rows. With 'header', room for a header is
+ * left ahead of them, at the start of the allocated block.
+ */
+static bin_row_t *
+bin_rows (const iore_stex_row_t *rows, size_t num_rows, bool header)
+{
+  size_t offset = (header ? sizeof(bin_header_t) : 0);
+  char *block = calloc (1, offset + (num_rows ? num_rows : 1)
+      * sizeof(bin_row_t));
+  assert(block);
+
+  bin_row_t *brows = (bin_row_t *) (block + offset);
+  size_t i;
+  for (i = 0; i < num_rows; i++)
+    {
+      brows[i].exp_repl_id = rows[i].exp_repl_id;
+      brows[i].run_id = rows[i].run_id;
+      brows[i].run_rept_id = rows[i].run_rept_id;
+      brows[i].task_id = rows[i].task_id;
+      brows[i].test = rows[i].type;
+      brows[i].action = rows[i].action;
+      brows[i].start_time = rows[i].time[IORE_TREC_EVENT_START];
+      brows[i].stop_time = rows[i].time[IORE_TREC_EVENT_STOP];
+      brows[i].data_size = rows[i].data_size;
+    }
+
+  return brows;
+} /* bin_rows () */
+
+static void
+bin_header (bin_header_t *header, enum iore_stex_report_type type,
+	    size_t num_rows)
+{
+  memset (header, 0, sizeof(bin_header_t));
+  memcpy (header->magic, BIN_STEX_MAGIC, sizeof(header->magic));
+  header->version = BIN_STEX_VERSION;
+  header->byte_order = BIN_STEX_BYTE_ORDER;
+  header->report_type = type;
+  header->row_size = sizeof(bin_row_t);
+  header->num_rows = num_rows;
+} /* bin_header () */
+
+static int
+bin_write (const char *fname, enum iore_stex_report_type type,
+	   const bin_row_t *rows, size_t num_rows)
+{
+  FILE *file = fopen (fname, "w");
+  if (!file)
+    {
+      iore_errorf("Failed opening file '%s'.", fname);
+      return IORE_FAILURE;
+    }
+
+  bin_header_t header;
+  bin_header (&header, type, num_rows);
+  int rerr = IORE_SUCCESS;
+  if (fwrite (&header, sizeof(header), 1, file) != 1
+      || fwrite (rows, sizeof(bin_row_t), num_rows, file) != num_rows)
+    {
+      iore_errorf("Failed writing file '%s'.", fname);
+      rerr = IORE_FAILURE;
+    }
+  fclose (file);
+
+  return rerr;
+} /* bin_write () */
+
+static int
+bin_get_file_name (enum iore_stex_report_type type, const char *dir,
+		   char *fname)
+{
+  time_t t = time (NULL);
+  struct tm *tm = localtime (&t);
+
+  if (type == IORE_STEX_REPORT_TASK)
+    snprintf (fname, FILENAME_MAX, BIN_STEX_TASK_FILE_NAME_FORMAT, dir,
+	      tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour,
+	      tm->tm_min, tm->tm_sec);
+  else if (type == IORE_STEX_REPORT_TEST)
+    snprintf (fname, FILENAME_MAX, BIN_STEX_TEST_FILE_NAME_FORMAT, dir,
+	      tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour,
+	      tm->tm_min, tm->tm_sec);
+  else
+    {
+      iore_error("Unsupported report type.");
+      return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* bin_get_file_name () */
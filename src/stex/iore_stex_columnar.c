@@ -0,0 +1,334 @@
+/*
+ * iore_stex_columnar.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "iore_stex.h"
+#include "iore_stex_columnar.h"
+#include "iore_ctx.h"
+#include "iore_error.h"
+
+/*** DEFINES *****************************************************************/
+
+#define COL_STEX_TASK_FILE_NAME_FORMAT "%s/iore_task_%04d%02d%02d%02d%02d%02d.col"
+#define COL_STEX_TEST_FILE_NAME_FORMAT "%s/iore_test_%04d%02d%02d%02d%02d%02d.col"
+
+/*** PROTOTYPES **************************************************************/
+
+int
+col_export_task (const iore_trec_exp_t, const iore_stex_t *);
+int
+col_export_test (const iore_trec_exp_t, const iore_stex_t *);
+int
+col_export_stats (const iore_trec_exp_t, const iore_stex_t *);
+
+static int
+col_write (const char *, enum iore_stex_report_type, iore_stex_row_t *,
+	   size_t);
+static void
+col_write_column (FILE *, const iore_stex_row_t *, size_t, enum iore_stex_col,
+		  const uint8_t *, iore_stex_col_desc_t *);
+static int
+col_row_cmp (const void *, const void *);
+static int
+col_get_file_name (enum iore_stex_report_type, const char *, char *);
+
+/*** VARIABLES ***************************************************************/
+
+const iore_stex_vtable_t stex_columnar =
+  { col_export_task, col_export_test, col_export_stats, NULL };
+
+static const uint32_t col_width[IORE_STEX_COL_LENGTH] =
+  { sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t), sizeof(int32_t),
+      sizeof(uint8_t), sizeof(double), sizeof(double), sizeof(uint64_t) };
+
+/*** FUNCTIONS ***************************************************************/
+
+/**
+ * Columns hold the rows of all tasks, so rows are gathered at the master
+ * task, which writes the file; the 'gather' option is implied.
+ */
+int
+col_export_task (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
+{
+  assert(stex);
+  assert(stex->export_dir);
+
+  const char *dir = stex->export_dir;
+
+  size_t num_rows;
+  iore_stex_row_t *rows = stex_rows (trec_exp, IORE_STEX_REPORT_TASK,
+				     &num_rows);
+  rows = stex_rows_gather (rows, &num_rows);
+
+  int rerr = IORE_SUCCESS;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      char fname[FILENAME_MAX];
+      rerr = stex_dir_check (dir);
+      if (!rerr)
+	rerr = col_get_file_name (IORE_STEX_REPORT_TASK, dir, fname);
+      if (!rerr)
+	rerr = col_write (fname, IORE_STEX_REPORT_TASK, rows, num_rows);
+    }
+  free (rows);
+
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  return rerr;
+} /* col_export_task () */
+
+int
+col_export_test (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
+{
+  assert(stex);
+  assert(stex->export_dir);
+
+  const char *dir = stex->export_dir;
+
+  int rerr = IORE_SUCCESS;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      char fname[FILENAME_MAX];
+      rerr = stex_dir_check (dir);
+      if (!rerr)
+	rerr = col_get_file_name (IORE_STEX_REPORT_TEST, dir, fname);
+      if (!rerr)
+	{
+	  size_t num_rows;
+	  iore_stex_row_t *rows = stex_rows (trec_exp, IORE_STEX_REPORT_TEST,
+					     &num_rows);
+	  rerr = col_write (fname, IORE_STEX_REPORT_TEST, rows, num_rows);
+	  free (rows);
+	}
+    }
+
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  return rerr;
+} /* col_export_test () */
+
+int
+col_export_stats (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
+{
+  assert(trec_exp.num_exp_repl == 0 || trec_exp.exp_repl);
+  assert(stex);
+
+  iore_error("Unsupported report type.");
+  return IORE_FAILURE;
+} /* col_export_stats () */
+
+/**
+ * Sorts 'rows' by run repetition, so that the index can point to contiguous
+ * ranges of rows, and writes them column by column.
+ */
+static int
+col_write (const char *fname, enum iore_stex_report_type type,
+	   iore_stex_row_t *rows, size_t num_rows)
+{
+  FILE *file = fopen (fname, "w");
+  if (!file)
+    {
+      iore_errorf("Failed opening file '%s'.", fname);
+      return IORE_FAILURE;
+    }
+
+  qsort (rows, num_rows, sizeof(iore_stex_row_t), col_row_cmp);
+
+  /* label dictionary, in order of first appearance */
+  iore_stex_col_label_t labels[IORE_TEST_TYPE_LENGTH
+      * IORE_TREC_ACTION_LENGTH];
+  uint8_t codes[IORE_TEST_TYPE_LENGTH * IORE_TREC_ACTION_LENGTH];
+  uint8_t *row_codes = malloc ((num_rows ? num_rows : 1) * sizeof(uint8_t));
+  assert(row_codes);
+  uint32_t num_labels = 0;
+  memset (codes, UINT8_MAX, sizeof(codes));
+  size_t i;
+  for (i = 0; i < num_rows; i++)
+    {
+      int key = rows[i].type * IORE_TREC_ACTION_LENGTH + rows[i].action;
+      if (codes[key] == UINT8_MAX)
+	{
+	  iore_stex_col_label_t *label = &labels[num_labels];
+	  memset (label, 0, sizeof(iore_stex_col_label_t));
+	  label->test = rows[i].type;
+	  label->action = rows[i].action;
+	  strncpy (label->test_lbl, test_type_lbl[rows[i].type],
+		   IORE_STEX_COL_LABEL_LEN - 1);
+	  strncpy (label->action_lbl, trec_action_lbl[rows[i].action],
+		   IORE_STEX_COL_LABEL_LEN - 1);
+	  codes[key] = num_labels++;
+	}
+      row_codes[i] = codes[key];
+    }
+
+  /* index of run repetitions */
+  iore_stex_col_entry_t *entries = malloc (
+      (num_rows ? num_rows : 1) * sizeof(iore_stex_col_entry_t));
+  assert(entries);
+  uint64_t num_entries = 0;
+  iore_stex_col_entry_t *entry = NULL;
+  for (i = 0; i < num_rows; i++)
+    {
+      if (!entry || entry->exp_repl_id != rows[i].exp_repl_id
+	  || entry->run_id != rows[i].run_id
+	  || entry->run_rept_id != rows[i].run_rept_id)
+	{
+	  entry = &entries[num_entries++];
+	  memset (entry, 0, sizeof(iore_stex_col_entry_t));
+	  entry->exp_repl_id = rows[i].exp_repl_id;
+	  entry->run_id = rows[i].run_id;
+	  entry->run_rept_id = rows[i].run_rept_id;
+	  entry->first_row = i;
+	}
+      entry->num_rows++;
+    }
+
+  iore_stex_col_header_t header;
+  memset (&header, 0, sizeof(header));
+  memcpy (header.magic, IORE_STEX_COL_MAGIC, sizeof(header.magic));
+  header.version = IORE_STEX_COL_VERSION;
+  header.byte_order = IORE_STEX_COL_BYTE_ORDER;
+  header.report_type = type;
+  header.num_cols = IORE_STEX_COL_LENGTH;
+  header.num_rows = num_rows;
+  fwrite (&header, sizeof(header), 1, file);
+
+  iore_stex_col_desc_t descs[IORE_STEX_COL_LENGTH];
+  int i_col;
+  for (i_col = 0; i_col < IORE_STEX_COL_LENGTH; i_col++)
+    col_write_column (file, rows, num_rows, i_col, row_codes, &descs[i_col]);
+
+  iore_stex_col_trailer_t trailer;
+  memcpy (trailer.magic, IORE_STEX_COL_MAGIC, sizeof(trailer.magic));
+  trailer.footer_offset = ftell (file);
+
+  iore_stex_col_footer_t footer;
+  footer.num_cols = IORE_STEX_COL_LENGTH;
+  footer.num_labels = num_labels;
+  footer.num_entries = num_entries;
+  fwrite (&footer, sizeof(footer), 1, file);
+  fwrite (descs, sizeof(iore_stex_col_desc_t), IORE_STEX_COL_LENGTH, file);
+  fwrite (labels, sizeof(iore_stex_col_label_t), num_labels, file);
+  fwrite (entries, sizeof(iore_stex_col_entry_t), num_entries, file);
+  fwrite (&trailer, sizeof(trailer), 1, file);
+
+  int rerr = IORE_SUCCESS;
+  if (ferror (file))
+    {
+      iore_errorf("Failed writing file '%s'.", fname);
+      rerr = IORE_FAILURE;
+    }
+  fclose (file);
+
+  free (entries);
+  free (row_codes);
+
+  return rerr;
+} /* col_write () */
+
+/**
+ * Writes the values of column 'col' of all 'rows', padded to the column
+ * alignment, and describes it into 'desc'.
+ */
+static void
+col_write_column (FILE *file, const iore_stex_row_t *rows, size_t num_rows,
+		  enum iore_stex_col col, const uint8_t *row_codes,
+		  iore_stex_col_desc_t *desc)
+{
+  desc->id = col;
+  desc->width = col_width[col];
+  desc->offset = ftell (file);
+
+  size_t i;
+  for (i = 0; i < num_rows; i++)
+    {
+      const iore_stex_row_t *row = &rows[i];
+      union
+      {
+	uint32_t u32;
+	int32_t i32;
+	uint8_t u8;
+	double f64;
+	uint64_t u64;
+      } val;
+
+      if (col == IORE_STEX_COL_EXP_REPL_ID)
+	val.u32 = row->exp_repl_id;
+      else if (col == IORE_STEX_COL_RUN_ID)
+	val.u32 = row->run_id;
+      else if (col == IORE_STEX_COL_RUN_REPT_ID)
+	val.u32 = row->run_rept_id;
+      else if (col == IORE_STEX_COL_TASK_ID)
+	val.i32 = row->task_id;
+      else if (col == IORE_STEX_COL_LABEL)
+	val.u8 = row_codes[i];
+      else if (col == IORE_STEX_COL_START_TIME)
+	val.f64 = row->time[IORE_TREC_EVENT_START];
+      else if (col == IORE_STEX_COL_STOP_TIME)
+	val.f64 = row->time[IORE_TREC_EVENT_STOP];
+      else
+	val.u64 = row->data_size;
+
+      fwrite (&val, desc->width, 1, file);
+    }
+
+  static const char pad[IORE_STEX_COL_ALIGN] =
+    { 0 };
+  long len = num_rows * desc->width;
+  fwrite (pad, 1, (IORE_STEX_COL_ALIGN - len % IORE_STEX_COL_ALIGN)
+      % IORE_STEX_COL_ALIGN,
+	  file);
+} /* col_write_column () */
+
+static int
+col_row_cmp (const void *a, const void *b)
+{
+  const iore_stex_row_t *ra = a;
+  const iore_stex_row_t *rb = b;
+
+  if (ra->exp_repl_id != rb->exp_repl_id)
+    return (ra->exp_repl_id > rb->exp_repl_id) ? 1 : -1;
+  if (ra->run_id != rb->run_id)
+    return (ra->run_id > rb->run_id) ? 1 : -1;
+  if (ra->run_rept_id != rb->run_rept_id)
+    return (ra->run_rept_id > rb->run_rept_id) ? 1 : -1;
+  if (ra->task_id != rb->task_id)
+    return (ra->task_id > rb->task_id) ? 1 : -1;
+  if (ra->type != rb->type)
+    return (ra->type > rb->type) ? 1 : -1;
+  if (ra->action != rb->action)
+    return (ra->action > rb->action) ? 1 : -1;
+
+  return 0;
+} /* col_row_cmp () */
+
+static int
+col_get_file_name (enum iore_stex_report_type type, const char *dir,
+		   char *fname)
+{
+  time_t t = time (NULL);
+  struct tm *tm = localtime (&t);
+
+  if (type == IORE_STEX_REPORT_TASK)
+    snprintf (fname, FILENAME_MAX, COL_STEX_TASK_FILE_NAME_FORMAT, dir,
+	      tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour,
+	      tm->tm_min, tm->tm_sec);
+  else if (type == IORE_STEX_REPORT_TEST)
+    snprintf (fname, FILENAME_MAX, COL_STEX_TEST_FILE_NAME_FORMAT, dir,
+	      tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour,
+	      tm->tm_min, tm->tm_sec);
+  else
+    {
+      iore_error("Unsupported report type.");
+      return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* col_get_file_name () */
@@ -0,0 +1,287 @@
+/*
+ * iore_stex_columnar_reader.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "iore_stex_columnar.h"
+#include "iore_stex_types.h"
+#include "iore_error.h"
+
+/*** DEFINES *****************************************************************/
+
+/**
+ * Same layout as the CSV task and test reports.
+ */
+#define COL_CSV_TASK_HEADER "exp_repl_id,run_id,run_rept_id,task_id,test,action,start_time,stop_time,latency,throughput\n"
+#define COL_CSV_TASK_ROW_FORMAT "%u,%u,%u,%d,%s,%s,%.6f,%.6f,%.6f,%.6f\n"
+#define COL_CSV_TEST_HEADER "exp_repl_id,run_id,run_rept_id,test,action,start_time,stop_time,latency,throughput\n"
+#define COL_CSV_TEST_ROW_FORMAT "%u,%u,%u,%s,%s,%.6f,%.6f,%.6f,%.6f\n"
+
+/*** PROTOTYPES **************************************************************/
+
+static void *
+cols_get (const iore_stex_cols_t *, size_t, const iore_stex_col_desc_t *,
+	  enum iore_stex_col, size_t);
+static int
+cols_check (const iore_stex_cols_t *);
+
+/*** FUNCTIONS ***************************************************************/
+
+/**
+ * Loads the columnar report file 'fname' into 'cols'. The file is validated
+ * against its header, trailer, column directory, label dictionary and
+ * index, so that truncated or corrupt files fail cleanly.
+ */
+int
+stex_cols_read (const char *fname, iore_stex_cols_t *cols)
+{
+  assert(fname);
+  assert(cols);
+
+  memset (cols, 0, sizeof(iore_stex_cols_t));
+
+  FILE *file = fopen (fname, "r");
+  if (!file)
+    return IORE_FAILURE;
+
+  fseek (file, 0, SEEK_END);
+  long size = ftell (file);
+  rewind (file);
+  if (size < (long) (sizeof(iore_stex_col_header_t)
+      + sizeof(iore_stex_col_footer_t) + sizeof(iore_stex_col_trailer_t)))
+    {
+      fclose (file);
+      return IORE_FAILURE;
+    }
+
+  cols->_data = malloc (size);
+  assert(cols->_data);
+  size_t nread = fread (cols->_data, 1, size, file);
+  fclose (file);
+  if (nread != (size_t) size)
+    {
+      stex_cols_free (cols);
+      return IORE_FAILURE;
+    }
+
+  /* the footer lies between the header and the trailer */
+  const iore_stex_col_header_t *header = (void *) cols->_data;
+  const iore_stex_col_trailer_t *trailer = (void *) (cols->_data + size
+      - sizeof(iore_stex_col_trailer_t));
+  uint64_t footer_end = size - sizeof(iore_stex_col_trailer_t);
+  if (memcmp (header->magic, IORE_STEX_COL_MAGIC, sizeof(header->magic))
+      || memcmp (trailer->magic, IORE_STEX_COL_MAGIC, sizeof(trailer->magic))
+      || header->version != IORE_STEX_COL_VERSION
+      || header->byte_order != IORE_STEX_COL_BYTE_ORDER
+      || (header->report_type != IORE_STEX_REPORT_TASK
+	  && header->report_type != IORE_STEX_REPORT_TEST)
+      || trailer->footer_offset < sizeof(iore_stex_col_header_t)
+      || trailer->footer_offset % IORE_STEX_COL_ALIGN
+      || trailer->footer_offset + sizeof(iore_stex_col_footer_t)
+	  > footer_end)
+    {
+      stex_cols_free (cols);
+      return IORE_FAILURE;
+    }
+  cols->report_type = header->report_type;
+  cols->num_rows = header->num_rows;
+
+  const iore_stex_col_footer_t *footer = (void *) (cols->_data
+      + trailer->footer_offset);
+  uint64_t avail = footer_end - trailer->footer_offset
+      - sizeof(iore_stex_col_footer_t);
+  if (footer->num_cols != header->num_cols
+      || footer->num_cols > avail / sizeof(iore_stex_col_desc_t))
+    {
+      stex_cols_free (cols);
+      return IORE_FAILURE;
+    }
+  avail -= footer->num_cols * sizeof(iore_stex_col_desc_t);
+  if (footer->num_labels > avail / sizeof(iore_stex_col_label_t))
+    {
+      stex_cols_free (cols);
+      return IORE_FAILURE;
+    }
+  avail -= footer->num_labels * sizeof(iore_stex_col_label_t);
+  if (footer->num_entries != avail / sizeof(iore_stex_col_entry_t)
+      || avail % sizeof(iore_stex_col_entry_t))
+    {
+      stex_cols_free (cols);
+      return IORE_FAILURE;
+    }
+
+  const iore_stex_col_desc_t *descs = (void *) (footer + 1);
+  cols->num_labels = footer->num_labels;
+  cols->labels = (void *) (descs + footer->num_cols);
+  cols->num_entries = footer->num_entries;
+  cols->entries = (void *) (cols->labels + footer->num_labels);
+
+  size_t num_cols = footer->num_cols;
+  cols->exp_repl_id = cols_get (cols, num_cols, descs,
+				IORE_STEX_COL_EXP_REPL_ID,
+				sizeof(*cols->exp_repl_id));
+  cols->run_id = cols_get (cols, num_cols, descs, IORE_STEX_COL_RUN_ID,
+			   sizeof(*cols->run_id));
+  cols->run_rept_id = cols_get (cols, num_cols, descs,
+				IORE_STEX_COL_RUN_REPT_ID,
+				sizeof(*cols->run_rept_id));
+  cols->task_id = cols_get (cols, num_cols, descs, IORE_STEX_COL_TASK_ID,
+			    sizeof(*cols->task_id));
+  cols->label = cols_get (cols, num_cols, descs, IORE_STEX_COL_LABEL,
+			  sizeof(*cols->label));
+  cols->start_time = cols_get (cols, num_cols, descs,
+			       IORE_STEX_COL_START_TIME,
+			       sizeof(*cols->start_time));
+  cols->stop_time = cols_get (cols, num_cols, descs, IORE_STEX_COL_STOP_TIME,
+			      sizeof(*cols->stop_time));
+  cols->data_size = cols_get (cols, num_cols, descs, IORE_STEX_COL_DATA_SIZE,
+			      sizeof(*cols->data_size));
+  if (!cols->exp_repl_id || !cols->run_id || !cols->run_rept_id
+      || !cols->task_id || !cols->label || !cols->start_time
+      || !cols->stop_time || !cols->data_size || cols_check (cols))
+    {
+      stex_cols_free (cols);
+      return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* stex_cols_read () */
+
+void
+stex_cols_free (iore_stex_cols_t *cols)
+{
+  if (cols)
+    {
+      free (cols->_data);
+      memset (cols, 0, sizeof(iore_stex_cols_t));
+    }
+} /* stex_cols_free () */
+
+/**
+ * Looks up the rows of a run repetition in the index. Returns a NULL
+ * pointer if there are none.
+ */
+const iore_stex_col_entry_t *
+stex_cols_find (const iore_stex_cols_t *cols, unsigned int exp_repl_id,
+		unsigned int run_id, unsigned int run_rept_id)
+{
+  assert(cols);
+
+  uint64_t i;
+  for (i = 0; i < cols->num_entries; i++)
+    {
+      const iore_stex_col_entry_t *entry = &cols->entries[i];
+      if (entry->exp_repl_id == exp_repl_id && entry->run_id == run_id
+	  && entry->run_rept_id == run_rept_id)
+	return entry;
+    }
+
+  return NULL;
+} /* stex_cols_find () */
+
+/**
+ * Writes the rows of 'cols' as CSV into 'file', in the layout of the CSV
+ * report of the same type. If 'entry' is given, only its rows are written.
+ */
+void
+stex_cols_to_csv (const iore_stex_cols_t *cols,
+		  const iore_stex_col_entry_t *entry, FILE *file)
+{
+  assert(cols);
+  assert(file);
+
+  bool task = (cols->report_type == IORE_STEX_REPORT_TASK);
+  fputs (task ? COL_CSV_TASK_HEADER : COL_CSV_TEST_HEADER, file);
+
+  uint64_t first = (entry ? entry->first_row : 0);
+  uint64_t last = (entry ? entry->first_row + entry->num_rows : cols->num_rows);
+  uint64_t i;
+  for (i = first; i < last; i++)
+    {
+      const iore_stex_col_label_t *label = &cols->labels[cols->label[i]];
+      double latency = cols->stop_time[i] - cols->start_time[i];
+      double tput = 0;
+      if (label->action == IORE_TREC_ACTION_WRITE_READ)
+	tput = cols->data_size[i] / latency;
+
+      if (task)
+	fprintf (file, COL_CSV_TASK_ROW_FORMAT, cols->exp_repl_id[i],
+		 cols->run_id[i], cols->run_rept_id[i], cols->task_id[i],
+		 label->test_lbl, label->action_lbl, cols->start_time[i],
+		 cols->stop_time[i], latency, tput);
+      else
+	fprintf (file, COL_CSV_TEST_ROW_FORMAT, cols->exp_repl_id[i],
+		 cols->run_id[i], cols->run_rept_id[i], label->test_lbl,
+		 label->action_lbl, cols->start_time[i], cols->stop_time[i],
+		 latency, tput);
+    }
+} /* stex_cols_to_csv () */
+
+/**
+ * Returns the values of column 'col', or a NULL pointer if the column is
+ * missing, is not 'width' bytes wide, is misaligned or does not fit between
+ * the header and the footer.
+ */
+static void *
+cols_get (const iore_stex_cols_t *cols, size_t num_cols,
+	  const iore_stex_col_desc_t *descs, enum iore_stex_col col,
+	  size_t width)
+{
+  uint64_t footer_offset = (char *) descs - cols->_data
+      - sizeof(iore_stex_col_footer_t);
+
+  size_t i;
+  for (i = 0; i < num_cols; i++)
+    if (descs[i].id == (uint32_t) col)
+      {
+	const iore_stex_col_desc_t *desc = &descs[i];
+	if (desc->width != width
+	    || desc->offset < sizeof(iore_stex_col_header_t)
+	    || desc->offset % IORE_STEX_COL_ALIGN
+	    || desc->offset > footer_offset
+	    || cols->num_rows > (footer_offset - desc->offset) / width)
+	  return NULL;
+	return cols->_data + desc->offset;
+      }
+
+  return NULL;
+} /* cols_get () */
+
+/**
+ * Checks the label dictionary, the label codes of rows and the index
+ * entries of 'cols', whose columns are already located.
+ */
+static int
+cols_check (const iore_stex_cols_t *cols)
+{
+  uint64_t i;
+  for (i = 0; i < cols->num_labels; i++)
+    {
+      const iore_stex_col_label_t *label = &cols->labels[i];
+      if (label->test >= IORE_TEST_TYPE_LENGTH
+	  || label->action >= IORE_TREC_ACTION_LENGTH
+	  || !memchr (label->test_lbl, '\0', sizeof(label->test_lbl))
+	  || !memchr (label->action_lbl, '\0', sizeof(label->action_lbl)))
+	return IORE_FAILURE;
+    }
+
+  for (i = 0; i < cols->num_rows; i++)
+    if (cols->label[i] >= cols->num_labels)
+      return IORE_FAILURE;
+
+  for (i = 0; i < cols->num_entries; i++)
+    {
+      const iore_stex_col_entry_t *entry = &cols->entries[i];
+      if (entry->first_row > cols->num_rows
+	  || entry->num_rows > cols->num_rows - entry->first_row)
+	return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* cols_check () */
@@ -22,116 +22,376 @@
 
 /*** DEFINES *****************************************************************/
 
+/**
+ * Task and test report rows are followed by the resource counters recorded,
+ * one column each. Rows of all reports end with the coordinates of the run
+ * in the parameter sweeps, one column per swept parameter.
+ */
+#define CSV_STEX_RSRC_TIME_FORMAT ",%.6f"
+#define CSV_STEX_RSRC_COUNT_FORMAT ",%.0f"
+
 /**
  * Task report constants.
  */
-#define CSV_STEX_TASK_FILE_NAME_FORMAT "%s/iore_task_%09d_%04d%02d%02d%02d%02d%02d.csv"
-#define CSV_STEX_TASK_HEADER "exp_repl_id,run_id,run_rept_id,task_id,test,action,start_time,stop_time,latency,throughput\n"
-#define CSV_STEX_TASK_ROW_FORMAT "%d,%d,%d,%d,%s,%s,%.6f,%.6f,%.6f,%.6f\n"
+#define CSV_STEX_TASK_FILE_NAME_FORMAT "%s/iore_task_%04d%02d%02d%02d%02d%02d.csv"
+#define CSV_STEX_TASK_HEADER "exp_repl_id,run_id,run_rept_id,task_id,test,action,start_time,stop_time,latency,throughput"
+#define CSV_STEX_TASK_ROW_FORMAT "%d,%d,%d,%d,%s,%s,%.6f,%.6f,%.6f,%.6f"
 
 /**
  * Test report constants.
  */
 #define CSV_STEX_TEST_FILE_NAME_FORMAT "%s/iore_test_%04d%02d%02d%02d%02d%02d.csv"
-#define CSV_STEX_TEST_HEADER "exp_repl_id,run_id,run_rept_id,test,action,start_time,stop_time,latency,throughput\n"
-#define CSV_STEX_TEST_ROW_FORMAT "%d,%d,%d,%s,%s,%.6f,%.6f,%.6f,%.6f\n"
+#define CSV_STEX_TEST_HEADER "exp_repl_id,run_id,run_rept_id,test,action,start_time,stop_time,latency,throughput"
+#define CSV_STEX_TEST_ROW_FORMAT "%d,%d,%d,%s,%s,%.6f,%.6f,%.6f,%.6f"
+
+/**
+ * Statistics report constants.
+ */
+#define CSV_STEX_STATS_FILE_NAME_FORMAT "%s/iore_stats_%04d%02d%02d%02d%02d%02d.csv"
+#define CSV_STEX_STATS_HEADER "exp_repl_id,run_id,run_rept_id,test,action,num_tasks,latency_min,latency_median,latency_mean,latency_p95,latency_max,throughput_min,throughput_median,throughput_mean,throughput_p95,throughput_max,start_skew,straggler_task,straggler_host,num_stragglers,bw_ci_level,bw_ci,interference"
+#define CSV_STEX_STATS_ROW_FORMAT "%d,%d,%d,%s,%s,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%d,%s,%u,%.2f,%.6f,%.6f"
 
 /*** PROTOTYPES **************************************************************/
 
 int
-csv_export_task (const iore_trec_exp_t, const char *);
+csv_export_task (const iore_trec_exp_t, const iore_stex_t *);
 int
-csv_export_test (const iore_trec_exp_t, const char *);
+csv_export_test (const iore_trec_exp_t, const iore_stex_t *);
+int
+csv_export_stats (const iore_trec_exp_t, const iore_stex_t *);
+int
+csv_stream_rept (const iore_stex_t *, unsigned int, unsigned int,
+		 const iore_trec_run_rept_t *);
 
+static int
+csv_write_task (const char *, iore_stex_row_t *, size_t, bool, bool);
+static int
+csv_stream_open (const iore_stex_t *, enum iore_stex_report_type, FILE **);
 static int
 csv_export (const iore_trec_exp_t, const char *, enum iore_stex_report_type);
 static int
+csv_open (const char *, enum iore_stex_report_type, FILE **);
+static int
 csv_export_header (FILE *, enum iore_stex_report_type);
 static int
 csv_export_rows (FILE *, const iore_trec_exp_t, enum iore_stex_report_type);
 static int
+csv_export_rows_rept (FILE *, unsigned int, unsigned int,
+		      const iore_trec_run_rept_t *, enum iore_stex_report_type);
+static int
 csv_export_row_action (FILE *, unsigned int, unsigned int, unsigned int,
 		       const iore_trec_test_t, enum iore_trec_action,
 		       enum iore_stex_report_type);
+static void
+csv_export_task_rows (FILE *, const iore_stex_row_t *, size_t);
+static int
+csv_export_rows_stats (FILE *, unsigned int, unsigned int, unsigned int,
+		       const iore_trec_test_t);
+static void
+csv_export_rsrc_header (FILE *);
+static void
+csv_export_rsrc (FILE *, const double *);
+static void
+csv_export_sweep_header (FILE *);
+static void
+csv_export_sweep (FILE *, unsigned int);
 static int
 csv_get_file_name (enum iore_stex_report_type, const char *, char *);
 
 /*** VARIABLES ***************************************************************/
 
 const iore_stex_vtable_t stex_csv =
-  { csv_export_task, csv_export_test };
+  { csv_export_task, csv_export_test, csv_export_stats, csv_stream_rept };
+
+/* resource counters of the report being exported */
+static iore_trec_rsrc_flags_t csv_rsrc =
+  { };
+/* sweep coordinates of the report being exported */
+static const iore_stex_sweep_t *csv_sweep = NULL;
 
 /*** FUNCTIONS ***************************************************************/
 
+/**
+ * Exports the task report of all tasks into a single file. Each task
+ * formats its own rows, which are written collectively through MPI-IO or,
+ * if the task report is gathered, by the master task.
+ */
 int
-csv_export_task (const iore_trec_exp_t trec_exp, const char *dir)
+csv_export_task (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
 {
-  assert(dir);
+  assert(stex);
+  assert(stex->export_dir);
 
-  int rerr = csv_export (trec_exp, dir, IORE_STEX_REPORT_TASK);
-  return rerr;
+  const char *dir = stex->export_dir;
+  csv_rsrc = trec_exp.rsrc;
+  csv_sweep = &stex->sweep;
+
+  /* the file name is taken at the master, clocks may tick in between */
+  char fname[FILENAME_MAX];
+  int rerr = IORE_SUCCESS;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      rerr = stex_dir_check (dir);
+      if (!rerr)
+	rerr = csv_get_file_name (IORE_STEX_REPORT_TASK, dir, fname);
+    }
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  if (rerr)
+    return IORE_FAILURE;
+  MPI_Bcast (fname, FILENAME_MAX, MPI_CHAR, IORE_MASTER_TASK, ctx.comm);
+
+  size_t num_rows;
+  iore_stex_row_t *rows = stex_rows (trec_exp, IORE_STEX_REPORT_TASK,
+				     &num_rows);
+
+  return csv_write_task (fname, rows, num_rows, stex->task_gather, false);
 } /* csv_export_task () */
 
 int
-csv_export_test (const iore_trec_exp_t trec_exp, const char *dir)
+csv_export_test (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
 {
-  assert(dir);
+  assert(stex);
+  assert(stex->export_dir);
+
+  csv_rsrc = trec_exp.rsrc;
+  csv_sweep = &stex->sweep;
 
   int rerr = IORE_SUCCESS;
   if (ctx.task_id == IORE_MASTER_TASK)
-    rerr = csv_export (trec_exp, dir, IORE_STEX_REPORT_TEST);
+    rerr = csv_export (trec_exp, stex->export_dir, IORE_STEX_REPORT_TEST);
 
   MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
   return rerr;
 } /* csv_export_test () */
 
+int
+csv_export_stats (const iore_trec_exp_t trec_exp, const iore_stex_t *stex)
+{
+  assert(stex);
+  assert(stex->export_dir);
+
+  csv_sweep = &stex->sweep;
+
+  /* statistics are computed by all tasks, but written by the master */
+  int rerr = IORE_SUCCESS;
+  FILE *file = NULL;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    rerr = csv_open (stex->export_dir, IORE_STEX_REPORT_STATS, &file);
+
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  if (!rerr)
+    rerr = csv_export_rows (file, trec_exp, IORE_STEX_REPORT_STATS);
+  if (file)
+    fclose (file);
+
+  return rerr;
+} /* csv_export_stats () */
+
+/**
+ * Appends the rows of a run repetition to the streamed reports enabled in
+ * 'stex'. Collective over the tasks of the run.
+ */
+int
+csv_stream_rept (const iore_stex_t *stex, unsigned int exp_repl_id,
+		 unsigned int run_id, const iore_trec_run_rept_t *trec_rept)
+{
+  assert(stex);
+  assert(trec_rept);
+
+  csv_rsrc = stex->os_counters;
+  csv_sweep = &stex->sweep;
+
+  int rerr = IORE_SUCCESS;
+  if (stex->report_type.task)
+    {
+      char fname[FILENAME_MAX];
+      stex_stream_file_name (stex, IORE_STEX_REPORT_TASK, fname);
+
+      iore_stex_row_t *rows = malloc (IORE_TEST_TYPE_LENGTH
+	  * IORE_TREC_ACTION_LENGTH * sizeof(iore_stex_row_t));
+      assert(rows);
+      size_t num_rows = stex_rows_rept (exp_repl_id, run_id, trec_rept,
+					IORE_STEX_REPORT_TASK, rows);
+      rerr |= csv_write_task (fname, rows, num_rows, stex->task_gather, true);
+    }
+
+  enum iore_stex_report_type type;
+  for (type = IORE_STEX_REPORT_TEST; type <= IORE_STEX_REPORT_STATS; type++)
+    {
+      if ((type == IORE_STEX_REPORT_TEST && !stex->report_type.test)
+	  || (type == IORE_STEX_REPORT_STATS && !stex->report_type.stats))
+	continue;
+
+      /* test rows are written by the master, statistics computed by all */
+      int rerr2 = IORE_SUCCESS;
+      FILE *file = NULL;
+      if (ctx.task_id == IORE_MASTER_TASK)
+	rerr2 = csv_stream_open (stex, type, &file);
+      MPI_Bcast (&rerr2, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+      if (!rerr2 && (type == IORE_STEX_REPORT_STATS || file))
+	rerr2 = csv_export_rows_rept (file, exp_repl_id, run_id, trec_rept,
+				      type);
+      if (file)
+	fclose (file);
+      if (type == IORE_STEX_REPORT_TEST)
+	MPI_Bcast (&rerr2, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+      rerr |= rerr2;
+    }
+
+  return rerr;
+} /* csv_stream_rept () */
+
+/**
+ * Writes the task report 'rows' of every task into file 'fname', appending
+ * them if 'append' is set. Each task formats its own rows, which are
+ * written collectively through MPI-IO or, if 'gather' is set, gathered and
+ * written by the master task. 'rows' is released. Collective.
+ */
 static int
-csv_export (const iore_trec_exp_t trec_exp, const char *dir,
-	    enum iore_stex_report_type type)
+csv_write_task (const char *fname, iore_stex_row_t *rows, size_t num_rows,
+		bool gather, bool append)
+{
+  /* the header goes first into new or empty files */
+  bool has_header = (ctx.task_id == IORE_MASTER_TASK
+      && (!append || stex_file_size (fname) == 0));
+
+  int rerr = IORE_SUCCESS;
+  if (gather)
+    {
+      rows = stex_rows_gather (rows, &num_rows);
+      if (ctx.task_id == IORE_MASTER_TASK)
+	{
+	  FILE *file = fopen (fname, append ? "a" : "w");
+	  if (file)
+	    {
+	      if (has_header)
+		{
+		  fputs (CSV_STEX_TASK_HEADER, file);
+		  csv_export_rsrc_header (file);
+		  csv_export_sweep_header (file);
+		}
+	      csv_export_task_rows (file, rows, num_rows);
+	      fclose (file);
+	    }
+	  else
+	    {
+	      iore_errorf("Failed opening file '%s'.", fname);
+	      rerr = IORE_FAILURE;
+	    }
+	}
+      MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+    }
+  else
+    {
+      char *buf = NULL;
+      size_t len = 0;
+      FILE *file = open_memstream (&buf, &len);
+      assert(file);
+      if (has_header)
+	{
+	  fputs (CSV_STEX_TASK_HEADER, file);
+	  csv_export_rsrc_header (file);
+	  csv_export_sweep_header (file);
+	}
+      csv_export_task_rows (file, rows, num_rows);
+      fclose (file);
+
+      if (append)
+	rerr = stex_append_shared (fname, buf, len);
+      else
+	rerr = stex_write_shared (fname, buf, len);
+      free (buf);
+    }
+  free (rows);
+
+  return rerr;
+} /* csv_write_task () */
+
+/**
+ * Opens the streamed report of 'type' for appending, writing its header if
+ * the file is empty.
+ */
+static int
+csv_stream_open (const iore_stex_t *stex, enum iore_stex_report_type type,
+		 FILE **file)
 {
-  if (!file_is_dir (dir))
+  char fname[FILENAME_MAX];
+  stex_stream_file_name (stex, type, fname);
+
+  *file = fopen (fname, "a");
+  if (!*file)
     {
-      iore_errorf_all("'%s' is not a directory.", dir);
+      iore_errorf("Failed opening file '%s'.", fname);
       return IORE_FAILURE;
     }
 
-  int amode = F_OK | W_OK;
-  if (access (dir, amode))
+  fseek (*file, 0, SEEK_END);
+  if (ftell (*file) == 0 && csv_export_header (*file, type))
     {
-      iore_errorf_all("Insufficient permissions on directory '%s'.", dir);
+      fclose (*file);
+      *file = NULL;
       return IORE_FAILURE;
     }
 
-  char fname[FILENAME_MAX];
-  if (csv_get_file_name (type, dir, fname))
+  return IORE_SUCCESS;
+} /* csv_stream_open () */
+
+static int
+csv_export (const iore_trec_exp_t trec_exp, const char *dir,
+	    enum iore_stex_report_type type)
+{
+  FILE *file;
+  if (csv_open (dir, type, &file))
     return IORE_FAILURE;
 
-  FILE *file = fopen (fname, "a");
-  assert(file);
+  int rerr = csv_export_rows (file, trec_exp, type);
+  fclose (file);
 
-  int rerr = csv_export_header (file, type);
   if (rerr)
     return IORE_FAILURE;
 
-  rerr = csv_export_rows (file, trec_exp, type);
+  return IORE_SUCCESS;
+} /* csv_export () */
+
+/**
+ * Opens the report file of 'type' in 'dir' and writes its header.
+ */
+static int
+csv_open (const char *dir, enum iore_stex_report_type type, FILE **file)
+{
+  if (stex_dir_check (dir))
+    return IORE_FAILURE;
 
-  if (rerr)
+  char fname[FILENAME_MAX];
+  if (csv_get_file_name (type, dir, fname))
     return IORE_FAILURE;
 
+  *file = fopen (fname, "a");
+  assert(*file);
+
+  if (csv_export_header (*file, type))
+    {
+      fclose (*file);
+      return IORE_FAILURE;
+    }
+
   return IORE_SUCCESS;
-} /* csv_export () */
+} /* csv_open () */
 
 static int
 csv_export_header (FILE *file, enum iore_stex_report_type type)
 {
-  if (type == IORE_STEX_REPORT_TASK)
+  if (type == IORE_STEX_REPORT_TEST && ctx.task_id == IORE_MASTER_TASK)
     {
-      fputs (CSV_STEX_TASK_HEADER, file);
+      fputs (CSV_STEX_TEST_HEADER, file);
+      csv_export_rsrc_header (file);
+      csv_export_sweep_header (file);
       fflush (file);
     }
-  else if (type == IORE_STEX_REPORT_TEST && ctx.task_id == IORE_MASTER_TASK)
+  else if (type == IORE_STEX_REPORT_STATS && ctx.task_id == IORE_MASTER_TASK)
     {
-      fputs (CSV_STEX_TEST_HEADER, file);
+      fputs (CSV_STEX_STATS_HEADER, file);
+      csv_export_sweep_header (file);
       fflush (file);
     }
   else
@@ -147,9 +407,7 @@ static int
 csv_export_rows (FILE *file, const iore_trec_exp_t trec_exp,
 		 enum iore_stex_report_type type)
 {
-  int rerr = IORE_SUCCESS;
-
-  unsigned int i_repl, i_run, i_rept, i_test, i_act;
+  unsigned int i_repl, i_run, i_rept;
   for (i_repl = 0; i_repl < trec_exp.num_exp_repl; i_repl++)
     {
       const iore_trec_exp_repl_t trec_repl = trec_exp.exp_repl[i_repl];
@@ -157,66 +415,76 @@ csv_export_rows (FILE *file, const iore_trec_exp_t trec_exp,
 	{
 	  const iore_trec_run_t trec_run = trec_repl.run[i_run];
 	  for (i_rept = 0; i_rept < trec_run.num_run_rept; i_rept++)
-	    {
-	      const iore_trec_run_rept_t trec_rept = trec_run.run_rept[i_rept];
-	      for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
-		{
-		  const iore_trec_test_t trec_test = trec_rept.test[i_test];
-		  if (trec_test.committed)
-		    {
-		      for (i_act = 0; i_act < IORE_TREC_ACTION_LENGTH; i_act++)
-			{
-			  rerr = csv_export_row_action (file, trec_repl.id,
-							trec_run.id,
-							trec_rept.id, trec_test,
-							i_act, type);
-			  if (rerr)
-			    return IORE_FAILURE;
-			} /* end of action loop */
-		    }
-		} /* end of test loop */
-	    } /* end of run_rept loop */
+	    if (csv_export_rows_rept (file, trec_repl.id, trec_run.id,
+				      &trec_run.run_rept[i_rept], type))
+	      return IORE_FAILURE;
 	} /* end of run loop */
     } /* end of exp_repl loop */
 
   return IORE_SUCCESS;
 } /* csv_export_rows () */
 
+/**
+ * Exports the rows of a run repetition. Collective for the statistics
+ * report.
+ */
 static int
-csv_export_row_action (FILE *file, unsigned int exp_repl_id,
-		       unsigned int run_id, unsigned int run_rept_id,
-		       iore_trec_test_t trec_test, enum iore_trec_action action,
-		       enum iore_stex_report_type type)
+csv_export_rows_rept (FILE *file, unsigned int exp_repl_id,
+		      unsigned int run_id,
+		      const iore_trec_run_rept_t *trec_rept,
+		      enum iore_stex_report_type type)
 {
-  iore_time_t start_time, stop_time, latency;
-  double tput;
+  int rerr = IORE_SUCCESS;
 
-  if (type == IORE_STEX_REPORT_TASK)
+  unsigned int i_test, i_act;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
     {
-      start_time = trec_test.task_time[action][IORE_TREC_EVENT_START];
-      stop_time = trec_test.task_time[action][IORE_TREC_EVENT_STOP];
-      latency = stop_time - start_time;
-      if (action == IORE_TREC_ACTION_WRITE_READ)
+      const iore_trec_test_t trec_test = trec_rept->test[i_test];
+      if (type == IORE_STEX_REPORT_STATS)
 	{
-	  tput = trec_test.task_data_size / latency;
+	  /* tasks out of the run have no committed records */
+	  bool committed = false;
+	  MPI_Allreduce (&trec_test.committed, &committed, 1, MPI_C_BOOL,
+			 MPI_LOR, ctx.comm);
+	  if (committed)
+	    rerr = csv_export_rows_stats (file, exp_repl_id, run_id,
+					  trec_rept->id, trec_test);
+	  if (rerr)
+	    return IORE_FAILURE;
 	}
-      else
+      else if (trec_test.committed)
 	{
-	  tput = 0;
+	  for (i_act = 0; i_act < IORE_TREC_ACTION_LENGTH; i_act++)
+	    {
+	      rerr = csv_export_row_action (file, exp_repl_id, run_id,
+					    trec_rept->id, trec_test, i_act,
+					    type);
+	      if (rerr)
+		return IORE_FAILURE;
+	    } /* end of action loop */
 	}
+    } /* end of test loop */
 
-      fprintf (file, CSV_STEX_TASK_ROW_FORMAT, exp_repl_id, run_id, run_rept_id,
-	       ctx.task_id, test_type_lbl[trec_test.type],
-	       trec_action_lbl[action], start_time, stop_time, latency, tput);
-    }
-  else if (type == IORE_STEX_REPORT_TEST)
+  return IORE_SUCCESS;
+} /* csv_export_rows_rept () */
+
+static int
+csv_export_row_action (FILE *file, unsigned int exp_repl_id,
+		       unsigned int run_id, unsigned int run_rept_id,
+		       iore_trec_test_t trec_test, enum iore_trec_action action,
+		       enum iore_stex_report_type type)
+{
+  iore_time_t start_time, stop_time, latency;
+  double tput;
+
+  if (type == IORE_STEX_REPORT_TEST)
     {
       start_time = trec_test.test_time[action][IORE_TREC_EVENT_START];
       stop_time = trec_test.test_time[action][IORE_TREC_EVENT_STOP];
       latency = stop_time - start_time;
       if (action == IORE_TREC_ACTION_WRITE_READ)
 	{
-	  tput = trec_test.task_data_size / latency;
+	  tput = trec_test.test_data_size / latency;
 	}
       else
 	{
@@ -226,6 +494,8 @@ csv_export_row_action (FILE *file, unsigned int exp_repl_id,
       fprintf (file, CSV_STEX_TEST_ROW_FORMAT, exp_repl_id, run_id, run_rept_id,
 	       test_type_lbl[trec_test.type], trec_action_lbl[action],
 	       start_time, stop_time, latency, tput);
+      csv_export_rsrc (file, trec_test.test_rsrc[action]);
+      csv_export_sweep (file, run_id);
     }
   else
     {
@@ -236,6 +506,123 @@ csv_export_row_action (FILE *file, unsigned int exp_repl_id,
   return IORE_SUCCESS;
 } /* csv_export_row_action () */
 
+static void
+csv_export_task_rows (FILE *file, const iore_stex_row_t *rows, size_t num_rows)
+{
+  size_t i;
+  for (i = 0; i < num_rows; i++)
+    {
+      const iore_stex_row_t *row = &rows[i];
+      iore_time_t latency = (row->time[IORE_TREC_EVENT_STOP]
+	  - row->time[IORE_TREC_EVENT_START]);
+      double tput = 0;
+      if (row->action == IORE_TREC_ACTION_WRITE_READ)
+	tput = row->data_size / latency;
+
+      fprintf (file, CSV_STEX_TASK_ROW_FORMAT, row->exp_repl_id, row->run_id,
+	       row->run_rept_id, row->task_id, test_type_lbl[row->type],
+	       trec_action_lbl[row->action], row->time[IORE_TREC_EVENT_START],
+	       row->time[IORE_TREC_EVENT_STOP], latency, tput);
+      csv_export_rsrc (file, row->rsrc);
+      csv_export_sweep (file, row->run_id);
+    }
+} /* csv_export_task_rows () */
+
+/**
+ * Collective; 'file' is only written by the master task.
+ */
+static int
+csv_export_rows_stats (FILE *file, unsigned int exp_repl_id,
+		       unsigned int run_id, unsigned int run_rept_id,
+		       const iore_trec_test_t trec_test)
+{
+  iore_stex_stats_t stats[IORE_TREC_ACTION_LENGTH];
+  if (stex_stats (&trec_test, stats))
+    return IORE_FAILURE;
+
+  if (ctx.task_id != IORE_MASTER_TASK)
+    return IORE_SUCCESS;
+
+  int i_act;
+  for (i_act = 0; i_act < IORE_TREC_ACTION_LENGTH; i_act++)
+    {
+      const iore_stex_stats_t *st = &stats[i_act];
+      fprintf (file, CSV_STEX_STATS_ROW_FORMAT, exp_repl_id, run_id,
+	       run_rept_id, test_type_lbl[trec_test.type],
+	       trec_action_lbl[i_act], st->num_tasks, st->latency.min,
+	       st->latency.median, st->latency.mean, st->latency.p95,
+	       st->latency.max,
+	       st->throughput.min, st->throughput.median, st->throughput.mean,
+	       st->throughput.p95, st->throughput.max, st->start_skew,
+	       st->straggler_task, st->straggler_host, st->num_stragglers,
+	       trec_test.bw_ci_level, trec_test.bw_ci,
+	       trec_test.interference);
+      csv_export_sweep (file, run_id);
+    }
+
+  return IORE_SUCCESS;
+} /* csv_export_rows_stats () */
+
+/**
+ * Appends the names of the resource counters recorded to the header of a
+ * task or test report.
+ */
+static void
+csv_export_rsrc_header (FILE *file)
+{
+  int i_rsrc;
+  for (i_rsrc = 0; i_rsrc < IORE_TREC_RSRC_LENGTH; i_rsrc++)
+    if (trec_rsrc_enabled (csv_rsrc, i_rsrc))
+      fprintf (file, ",%s", trec_rsrc_lbl[i_rsrc]);
+} /* csv_export_rsrc_header () */
+
+/**
+ * Appends the resource counters recorded to a task or test report row.
+ */
+static void
+csv_export_rsrc (FILE *file, const double *rsrc)
+{
+  int i_rsrc;
+  for (i_rsrc = 0; i_rsrc < IORE_TREC_RSRC_LENGTH; i_rsrc++)
+    {
+      if (!trec_rsrc_enabled (csv_rsrc, i_rsrc))
+	continue;
+      if (i_rsrc == IORE_TREC_RSRC_UTIME || i_rsrc == IORE_TREC_RSRC_STIME
+	  || i_rsrc == IORE_TREC_RSRC_TASK_CLOCK)
+	fprintf (file, CSV_STEX_RSRC_TIME_FORMAT, rsrc[i_rsrc]);
+      else
+	fprintf (file, CSV_STEX_RSRC_COUNT_FORMAT, rsrc[i_rsrc]);
+    }
+} /* csv_export_rsrc () */
+
+/**
+ * Ends the header of a report with the swept parameters.
+ */
+static void
+csv_export_sweep_header (FILE *file)
+{
+  unsigned int i;
+  for (i = 0; csv_sweep && i < csv_sweep->num_params; i++)
+    fprintf (file, ",%s", csv_sweep->params[i]);
+  fputc ('\n', file);
+} /* csv_export_sweep_header () */
+
+/**
+ * Ends a row of run 'run_id' with its sweep coordinates, left empty for
+ * parameters the run does not sweep.
+ */
+static void
+csv_export_sweep (FILE *file, unsigned int run_id)
+{
+  unsigned int i;
+  for (i = 0; csv_sweep && i < csv_sweep->num_params; i++)
+    {
+      const char *value = stex_sweep_value (csv_sweep, run_id, i);
+      fprintf (file, ",%s", value ? value : "");
+    }
+  fputc ('\n', file);
+} /* csv_export_sweep () */
+
 /**
  * Returns a NULL pointer in case of failure.
  */
@@ -248,12 +635,16 @@ csv_get_file_name (enum iore_stex_report_type type, const char *dir,
 
   if (type == IORE_STEX_REPORT_TASK)
     snprintf (fname, FILENAME_MAX, CSV_STEX_TASK_FILE_NAME_FORMAT, dir,
-	      ctx.task_id, tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
-	      tm->tm_hour, tm->tm_min, tm->tm_sec);
+	      tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour,
+	      tm->tm_min, tm->tm_sec);
   else if (type == IORE_STEX_REPORT_TEST)
     snprintf (fname, FILENAME_MAX, CSV_STEX_TEST_FILE_NAME_FORMAT, dir,
 	      tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour,
 	      tm->tm_min, tm->tm_sec);
+  else if (type == IORE_STEX_REPORT_STATS)
+    snprintf (fname, FILENAME_MAX, CSV_STEX_STATS_FILE_NAME_FORMAT, dir,
+	      tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour,
+	      tm->tm_min, tm->tm_sec);
   else
     {
       iore_error("Unsupported report type.");
@@ -0,0 +1,321 @@
+/*
+ * iore_stex_stats.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "iore_stex.h"
+#include "iore_ctx.h"
+#include "iore_error.h"
+
+/*** DEFINES *****************************************************************/
+
+#define STATS_P95 95 /* percentile */
+#define STATS_STRAGGLER_FACTOR 1.5 /* stragglers exceed the median this much */
+#define STATS_TIMES_LEN (2 * IORE_TREC_ACTION_LENGTH) /* per task */
+
+/*** PROTOTYPES **************************************************************/
+
+static void
+stats_dist (double *, int, iore_stex_dist_t *);
+static int
+stats_cmp (const void *, const void *);
+static const char *
+stats_host (int);
+static double
+stats_t_quantile (double, unsigned int);
+static double
+stats_z_quantile (double);
+
+/*** VARIABLES ***************************************************************/
+
+static char *hosts = NULL; /* processor names of all tasks, at the master */
+static int hosts_len = 0;
+
+/*** FUNCTIONS ***************************************************************/
+
+/**
+ * Computes the statistics of every action of 'trec_test' across the tasks
+ * of ctx.comm into 'stats', an array of IORE_TREC_ACTION_LENGTH elements.
+ * Tasks whose record is not committed (e.g. they were left out of a run
+ * with fewer tasks) or is remote must still call it, but are not
+ * accounted.
+ * Collective; results are set at the master task only.
+ */
+int
+stex_stats (const iore_trec_test_t *trec_test, iore_stex_stats_t *stats)
+{
+  assert(trec_test);
+  assert(stats);
+
+  int num_tasks;
+  MPI_Comm_size (ctx.comm, &num_tasks);
+
+  /*
+   * hosts are gathered once per number of tasks, as tasks do not migrate
+   * and runs take the first tasks; tasks may have been in different runs
+   * before, so they agree on it
+   */
+  int gather_hosts = (hosts_len < num_tasks);
+  MPI_Allreduce (MPI_IN_PLACE, &gather_hosts, 1, MPI_INT, MPI_LOR, ctx.comm);
+  if (gather_hosts)
+    {
+      char host[MPI_MAX_PROCESSOR_NAME] =
+	{ 0 };
+      int len;
+      MPI_Get_processor_name (host, &len);
+      if (ctx.task_id == IORE_MASTER_TASK)
+	{
+	  hosts = realloc (hosts, num_tasks * MPI_MAX_PROCESSOR_NAME);
+	  assert(hosts);
+	}
+      MPI_Gather (host, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, hosts,
+		  MPI_MAX_PROCESSOR_NAME, MPI_CHAR, IORE_MASTER_TASK, ctx.comm);
+      hosts_len = num_tasks;
+    }
+
+  /* start time and duration of each action, all gathered at once */
+  double times[STATS_TIMES_LEN];
+  int i_act;
+  for (i_act = 0; i_act < IORE_TREC_ACTION_LENGTH; i_act++)
+    {
+      times[2 * i_act] = trec_test->task_time[i_act][IORE_TREC_EVENT_START];
+      times[2 * i_act + 1] = (trec_test->task_time[i_act][IORE_TREC_EVENT_STOP]
+	  - trec_test->task_time[i_act][IORE_TREC_EVENT_START]);
+    }
+  unsigned long data_size = trec_test->task_data_size;
+  int committed = trec_test->committed && !trec_test->remote;
+
+  double *all_times = NULL;
+  unsigned long *all_data_sizes = NULL;
+  int *all_committed = NULL;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      all_times = malloc (num_tasks * sizeof(times));
+      assert(all_times);
+      all_data_sizes = malloc (num_tasks * sizeof(unsigned long));
+      assert(all_data_sizes);
+      all_committed = malloc (num_tasks * sizeof(int));
+      assert(all_committed);
+    }
+  MPI_Gather (times, STATS_TIMES_LEN, MPI_DOUBLE, all_times, STATS_TIMES_LEN,
+	      MPI_DOUBLE, IORE_MASTER_TASK, ctx.comm);
+  MPI_Gather (&data_size, 1, MPI_UNSIGNED_LONG, all_data_sizes, 1,
+	      MPI_UNSIGNED_LONG, IORE_MASTER_TASK, ctx.comm);
+  MPI_Gather (&committed, 1, MPI_INT, all_committed, 1, MPI_INT,
+	      IORE_MASTER_TASK, ctx.comm);
+
+  if (ctx.task_id != IORE_MASTER_TASK)
+    return IORE_SUCCESS;
+
+  /* compacts the accounted tasks, keeping their ids */
+  int *ids = malloc (num_tasks * sizeof(int));
+  assert(ids);
+  int len = 0;
+  int i;
+  for (i = 0; i < num_tasks; i++)
+    if (all_committed[i])
+      ids[len++] = i;
+
+  double *vals = malloc (num_tasks * sizeof(double));
+  assert(vals);
+  for (i_act = 0; i_act < IORE_TREC_ACTION_LENGTH; i_act++)
+    {
+      iore_stex_stats_t *st = &stats[i_act];
+      memset (st, 0, sizeof(iore_stex_stats_t));
+      st->num_tasks = len;
+      st->straggler_host = "";
+      if (!len)
+	continue;
+
+      /* start skew */
+      double min_start = 0, max_start = 0;
+      for (i = 0; i < len; i++)
+	{
+	  double start = all_times[ids[i] * STATS_TIMES_LEN + 2 * i_act];
+	  if (i == 0 || start < min_start)
+	    min_start = start;
+	  if (i == 0 || start > max_start)
+	    max_start = start;
+	}
+      st->start_skew = max_start - min_start;
+
+      /* durations and stragglers */
+      int slowest = 0;
+      for (i = 0; i < len; i++)
+	{
+	  vals[i] = all_times[ids[i] * STATS_TIMES_LEN + 2 * i_act + 1];
+	  if (vals[i] > vals[slowest])
+	    slowest = i;
+	}
+      st->straggler_task = ids[slowest];
+      stats_dist (vals, len, &st->latency);
+      st->straggler_host = stats_host (st->straggler_task);
+      for (i = 0; i < len; i++)
+	if (all_times[ids[i] * STATS_TIMES_LEN + 2 * i_act + 1]
+	    > STATS_STRAGGLER_FACTOR * st->latency.median)
+	  st->num_stragglers++;
+
+      /* bandwidth, for data transfers only */
+      if (i_act == IORE_TREC_ACTION_WRITE_READ)
+	{
+	  for (i = 0; i < len; i++)
+	    {
+	      double latency = all_times[ids[i] * STATS_TIMES_LEN + 2 * i_act
+		  + 1];
+	      vals[i] = (latency > 0) ? all_data_sizes[ids[i]] / latency : 0;
+	    }
+	  stats_dist (vals, len, &st->throughput);
+	}
+    }
+
+  free (vals);
+  free (ids);
+  free (all_committed);
+  free (all_data_sizes);
+  free (all_times);
+
+  return IORE_SUCCESS;
+} /* stex_stats () */
+
+/**
+ * Returns the half-width of the confidence interval of the mean of 'vals'
+ * at confidence 'level', relative to the mean, i.e., t * s / (sqrt(n) *
+ * mean). Returns NAN for fewer than two values or a non-positive mean.
+ */
+double
+stex_ci (const double *vals, unsigned int len, double level)
+{
+  assert(vals || !len);
+
+  if (len < 2)
+    return NAN;
+
+  double mean = 0;
+  unsigned int i;
+  for (i = 0; i < len; i++)
+    mean += vals[i];
+  mean /= len;
+  if (mean <= 0)
+    return NAN;
+
+  double var = 0;
+  for (i = 0; i < len; i++)
+    var += (vals[i] - mean) * (vals[i] - mean);
+  var /= (len - 1);
+
+  double t = stats_t_quantile ((1 + level) / 2, len - 1);
+  return t * sqrt (var / len) / mean;
+} /* stex_ci () */
+
+/**
+ * Sorts 'vals' and describes their distribution. Percentiles are taken by
+ * the nearest-rank method.
+ */
+static void
+stats_dist (double *vals, int len, iore_stex_dist_t *dist)
+{
+  qsort (vals, len, sizeof(double), stats_cmp);
+
+  double sum = 0;
+  int i;
+  for (i = 0; i < len; i++)
+    sum += vals[i];
+
+  dist->min = vals[0];
+  dist->max = vals[len - 1];
+  dist->mean = sum / len;
+  dist->median = (len % 2) ?
+      vals[len / 2] : (vals[len / 2 - 1] + vals[len / 2]) / 2;
+  dist->p95 = vals[(STATS_P95 * len + 99) / 100 - 1];
+} /* stats_dist () */
+
+static int
+stats_cmp (const void *a, const void *b)
+{
+  double da = *(const double *) a;
+  double db = *(const double *) b;
+
+  return (da > db) - (da < db);
+} /* stats_cmp () */
+
+static const char *
+stats_host (int task_id)
+{
+  if (!hosts || task_id >= hosts_len)
+    return "";
+
+  return hosts + task_id * MPI_MAX_PROCESSOR_NAME;
+} /* stats_host () */
+
+/**
+ * Quantile 'p' of the Student's t distribution with 'df' degrees of
+ * freedom. Exact for one and two degrees of freedom, otherwise taken from
+ * the normal quantile by the Cornish-Fisher expansion, within 1% for three
+ * degrees of freedom and closer for more.
+ */
+static double
+stats_t_quantile (double p, unsigned int df)
+{
+  if (df == 1)
+    return tan (M_PI * (p - 0.5));
+  if (df == 2)
+    return (2 * p - 1) / sqrt (2 * p * (1 - p));
+
+  double z = stats_z_quantile (p);
+  double z2 = z * z;
+  double n = df;
+
+  return z + z * (z2 + 1) / (4 * n)
+      + z * ((5 * z2 + 16) * z2 + 3) / (96 * n * n)
+      + z * (((3 * z2 + 19) * z2 + 17) * z2 - 15) / (384 * n * n * n)
+      + z * ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945)
+	  / (92160 * n * n * n * n);
+} /* stats_t_quantile () */
+
+/**
+ * Quantile 'p' of the standard normal distribution, by the rational
+ * approximation of P. J. Acklam (relative error below 1.2e-9).
+ */
+static double
+stats_z_quantile (double p)
+{
+  static const double a[] =
+    { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+	1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+  static const double b[] =
+    { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+	6.680131188771972e+01, -1.328068155288572e+01 };
+  static const double c[] =
+    { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+	-2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+  static const double d[] =
+    { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+	3.754408661907416e+00 };
+  const double p_low = 0.02425;
+
+  double q, r;
+  if (p < p_low)
+    {
+      q = sqrt (-2 * log (p));
+      return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q
+	  + c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+  if (p > 1 - p_low)
+    {
+      q = sqrt (-2 * log (1 - p));
+      return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q
+	  + c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+
+  q = p - 0.5;
+  r = q * q;
+  return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5])
+      * q / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+} /* stats_z_quantile () */
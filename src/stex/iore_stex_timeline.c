@@ -0,0 +1,269 @@
+/*
+ * iore_stex_timeline.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "iore_stex.h"
+#include "iore_ctx.h"
+#include "iore_error.h"
+#include "iore_test_types.h"
+#include "iore_trec.h"
+
+/*** DEFINES *****************************************************************/
+
+/**
+ * Timelines are written in the Chrome trace event format, read by
+ * chrome://tracing and Perfetto, one file per run repetition. Tasks are
+ * the threads of a single process, so that each has its own track; test
+ * actions and captured requests are complete ("X") events, and barriers
+ * are global instant ("i") events. Events other than the first are
+ * preceded by a separator, so that tasks can format theirs apart.
+ */
+#define STEX_TIMELINE_FILE_NAME_FORMAT "%s/iore_timeline_%u_%u_%u.json"
+#define STEX_TIMELINE_HEADER_FORMAT "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"exp_repl_id\":%u,\"run_id\":%u,\"run_rept_id\":%u},\"traceEvents\":[\n"
+#define STEX_TIMELINE_FOOTER "\n]}\n"
+#define STEX_TIMELINE_PROCESS_FORMAT "{\"ph\":\"M\",\"pid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"Run #%u, repetition #%u\"}}"
+#define STEX_TIMELINE_THREAD_FORMAT ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"task %d (%s)\"}},\n{\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%d}}"
+#define STEX_TIMELINE_ACTION_FORMAT ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"cat\":\"%s\",\"name\":\"%s %s\",\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"data_size\":%zu}}"
+#define STEX_TIMELINE_REQ_FORMAT ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"cat\":\"%s,request\",\"name\":\"%s request\",\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"file_id\":%u,\"offset\":%lld,\"size\":%zu}}"
+#define STEX_TIMELINE_BARRIER_FORMAT ",\n{\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":%d,\"cat\":\"%s\",\"name\":\"barrier\",\"ts\":%.3f}"
+
+/* time stamps and durations of the format are in microseconds */
+#define STEX_TIMELINE_TS(t, base) (((t) - (base)) * 1e6)
+#define STEX_TIMELINE_DUR(t) \
+  (((t)[IORE_TREC_EVENT_STOP] - (t)[IORE_TREC_EVENT_START]) * 1e6)
+
+/*** PROTOTYPES **************************************************************/
+
+static const char *
+stex_timeline_str (const char *, char *, size_t);
+static void
+stex_timeline_actions (FILE *, const iore_trec_run_rept_t *, iore_time_t);
+static void
+stex_timeline_reqs (FILE *, const iore_trec_req_t *, size_t, iore_time_t);
+static void
+stex_timeline_barriers (FILE *, const iore_trec_run_rept_t *, iore_time_t,
+			bool);
+
+/*** VARIABLES ***************************************************************/
+
+static const iore_stex_t *timeline = NULL; /* NULL if not exporting */
+
+/*** FUNCTIONS ***************************************************************/
+
+/**
+ * Starts exporting the timeline of each run repetition, if enabled by
+ * 'stex'. Collective.
+ */
+int
+stex_timeline_open (const iore_stex_t *stex)
+{
+  assert(stex);
+
+  timeline = NULL;
+  if (!stex->timeline)
+    return IORE_SUCCESS;
+
+  int rerr = IORE_SUCCESS;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    rerr = stex_dir_check (stex->export_dir);
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  if (rerr)
+    return IORE_FAILURE;
+
+  timeline = stex;
+
+  return IORE_SUCCESS;
+} /* stex_timeline_open () */
+
+/**
+ * Writes the timeline of a run repetition: the actions of the tests of
+ * each task, on a track per task, the requests captured by the task, if
+ * any, and the barriers of the tests, which all tasks leave at about the
+ * earliest start of the next action. Must be called before the captured
+ * requests are flushed. Time stamps count from the start of the run
+ * repetition at the master task. Collective over the tasks of the run.
+ */
+int
+stex_timeline_rept (unsigned int exp_repl_id, unsigned int run_id,
+		    const iore_trec_run_rept_t *trec_rept,
+		    bool intra_test_barrier)
+{
+  assert(trec_rept);
+
+  if (!timeline)
+    return IORE_SUCCESS;
+
+  char fname[FILENAME_MAX];
+  snprintf (fname, FILENAME_MAX, STEX_TIMELINE_FILE_NAME_FORMAT,
+	    timeline->export_dir, exp_repl_id, run_id, trec_rept->id);
+
+  iore_time_t base = trec_rept->time[IORE_TREC_EVENT_START];
+  MPI_Bcast (&base, 1, MPI_DOUBLE, IORE_MASTER_TASK, ctx.comm);
+
+  int num_procs;
+  MPI_Comm_size (ctx.comm, &num_procs);
+  char host[MPI_MAX_PROCESSOR_NAME];
+  char host_str[6 * MPI_MAX_PROCESSOR_NAME]; /* each char as \u00XX */
+  int len;
+  MPI_Get_processor_name (host, &len);
+
+  char *buf = NULL;
+  size_t buf_len = 0;
+  FILE *file = open_memstream (&buf, &buf_len);
+  assert(file);
+
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      fprintf (file, STEX_TIMELINE_HEADER_FORMAT, exp_repl_id, run_id,
+	       trec_rept->id);
+      fprintf (file, STEX_TIMELINE_PROCESS_FORMAT, run_id, trec_rept->id);
+    }
+  fprintf (file, STEX_TIMELINE_THREAD_FORMAT, ctx.task_id, ctx.task_id,
+	   stex_timeline_str (host, host_str, sizeof(host_str)), ctx.task_id,
+	   ctx.task_id);
+
+  stex_timeline_actions (file, trec_rept, base);
+
+  const iore_trec_req_t *reqs1, *reqs2;
+  size_t len1, len2;
+  trec_reqs_get (&reqs1, &len1, &reqs2, &len2);
+  stex_timeline_reqs (file, reqs1, len1, base);
+  stex_timeline_reqs (file, reqs2, len2, base);
+
+  if (ctx.task_id == IORE_MASTER_TASK)
+    stex_timeline_barriers (file, trec_rept, base, intra_test_barrier);
+  if (ctx.task_id == num_procs - 1)
+    fputs (STEX_TIMELINE_FOOTER, file);
+  fclose (file);
+
+  int rerr = stex_write_shared (fname, buf, buf_len);
+  free (buf);
+
+  return rerr;
+} /* stex_timeline_rept () */
+
+void
+stex_timeline_close ()
+{
+  timeline = NULL;
+} /* stex_timeline_close () */
+
+/**
+ * Returns 'str' escaped as the contents of a JSON string, formatted into
+ * 'buf' of 'len' bytes, truncated if needed.
+ */
+static const char *
+stex_timeline_str (const char *str, char *buf, size_t len)
+{
+  assert(len > 0);
+
+  size_t n = 0;
+  for (; *str; str++)
+    {
+      unsigned char c = *str;
+      char esc[7];
+      if (c == '"' || c == '\\')
+	snprintf (esc, sizeof(esc), "\\%c", c);
+      else if (c < 0x20)
+	snprintf (esc, sizeof(esc), "\\u%04x", c);
+      else
+	snprintf (esc, sizeof(esc), "%c", c);
+
+      size_t esc_len = strlen (esc);
+      if (n + esc_len >= len)
+	break;
+      memcpy (buf + n, esc, esc_len);
+      n += esc_len;
+    }
+  buf[n] = '\0';
+
+  return buf;
+} /* stex_timeline_str () */
+
+/**
+ * Formats the actions of the committed tests of the task.
+ */
+static void
+stex_timeline_actions (FILE *file, const iore_trec_run_rept_t *trec_rept,
+		       iore_time_t base)
+{
+  unsigned int i_test, i_act;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    {
+      const iore_trec_test_t *trec_test = &trec_rept->test[i_test];
+      if (!trec_test->committed)
+	continue;
+      for (i_act = 0; i_act < IORE_TREC_ACTION_LENGTH; i_act++)
+	{
+	  const iore_time_t *time = trec_test->task_time[i_act];
+	  if (time[IORE_TREC_EVENT_START] == 0
+	      && time[IORE_TREC_EVENT_STOP] == 0)
+	    continue; /* not taken by the test */
+
+	  const char *type = test_type_lbl[trec_test->type];
+	  fprintf (file, STEX_TIMELINE_ACTION_FORMAT, ctx.task_id, type, type,
+		   trec_action_lbl[i_act],
+		   STEX_TIMELINE_TS(time[IORE_TREC_EVENT_START], base),
+		   STEX_TIMELINE_DUR(time),
+		   (i_act == IORE_TREC_ACTION_WRITE_READ ?
+		       trec_test->task_data_size : 0));
+	}
+    }
+} /* stex_timeline_actions () */
+
+/**
+ * Formats 'len' requests captured by the task.
+ */
+static void
+stex_timeline_reqs (FILE *file, const iore_trec_req_t *reqs, size_t len,
+		    iore_time_t base)
+{
+  size_t i;
+  for (i = 0; i < len; i++)
+    {
+      const iore_trec_req_t *req = &reqs[i];
+      fprintf (file, STEX_TIMELINE_REQ_FORMAT, ctx.task_id,
+	       test_type_lbl[req->type], test_type_lbl[req->type],
+	       STEX_TIMELINE_TS(req->time[IORE_TREC_EVENT_START], base),
+	       STEX_TIMELINE_DUR(req->time),
+	       req->file_id, (long long) req->offset, req->size);
+    }
+} /* stex_timeline_reqs () */
+
+/**
+ * Formats the barriers of the committed tests, from the test records
+ * reduced at the master task. Tests start after a barrier and, if
+ * 'intra_test_barrier' is set, so does every action.
+ */
+static void
+stex_timeline_barriers (FILE *file, const iore_trec_run_rept_t *trec_rept,
+			iore_time_t base, bool intra_test_barrier)
+{
+  unsigned int i_test, i_act;
+  for (i_test = 0; i_test < IORE_TEST_TYPE_LENGTH; i_test++)
+    {
+      const iore_trec_test_t *trec_test = &trec_rept->test[i_test];
+      if (!trec_test->committed)
+	continue;
+      for (i_act = 0; i_act < IORE_TREC_ACTION_LENGTH; i_act++)
+	{
+	  const iore_time_t *time = trec_test->test_time[i_act];
+	  if ((i_act != IORE_TREC_ACTION_CREATE_OPEN && !intra_test_barrier)
+	      || (time[IORE_TREC_EVENT_START] == 0
+		  && time[IORE_TREC_EVENT_STOP] == 0))
+	    continue;
+
+	  fprintf (file, STEX_TIMELINE_BARRIER_FORMAT, ctx.task_id,
+		   test_type_lbl[trec_test->type],
+		   STEX_TIMELINE_TS(time[IORE_TREC_EVENT_START], base));
+	}
+    }
+} /* stex_timeline_barriers () */
@@ -14,9 +14,9 @@
 /*** VARIABLES ***************************************************************/
 
 const char * const stex_format_lbl[IORE_STEX_FORMAT_LENGTH] =
-  { "csv" };
+  { "csv", "binary", "columnar" };
 const char * const stex_report_lbl[IORE_STEX_REPORT_LENGTH] =
-  { "task", "test" };
+  { "task", "test", "stats" };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -30,7 +30,16 @@ stex2str (const iore_stex_t *stex)
       int len = snprintf(str, 0, STEX2STR_FORMAT, stex,
 	  (stex->report_type.task ? "true" : "false"),
 	  (stex->report_type.test ? "true" : "false"),
-	  stex_format_lbl[stex->data_format], stex->export_dir) + 1;
+	  (stex->report_type.stats ? "true" : "false"),
+	  stex_format_lbl[stex->data_format], stex->export_dir,
+	  (stex->task_gather ? "true" : "false"),
+	  (stex->stream ? "true" : "false"), stex->stream_sync_interval,
+	  (stex->resume ? "true" : "false"),
+	  (stex->timeline ? "true" : "false"),
+	  (stex->os_counters.rusage ? "true" : "false"),
+	  (stex->os_counters.io ? "true" : "false"),
+	  (stex->os_counters.perf ? "true" : "false"),
+	  stex->sweep.num_params) + 1;
       if (len > 0)
 	{
 	  str = malloc (len);
@@ -38,7 +47,16 @@ stex2str (const iore_stex_t *stex)
 	  snprintf(str, len, STEX2STR_FORMAT, stex,
 		   (stex->report_type.task ? "true" : "false"),
 		   (stex->report_type.test ? "true" : "false"),
-		   stex_format_lbl[stex->data_format], stex->export_dir);
+		   (stex->report_type.stats ? "true" : "false"),
+		   stex_format_lbl[stex->data_format], stex->export_dir,
+		   (stex->task_gather ? "true" : "false"),
+		   (stex->stream ? "true" : "false"), stex->stream_sync_interval,
+		   (stex->resume ? "true" : "false"),
+		   (stex->timeline ? "true" : "false"),
+		   (stex->os_counters.rusage ? "true" : "false"),
+		   (stex->os_counters.io ? "true" : "false"),
+		   (stex->os_counters.perf ? "true" : "false"),
+		   stex->sweep.num_params);
 	}
     }
 
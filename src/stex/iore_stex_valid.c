@@ -17,7 +17,9 @@ stex_valid (iore_stex_t *stex)
 {
   int rerr = IORE_SUCCESS;
 
-  if (stex->report_type.task || stex->report_type.test)
+  bool reports = (stex->report_type.task || stex->report_type.test
+      || stex->report_type.stats);
+  if (reports)
     {
       if (stex->data_format >= IORE_STEX_FORMAT_LENGTH)
 	{
@@ -25,11 +27,60 @@ stex_valid (iore_stex_t *stex)
 	  rerr = IORE_FAILURE;
 	}
 
-      if (stex->export_dir == NULL || strlen (stex->export_dir) == 0)
+      if (stex->data_format != IORE_STEX_FORMAT_CSV
+	  && stex->data_format < IORE_STEX_FORMAT_LENGTH
+	  && stex->report_type.stats)
 	{
-	  iore_error("Validation: Empty directory path.");
+	  iore_errorf("Validation: Stats report not supported by %s format.",
+		      stex_format_lbl[stex->data_format]);
 	  rerr = IORE_FAILURE;
 	}
+
+      if (stex->stream && stex->data_format != IORE_STEX_FORMAT_CSV
+	  && stex->data_format < IORE_STEX_FORMAT_LENGTH)
+	{
+	  iore_errorf("Validation: Streaming not supported by %s format.",
+		      stex_format_lbl[stex->data_format]);
+	  rerr = IORE_FAILURE;
+	}
+
+      if ((stex->os_counters.rusage || stex->os_counters.io
+	  || stex->os_counters.perf)
+	  && stex->data_format != IORE_STEX_FORMAT_CSV
+	  && stex->data_format < IORE_STEX_FORMAT_LENGTH)
+	{
+	  iore_errorf("Validation: OS counters not supported by %s format.",
+		      stex_format_lbl[stex->data_format]);
+	  rerr = IORE_FAILURE;
+	}
+
+      if (stex->sweep.num_params > 0
+	  && stex->data_format != IORE_STEX_FORMAT_CSV
+	  && stex->data_format < IORE_STEX_FORMAT_LENGTH)
+	{
+	  iore_errorf("Validation: Sweeps not supported by %s format.",
+		      stex_format_lbl[stex->data_format]);
+	  rerr = IORE_FAILURE;
+	}
+
+      if (stex->stream_sync_interval == 0)
+	{
+	  iore_errorf(VALID_MSG_GREATER_ZERO, "stream sync interval");
+	  rerr = IORE_FAILURE;
+	}
+    }
+
+  if ((reports || stex->timeline)
+      && (stex->export_dir == NULL || strlen (stex->export_dir) == 0))
+    {
+      iore_error("Validation: Empty directory path.");
+      rerr = IORE_FAILURE;
+    }
+
+  if (stex->resume && !stex->stream)
+    {
+      iore_error("Validation: Resuming requires streamed reports.");
+      rerr = IORE_FAILURE;
     }
 
   return rerr;
@@ -6,17 +6,80 @@
 
 #include <mpi.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+#include <limits.h>
 #include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
 
 #include "iore_trec.h"
 #include "iore_ctx.h"
+#include "iore_lmet.h"
+#include "iore_error.h"
+
+/*** DEFINES *****************************************************************/
+
+/**
+ * Layout of a packed test record: the start and stop times of every action,
+ * the data size, the committed flag and the resource counters of every
+ * action. Data sizes and counters are packed as doubles, which are exact up
+ * to 2^53.
+ */
+#define TREC_PACK_START 0
+#define TREC_PACK_STOP IORE_TREC_ACTION_LENGTH
+#define TREC_PACK_DATA_SIZE (2 * IORE_TREC_ACTION_LENGTH)
+#define TREC_PACK_COMMITTED (TREC_PACK_DATA_SIZE + 1)
+#define TREC_PACK_RSRC (TREC_PACK_COMMITTED + 1)
+#define TREC_PACK_LEN \
+  (TREC_PACK_RSRC + IORE_TREC_ACTION_LENGTH * IORE_TREC_RSRC_LENGTH)
+
+/**
+ * Clock synchronization constants. Drifts are only estimated from offsets
+ * far enough apart in time for the offset errors to be negligible.
+ */
+#define TREC_CLOCK_SYNC_TAG 0
+#define TREC_CLOCK_DRIFT_MIN_SECS 1.0
+
+#define TREC_REQS_FILE_FORMAT "%s/iore_reqs_%u_%u_%u.trace"
+
+#define TREC_RSRC_IO_BUF_LEN 512
+#define TREC_RSRC_PERF_LEN \
+  (IORE_TREC_RSRC_LENGTH - IORE_TREC_RSRC_TASK_CLOCK)
 
 /*** PROTOTYPES **************************************************************/
 
 static iore_time_t
 trec_curtime ();
+static iore_time_t
+trec_timer ();
+static void
+trec_clock_pingpong (int, iore_time_t *, iore_time_t *, iore_time_t *);
 static void
 trec_run_rept_reduce ();
+static void
+trec_pack_init ();
+static void
+trec_test_pack (const iore_trec_test_t *, double *);
+static void
+trec_test_unpack (const double *, iore_trec_test_t *);
+static void
+trec_pack_op (void *, void *, int *, MPI_Datatype *);
+static int
+trec_rsrc_perf_open ();
+static void
+trec_rsrc_read (double *);
+static void
+trec_rsrc_read_io (double *);
+static void
+trec_rsrc_read_perf (double *);
 
 /*** VARIABLES ***************************************************************/
 
@@ -24,7 +87,48 @@ static iore_trec_exp_t trec_exp =
   { };
 static iore_trec_st_t state =
   { };
-static iore_time_t wclock_delta = 0.0;
+
+/**
+ * Clock of the task, as a linear model of its offset to the clock of the
+ * master task: offset + drift * (timer - ref).
+ */
+static struct
+{
+  iore_trec_clock_t conf;
+  iore_time_t offset;
+  double drift;
+  iore_time_t ref;
+  iore_time_t error; /* bound across tasks of the last synchronization */
+  bool synced;
+} clock_st =
+  { .conf =
+    { IORE_TREC_TIMER_MPI_WTIME, IORE_TREC_CLOCK_SYNC_ROUNDS } };
+static MPI_Datatype pack_type = MPI_DATATYPE_NULL;
+static MPI_Op pack_op = MPI_OP_NULL;
+
+/**
+ * Ring of the requests captured by the task, see trec_reqs_start (). 'head'
+ * counts the requests captured since the last flush, so that the ring holds
+ * the last 'conf.ring_len' of them.
+ */
+static struct
+{
+  iore_trec_reqs_t conf;
+  iore_trec_req_t *ring;
+  size_t head;
+  unsigned int file_id;
+} reqs_st =
+  { };
+
+static int rsrc_io_fd = -1;
+static double rsrc_io_self = 0.0; /* bytes read from /proc/self/io */
+static int rsrc_perf_fd = -1;
+static double rsrc_start[IORE_TREC_RSRC_LENGTH];
+
+/* perf_event_open () software counters, in the order of the enum */
+static const unsigned long long rsrc_perf_config[TREC_RSRC_PERF_LEN] =
+  { PERF_COUNT_SW_TASK_CLOCK, PERF_COUNT_SW_PAGE_FAULTS,
+      PERF_COUNT_SW_CONTEXT_SWITCHES, PERF_COUNT_SW_CPU_MIGRATIONS };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -40,14 +144,7 @@ trec_init ()
   state.trec_test = NULL;
   state.test_action = IORE_TREC_ACTION_LENGTH;
 
-  iore_time_t now, ref_time;
-
-  MPI_Barrier (MPI_COMM_WORLD);
-  now = trec_curtime ();
-  if (ctx.task_id == IORE_MASTER_TASK)
-    ref_time = now;
-  MPI_Bcast (&ref_time, 1, MPI_DOUBLE, IORE_MASTER_TASK, MPI_COMM_WORLD);
-  wclock_delta = now - ref_time;
+  trec_clock_sync ();
 } /* trec_init () */
 
 void
@@ -82,6 +179,14 @@ trec_destroy ()
       trec_exp.exp_repl = NULL;
       trec_exp.num_exp_repl = 0;
     }
+
+  trec_rsrc_stop ();
+  trec_reqs_stop ();
+
+  if (pack_op != MPI_OP_NULL)
+    MPI_Op_free (&pack_op);
+  if (pack_type != MPI_DATATYPE_NULL)
+    MPI_Type_free (&pack_type);
 } /* trec_destroy () */
 
 iore_trec_exp_t
@@ -90,10 +195,356 @@ get_trec_exp ()
   return trec_exp;
 } /* get_trec_exp () */
 
+/**
+ * Switches the clock of the records to 'conf', synchronizing it anew.
+ * Collective over all tasks.
+ */
+void
+trec_clock_set (const iore_trec_clock_t *conf)
+{
+  assert(conf);
+
+  clock_st.conf = *conf;
+  clock_st.synced = false;
+  trec_clock_sync ();
+} /* trec_clock_set () */
+
+/**
+ * Synchronizes the clocks of all tasks to the clock of the master task,
+ * which is sampled by each task in turn through ping-pong rounds. The
+ * round of shortest round-trip gives the offset, within half of its
+ * round-trip. Offsets of successive synchronizations give the drift of the
+ * clock. Collective over all tasks.
+ */
+void
+trec_clock_sync ()
+{
+  int task_id, num_procs;
+  MPI_Comm_rank (MPI_COMM_WORLD, &task_id);
+  MPI_Comm_size (MPI_COMM_WORLD, &num_procs);
+
+  iore_time_t offset = 0.0, ref = trec_timer (), error = 0.0;
+
+  MPI_Barrier (MPI_COMM_WORLD);
+  if (task_id == IORE_MASTER_TASK)
+    {
+      int i;
+      for (i = 0; i < num_procs; i++)
+	if (i != IORE_MASTER_TASK)
+	  trec_clock_pingpong (i, NULL, NULL, NULL);
+    }
+  else
+    trec_clock_pingpong (IORE_MASTER_TASK, &offset, &ref, &error);
+
+  if (clock_st.synced && ref - clock_st.ref >= TREC_CLOCK_DRIFT_MIN_SECS)
+    clock_st.drift = (offset - clock_st.offset) / (ref - clock_st.ref);
+  else if (!clock_st.synced)
+    clock_st.drift = 0.0;
+  clock_st.offset = offset;
+  clock_st.ref = ref;
+  clock_st.synced = true;
+
+  MPI_Allreduce (&error, &clock_st.error, 1, MPI_DOUBLE, MPI_MAX,
+		 MPI_COMM_WORLD);
+  trec_exp.clock_error = (clock_st.error > trec_exp.clock_error ?
+      clock_st.error : trec_exp.clock_error);
+} /* trec_clock_sync () */
+
+iore_time_t
+trec_clock_error ()
+{
+  return clock_st.error;
+} /* trec_clock_error () */
+
+/**
+ * Starts recording the resource counters of 'flags' around every action,
+ * collectively over all tasks. Fails on all tasks if a counter group is not
+ * available at any task.
+ */
+int
+trec_rsrc_start (iore_trec_rsrc_flags_t flags)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (flags.io)
+    {
+      rsrc_io_fd = open ("/proc/self/io", O_RDONLY);
+      if (rsrc_io_fd < 0)
+	{
+	  iore_errorf_all("Unable to open /proc/self/io: %s.",
+			  strerror (errno));
+	  rerr = IORE_FAILURE;
+	}
+    }
+
+  if (flags.perf && !rerr)
+    rerr = trec_rsrc_perf_open ();
+
+  MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (rerr)
+    {
+      trec_rsrc_stop ();
+      return IORE_FAILURE;
+    }
+
+  trec_exp.rsrc = flags;
+
+  return IORE_SUCCESS;
+} /* trec_rsrc_start () */
+
+void
+trec_rsrc_stop ()
+{
+  if (rsrc_io_fd >= 0)
+    close (rsrc_io_fd);
+  if (rsrc_perf_fd >= 0)
+    close (rsrc_perf_fd);
+  rsrc_io_fd = -1;
+  rsrc_perf_fd = -1;
+
+  /* the recorded groups remain in 'trec_exp' for the exporters */
+} /* trec_rsrc_stop () */
+
+/**
+ * Starts capturing the requests of the tests as set by 'conf', into a ring
+ * allocated up front, so that requests are captured without allocations.
+ * Collective over all tasks; fails on all tasks if any cannot allocate its
+ * ring.
+ */
+int
+trec_reqs_start (const iore_trec_reqs_t *conf)
+{
+  assert(conf);
+
+  int rerr = IORE_SUCCESS;
+
+  if (conf->ring_len == 0)
+    return IORE_SUCCESS;
+
+  reqs_st.ring = malloc (conf->ring_len * sizeof(iore_trec_req_t));
+  if (!reqs_st.ring)
+    {
+      iore_errorf_all("Unable to allocate a ring of %zu requests.",
+		      conf->ring_len);
+      rerr = IORE_FAILURE;
+    }
+
+  MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (rerr)
+    {
+      trec_reqs_stop ();
+      return IORE_FAILURE;
+    }
+
+  reqs_st.conf = *conf;
+  reqs_st.head = 0;
+  reqs_st.file_id = 0;
+
+  return IORE_SUCCESS;
+} /* trec_reqs_start () */
+
+void
+trec_reqs_stop ()
+{
+  free (reqs_st.ring);
+  reqs_st.ring = NULL;
+  reqs_st.head = 0;
+} /* trec_reqs_stop () */
+
+/**
+ * Sets the file the next requests of the task are issued to, by its index
+ * among the files of the task.
+ */
+void
+trec_req_file (unsigned int file_id)
+{
+  reqs_st.file_id = file_id;
+} /* trec_req_file () */
+
+/**
+ * Returns the start time of a request about to be issued, to be passed to
+ * trec_req_stop (), or zero if requests are not captured.
+ */
+iore_time_t
+trec_req_start ()
+{
+  return (reqs_st.ring ? trec_curtime () : 0.0);
+} /* trec_req_start () */
+
+/**
+ * Captures a request of 'size' bytes at 'offset', started at 'start' and
+ * just completed, into the ring, overwriting the oldest request if full.
+ * Requests out of a test action are not captured.
+ */
+void
+trec_req_stop (off_t offset, size_t size, iore_time_t start)
+{
+  if (reqs_st.ring && state.trec_test
+      && state.test_action < IORE_TREC_ACTION_LENGTH)
+    {
+      iore_trec_req_t *req = &reqs_st.ring[reqs_st.head
+	  % reqs_st.conf.ring_len];
+      req->type = state.trec_test->type;
+      req->action = state.test_action;
+      req->file_id = reqs_st.file_id;
+      req->offset = offset;
+      req->size = size;
+      req->time[IORE_TREC_EVENT_START] = start;
+      req->time[IORE_TREC_EVENT_STOP] = trec_curtime ();
+      reqs_st.head++;
+    }
+} /* trec_req_stop () */
+
+/**
+ * Returns the requests captured by the task since the last flush, oldest
+ * first, as up to two runs of the ring: '*len1' requests from '*reqs1',
+ * then '*len2' from '*reqs2', the start of the ring.
+ */
+void
+trec_reqs_get (const iore_trec_req_t **reqs1, size_t *len1,
+	       const iore_trec_req_t **reqs2, size_t *len2)
+{
+  size_t ring_len = reqs_st.conf.ring_len;
+
+  *reqs1 = reqs_st.ring;
+  *reqs2 = reqs_st.ring;
+  *len1 = 0;
+  *len2 = 0;
+  if (!reqs_st.ring)
+    return;
+
+  if (reqs_st.head <= ring_len)
+    *len1 = reqs_st.head;
+  else
+    {
+      *reqs1 = reqs_st.ring + reqs_st.head % ring_len;
+      *len1 = ring_len - reqs_st.head % ring_len;
+      *len2 = reqs_st.head % ring_len;
+    }
+} /* trec_reqs_get () */
+
+/**
+ * Writes the requests captured since the last flush, out of the timed
+ * actions, into a trace file of the repetition 'rpt_id' of run 'run_id' of
+ * replication 'rpl_id', which can be replayed by a trace workload, and
+ * empties the ring. Time stamps count from the earliest request of all
+ * tasks, and requests lost to full rings are reported. Collective over
+ * ctx.comm.
+ */
+int
+trec_reqs_flush (unsigned int rpl_id, unsigned int run_id,
+		 unsigned int rpt_id)
+{
+  int rerr = IORE_SUCCESS;
+
+  if (!reqs_st.ring)
+    return IORE_SUCCESS;
+
+  int num_tasks;
+  MPI_Comm_size (ctx.comm, &num_tasks);
+
+  const iore_trec_req_t *reqs1, *reqs2;
+  size_t len1, len2;
+  trec_reqs_get (&reqs1, &len1, &reqs2, &len2);
+  unsigned long long len = len1 + len2;
+  unsigned long long lost = reqs_st.head - len;
+
+  /* converts the requests into trace records */
+  iore_time_t base = (len > 0 ? reqs1[0].time[IORE_TREC_EVENT_START] :
+      DBL_MAX);
+  MPI_Allreduce (MPI_IN_PLACE, &base, 1, MPI_DOUBLE, MPI_MIN, ctx.comm);
+  iore_wkld_trace_rec_t *recs = malloc (
+      (len + 1) * sizeof(iore_wkld_trace_rec_t));
+  assert(recs);
+  size_t i;
+  for (i = 0; i < len; i++)
+    {
+      const iore_trec_req_t *req = (
+	  i < len1 ? &reqs1[i] : &reqs2[i - len1]);
+      iore_time_t start = req->time[IORE_TREC_EVENT_START];
+      iore_time_t stop = req->time[IORE_TREC_EVENT_STOP];
+      recs[i].offset = req->offset;
+      recs[i].size = req->size;
+      recs[i].time = (start > base ? (start - base) * 1e9 + 0.5 : 0);
+      recs[i].duration = (stop > start ? (stop - start) * 1e9 + 0.5 : 0);
+      recs[i].file_id = req->file_id;
+      recs[i].op = req->type;
+    }
+
+  /* indexes the records of the tasks */
+  uint64_t *idx = malloc ((num_tasks + 1) * sizeof(uint64_t));
+  assert(idx);
+  MPI_Allgather (&len, 1, MPI_UNSIGNED_LONG_LONG, idx + 1, 1,
+		 MPI_UNSIGNED_LONG_LONG, ctx.comm);
+  idx[0] = 0;
+  int j;
+  for (j = 1; j <= num_tasks; j++)
+    idx[j] += idx[j - 1];
+
+  char path[PATH_MAX];
+  snprintf (path, PATH_MAX, TREC_REQS_FILE_FORMAT, reqs_st.conf.dir, rpl_id,
+	    run_id, rpt_id);
+  MPI_File fh;
+  if (MPI_File_open (ctx.comm, path, MPI_MODE_CREATE | MPI_MODE_WRONLY,
+		     MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+    {
+      iore_errorf("Unable to open request trace file '%s'.", path);
+      rerr = IORE_FAILURE;
+    }
+  else
+    {
+      MPI_File_set_size (fh, 0);
+
+      iore_wkld_trace_hdr_t hdr;
+      memcpy (hdr.magic, WKLD_TRACE_MAGIC, sizeof(hdr.magic));
+      hdr.num_ranks = num_tasks;
+      hdr.time_mode = IORE_WKLD_TRACE_TIME_STAMP;
+      MPI_Offset recs_off = (sizeof(hdr) + (num_tasks + 1) * sizeof(uint64_t));
+      if (ctx.task_id == IORE_MASTER_TASK
+	  && (MPI_File_write_at (fh, 0, &hdr, sizeof(hdr), MPI_BYTE,
+				 MPI_STATUS_IGNORE) != MPI_SUCCESS
+	      || MPI_File_write_at (fh, sizeof(hdr), idx,
+				    (num_tasks + 1) * sizeof(uint64_t),
+				    MPI_BYTE, MPI_STATUS_IGNORE)
+		  != MPI_SUCCESS))
+	rerr = IORE_FAILURE;
+
+      MPI_Datatype rec_type;
+      MPI_Type_contiguous (sizeof(iore_wkld_trace_rec_t), MPI_BYTE, &rec_type);
+      MPI_Type_commit (&rec_type);
+      if (MPI_File_write_at_all (
+	  fh, recs_off + idx[ctx.task_id] * sizeof(iore_wkld_trace_rec_t),
+	  recs, len, rec_type, MPI_STATUS_IGNORE) != MPI_SUCCESS)
+	rerr = IORE_FAILURE;
+      MPI_Type_free (&rec_type);
+      if (MPI_File_close (&fh) != MPI_SUCCESS)
+	rerr = IORE_FAILURE;
+      if (rerr)
+	iore_errorf_all("Failed writing request trace file '%s'.", path);
+    }
+  free (idx);
+  free (recs);
+
+  /* the master writes the header alone, so all tasks learn of its failure;
+   * IORE_FAILURE is negative */
+  MPI_Allreduce (MPI_IN_PLACE, &rerr, 1, MPI_INT, MPI_MIN, ctx.comm);
+
+  MPI_Allreduce (MPI_IN_PLACE, &lost, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+		 ctx.comm);
+  if (!rerr && lost > 0)
+    iore_warnf("%llu requests overwritten in full capture rings, not in "
+	       "'%s'.", lost, path);
+
+  reqs_st.head = 0;
+
+  return rerr;
+} /* trec_reqs_flush () */
+
 void
 trec_exp_start (unsigned int num_exp_repl)
 {
   trec_exp.time[IORE_TREC_EVENT_START] = trec_curtime ();
+  trec_exp.clock_error = clock_st.error;
 
   if (num_exp_repl > 0)
     {
@@ -117,6 +568,7 @@ trec_exp_repl_start (unsigned int id, unsigned int num_run)
     {
       iore_trec_exp_repl_t *trec_repl = &trec_exp.exp_repl[id - 1];
       trec_repl->time[IORE_TREC_EVENT_START] = trec_curtime ();
+      trec_repl->clock_error = clock_st.error;
 
       trec_repl->id = id;
       trec_repl->num_run = num_run;
@@ -174,6 +626,22 @@ trec_run_stop ()
   return trec_run;
 } /* trec_run_stop () */
 
+/**
+ * Releases the repetition records of 'trec_run', once they were exported.
+ */
+void
+trec_run_release (iore_trec_run_t *trec_run)
+{
+  assert(trec_run);
+
+  if (trec_run->num_run_rept > 0)
+    {
+      free (trec_run->run_rept);
+      trec_run->run_rept = NULL;
+      trec_run->num_run_rept = 0;
+    }
+} /* trec_run_release () */
+
 void
 trec_run_rept_start (unsigned int id)
 {
@@ -185,6 +653,8 @@ trec_run_rept_start (unsigned int id)
       trec_rept->id = id;
 
       state.trec_rept = trec_rept;
+      lmet_rept (state.trec_repl ? state.trec_repl->id : 0,
+		 state.trec_run->id, id);
     }
 } /* trec_run_rept_start () */
 
@@ -216,8 +686,21 @@ trec_test_start (enum iore_test_type type, enum iore_trec_action action)
       trec_test->type = type;
       state.trec_test = trec_test;
       state.test_action = action;
+      reqs_st.file_id = 0;
 
+      trec_rsrc_read (rsrc_start);
       trec_test->task_time[action][IORE_TREC_EVENT_START] = trec_curtime ();
+
+      /* the flush action takes over the per-request flushes of the write */
+      if (action == IORE_TREC_ACTION_WRITE_READ)
+	state.flush_time = 0.0;
+      else if (action == IORE_TREC_ACTION_FLUSH)
+	{
+	  trec_test->task_time[action][IORE_TREC_EVENT_START] -=
+	      state.flush_time;
+	  state.flush_time = 0.0;
+	}
+      lmet_action (type, action);
     }
 } /* trec_test_start () */
 
@@ -226,15 +709,57 @@ trec_test_stop (size_t data_size)
 {
   if (state.trec_test && state.test_action < IORE_TREC_ACTION_LENGTH)
     {
-      state.trec_test->task_time[state.test_action][IORE_TREC_EVENT_STOP] =
-	  trec_curtime ();
+      iore_time_t *time = state.trec_test->task_time[state.test_action];
+      time[IORE_TREC_EVENT_STOP] = trec_curtime ();
+
+      /* per-request flushes are moved out of the end of the write action */
+      if (state.test_action == IORE_TREC_ACTION_WRITE_READ
+	  && state.flush_time > 0.0)
+	{
+	  iore_time_t *flush =
+	      state.trec_test->task_time[IORE_TREC_ACTION_FLUSH];
+	  time[IORE_TREC_EVENT_STOP] -= state.flush_time;
+	  flush[IORE_TREC_EVENT_START] = time[IORE_TREC_EVENT_STOP];
+	  flush[IORE_TREC_EVENT_STOP] = time[IORE_TREC_EVENT_STOP]
+	      + state.flush_time;
+	}
+
+      double *rsrc = state.trec_test->task_rsrc[state.test_action];
+      trec_rsrc_read (rsrc);
+      int i_rsrc;
+      for (i_rsrc = 0; i_rsrc < IORE_TREC_RSRC_LENGTH; i_rsrc++)
+	rsrc[i_rsrc] -= rsrc_start[i_rsrc];
 
       if (state.test_action == IORE_TREC_ACTION_WRITE_READ)
 	state.trec_test->task_data_size = data_size;
       state.test_action = IORE_TREC_ACTION_LENGTH;
+      lmet_action (IORE_LMET_IDLE, IORE_LMET_IDLE);
     }
 } /* trec_test_stop () */
 
+/**
+ * Returns the start time of a per-request flush, to be passed to
+ * trec_flush_req_stop ().
+ */
+iore_time_t
+trec_flush_req_start ()
+{
+  return trec_curtime ();
+} /* trec_flush_req_start () */
+
+/**
+ * Accounts a per-request flush, started at 'start' and just completed, to
+ * the flush action instead of the write action: the write action is
+ * shortened by the time of its per-request flushes, which precedes the
+ * end-of-write flush in the flush action, if any (see trec_test_start ()).
+ */
+void
+trec_flush_req_stop (iore_time_t start)
+{
+  if (state.trec_test && state.test_action == IORE_TREC_ACTION_WRITE_READ)
+    state.flush_time += trec_curtime () - start;
+} /* trec_flush_req_stop () */
+
 iore_trec_test_t *
 trec_test_commit ()
 {
@@ -250,43 +775,338 @@ trec_test_commit ()
   return trec_test;
 } /* trec_test_commit () */
 
+/**
+ * Returns the mean time of a trec_test_start () and trec_test_stop () pair,
+ * over 'n' pairs recorded into a scratch repetition, leaving the actual
+ * records untouched.
+ */
+iore_time_t
+trec_test_cost (unsigned int n)
+{
+  assert(n > 0);
+
+  iore_trec_st_t saved = state;
+  iore_trec_run_rept_t scratch =
+    { };
+  state.trec_rept = &scratch;
+
+  iore_time_t start = trec_curtime ();
+  unsigned int i;
+  for (i = 0; i < n; i++)
+    {
+      trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_WRITE_READ);
+      trec_test_stop (0);
+    }
+  iore_time_t cost = (trec_curtime () - start) / n;
+
+  state = saved;
+
+  return cost;
+} /* trec_test_cost () */
+
+/**
+ * Reduces the task times and data sizes of 'trec_test' into its test times
+ * and data size at the master task, in a single collective.
+ */
+void
+trec_test_reduce (iore_trec_test_t *trec_test)
+{
+  assert(trec_test);
+
+  trec_pack_init ();
+
+  double pack[TREC_PACK_LEN], test_pack[TREC_PACK_LEN];
+  trec_test_pack (trec_test, pack);
+  MPI_Reduce (pack, test_pack, 1, pack_type, pack_op, IORE_MASTER_TASK,
+	      ctx.comm);
+
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      bool committed = trec_test->committed;
+      trec_test_unpack (test_pack, trec_test);
+      trec_test->committed = committed;
+    }
+} /* trec_test_reduce () */
+
 static iore_time_t
 trec_curtime ()
 {
-  return (MPI_Wtime () - wclock_delta);
+  iore_time_t now = trec_timer ();
+  return (now - clock_st.offset - clock_st.drift * (now - clock_st.ref));
 } /* trec_curtime () */
 
+static iore_time_t
+trec_timer ()
+{
+  if (clock_st.conf.timer == IORE_TREC_TIMER_MONOTONIC_RAW)
+    {
+      struct timespec ts;
+      clock_gettime (CLOCK_MONOTONIC_RAW, &ts);
+      return (ts.tv_sec + ts.tv_nsec / 1e9);
+    }
+
+  return MPI_Wtime ();
+} /* trec_timer () */
+
+/**
+ * Runs the ping-pong rounds between the master task and task 'peer'. At
+ * the other task, sets the offset of its clock to the clock of the master,
+ * the time it was taken at and its error bound. The first round only warms
+ * up the path.
+ */
+static void
+trec_clock_pingpong (int peer, iore_time_t *offset, iore_time_t *ref,
+		     iore_time_t *error)
+{
+  unsigned int i;
+  iore_time_t best_rtt = -1.0;
+  for (i = 0; i <= clock_st.conf.sync_rounds; i++)
+    {
+      iore_time_t master_time;
+      if (!offset)
+	{
+	  MPI_Recv (NULL, 0, MPI_BYTE, peer, TREC_CLOCK_SYNC_TAG,
+		    MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+	  master_time = trec_timer ();
+	  MPI_Send (&master_time, 1, MPI_DOUBLE, peer, TREC_CLOCK_SYNC_TAG,
+		    MPI_COMM_WORLD);
+	  continue;
+	}
+
+      iore_time_t send_time = trec_timer ();
+      MPI_Send (NULL, 0, MPI_BYTE, peer, TREC_CLOCK_SYNC_TAG, MPI_COMM_WORLD);
+      MPI_Recv (&master_time, 1, MPI_DOUBLE, peer, TREC_CLOCK_SYNC_TAG,
+		MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      iore_time_t recv_time = trec_timer ();
+
+      iore_time_t rtt = recv_time - send_time;
+      if (i > 0 && (best_rtt < 0 || rtt < best_rtt))
+	{
+	  best_rtt = rtt;
+	  *ref = (send_time + recv_time) / 2;
+	  *offset = *ref - master_time;
+	  *error = rtt / 2;
+	}
+    }
+} /* trec_clock_pingpong () */
+
+/**
+ * Reduces the records of all test types of the current repetition in a
+ * single collective. Tests are committed only if committed by all tasks.
+ */
 static void
 trec_run_rept_reduce ()
 {
   if (state.trec_rept)
     {
-      int i_type, i_action;
+      trec_pack_init ();
+
+      double pack[IORE_TEST_TYPE_LENGTH][TREC_PACK_LEN];
+      double test_pack[IORE_TEST_TYPE_LENGTH][TREC_PACK_LEN];
+      int i_type;
       for (i_type = 0; i_type < IORE_TEST_TYPE_LENGTH; i_type++)
-	{
-	  iore_trec_test_t *trec_test = &state.trec_rept->test[i_type];
-	  for (i_action = 0; i_action < IORE_TREC_ACTION_LENGTH; i_action++)
-	    {
-	      MPI_Reduce (
-		  &trec_test->task_time[i_action][IORE_TREC_EVENT_START],
-		  &trec_test->test_time[i_action][IORE_TREC_EVENT_START], 1,
-		  MPI_DOUBLE,
-		  MPI_MIN, IORE_MASTER_TASK, ctx.comm);
-	      MPI_Reduce (&trec_test->task_time[i_action][IORE_TREC_EVENT_STOP],
-			  &trec_test->test_time[i_action][IORE_TREC_EVENT_STOP],
-			  1,
-			  MPI_DOUBLE,
-			  MPI_MAX, IORE_MASTER_TASK, ctx.comm);
-	      MPI_Reduce (&trec_test->task_data_size,
-			  &trec_test->test_data_size, 1, MPI_AINT, MPI_SUM,
-			  IORE_MASTER_TASK,
-			  ctx.comm);
-	      bool committed = false;
-	      MPI_Allreduce (&trec_test->committed, &committed, 1, MPI_C_BOOL,
-	      MPI_LAND,
-			     ctx.comm);
-	      trec_test->committed = committed;
-	    } /* end of action loop */
-	} /* end of type loop */
+	trec_test_pack (&state.trec_rept->test[i_type], pack[i_type]);
+
+      MPI_Allreduce (pack, test_pack, IORE_TEST_TYPE_LENGTH, pack_type,
+		     pack_op, ctx.comm);
+
+      for (i_type = 0; i_type < IORE_TEST_TYPE_LENGTH; i_type++)
+	trec_test_unpack (test_pack[i_type], &state.trec_rept->test[i_type]);
     }
 } /* trec_run_rept_reduce () */
+
+static void
+trec_pack_init ()
+{
+  if (pack_op != MPI_OP_NULL)
+    return;
+
+  /* records are reduced as a whole, MPI may not split them */
+  MPI_Type_contiguous (TREC_PACK_LEN, MPI_DOUBLE, &pack_type);
+  MPI_Type_commit (&pack_type);
+  MPI_Op_create (trec_pack_op, true, &pack_op);
+} /* trec_pack_init () */
+
+static void
+trec_test_pack (const iore_trec_test_t *trec_test, double *pack)
+{
+  int i_action;
+  for (i_action = 0; i_action < IORE_TREC_ACTION_LENGTH; i_action++)
+    {
+      pack[TREC_PACK_START + i_action] =
+	  trec_test->task_time[i_action][IORE_TREC_EVENT_START];
+      pack[TREC_PACK_STOP + i_action] =
+	  trec_test->task_time[i_action][IORE_TREC_EVENT_STOP];
+    }
+  pack[TREC_PACK_DATA_SIZE] = trec_test->task_data_size;
+  pack[TREC_PACK_COMMITTED] = trec_test->committed;
+  memcpy (&pack[TREC_PACK_RSRC], trec_test->task_rsrc,
+	  sizeof(trec_test->task_rsrc));
+} /* trec_test_pack () */
+
+static void
+trec_test_unpack (const double *pack, iore_trec_test_t *trec_test)
+{
+  int i_action;
+  for (i_action = 0; i_action < IORE_TREC_ACTION_LENGTH; i_action++)
+    {
+      trec_test->test_time[i_action][IORE_TREC_EVENT_START] =
+	  pack[TREC_PACK_START + i_action];
+      trec_test->test_time[i_action][IORE_TREC_EVENT_STOP] =
+	  pack[TREC_PACK_STOP + i_action];
+    }
+  trec_test->test_data_size = pack[TREC_PACK_DATA_SIZE];
+  trec_test->committed = pack[TREC_PACK_COMMITTED];
+  memcpy (trec_test->test_rsrc, &pack[TREC_PACK_RSRC],
+	  sizeof(trec_test->test_rsrc));
+} /* trec_test_unpack () */
+
+/**
+ * MPI reduction operator over packed test records: minimum start times,
+ * maximum stop times, total data size, logical and of committed flags and
+ * total resource counters.
+ */
+static void
+trec_pack_op (void *in, void *inout, int *len, MPI_Datatype *dtype)
+{
+  assert(*dtype == pack_type);
+
+  const double *a = in;
+  double *b = inout;
+  int i;
+  for (i = 0; i < *len * TREC_PACK_LEN; i++)
+    {
+      int field = i % TREC_PACK_LEN;
+      if (field < TREC_PACK_STOP)
+	b[i] = (a[i] < b[i]) ? a[i] : b[i];
+      else if (field < TREC_PACK_DATA_SIZE)
+	b[i] = (a[i] > b[i]) ? a[i] : b[i];
+      else if (field == TREC_PACK_COMMITTED)
+	b[i] = (a[i] && b[i]);
+      else
+	b[i] += a[i];
+    }
+} /* trec_pack_op () */
+
+/**
+ * Opens the software counters as a single group, so that they are read with
+ * a single read (). They count the task at user and kernel level, which
+ * unprivileged users are allowed up to perf_event_paranoid 1.
+ */
+static int
+trec_rsrc_perf_open ()
+{
+  int i;
+  for (i = 0; i < TREC_RSRC_PERF_LEN; i++)
+    {
+      struct perf_event_attr attr;
+      memset (&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_SOFTWARE;
+      attr.config = rsrc_perf_config[i];
+      attr.read_format = PERF_FORMAT_GROUP;
+      attr.exclude_hv = 1;
+
+      int fd = syscall (SYS_perf_event_open, &attr, 0, -1, rsrc_perf_fd, 0);
+      if (fd < 0)
+	{
+	  iore_errorf_all(
+	      "Unable to open perf %s counter: %s (see perf_event_paranoid).",
+	      trec_rsrc_lbl[IORE_TREC_RSRC_TASK_CLOCK + i], strerror (errno));
+	  return IORE_FAILURE;
+	}
+      if (rsrc_perf_fd < 0)
+	rsrc_perf_fd = fd;
+    }
+
+  return IORE_SUCCESS;
+} /* trec_rsrc_perf_open () */
+
+/**
+ * Reads the current resource counters of the task into 'val'. Counters of
+ * groups not recorded are left zero.
+ */
+static void
+trec_rsrc_read (double *val)
+{
+  memset (val, 0, IORE_TREC_RSRC_LENGTH * sizeof(double));
+
+  if (trec_exp.rsrc.rusage)
+    {
+      struct rusage usage;
+      if (!getrusage (RUSAGE_SELF, &usage))
+	{
+	  val[IORE_TREC_RSRC_UTIME] = (usage.ru_utime.tv_sec
+	      + usage.ru_utime.tv_usec / 1e6);
+	  val[IORE_TREC_RSRC_STIME] = (usage.ru_stime.tv_sec
+	      + usage.ru_stime.tv_usec / 1e6);
+	  val[IORE_TREC_RSRC_MINFLT] = usage.ru_minflt;
+	  val[IORE_TREC_RSRC_MAJFLT] = usage.ru_majflt;
+	  val[IORE_TREC_RSRC_NVCSW] = usage.ru_nvcsw;
+	  val[IORE_TREC_RSRC_NIVCSW] = usage.ru_nivcsw;
+	}
+    }
+
+  if (rsrc_io_fd >= 0)
+    trec_rsrc_read_io (val);
+
+  if (rsrc_perf_fd >= 0)
+    trec_rsrc_read_perf (val);
+} /* trec_rsrc_read () */
+
+static void
+trec_rsrc_read_io (double *val)
+{
+  static const struct
+  {
+    const char *key;
+    enum iore_trec_rsrc rsrc;
+  } io_keys[] =
+    {
+      { "rchar:", IORE_TREC_RSRC_RCHAR },
+      { "wchar:", IORE_TREC_RSRC_WCHAR },
+      { "read_bytes:", IORE_TREC_RSRC_READ_BYTES },
+      { "write_bytes:", IORE_TREC_RSRC_WRITE_BYTES } };
+
+  char buf[TREC_RSRC_IO_BUF_LEN];
+  ssize_t len = pread (rsrc_io_fd, buf, sizeof(buf) - 1, 0);
+  if (len <= 0)
+    return;
+  buf[len] = '\0';
+
+  /* rchar counts the reads of /proc/self/io itself, which are left out */
+  double self = rsrc_io_self;
+  rsrc_io_self += len;
+
+  char *line;
+  for (line = buf; line && *line; line = strchr (line, '\n'))
+    {
+      if (*line == '\n')
+	line++;
+
+      unsigned int i;
+      for (i = 0; i < sizeof(io_keys) / sizeof(io_keys[0]); i++)
+	{
+	  size_t key_len = strlen (io_keys[i].key);
+	  if (!strncmp (line, io_keys[i].key, key_len))
+	    val[io_keys[i].rsrc] = strtoull (line + key_len, NULL, 10);
+	}
+    }
+  val[IORE_TREC_RSRC_RCHAR] -= self;
+} /* trec_rsrc_read_io () */
+
+static void
+trec_rsrc_read_perf (double *val)
+{
+  /* PERF_FORMAT_GROUP: the number of counters, then their values */
+  uint64_t buf[1 + TREC_RSRC_PERF_LEN];
+  if (read (rsrc_perf_fd, buf, sizeof(buf)) != sizeof(buf))
+    return;
+
+  int i;
+  for (i = 0; i < TREC_RSRC_PERF_LEN && i < (int) buf[0]; i++)
+    val[IORE_TREC_RSRC_TASK_CLOCK + i] = buf[1 + i];
+
+  /* nanoseconds */
+  val[IORE_TREC_RSRC_TASK_CLOCK] /= 1e9;
+} /* trec_rsrc_read_perf () */
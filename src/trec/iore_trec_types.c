@@ -30,7 +30,25 @@ arrtestact2str (const iore_time_t *, int);
 const char * const trec_event_lbl[IORE_TREC_EVENT_LENGTH] =
   { "start", "stop" };
 const char * const trec_action_lbl[IORE_TREC_ACTION_LENGTH] =
-  { "create/open", "write/read", "close", "remove" };
+  { "create/open", "write/read", "close", "remove", "cache defeat",
+      "flush", "prealloc" };
+const char * const trec_timer_lbl[IORE_TREC_TIMER_LENGTH] =
+  { "mpi_wtime", "monotonic_raw" };
+const char * const trec_rsrc_lbl[IORE_TREC_RSRC_LENGTH] =
+  { "utime", "stime", "minflt", "majflt", "nvcsw", "nivcsw", "rchar", "wchar",
+      "read_bytes", "write_bytes", "task_clock", "page_faults",
+      "context_switches", "cpu_migrations" };
+const char * const trec_rsrc_group_lbl[IORE_TREC_RSRC_GROUP_LENGTH] =
+  { "rusage", "io", "perf" };
+
+static const enum iore_trec_rsrc_group rsrc_group[IORE_TREC_RSRC_LENGTH] =
+  { IORE_TREC_RSRC_GROUP_RUSAGE, IORE_TREC_RSRC_GROUP_RUSAGE,
+      IORE_TREC_RSRC_GROUP_RUSAGE, IORE_TREC_RSRC_GROUP_RUSAGE,
+      IORE_TREC_RSRC_GROUP_RUSAGE, IORE_TREC_RSRC_GROUP_RUSAGE,
+      IORE_TREC_RSRC_GROUP_IO, IORE_TREC_RSRC_GROUP_IO,
+      IORE_TREC_RSRC_GROUP_IO, IORE_TREC_RSRC_GROUP_IO,
+      IORE_TREC_RSRC_GROUP_PERF, IORE_TREC_RSRC_GROUP_PERF,
+      IORE_TREC_RSRC_GROUP_PERF, IORE_TREC_RSRC_GROUP_PERF };
 
 /*** FUNCTIONS ***************************************************************/
 
@@ -45,13 +63,13 @@ trecexp2str (const iore_trec_exp_t *exp)
       char *exp_repl = arrrepl2str (exp->exp_repl, exp->num_exp_repl);
 
       int len = snprintf (str, 0, TRECEXP2STR_FORMAT, exp, time,
-			  exp->num_exp_repl, exp_repl) + 1;
+			  exp->clock_error, exp->num_exp_repl, exp_repl) + 1;
       if (len > 0)
 	{
 	  str = malloc (len);
 	  assert(str);
-	  snprintf (str, len, TRECEXP2STR_FORMAT, exp, time, exp->num_exp_repl,
-		    exp_repl);
+	  snprintf (str, len, TRECEXP2STR_FORMAT, exp, time, exp->clock_error,
+		    exp->num_exp_repl, exp_repl);
 	}
     }
 
@@ -69,13 +87,13 @@ trecexprepl2str (const iore_trec_exp_repl_t *repl)
       char *run = arrrun2str (repl->run, repl->num_run);
 
       int len = snprintf (str, 0, TRECEXPREPL2STR_FORMAT, repl, repl->id, time,
-			  repl->num_run, run) + 1;
+			  repl->clock_error, repl->num_run, run) + 1;
       if (len > 0)
 	{
 	  str = malloc (len);
 	  assert(str);
 	  snprintf (str, len, TRECEXPREPL2STR_FORMAT, repl, repl->id, time,
-		    repl->num_run, run);
+		    repl->clock_error, repl->num_run, run);
 	}
     }
 
@@ -160,6 +178,64 @@ trectest2str (const iore_trec_test_t *test)
   return str;
 } /* trectest2str () */
 
+char *
+trecclock2str (const iore_trec_clock_t *clock)
+{
+  char *str = NULL;
+
+  if (clock)
+    {
+      int len = snprintf (str, 0, TRECCLOCK2STR_FORMAT, clock,
+			  trec_timer_lbl[clock->timer], clock->sync_rounds) + 1;
+      if (len > 0)
+	{
+	  str = malloc (len);
+	  assert(str);
+	  snprintf (str, len, TRECCLOCK2STR_FORMAT, clock,
+		    trec_timer_lbl[clock->timer], clock->sync_rounds);
+	}
+    }
+
+  return str;
+} /* trecclock2str () */
+
+char *
+trecreqs2str (const iore_trec_reqs_t *reqs)
+{
+  char *str = NULL;
+
+  if (reqs)
+    {
+      int len = snprintf (str, 0, TRECREQS2STR_FORMAT, reqs, reqs->ring_len,
+			  reqs->dir) + 1;
+      if (len > 0)
+	{
+	  str = malloc (len);
+	  assert(str);
+	  snprintf (str, len, TRECREQS2STR_FORMAT, reqs, reqs->ring_len,
+		    reqs->dir);
+	}
+    }
+
+  return str;
+} /* trecreqs2str () */
+
+bool
+trec_rsrc_enabled (iore_trec_rsrc_flags_t flags, enum iore_trec_rsrc rsrc)
+{
+  switch (rsrc_group[rsrc])
+    {
+    case IORE_TREC_RSRC_GROUP_RUSAGE:
+      return flags.rusage;
+    case IORE_TREC_RSRC_GROUP_IO:
+      return flags.io;
+    case IORE_TREC_RSRC_GROUP_PERF:
+      return flags.perf;
+    default:
+      return false;
+    }
+} /* trec_rsrc_enabled () */
+
 static char *
 arrrepl2str (const iore_trec_exp_repl_t *repl, int len)
 {
@@ -0,0 +1,403 @@
+/*
+ * bench_iore.c
+ *
+ * Author: Camilo <eduardo.camilo@posgrad.ufsc.br>
+ */
+
+/* static helpers of the test module are benchmarked in place */
+#include "iore_test.c"
+
+#include "iore_dict.h"
+#include "iore_trec.h"
+
+#define BENCH_CSV_HEADER "commit,bench,param,tasks,iters,ns_per_op\n"
+#define BENCH_DICT_KEY_LEN 32
+#define BENCH_MIN_SECS 0.05 /* minimum measuring time of each benchmark */
+#define BENCH_COLL_REPS 8 /* repetitions of benchmarks calling collectives */
+
+void
+bench_report (const char *, const char *, unsigned int, unsigned long,
+	      double, MPI_Comm);
+void
+bench_offs_nx1_rnd ();
+void
+bench_dset_to_off ();
+void
+bench_buf_prep ();
+void
+bench_prng ();
+void
+bench_dict_get ();
+void
+bench_trec_test ();
+void
+bench_trec_reduce ();
+
+static const char *commit = "unknown";
+
+int
+main (int argc, char **argv)
+{
+  MPI_Init (&argc, &argv);
+  ctx_init ();
+  trec_init ();
+
+  if (argc > 1)
+    commit = argv[1];
+
+  if (ctx.task_id == IORE_MASTER_TASK)
+    fputs (BENCH_CSV_HEADER, stdout);
+
+  bench_offs_nx1_rnd ();
+  bench_dset_to_off ();
+  bench_buf_prep ();
+  bench_prng ();
+  bench_dict_get ();
+  bench_trec_test ();
+  bench_trec_reduce ();
+
+  trec_destroy ();
+  MPI_Finalize ();
+
+  return 0;
+} /* main () */
+
+/**
+ * Prints a CSV line with the mean time per operation, taking the maximum
+ * over the tasks of 'comm'.
+ */
+void
+bench_report (const char *bench, const char *param, unsigned int tasks,
+	      unsigned long iters, double secs, MPI_Comm comm)
+{
+  double ns_per_op = secs * 1e9 / iters;
+  double max_ns_per_op;
+  MPI_Reduce (&ns_per_op, &max_ns_per_op, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+
+  int task_id;
+  MPI_Comm_rank (comm, &task_id);
+  if (task_id == 0)
+    {
+      fprintf (stdout, "%s,%s,%s,%u,%lu,%.3f\n", commit, bench, param, tasks,
+	       iters, max_ns_per_op);
+      fflush (stdout);
+    }
+} /* bench_report () */
+
+/**
+ * Random Nx1 offsets, per offset of the running task, for files shared by
+ * 'tasks' tasks issuing 'reqs' requests each.
+ */
+void
+bench_offs_nx1_rnd ()
+{
+  const unsigned int l_reqs[] =
+    { 1024, 16384 };
+  const unsigned int l_tasks[] =
+    { 1, 16, 256 };
+  size_t req_size = 4096;
+
+  unsigned int i, j, k;
+  for (i = 0; i < sizeof(l_reqs) / sizeof(l_reqs[0]); i++)
+    for (j = 0; j < sizeof(l_tasks) / sizeof(l_tasks[0]); j++)
+      {
+	unsigned int reqs = l_reqs[i];
+	unsigned int tasks = l_tasks[j];
+
+	iore_wkld_t wkld;
+	wkld_init (&wkld);
+	wkld.type = IORE_WKLD_OFFSET;
+	wkld.u.oset.ac_pattern = IORE_WKLD_OSET_AP_RANDOM;
+	wkld.u.oset._data_sizes_len = 1;
+	wkld.u.oset.data_sizes = malloc (sizeof(size_t));
+	assert(wkld.u.oset.data_sizes);
+	wkld.u.oset.data_sizes[0] = reqs * req_size;
+	wkld.u.oset._req_sizes_len = 1;
+	wkld.u.oset.req_sizes = malloc (sizeof(size_t));
+	assert(wkld.u.oset.req_sizes);
+	wkld.u.oset.req_sizes[0] = req_size;
+	wkld.u.oset.my_req_size = req_size;
+
+	int *members = malloc (tasks * sizeof(int));
+	assert(members);
+	for (k = 0; k < tasks; k++)
+	  members[k] = k;
+	off_t *offs = malloc (reqs * sizeof(off_t));
+	assert(offs);
+
+	/* the PRNG is seeded collectively, so all tasks repeat alike */
+	double start = MPI_Wtime ();
+	for (k = 0; k < BENCH_COLL_REPS; k++)
+	  test_offs_nx1_rnd_prep (&wkld, reqs, 0, members, tasks, offs);
+	double secs = MPI_Wtime () - start;
+
+	char param[32];
+	snprintf (param, sizeof(param), "reqs=%u", reqs);
+	bench_report ("offs_nx1_rnd_prep", param, tasks,
+		      (unsigned long) reqs * BENCH_COLL_REPS, secs, ctx.comm);
+
+	free (offs);
+	free (members);
+	wkld_free (&wkld);
+      }
+} /* bench_offs_nx1_rnd () */
+
+/**
+ * Offsets of the first task of a cube of doubles decomposed over 'tasks'
+ * tasks, per offset.
+ */
+void
+bench_dset_to_off ()
+{
+  const unsigned int l_dim_sizes[] =
+    { 64, 256 };
+  const unsigned int l_tasks[] =
+    { 1, 8, 64 };
+
+  unsigned int i, j;
+  for (i = 0; i < sizeof(l_dim_sizes) / sizeof(l_dim_sizes[0]); i++)
+    for (j = 0; j < sizeof(l_tasks) / sizeof(l_tasks[0]); j++)
+      {
+	unsigned int dim_size = l_dim_sizes[i];
+	unsigned int tasks = l_tasks[j];
+
+	iore_wkld_dset_t dset;
+	dset.num_vars = 1;
+	dset._vars_size = dset_var_size (IORE_WKLD_DSET_DV_DOUBLE);
+	dset.type = IORE_WKLD_DSET_CARTESIAN;
+	dset.u.cart.num_dims = 3;
+	unsigned int g_dim_sizes[3] =
+	  { dim_size, dim_size, dim_size };
+	unsigned int g_dim_divs[3] =
+	  { 1, 1, 1 };
+	unsigned int divs = tasks;
+	unsigned int d = 0;
+	while (divs > 1)
+	  {
+	    g_dim_divs[d % 3] *= 2;
+	    divs /= 2;
+	    d++;
+	  }
+	dset.u.cart.g_dim_sizes = g_dim_sizes;
+	dset.u.cart.g_dim_divs = g_dim_divs;
+	test_dset_cart_type_prep (&dset, 0);
+
+	unsigned long offs_len = dset.u.cart.my_dim_sizes[0]
+	    * dset.u.cart.my_dim_sizes[1];
+	unsigned long iters = 0;
+	double start = MPI_Wtime ();
+	double secs;
+	do
+	  {
+	    free (dset_to_off (&dset, IORE_TEST_FMODE_NX1));
+	    iters += offs_len;
+	    secs = MPI_Wtime () - start;
+	  }
+	while (secs < BENCH_MIN_SECS);
+
+	char param[32];
+	snprintf (param, sizeof(param), "dim_size=%u", dim_size);
+	bench_report ("dset_to_off", param, tasks, iters, secs, ctx.comm);
+
+	test_dset_cart_type_post (&dset.u.cart);
+      }
+} /* bench_dset_to_off () */
+
+/**
+ * Write buffer preparation, per byte.
+ */
+void
+bench_buf_prep ()
+{
+  const size_t l_sizes[] =
+    { 65536, 1048576, 16777216 };
+
+  unsigned int i;
+  for (i = 0; i < sizeof(l_sizes) / sizeof(l_sizes[0]); i++)
+    {
+      char *buf;
+      unsigned long iters = 0;
+      double start = MPI_Wtime ();
+      double secs;
+      do
+	{
+	  test_buf_prep (l_sizes[i], IORE_TEST_TYPE_WRITE, &buf);
+	  free (buf);
+	  iters += l_sizes[i];
+	  secs = MPI_Wtime () - start;
+	}
+      while (secs < BENCH_MIN_SECS);
+
+      char param[32];
+      snprintf (param, sizeof(param), "size=%zu", l_sizes[i]);
+      bench_report ("test_buf_prep", param, ctx.num_procs, iters, secs,
+		    ctx.comm);
+    }
+} /* bench_buf_prep () */
+
+/**
+ * Samples drawn per distribution.
+ */
+void
+bench_prng ()
+{
+  const char *l_params[IORE_PRNG_LENGTH][2][2] =
+    {
+      { /* unif */
+	{ PRNG_PARAM_MIN, "0" },
+	{ PRNG_PARAM_MAX, "1048576" } },
+      { /* norm */
+	{ PRNG_PARAM_MEAN, "65536" },
+	{ PRNG_PARAM_STDEV, "4096" } },
+      { /* geom */
+	{ PRNG_PARAM_MEAN, "65536" },
+	{ NULL, NULL } } };
+
+  int type;
+  for (type = 0; type < IORE_PRNG_LENGTH; type++)
+    {
+      iore_prng_dist_t dist;
+      dist.type = type;
+      dict_initc (&dist.params, 2);
+      unsigned int i;
+      for (i = 0; i < 2 && l_params[type][i][0]; i++)
+	dict_set (&dist.params, l_params[type][i][0], l_params[type][i][1]);
+
+      iore_prng_t *prng = prng_new_sync (&dist);
+      assert(prng);
+
+      unsigned long iters = 0;
+      volatile double sum = 0;
+      double start = MPI_Wtime ();
+      double secs;
+      do
+	{
+	  for (i = 0; i < 1024; i++)
+	    sum += prng_next_double (prng);
+	  iters += 1024;
+	  secs = MPI_Wtime () - start;
+	}
+      while (secs < BENCH_MIN_SECS);
+
+      bench_report ("prng_next_double", prng_type_lbl[type], ctx.num_procs,
+		    iters, secs, ctx.comm);
+
+      free (prng);
+      dict_free (&dist.params);
+    }
+} /* bench_prng () */
+
+/**
+ * Hit lookups over dictionaries of several lengths.
+ */
+void
+bench_dict_get ()
+{
+  const unsigned int l_lens[] =
+    { 4, 16, 64 };
+
+  unsigned int i, j;
+  for (i = 0; i < sizeof(l_lens) / sizeof(l_lens[0]); i++)
+    {
+      unsigned int len = l_lens[i];
+      char (*keys)[BENCH_DICT_KEY_LEN] = malloc (len * BENCH_DICT_KEY_LEN);
+      assert(keys);
+
+      dict_t dict;
+      dict_initc (&dict, len);
+      for (j = 0; j < len; j++)
+	{
+	  snprintf (keys[j], BENCH_DICT_KEY_LEN, "param_%u", j);
+	  dict_set (&dict, keys[j], "value");
+	}
+
+      unsigned long iters = 0;
+      unsigned long hits = 0;
+      double start = MPI_Wtime ();
+      double secs;
+      do
+	{
+	  for (j = 0; j < 1024; j++)
+	    hits += (dict_get (&dict, keys[j % len]) != NULL);
+	  iters += 1024;
+	  secs = MPI_Wtime () - start;
+	}
+      while (secs < BENCH_MIN_SECS);
+      assert(hits == iters);
+
+      char param[32];
+      snprintf (param, sizeof(param), "len=%u", len);
+      bench_report ("dict_get", param, ctx.num_procs, iters, secs, ctx.comm);
+
+      dict_free (&dict);
+      free (keys);
+    }
+} /* bench_dict_get () */
+
+/**
+ * Pairs of trec_test_start () and trec_test_stop () calls.
+ */
+void
+bench_trec_test ()
+{
+  unsigned long iters = 1000000;
+  double secs = trec_test_cost (iters) * iters;
+
+  bench_report ("trec_test_start_stop", "", ctx.num_procs, iters, secs,
+		ctx.comm);
+} /* bench_trec_test () */
+
+/**
+ * Repetition stops, which reduce the test records of all tasks, over
+ * communicators of increasing sizes.
+ */
+void
+bench_trec_reduce ()
+{
+  const unsigned int iters = 100;
+  MPI_Comm world_comm = ctx.comm;
+  int world_task_id = ctx.task_id;
+  int world_num_procs = ctx.num_procs;
+
+  int size;
+  for (size = 1;; size *= 2)
+    {
+      if (size > world_num_procs)
+	size = world_num_procs;
+
+      MPI_Comm comm;
+      MPI_Comm_split (world_comm, world_task_id < size ? 0 : MPI_UNDEFINED,
+		      world_task_id, &comm);
+      if (comm != MPI_COMM_NULL)
+	{
+	  ctx.comm = comm;
+
+	  trec_exp_start (1);
+	  trec_exp_repl_start (1, 1);
+	  trec_run_start (1, iters);
+
+	  unsigned int i;
+	  MPI_Barrier (comm);
+	  double start = MPI_Wtime ();
+	  for (i = 1; i <= iters; i++)
+	    {
+	      trec_run_rept_start (i);
+	      trec_run_rept_stop ();
+	    }
+	  double secs = MPI_Wtime () - start;
+
+	  trec_run_stop ();
+	  trec_exp_repl_stop ();
+	  trec_exp_stop ();
+	  trec_destroy ();
+
+	  bench_report ("trec_run_rept_reduce", "", size, iters, secs, comm);
+
+	  ctx.comm = world_comm;
+	  MPI_Comm_free (&comm);
+	}
+
+      if (size == world_num_procs)
+	break;
+    }
+} /* bench_trec_reduce () */
@@ -37,7 +37,6 @@ main (int argc, char **argv)
   MPI_Init (&argc, &argv);
   ctx_init ();
   trec_init ();
-  prng_pool_init ();
 
   const int num_tests = 5;
   int i;
@@ -179,6 +178,7 @@ test_05 ()
       iore_exp_repl_t repl;
       repl.id = 1;
       repl._runs_len = exp._runs_len;
+      repl.co_schedule = exp.co_schedule;
       repl.runs = malloc (repl._runs_len * sizeof(iore_run_t *));
       assert(repl.runs);
       unsigned int i;
@@ -8,17 +8,38 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <assert.h>
 
 #include "iore_parser_file.h"
 #include "iore_ctx.h"
 #include "iore_error.h"
 #include "iore_experiment.h"
+#include "iore_stex.h"
 
 #define MAX_PROCESSES 2
+#define SWEEP_PATH_LEN 64
+
+/* run definition with the given sweep, 'num_tasks' 2, 'data_sizes' [ "4M" ]
+ * and 'request_sizes' [ "1M", "2M" ] */
+#define SWEEP_EXP_FORMAT "{ \"runs\": [ { \"test\": { \"type\": [ \"write\" ], \"file_mode\": \"Nx1\", \"file_name\": \"/tmp/testfile\", \"workload\": { \"num_tasks\": 2, \"offset\": { \"access_pattern\": \"sequential\", \"data_sizes\": [ \"4M\" ], \"request_sizes\": [ \"1M\", \"2M\" ] } }, \"afio\": { \"posix\": {} } }, \"sweep\": %s } ] }"
 
 int
 test_parse (char *);
+int
+test_sweep (const char *, iore_exp_t *);
+int
+test_sweep_01 ();
+int
+test_sweep_02 ();
+int
+test_sweep_03 ();
+int
+test_sweep_04 ();
+int
+test_sweep_05 ();
+int
+check_run (const iore_exp_t *, unsigned int, size_t, unsigned int);
 
 int
 main (int argc, char **argv)
@@ -36,6 +57,33 @@ main (int argc, char **argv)
   else
     fputs ("Missign experiment definition file.\n", stderr);
 
+  const int num_tests = 5;
+  int i;
+  for (i = 1; i <= num_tests; i++)
+    {
+      int rerr = IORE_FAILURE;
+      switch (i)
+	{
+	case 1:
+	  rerr = test_sweep_01 ();
+	  break;
+	case 2:
+	  rerr = test_sweep_02 ();
+	  break;
+	case 3:
+	  rerr = test_sweep_03 ();
+	  break;
+	case 4:
+	  rerr = test_sweep_04 ();
+	  break;
+	case 5:
+	  rerr = test_sweep_05 ();
+	  break;
+	}
+      fprintf (stdout, "[Task %d] Test sweep %d:...%s!\n", ctx.task_id, i,
+	       (rerr ? "FAILED" : "SUCCESS"));
+    }
+
   MPI_Finalize ();
   fputs ("Finalizing JSON parser test.\n", stdout);
 } /* main () */
@@ -57,3 +105,270 @@ test_parse (char *file)
 
   return rerr;
 } /* test_parse () */
+
+/**
+ * Parses an experiment whose single run has sweep 'jsweep' into 'exp'.
+ * The definition file is written by the master task, which is the only one
+ * reading it. Returns IORE_FAILURE if the parse fails. Collective.
+ */
+int
+test_sweep (const char *jsweep, iore_exp_t *exp)
+{
+  char path[SWEEP_PATH_LEN] = "/tmp/test_prsr_jsonXXXXXX.json";
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      int fd = mkstemps (path, strlen (".json"));
+      if (fd >= 0)
+	{
+	  FILE *f = fdopen (fd, "w");
+	  assert(f);
+	  fprintf (f, SWEEP_EXP_FORMAT, jsweep);
+	  fclose (f);
+	}
+      else
+	path[0] = '\0';
+    }
+  MPI_Bcast (path, SWEEP_PATH_LEN, MPI_CHAR, IORE_MASTER_TASK, ctx.comm);
+  if (path[0] == '\0')
+    return IORE_FAILURE;
+
+  exp_init (exp);
+  int rerr = (parse (path, exp) ? IORE_SUCCESS : IORE_FAILURE);
+
+  MPI_Barrier (ctx.comm);
+  if (ctx.task_id == IORE_MASTER_TASK)
+    unlink (path);
+
+  return rerr;
+} /* test_sweep () */
+
+/**
+ * Checks that run 'i_run' of 'exp' has a single request size 'req_size' and
+ * 'num_tasks' tasks.
+ */
+int
+check_run (const iore_exp_t *exp, unsigned int i_run, size_t req_size,
+	   unsigned int num_tasks)
+{
+  const iore_wkld_t *wkld = &exp->runs[i_run].test.wkld;
+  if (exp->runs[i_run].id != i_run + 1 || wkld->num_tasks != num_tasks
+      || wkld->u.oset._req_sizes_len != 1
+      || wkld->u.oset.req_sizes[0] != req_size)
+    {
+      fprintf (stderr, "FAIL: run %u: expected request size %zu and %u "
+	       "tasks.\n", i_run + 1, req_size, num_tasks);
+      return IORE_FAILURE;
+    }
+
+  return IORE_SUCCESS;
+} /* check_run () */
+
+/**
+ * Product of a multiplicative size range and a list of values: the last
+ * parameter varies fastest and the range bounds are inclusive.
+ */
+int
+test_sweep_01 ()
+{
+  int rerr = IORE_SUCCESS;
+
+  iore_exp_t exp =
+    { };
+  if (test_sweep ("{ \"mode\": \"product\", \"params\": [ "
+		  "{ \"param\": \"test.workload.offset.request_sizes\", "
+		  "\"range\": { \"from\": \"64K\", \"to\": \"256K\", "
+		  "\"mul\": 2 } }, "
+		  "{ \"param\": \"test.workload.num_tasks\", "
+		  "\"values\": [ 1, 4 ] } ] }", &exp)
+      || exp._runs_len != 6)
+    return IORE_FAILURE;
+
+  const size_t req_sizes[] =
+    { 65536, 65536, 131072, 131072, 262144, 262144 };
+  const unsigned int num_tasks[] =
+    { 1, 4, 1, 4, 1, 4 };
+  unsigned int i;
+  for (i = 0; i < 6; i++)
+    rerr |= check_run (&exp, i, req_sizes[i], num_tasks[i]);
+
+  /* one coordinate per run and swept parameter */
+  const iore_stex_sweep_t *sweep = &exp.stex.sweep;
+  if (sweep->num_params != 2 || sweep->num_runs != 7
+      || stex_sweep_value (sweep, 0, 0) != NULL
+      || strcmp (stex_sweep_value (sweep, 3, 0), "131072") != 0
+      || strcmp (stex_sweep_value (sweep, 3, 1), "1") != 0
+      || strcmp (stex_sweep_value (sweep, 6, 1), "4") != 0)
+    {
+      fputs ("FAIL: unexpected sweep coordinates.\n", stderr);
+      rerr = IORE_FAILURE;
+    }
+
+  exp_free (&exp);
+
+  return rerr;
+} /* test_sweep_01 () */
+
+/**
+ * Zip of two lists of values, and additive ranges whose upper bound is
+ * either a point of the range or not.
+ */
+int
+test_sweep_02 ()
+{
+  int rerr = IORE_SUCCESS;
+
+  iore_exp_t exp =
+    { };
+  if (test_sweep ("{ \"mode\": \"zip\", \"params\": [ "
+		  "{ \"param\": \"test.workload.num_tasks\", "
+		  "\"values\": [ 1, 2, 4 ] }, "
+		  "{ \"param\": \"test.workload.offset.request_sizes\", "
+		  "\"values\": [ \"1K\", \"2K\", \"4K\" ] } ] }", &exp)
+      || exp._runs_len != 3)
+    return IORE_FAILURE;
+  rerr |= check_run (&exp, 0, 1024, 1);
+  rerr |= check_run (&exp, 1, 2048, 2);
+  rerr |= check_run (&exp, 2, 4096, 4);
+  exp_free (&exp);
+
+  memset (&exp, 0, sizeof(iore_exp_t));
+  if (test_sweep ("{ \"params\": [ "
+		  "{ \"param\": \"test.workload.num_tasks\", "
+		  "\"range\": { \"from\": 1, \"to\": 7, \"add\": 3 } } ] }",
+		  &exp) || exp._runs_len != 3
+      || exp.runs[2].test.wkld.num_tasks != 7)
+    rerr = IORE_FAILURE;
+  exp_free (&exp);
+
+  memset (&exp, 0, sizeof(iore_exp_t));
+  if (test_sweep ("{ \"params\": [ "
+		  "{ \"param\": \"test.workload.offset.request_sizes\", "
+		  "\"range\": { \"from\": \"1K\", \"to\": \"3K\", "
+		  "\"add\": \"1K\" } } ] }", &exp) || exp._runs_len != 3
+      || check_run (&exp, 2, 3072, 2))
+    rerr = IORE_FAILURE;
+  exp_free (&exp);
+
+  memset (&exp, 0, sizeof(iore_exp_t));
+  if (test_sweep ("{ \"params\": [ "
+		  "{ \"param\": \"test.workload.num_tasks\", "
+		  "\"range\": { \"from\": 1, \"to\": 8, \"add\": 3 } } ] }",
+		  &exp) || exp._runs_len != 3
+      || exp.runs[2].test.wkld.num_tasks != 7)
+    rerr = IORE_FAILURE;
+  exp_free (&exp);
+
+  return rerr;
+} /* test_sweep_02 () */
+
+/**
+ * Empty or endless ranges are rejected: reversed bounds, a multiplier of
+ * one, a multiplicative range from zero and a step of zero. So are ranges
+ * with both steps and ranges with too many values.
+ */
+int
+test_sweep_03 ()
+{
+  const char *jsweeps[] =
+    {
+	"{ \"params\": [ { \"param\": \"test.workload.num_tasks\", "
+	    "\"range\": { \"from\": 4, \"to\": 1, \"add\": 1 } } ] }",
+	"{ \"params\": [ { \"param\": \"test.workload.num_tasks\", "
+	    "\"range\": { \"from\": 1, \"to\": 4, \"mul\": 1 } } ] }",
+	"{ \"params\": [ { \"param\": \"test.workload.num_tasks\", "
+	    "\"range\": { \"from\": 0, \"to\": 4, \"mul\": 2 } } ] }",
+	"{ \"params\": [ { \"param\": \"test.workload.num_tasks\", "
+	    "\"range\": { \"from\": 1, \"to\": 4, \"add\": 0 } } ] }",
+	"{ \"params\": [ { \"param\": \"test.workload.num_tasks\", "
+	    "\"range\": { \"from\": 1, \"to\": 4, \"add\": 1, "
+	    "\"mul\": 2 } } ] }",
+	"{ \"params\": [ { \"param\": \"test.workload.num_tasks\", "
+	    "\"range\": { \"from\": 1, \"to\": 100000, \"add\": 1 } } ] }" };
+
+  int rerr = IORE_SUCCESS;
+
+  unsigned int i;
+  for (i = 0; i < sizeof(jsweeps) / sizeof(jsweeps[0]); i++)
+    {
+      iore_exp_t exp =
+	{ };
+      if (!test_sweep (jsweeps[i], &exp))
+	{
+	  fprintf (stderr, "FAIL: range %u accepted.\n", i + 1);
+	  rerr = IORE_FAILURE;
+	}
+      exp_free (&exp);
+    }
+
+  return rerr;
+} /* test_sweep_03 () */
+
+/**
+ * Zips of lists of different lengths, and parameters that are not
+ * attributes of the run, are rejected.
+ */
+int
+test_sweep_04 ()
+{
+  const char *jsweeps[] =
+    {
+	"{ \"mode\": \"zip\", \"params\": [ "
+	    "{ \"param\": \"test.workload.num_tasks\", \"values\": [ 1, 2 ] }, "
+	    "{ \"param\": \"test.workload.offset.request_sizes\", "
+	    "\"values\": [ \"1K\" ] } ] }",
+	"{ \"params\": [ { \"param\": \"test.file_name.suffix\", "
+	    "\"values\": [ \"a\" ] } ] }",
+	"{ \"params\": [ { \"param\": \"test.workload.num_tasks\" } ] }" };
+
+  int rerr = IORE_SUCCESS;
+
+  unsigned int i;
+  for (i = 0; i < sizeof(jsweeps) / sizeof(jsweeps[0]); i++)
+    {
+      iore_exp_t exp =
+	{ };
+      if (!test_sweep (jsweeps[i], &exp))
+	{
+	  fprintf (stderr, "FAIL: sweep %u accepted.\n", i + 1);
+	  rerr = IORE_FAILURE;
+	}
+      exp_free (&exp);
+    }
+
+  return rerr;
+} /* test_sweep_04 () */
+
+/**
+ * Swept values take precedence over the values of the run definition: a
+ * swept list attribute is replaced by a list with the swept value alone,
+ * and the attributes not swept keep their values.
+ */
+int
+test_sweep_05 ()
+{
+  int rerr = IORE_SUCCESS;
+
+  iore_exp_t exp =
+    { };
+  if (test_sweep ("{ \"params\": [ "
+		  "{ \"param\": \"test.workload.offset.request_sizes\", "
+		  "\"values\": [ \"512K\", \"4096\" ] } ] }", &exp)
+      || exp._runs_len != 2)
+    return IORE_FAILURE;
+
+  rerr |= check_run (&exp, 0, 524288, 2);
+  rerr |= check_run (&exp, 1, 4096, 2);
+  unsigned int i;
+  for (i = 0; i < 2; i++)
+    {
+      const iore_wkld_oset_t *oset = &exp.runs[i].test.wkld.u.oset;
+      if (oset->_data_sizes_len != 1 || oset->data_sizes[0] != 4194304)
+	{
+	  fprintf (stderr, "FAIL: run %u: data sizes overridden.\n", i + 1);
+	  rerr = IORE_FAILURE;
+	}
+    }
+  exp_free (&exp);
+
+  return rerr;
+} /* test_sweep_05 () */
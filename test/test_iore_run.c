@@ -34,7 +34,6 @@ main (int argc, char **argv)
   MPI_Init (&argc, &argv);
   ctx_init ();
   trec_init ();
-  prng_pool_init ();
 
   const int num_tests = 4;
   int i;
@@ -6,10 +6,15 @@
 
 #include <mpi.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <stdbool.h>
+#include <glob.h>
+#include <json.h>
 
 #include "iore_stex.h"
+#include "iore_stex_columnar.h"
 #include "iore_ctx.h"
 #include "iore_trec.h"
 #include "iore_error.h"
@@ -18,6 +23,18 @@ void
 record (int, int, int);
 int
 export (const iore_stex_t);
+int
+export_timeline (const iore_stex_t *);
+int
+check_timeline (const char *);
+int
+roundtrip_columnar (iore_stex_t);
+int
+roundtrip_report (const char *, const char *);
+char **
+read_lines (FILE *, size_t *);
+int
+line_cmp (const void *, const void *);
 void
 tostr (iore_stex_t);
 
@@ -48,6 +65,39 @@ main (int argc, char **argv)
   else
     fputs ("Data exported.\n", stdout);
 
+  fputs ("Exporting binary data...\n", stdout);
+  stex.data_format = IORE_STEX_FORMAT_BINARY;
+  if (export (stex))
+    fputs ("Failed exporting binary data.\n", stderr);
+  else
+    fputs ("Binary data exported.\n", stdout);
+
+  fputs ("Exporting columnar data...\n", stdout);
+  stex.data_format = IORE_STEX_FORMAT_COLUMNAR;
+  if (export (stex))
+    fputs ("Failed exporting columnar data.\n", stderr);
+  else
+    fputs ("Columnar data exported.\n", stdout);
+
+  fputs ("Round-tripping columnar data...\n", stdout);
+  if (roundtrip_columnar (stex))
+    fputs ("FAIL: columnar data differs from CSV data.\n", stderr);
+  else
+    fputs ("Columnar data round-tripped.\n", stdout);
+
+  fputs ("Exporting timeline...\n", stdout);
+  stex.timeline = true;
+  if (export_timeline (&stex))
+    fputs ("Failed exporting timeline.\n", stderr);
+  else
+    fputs ("Timeline exported.\n", stdout);
+
+  fputs ("Checking timeline...\n", stdout);
+  if (check_timeline ("/tmp/iore_timeline_1_1_1.json"))
+    fputs ("FAIL: timeline is not well formed.\n", stderr);
+  else
+    fputs ("Timeline checked.\n", stdout);
+
   fputs ("Displaying to string...\n", stdout);
   tostr (stex);
   fputs ("String displayed.\n", stdout);
@@ -143,6 +193,278 @@ export (const iore_stex_t stex)
   return rerr;
 } /* export () */
 
+int
+export_timeline (const iore_stex_t *stex)
+{
+  int rerr;
+
+  iore_trec_exp_t exp = get_trec_exp ();
+  rerr = stex_timeline_open (stex);
+  if (!rerr)
+    rerr = stex_timeline_rept (exp.exp_repl[0].id, exp.exp_repl[0].run[0].id,
+			       &exp.exp_repl[0].run[0].run_rept[0], false);
+  stex_timeline_close ();
+
+  return rerr;
+} /* export_timeline () */
+
+/**
+ * Checks, at the master task, that the timeline in 'fname' parses as JSON,
+ * so that the events of consecutive tasks are separated and the footer is
+ * written once, at the end, and that it names the track of every task.
+ * Collective.
+ */
+int
+check_timeline (const char *fname)
+{
+  int rerr = IORE_SUCCESS;
+
+  MPI_Barrier (ctx.comm);
+  if (ctx.task_id != IORE_MASTER_TASK)
+    return rerr;
+
+  int num_procs;
+  MPI_Comm_size (ctx.comm, &num_procs);
+
+  FILE *file = fopen (fname, "r");
+  if (!file)
+    return IORE_FAILURE;
+  char *buf = NULL;
+  size_t len = 0;
+  FILE *mem = open_memstream (&buf, &len);
+  char chunk[4096];
+  size_t n;
+  while ((n = fread (chunk, 1, sizeof(chunk), file)) > 0)
+    fwrite (chunk, 1, n, mem);
+  fclose (mem);
+  fclose (file);
+
+  json_value *jtl = json_parse (buf, len);
+  if (!jtl || jtl->type != json_object || len < 4
+      || strcmp (buf + len - 4, "\n]}\n") != 0)
+    rerr = IORE_FAILURE;
+  else
+    {
+      json_value *jevts = NULL;
+      unsigned int i;
+      for (i = 0; i < jtl->u.object.length; i++)
+	if (strcmp (jtl->u.object.values[i].name, "traceEvents") == 0)
+	  jevts = jtl->u.object.values[i].value;
+
+      int num_threads = 0;
+      for (i = 0; jevts && jevts->type == json_array
+	  && i < jevts->u.array.length; i++)
+	{
+	  json_value *jevt = jevts->u.array.values[i];
+	  unsigned int j;
+	  for (j = 0; jevt->type == json_object && j < jevt->u.object.length;
+	      j++)
+	    if (strcmp (jevt->u.object.values[j].name, "name") == 0
+		&& jevt->u.object.values[j].value->type == json_string
+		&& strcmp (jevt->u.object.values[j].value->u.string.ptr,
+			   "thread_name") == 0)
+	      num_threads++;
+	}
+      if (num_threads != num_procs)
+	rerr = IORE_FAILURE;
+    }
+
+  json_value_free (jtl);
+  free (buf);
+
+  return rerr;
+} /* check_timeline () */
+
+/**
+ * Exports the task and test reports both as CSV and columnar data, each
+ * format into its own directory, and checks that the columnar files read
+ * back by stex_cols_read () convert to the rows of the CSV files. The
+ * columnar exporter sorts rows, so rows are compared in sorted order.
+ */
+int
+roundtrip_columnar (iore_stex_t stex)
+{
+  char dirs[2][32] =
+    { "/tmp/test_iore_stex_csvXXXXXX", "/tmp/test_iore_stex_colXXXXXX" };
+  int rerr = IORE_SUCCESS;
+  if (ctx.task_id == IORE_MASTER_TASK)
+    rerr = (!mkdtemp (dirs[0]) || !mkdtemp (dirs[1]));
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+  MPI_Bcast (dirs, sizeof(dirs), MPI_CHAR, IORE_MASTER_TASK, ctx.comm);
+  if (rerr)
+    return IORE_FAILURE;
+
+  stex.data_format = IORE_STEX_FORMAT_CSV;
+  stex.export_dir = dirs[0];
+  rerr = export (stex);
+  stex.data_format = IORE_STEX_FORMAT_COLUMNAR;
+  stex.export_dir = dirs[1];
+  rerr |= export (stex);
+
+  if (!rerr && ctx.task_id == IORE_MASTER_TASK)
+    {
+      rerr |= roundtrip_report (dirs[0], dirs[1]);
+      char pattern[FILENAME_MAX];
+      glob_t files;
+      snprintf (pattern, FILENAME_MAX, "%s/iore_*", dirs[1]);
+      if (!glob (pattern, 0, NULL, &files))
+	{
+	  /* a corrupt copy of the last report must be rejected */
+	  FILE *file = fopen (files.gl_pathv[files.gl_pathc - 1], "r+");
+	  iore_stex_cols_t cols;
+	  if (!file || fseek (file, -24, SEEK_END)
+	      || fwrite ("\xff\xff\xff\xff\xff\xff\xff\x7f", 8, 1, file)
+		  != 1)
+	    rerr = IORE_FAILURE;
+	  if (file)
+	    fclose (file);
+	  if (!stex_cols_read (files.gl_pathv[files.gl_pathc - 1], &cols))
+	    {
+	      stex_cols_free (&cols);
+	      rerr = IORE_FAILURE;
+	    }
+	  if (truncate (files.gl_pathv[0], 100)
+	      || !stex_cols_read (files.gl_pathv[0], &cols))
+	    rerr = IORE_FAILURE;
+	  globfree (&files);
+	}
+    }
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      unsigned int i;
+      size_t j;
+      for (i = 0; i < 2; i++)
+	{
+	  char pattern[FILENAME_MAX];
+	  glob_t files;
+	  snprintf (pattern, FILENAME_MAX, "%s/*", dirs[i]);
+	  if (!glob (pattern, 0, NULL, &files))
+	    {
+	      for (j = 0; j < files.gl_pathc; j++)
+		unlink (files.gl_pathv[j]);
+	      globfree (&files);
+	    }
+	  rmdir (dirs[i]);
+	}
+    }
+  MPI_Bcast (&rerr, 1, MPI_INT, IORE_MASTER_TASK, ctx.comm);
+
+  return rerr;
+} /* roundtrip_columnar () */
+
+/**
+ * Compares the task and test reports of the CSV files in 'csv_dir' with
+ * the CSV conversion of the columnar files in 'col_dir'.
+ */
+int
+roundtrip_report (const char *csv_dir, const char *col_dir)
+{
+  static const char *reports[] =
+    { "task", "test" };
+
+  int rerr = IORE_SUCCESS;
+  unsigned int i;
+  for (i = 0; i < sizeof(reports) / sizeof(reports[0]) && !rerr; i++)
+    {
+      char pattern[FILENAME_MAX];
+      glob_t csv_files, col_files;
+      snprintf (pattern, FILENAME_MAX, "%s/iore_%s_*.csv", csv_dir,
+		reports[i]);
+      int csv_rerr = glob (pattern, 0, NULL, &csv_files);
+      snprintf (pattern, FILENAME_MAX, "%s/iore_%s_*.col", col_dir,
+		reports[i]);
+      int col_rerr = glob (pattern, 0, NULL, &col_files);
+      if (csv_rerr || col_rerr || csv_files.gl_pathc != 1
+	  || col_files.gl_pathc != 1)
+	rerr = IORE_FAILURE;
+
+      iore_stex_cols_t cols;
+      if (!rerr && stex_cols_read (col_files.gl_pathv[0], &cols))
+	rerr = IORE_FAILURE;
+      if (!rerr)
+	{
+	  FILE *csv = fopen (csv_files.gl_pathv[0], "r");
+	  FILE *conv = tmpfile ();
+	  if (!csv || !conv)
+	    rerr = IORE_FAILURE;
+	  else
+	    {
+	      stex_cols_to_csv (&cols, NULL, conv);
+	      rewind (conv);
+
+	      size_t num_csv, num_conv, j;
+	      char **csv_lines = read_lines (csv, &num_csv);
+	      char **conv_lines = read_lines (conv, &num_conv);
+	      if (num_csv != num_conv || num_csv < 2
+		  || strcmp (csv_lines[0], conv_lines[0]))
+		rerr = IORE_FAILURE;
+	      else
+		{
+		  /* rows follow the header */
+		  qsort (csv_lines + 1, num_csv - 1, sizeof(char *),
+			 line_cmp);
+		  qsort (conv_lines + 1, num_conv - 1, sizeof(char *),
+			 line_cmp);
+		  for (j = 1; j < num_csv && !rerr; j++)
+		    if (strcmp (csv_lines[j], conv_lines[j]))
+		      rerr = IORE_FAILURE;
+		}
+	      for (j = 0; j < num_csv; j++)
+		free (csv_lines[j]);
+	      for (j = 0; j < num_conv; j++)
+		free (conv_lines[j]);
+	      free (csv_lines);
+	      free (conv_lines);
+	    }
+	  if (csv)
+	    fclose (csv);
+	  if (conv)
+	    fclose (conv);
+	  stex_cols_free (&cols);
+	}
+
+      if (!csv_rerr)
+	globfree (&csv_files);
+      if (!col_rerr)
+	globfree (&col_files);
+      fprintf (stdout, "Columnar %s report round trip: %s\n", reports[i],
+	       rerr ? "FAIL" : "OK");
+    }
+
+  return rerr;
+} /* roundtrip_report () */
+
+/**
+ * Returns the lines of 'file', without their line ends, and their number
+ * into 'num_lines'.
+ */
+char **
+read_lines (FILE *file, size_t *num_lines)
+{
+  char **lines = NULL;
+  *num_lines = 0;
+
+  char *line = NULL;
+  size_t cap = 0;
+  ssize_t len;
+  while ((len = getline (&line, &cap, file)) >= 0)
+    {
+      if (len > 0 && line[len - 1] == '\n')
+	line[len - 1] = '\0';
+      lines = realloc (lines, (*num_lines + 1) * sizeof(char *));
+      lines[(*num_lines)++] = strdup (line);
+    }
+  free (line);
+
+  return lines;
+} /* read_lines () */
+
+int
+line_cmp (const void *a, const void *b)
+{
+  return strcmp (*(char * const *) a, *(char * const *) b);
+} /* line_cmp () */
+
 void
 tostr (iore_stex_t stex)
 {
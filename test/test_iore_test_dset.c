@@ -41,7 +41,6 @@ main (int argc, char **argv)
   MPI_Init (&argc, &argv);
   ctx_init ();
   trec_init ();
-  prng_pool_init ();
 
   if (ctx.num_procs > MAX_PROCESSES)
     {
@@ -132,6 +131,8 @@ default_wkld (iore_wkld_t *wkld)
   assert(wkld->u.dset.u.cart.g_dim_sizes);
   wkld->u.dset.u.cart.g_dim_divs = malloc (size);
   assert(wkld->u.dset.u.cart.g_dim_divs);
+  wkld->u.dset.u.cart.my_dim_sizes = NULL;
+  wkld->u.dset.u.cart.my_start_coord = NULL;
   for (i = 0; i < num_dims; i++)
     {
       wkld->u.dset.u.cart.g_dim_sizes[i] = i + 1;
@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <assert.h>
 
 #include "iore_test.h"
@@ -15,6 +16,7 @@
 #include "iore_error.h"
 #include "iore_trec.h"
 #include "iore_prng.h"
+#include "iore_workload.h"
 
 #define MAX_PROCESSES 2
 
@@ -38,6 +40,12 @@ int
 test_09 ();
 int
 test_10 ();
+int
+test_11 ();
+int
+test_12 ();
+int
+test_13 ();
 
 int
 main (int argc, char **argv)
@@ -46,7 +54,6 @@ main (int argc, char **argv)
   MPI_Init (&argc, &argv);
   ctx_init ();
   trec_init ();
-  prng_pool_init ();
 
   if (ctx.num_procs > MAX_PROCESSES)
     {
@@ -62,7 +69,7 @@ main (int argc, char **argv)
 
   if (ctx.comm != MPI_COMM_NULL)
     {
-      const int num_tests = 10;
+      const int num_tests = 13;
       int i;
       int rerr;
       for (i = 1; i <= num_tests; i++)
@@ -103,6 +110,15 @@ main (int argc, char **argv)
 	    case 10:
 	      rerr = test_10 ();
 	      break;
+	    case 11:
+	      rerr = test_11 ();
+	      break;
+	    case 12:
+	      rerr = test_12 ();
+	      break;
+	    case 13:
+	      rerr = test_13 ();
+	      break;
 	    }
 	  if (rerr)
 	    fprintf (stdout, "[Task %d] Test %d: ...FAIL!\n", ctx.task_id, i);
@@ -331,3 +347,201 @@ test_10 ()
 
   return rerr;
 } /* test_10 () */
+
+/**
+ * Plans a trace with a known layout: task 0 writes [0, 100), [200, 300)
+ * and [250, 400) of its file, so the plan shows 300 bytes in extents, one
+ * gap of 100 bytes and one overlap of 50 bytes.
+ */
+int
+test_11 ()
+{
+  int rerr = IORE_SUCCESS;
+
+  iore_wkld_trace_hdr_t hdr =
+    { WKLD_TRACE_MAGIC, 2, IORE_WKLD_TRACE_TIME_NONE };
+  uint64_t idx[3] =
+    { 0, 3, 3 };
+  iore_wkld_trace_rec_t recs[3] =
+    {
+      { 200, 100, 0, 0, 0, IORE_TEST_TYPE_WRITE },
+      { 0, 100, 0, 0, 0, IORE_TEST_TYPE_WRITE },
+      { 250, 150, 0, 0, 0, IORE_TEST_TYPE_WRITE } };
+
+  const char *name = "./test_iore_test_oset.trace";
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      FILE *fp = fopen (name, "w");
+      assert(fp);
+      fwrite (&hdr, sizeof(hdr), 1, fp);
+      fwrite (idx, sizeof(idx), 1, fp);
+      fwrite (recs, sizeof(recs), 1, fp);
+      fclose (fp);
+    }
+  MPI_Barrier (ctx.comm);
+
+  iore_test_t test;
+  if (!test_init (&test))
+    rerr = IORE_FAILURE;
+  else
+    {
+      test.type.read = false;
+      wkld_free (&test.wkld);
+      MPI_Comm_size (ctx.comm, (int *) &test.wkld.num_tasks);
+      test.wkld.type = IORE_WKLD_TRACE;
+      test.wkld.u.trace.file_name = strdup (name);
+      assert(test.wkld.u.trace.file_name);
+      test.wkld.u.trace.timing = IORE_WKLD_TRACE_TM_RECORDED;
+
+      /* the plan is shown on stdout, captured into 'out' */
+      char out[] = "./test_iore_test_oset.XXXXXX";
+      int fd = mkstemp (out);
+      assert(fd >= 0);
+      fflush (stdout);
+      int saved_fd = dup (STDOUT_FILENO);
+      dup2 (fd, STDOUT_FILENO);
+      rerr = test_plan (&test, 0);
+      fflush (stdout);
+      dup2 (saved_fd, STDOUT_FILENO);
+      close (saved_fd);
+      close (fd);
+
+      if (!rerr && ctx.task_id == IORE_MASTER_TASK)
+	{
+	  char line[256];
+	  bool found = false;
+	  FILE *fp = fopen (out, "r");
+	  assert(fp);
+	  while (!found && fgets (line, sizeof(line), fp))
+	    found = (strcmp (line, "write files: 1, 300 bytes in extents, 1 "
+			     "gaps (100 bytes), 1 overlaps (50 bytes)\n")
+		== 0);
+	  fclose (fp);
+	  if (!found)
+	    rerr = IORE_FAILURE;
+	}
+      unlink (out);
+    }
+
+  test_free (&test);
+  MPI_Barrier (ctx.comm);
+  if (ctx.task_id == IORE_MASTER_TASK)
+    unlink (name);
+
+  return rerr;
+} /* test_11 () */
+
+/**
+ * Replays a trace whose record of rank 1 names a file the task does not
+ * have: every task fails the test, rather than waiting for rank 1.
+ */
+int
+test_12 ()
+{
+  int rerr = IORE_SUCCESS;
+
+  iore_wkld_trace_hdr_t hdr =
+    { WKLD_TRACE_MAGIC, 2, IORE_WKLD_TRACE_TIME_NONE };
+  uint64_t idx[3] =
+    { 0, 1, 2 };
+  iore_wkld_trace_rec_t recs[2] =
+    {
+      { 0, 100, 0, 0, 0, IORE_TEST_TYPE_WRITE },
+      { 0, 100, 0, 0, 5, IORE_TEST_TYPE_WRITE } };
+
+  const char *name = "./test_iore_test_oset.trace";
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      FILE *fp = fopen (name, "w");
+      assert(fp);
+      fwrite (&hdr, sizeof(hdr), 1, fp);
+      fwrite (idx, sizeof(idx), 1, fp);
+      fwrite (recs, sizeof(recs), 1, fp);
+      fclose (fp);
+    }
+  MPI_Barrier (ctx.comm);
+
+  iore_test_t test;
+  if (!test_init (&test))
+    rerr = IORE_FAILURE;
+  else
+    {
+      test.type.read = false;
+      wkld_free (&test.wkld);
+      MPI_Comm_size (ctx.comm, (int *) &test.wkld.num_tasks);
+      test.wkld.type = IORE_WKLD_TRACE;
+      test.wkld.u.trace.file_name = strdup (name);
+      assert(test.wkld.u.trace.file_name);
+      test.wkld.u.trace.timing = IORE_WKLD_TRACE_TM_NONE;
+
+      /* rank 1 only takes part with more than one task */
+      bool invalid = (test.wkld.num_tasks > 1);
+      bool failed = (test_exec (&test, 0, 0, 0) != IORE_SUCCESS);
+      if (failed != invalid)
+	rerr = IORE_FAILURE;
+    }
+
+  test_free (&test);
+  MPI_Barrier (ctx.comm);
+  if (ctx.task_id == IORE_MASTER_TASK)
+    unlink (name);
+
+  return rerr;
+} /* test_12 () */
+
+/**
+ * Replays time stamps recorded 300 ms apart on ranks 0 and 1: stamps are
+ * relative to the earliest of all ranks, so rank 1 waits for its own.
+ */
+int
+test_13 ()
+{
+  int rerr = IORE_SUCCESS;
+
+  iore_wkld_trace_hdr_t hdr =
+    { WKLD_TRACE_MAGIC, 2, IORE_WKLD_TRACE_TIME_STAMP };
+  uint64_t idx[3] =
+    { 0, 1, 2 };
+  iore_wkld_trace_rec_t recs[2] =
+    {
+      { 0, 100, 1000000000, 0, 0, IORE_TEST_TYPE_WRITE },
+      { 0, 100, 1300000000, 0, 0, IORE_TEST_TYPE_WRITE } };
+
+  const char *name = "./test_iore_test_oset.trace";
+  if (ctx.task_id == IORE_MASTER_TASK)
+    {
+      FILE *fp = fopen (name, "w");
+      assert(fp);
+      fwrite (&hdr, sizeof(hdr), 1, fp);
+      fwrite (idx, sizeof(idx), 1, fp);
+      fwrite (recs, sizeof(recs), 1, fp);
+      fclose (fp);
+    }
+  MPI_Barrier (ctx.comm);
+
+  iore_test_t test;
+  if (!test_init (&test))
+    rerr = IORE_FAILURE;
+  else
+    {
+      test.type.read = false;
+      wkld_free (&test.wkld);
+      MPI_Comm_size (ctx.comm, (int *) &test.wkld.num_tasks);
+      test.wkld.type = IORE_WKLD_TRACE;
+      test.wkld.u.trace.file_name = strdup (name);
+      assert(test.wkld.u.trace.file_name);
+      test.wkld.u.trace.timing = IORE_WKLD_TRACE_TM_RECORDED;
+
+      double start = MPI_Wtime ();
+      rerr = test_exec (&test, 0, 0, 0);
+      if (!rerr && ctx.task_id == 1 && MPI_Wtime () - start < 0.3)
+	rerr = IORE_FAILURE;
+    }
+
+  test_free (&test);
+  MPI_Barrier (ctx.comm);
+  if (ctx.task_id == IORE_MASTER_TASK)
+    unlink (name);
+
+  return rerr;
+} /* test_13 () */
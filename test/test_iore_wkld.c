@@ -8,14 +8,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <assert.h>
 
 #include "iore_workload.h"
 #include "iore_ctx.h"
 #include "iore_error.h"
 #include "iore_prng.h"
+#include "iore_trec.h"
 
 #define MAX_PROCESSES 2
+#define REQS_RING_LEN 3
+#define REQS_NUM 4 /* requests captured per task, one lost to the ring */
 
 int
 test_01 ();
@@ -25,6 +29,10 @@ int
 test_03 ();
 int
 test_04 ();
+int
+test_05 ();
+int
+test_06 ();
 
 int
 main (int argc, char **argv)
@@ -32,6 +40,12 @@ main (int argc, char **argv)
   fputs ("Initializing Workload test...\n", stdout);
   MPI_Init (&argc, &argv);
   ctx_init ();
+  trec_init ();
+
+  /* the capture ring is agreed on by all the tasks, see test_06 () */
+  iore_trec_reqs_t reqs =
+    { REQS_RING_LEN, "." };
+  trec_reqs_start (&reqs);
 
   if (ctx.num_procs > MAX_PROCESSES)
     {
@@ -47,7 +61,7 @@ main (int argc, char **argv)
 
   if (ctx.comm != MPI_COMM_NULL)
     {
-      const int num_tests = 4;
+      const int num_tests = 6;
       int i;
       int rerr;
       for (i = 1; i <= num_tests; i++)
@@ -66,6 +80,12 @@ main (int argc, char **argv)
 	    case 4:
 	      rerr = test_04 ();
 	      break;
+	    case 5:
+	      rerr = test_05 ();
+	      break;
+	    case 6:
+	      rerr = test_06 ();
+	      break;
 	    }
 	  if (rerr)
 	    fprintf (stdout, "[Task %d] Test %d: ...FAIL!\n", ctx.task_id, i);
@@ -75,6 +95,8 @@ main (int argc, char **argv)
 	}
     }
 
+  trec_reqs_stop ();
+  trec_destroy ();
   MPI_Finalize ();
   fputs ("Finalizing Workload test.\n", stdout);
 } /* main () */
@@ -194,3 +216,134 @@ test_04 ()
 
   return rerr;
 } /* test_04 () */
+
+int
+test_05 ()
+{
+  int rerr = IORE_SUCCESS;
+
+  /* rank 0 writes twice and reads once, rank 1 writes once */
+  iore_wkld_trace_hdr_t hdr =
+    { WKLD_TRACE_MAGIC, 2, IORE_WKLD_TRACE_TIME_THINK };
+  uint64_t idx[3] =
+    { 0, 3, 4 };
+  iore_wkld_trace_rec_t recs[4] =
+    {
+      { 0, 100, 0, 0, 0, IORE_TEST_TYPE_WRITE },
+      { 4096, 300, 1000, 0, 0, IORE_TEST_TYPE_WRITE },
+      { 0, 50, 0, 0, 0, IORE_TEST_TYPE_READ },
+      { 8192, 200, 0, 0, 0, IORE_TEST_TYPE_WRITE } };
+
+  char name[64];
+  snprintf (name, sizeof(name), "./test_iore_wkld.%d.trace", ctx.task_id);
+  FILE *fp = fopen (name, "w");
+  assert(fp);
+  fwrite (&hdr, sizeof(hdr), 1, fp);
+  fwrite (idx, sizeof(idx), 1, fp);
+  fwrite (recs, sizeof(recs), 1, fp);
+  fclose (fp);
+
+  iore_wkld_t wkld =
+    { };
+  wkld.num_tasks = ctx.num_procs;
+  wkld.type = IORE_WKLD_TRACE;
+  wkld.u.trace.file_name = strdup (name);
+  wkld.u.trace.timing = IORE_WKLD_TRACE_TM_RECORDED;
+
+  if (wkld_trace_map (&wkld.u.trace, ctx.task_id, IORE_TEST_TYPE_WRITE, 1))
+    rerr = IORE_FAILURE;
+  else if (ctx.task_id == 0)
+    rerr = !(wkld.u.trace._my_recs_len == 3
+	&& wkld.u.trace.my_data_size == 400
+	&& wkld.u.trace.my_req_size == 300 && wkld.u.trace._num_reqs == 2
+	&& wkld.u.trace._file_size == 4396);
+  else if (ctx.task_id == 1)
+    rerr = !(wkld.u.trace._my_recs_len == 1
+	&& wkld.u.trace.my_data_size == 200 && wkld.u.trace._num_reqs == 1);
+
+  fprintf (stdout, "[Task %d] %s\n", ctx.task_id, wkld2str (&wkld));
+
+  /* ranks not in the trace replay nothing */
+  if (!rerr && !wkld_trace_map (&wkld.u.trace, 2, IORE_TEST_TYPE_WRITE, 1))
+    rerr = (wkld.u.trace._my_recs_len != 0);
+
+  wkld_free (&wkld);
+  unlink (name);
+
+  return rerr;
+} /* test_05 () */
+
+/**
+ * Captures the requests of a write test, flushes them into a trace file and
+ * maps the trace back: each task finds its last REQS_RING_LEN requests, in
+ * issue order, with their files and increasing time stamps.
+ */
+int
+test_06 ()
+{
+  int rerr = IORE_SUCCESS;
+
+  trec_exp_start (1);
+  trec_exp_repl_start (1, 1);
+  trec_run_start (1, 1);
+  trec_run_rept_start (1);
+  trec_test_start (IORE_TEST_TYPE_WRITE, IORE_TREC_ACTION_WRITE_READ);
+  int i;
+  for (i = 0; i < REQS_NUM; i++)
+    {
+      trec_req_file (i % 2);
+      iore_time_t start = trec_req_start ();
+      trec_req_stop ((ctx.task_id * REQS_NUM + i) * 100, 100 + i, start);
+    }
+  trec_test_stop (0);
+  trec_test_commit ();
+  trec_run_rept_stop ();
+
+  if (trec_reqs_flush (1, 1, 1))
+    rerr = IORE_FAILURE;
+
+  trec_run_stop ();
+  trec_exp_repl_stop ();
+  trec_exp_stop ();
+
+  const char *name = "./iore_reqs_1_1_1.trace";
+  iore_wkld_t wkld =
+    { };
+  wkld.num_tasks = ctx.num_procs;
+  wkld.type = IORE_WKLD_TRACE;
+  wkld.u.trace.file_name = strdup (name);
+  wkld.u.trace.timing = IORE_WKLD_TRACE_TM_RECORDED;
+
+  if (!rerr
+      && wkld_trace_map (&wkld.u.trace, ctx.task_id, IORE_TEST_TYPE_WRITE, 2))
+    rerr = IORE_FAILURE;
+  else if (!rerr)
+    {
+      const iore_wkld_trace_t *trace = &wkld.u.trace;
+      rerr = !(trace->_time_mode == IORE_WKLD_TRACE_TIME_STAMP
+	  && trace->_my_recs_len == REQS_RING_LEN
+	  && trace->_num_reqs == REQS_RING_LEN
+	  && trace->my_data_size == 101 + 102 + 103
+	  && trace->my_req_size == 103);
+
+      size_t j;
+      for (j = 0; j < trace->_my_recs_len && !rerr; j++)
+	{
+	  const iore_wkld_trace_rec_t *rec = &trace->my_recs[j];
+	  int i_req = REQS_NUM - REQS_RING_LEN + j;
+	  rerr = !(rec->offset == (uint64_t) (ctx.task_id * REQS_NUM + i_req)
+	      * 100 && rec->size == (uint64_t) (100 + i_req)
+	      && rec->file_id == (uint32_t) (i_req % 2)
+	      && rec->op == IORE_TEST_TYPE_WRITE
+	      && (j == 0 || rec->time >= trace->my_recs[j - 1].time));
+	}
+      wkld_trace_unmap (&wkld.u.trace);
+    }
+
+  wkld_free (&wkld);
+  MPI_Barrier (ctx.comm);
+  if (ctx.task_id == IORE_MASTER_TASK)
+    unlink (name);
+
+  return rerr;
+} /* test_06 () */